@@ -3,27 +3,29 @@
 
 #include <rh.hpp>
 
-#include <rh/Mutex.hpp>
+#include <rh/Lockable.hpp>
 
 _RHLIB_BEGIN
 
+// Works with any Lockable, i.e. Mutex or SpinLock
+template <Lockable LockT>
 class ScopedLock {
 public:
-  using type = ScopedLock;
+  using type = ScopedLock<LockT>;
 
 public:
-  constexpr ScopedLock(Mutex& mtx)
-    : m_mutex(mtx)
+  constexpr ScopedLock(LockT& lock)
+    : m_lock(lock)
   {
-    m_mutex.lock();
+    m_lock.lock();
   }
 
   constexpr ~ScopedLock() {
-    m_mutex.unlock();
+    m_lock.unlock();
   }
 
 private:
-  Mutex& m_mutex;
+  LockT& m_lock;
 };
 
 _RHLIB_END
@@ -0,0 +1,52 @@
+#pragma once
+#define _RHLIB_INCLUDED_SPINLOCK
+
+#include <rh.hpp>
+
+_RHLIB_BEGIN
+
+// Busy-waiting lock for very short critical sections. Never puts thread to sleep
+class SpinLock {
+public:
+  using type = SpinLock;
+
+private:
+  bool m_locked = false;
+
+public:
+  constexpr SpinLock() noexcept = default;
+
+  SpinLock(SpinLock const&) = delete;
+  SpinLock& operator=(SpinLock const&) = delete;
+
+public:
+  inline void lock() noexcept {
+    while (__atomic_exchange_n(&m_locked, true, __ATOMIC_ACQUIRE)) {
+      // wait on plain loads, so cache line isn't bounced between cores
+      while (__atomic_load_n(&m_locked, __ATOMIC_RELAXED))
+        _relax();
+    }
+  }
+
+  inline void unlock() noexcept {
+    __atomic_store_n(&m_locked, false, __ATOMIC_RELEASE);
+  }
+
+  // true = locked, false = not locked
+  inline bool try_lock() noexcept {
+    return
+      !__atomic_load_n(&m_locked, __ATOMIC_RELAXED) &&
+      !__atomic_exchange_n(&m_locked, true, __ATOMIC_ACQUIRE);
+  }
+
+private:
+  static inline void _relax() noexcept {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    __builtin_ia32_pause();
+#endif
+  }
+};
+
+_RHLIB_END
+
+_RHLIB_GLOBAL_CLASS(SpinLock);
@@ -0,0 +1,101 @@
+#include <benchmark/benchmark.h>
+
+#include <rh/Deque.hpp>
+#include <rh/List.hpp>
+#include <rh/RingBuffer.hpp>
+
+namespace {
+
+// the queue a List can offer without a dedicated type, every pop shifts the rest
+struct ListQueue {
+  rh::List<int> items;
+
+  explicit ListQueue(size_t) {}
+
+  void push(int value) {
+    items.append(value);
+  }
+
+  int pop() {
+    int value = items[0];
+    items.erase(0);
+    return value;
+  }
+};
+
+struct DequeQueue {
+  rh::Deque<int> items;
+
+  explicit DequeQueue(size_t) {}
+
+  void push(int value) {
+    items.append(value);
+  }
+
+  int pop() {
+    int value = items.front();
+    items.popFront();
+    return value;
+  }
+};
+
+struct RingBufferQueue {
+  rh::RingBuffer<int> items;
+
+  explicit RingBufferQueue(size_t depth) : items(depth) {}
+
+  void push(int value) {
+    items.append(value);
+  }
+
+  int pop() {
+    int value = items.front();
+    items.popFront();
+    return value;
+  }
+};
+
+// steady-state FIFO holding `depth` items, one push and one pop per iteration
+template <typename QueueT>
+void fifo(benchmark::State& state) {
+  size_t depth = static_cast<size_t>(state.range(0));
+  QueueT queue{depth};
+  int next = 0;
+
+  for (size_t index = 0; index < depth; ++index)
+    queue.push(next++);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(queue.pop());
+    queue.push(next++);
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+// fill to `depth` then drain, so growth and chunk recycling are included
+template <typename QueueT>
+void fillDrain(benchmark::State& state) {
+  size_t depth = static_cast<size_t>(state.range(0));
+
+  for (auto _ : state) {
+    QueueT queue{depth};
+
+    for (size_t index = 0; index < depth; ++index)
+      queue.push(static_cast<int>(index));
+
+    for (size_t index = 0; index < depth; ++index)
+      benchmark::DoNotOptimize(queue.pop());
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * depth));
+}
+
+} // namespace
+
+BENCHMARK(fifo<ListQueue>)->RangeMultiplier(16)->Range(16, 1 << 16);
+BENCHMARK(fifo<DequeQueue>)->RangeMultiplier(16)->Range(16, 1 << 16);
+BENCHMARK(fifo<RingBufferQueue>)->RangeMultiplier(16)->Range(16, 1 << 16);
+BENCHMARK(fillDrain<ListQueue>)->RangeMultiplier(16)->Range(16, 1 << 16);
+BENCHMARK(fillDrain<DequeQueue>)->RangeMultiplier(16)->Range(16, 1 << 16);
+BENCHMARK(fillDrain<RingBufferQueue>)->RangeMultiplier(16)->Range(16, 1 << 16);
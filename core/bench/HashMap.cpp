@@ -0,0 +1,107 @@
+#include <benchmark/benchmark.h>
+
+#include <rh/HashMap.hpp>
+
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+// scrambled keys so neither table sees a sequential pattern
+std::vector<uint64_t> makeKeys(size_t count, uint64_t seed) {
+  std::vector<uint64_t> keys(count);
+  uint64_t state = seed;
+
+  for (uint64_t& key : keys) {
+    state = state * 6364136223846793005u + 1442695040888963407u;
+    key = state ^ (state >> 29);
+  }
+
+  return keys;
+}
+
+struct RhMap {
+  rh::HashMap<uint64_t, uint64_t> map;
+
+  void insert(uint64_t key, uint64_t value) {
+    (void)map.insert(key, value);
+  }
+
+  [[nodiscard]]
+  uint64_t const* find(uint64_t key) const {
+    return map.find(key);
+  }
+};
+
+struct StdMap {
+  std::unordered_map<uint64_t, uint64_t> map;
+
+  void insert(uint64_t key, uint64_t value) {
+    map.emplace(key, value);
+  }
+
+  [[nodiscard]]
+  uint64_t const* find(uint64_t key) const {
+    auto found = map.find(key);
+    return found == map.end() ? nullptr : &found->second;
+  }
+};
+
+template <typename MapT>
+void insert(benchmark::State& state) {
+  std::vector<uint64_t> keys = makeKeys(static_cast<size_t>(state.range(0)), 1);
+
+  for (auto _ : state) {
+    MapT map;
+
+    for (uint64_t key : keys)
+      map.insert(key, key);
+
+    benchmark::DoNotOptimize(map.find(keys.front()));
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * keys.size()));
+}
+
+template <typename MapT>
+void lookup(benchmark::State& state, bool hit) {
+  std::vector<uint64_t> keys = makeKeys(static_cast<size_t>(state.range(0)), 1);
+  std::vector<uint64_t> misses = makeKeys(keys.size(), 2);
+  std::vector<uint64_t> const& probes = hit ? keys : misses;
+  MapT map;
+
+  for (uint64_t key : keys)
+    map.insert(key, key);
+
+  size_t index = 0;
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(map.find(probes[index]));
+
+    if (++index == probes.size())
+      index = 0;
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+template <typename MapT>
+void hit(benchmark::State& state) {
+  lookup<MapT>(state, true);
+}
+
+template <typename MapT>
+void miss(benchmark::State& state) {
+  lookup<MapT>(state, false);
+}
+
+} // namespace
+
+// 1K keys stay in L1/L2, 32M and 128M keys are far past the last level cache.
+// At 128M keys std::unordered_map alone takes about 6 GiB
+BENCHMARK(insert<RhMap>)->RangeMultiplier(32)->Range(1 << 10, 1 << 27)->Unit(benchmark::kMillisecond);
+BENCHMARK(insert<StdMap>)->RangeMultiplier(32)->Range(1 << 10, 1 << 27)->Unit(benchmark::kMillisecond);
+BENCHMARK(hit<RhMap>)->RangeMultiplier(32)->Range(1 << 10, 1 << 27);
+BENCHMARK(hit<StdMap>)->RangeMultiplier(32)->Range(1 << 10, 1 << 27);
+BENCHMARK(miss<RhMap>)->RangeMultiplier(32)->Range(1 << 10, 1 << 27);
+BENCHMARK(miss<StdMap>)->RangeMultiplier(32)->Range(1 << 10, 1 << 27);
@@ -0,0 +1,76 @@
+#include <benchmark/benchmark.h>
+
+#include <rh/InternTable.hpp>
+
+#include <vector>
+
+namespace {
+
+constexpr size_t STRINGS_COUNT = 1024;
+
+InternTable& table() {
+  static InternTable instance;
+  return instance;
+}
+
+std::vector<String> const& strings() {
+  static std::vector<String> instance = [] {
+    std::vector<String> result;
+
+    for (size_t index = 0; index < STRINGS_COUNT; ++index) {
+      String string{U"identifier_"};
+
+      for (size_t value = index + 1; value > 0; value /= 26)
+        string.append(U'a' + static_cast<char32_t>(value % 26));
+
+      (void)table().intern(string);
+      result.push_back(std::move(string));
+    }
+
+    return result;
+  }();
+
+  return instance;
+}
+
+// hit path, which counts statistics
+void internHit(benchmark::State& state) {
+  std::vector<String> const& keys = strings();
+  size_t index = static_cast<size_t>(state.thread_index()) * 97;
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(table().intern(keys[index % STRINGS_COUNT]));
+    ++index;
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+// same lookup without statistics, the baseline for internHit
+void find(benchmark::State& state) {
+  std::vector<String> const& keys = strings();
+  size_t index = static_cast<size_t>(state.thread_index()) * 97;
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(table().find(keys[index % STRINGS_COUNT]));
+    ++index;
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+// every thread interns the same atom, so all of them hit one shard
+void internSameHit(benchmark::State& state) {
+  String const& key = strings()[0];
+
+  for (auto _ : state)
+    benchmark::DoNotOptimize(table().intern(key));
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+}
+
+BENCHMARK(internHit)->ThreadRange(1, 8);
+BENCHMARK(find)->ThreadRange(1, 8);
+BENCHMARK(internSameHit)->ThreadRange(1, 8);
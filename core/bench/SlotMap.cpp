@@ -0,0 +1,158 @@
+#include <benchmark/benchmark.h>
+
+#include <rh/HashMap.hpp>
+#include <rh/List.hpp>
+#include <rh/SlotMap.hpp>
+
+#include <vector>
+
+namespace {
+
+struct Particle {
+  float x, y, z;
+  float dx, dy, dz;
+};
+
+Particle particle(uint64_t seed) {
+  float value = static_cast<float>(seed % 1024);
+  return { value, value, value, 1.0f, 0.5f, 0.25f };
+}
+
+// xorshift, cheap enough not to show up next to the container work
+struct Random {
+  uint64_t state = 0x9E3779B97F4A7C15ull;
+
+  size_t below(size_t bound) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return static_cast<size_t>(state % bound);
+  }
+};
+
+// SlotMap, with the handles an owner would keep
+struct SlotMapStore {
+  rh::SlotMap<Particle> items;
+  std::vector<rh::SlotHandle> handles;
+
+  void add(uint64_t seed) {
+    handles.push_back(items.insert(particle(seed)));
+  }
+
+  void replace(size_t which, uint64_t seed) {
+    (void)items.erase(handles[which]);
+    handles[which] = items.insert(particle(seed));
+  }
+
+  [[nodiscard]]
+  Particle const* find(size_t which) const {
+    return items.find(handles[which]);
+  }
+};
+
+// the usual alternative, items keyed by a never-reused id
+struct HashMapStore {
+  rh::HashMap<uint64_t, Particle> items;
+  std::vector<uint64_t> ids;
+  uint64_t nextId = 0;
+
+  void add(uint64_t seed) {
+    ids.push_back(nextId);
+    (void)items.insert(nextId++, particle(seed));
+  }
+
+  void replace(size_t which, uint64_t seed) {
+    (void)items.erase(ids[which]);
+    ids[which] = nextId;
+    (void)items.insert(nextId++, particle(seed));
+  }
+
+  [[nodiscard]]
+  Particle const* find(size_t which) const {
+    return items.find(ids[which]);
+  }
+};
+
+template <typename StoreT>
+StoreT makeStore(size_t count) {
+  StoreT store;
+
+  for (size_t index = 0; index < count; ++index)
+    store.add(index);
+
+  return store;
+}
+
+// erase a random live item and insert a new one, the population stays the same
+template <typename StoreT>
+void churn(benchmark::State& state) {
+  size_t live = static_cast<size_t>(state.range(0));
+  StoreT store = makeStore<StoreT>(live);
+  Random random;
+  uint64_t seed = live;
+
+  for (auto _ : state)
+    store.replace(random.below(live), seed++);
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+template <typename StoreT>
+void lookup(benchmark::State& state) {
+  size_t live = static_cast<size_t>(state.range(0));
+  StoreT store = makeStore<StoreT>(live);
+  Random random;
+
+  for (auto _ : state)
+    benchmark::DoNotOptimize(store.find(random.below(live)));
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+template <typename ContainerT>
+void step(ContainerT& particles) {
+  for (Particle& item : particles) {
+    item.x += item.dx;
+    item.y += item.dy;
+    item.z += item.dz;
+  }
+
+  benchmark::ClobberMemory();
+}
+
+// after churn the items are still dense, so this should match iterateList
+void iterateSlotMap(benchmark::State& state) {
+  size_t live = static_cast<size_t>(state.range(0));
+  SlotMapStore store = makeStore<SlotMapStore>(live);
+  Random random;
+
+  for (size_t index = 0; index < live; ++index)
+    store.replace(random.below(live), index);
+
+  for (auto _ : state)
+    step(store.items);
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * live));
+}
+
+void iterateList(benchmark::State& state) {
+  size_t live = static_cast<size_t>(state.range(0));
+  rh::List<Particle> particles;
+
+  for (size_t index = 0; index < live; ++index)
+    particles.append(particle(index));
+
+  for (auto _ : state)
+    step(particles);
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * live));
+}
+
+} // namespace
+
+BENCHMARK(churn<SlotMapStore>)->Arg(1 << 20)->Arg(1 << 22);
+BENCHMARK(churn<HashMapStore>)->Arg(1 << 20)->Arg(1 << 22);
+BENCHMARK(lookup<SlotMapStore>)->Arg(1 << 20)->Arg(1 << 22);
+BENCHMARK(lookup<HashMapStore>)->Arg(1 << 20)->Arg(1 << 22);
+BENCHMARK(iterateSlotMap)->Arg(1 << 20)->Arg(1 << 22)->Unit(benchmark::kMicrosecond);
+BENCHMARK(iterateList)->Arg(1 << 20)->Arg(1 << 22)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,55 @@
+#include <benchmark/benchmark.h>
+
+#include <rh/List.hpp>
+#include <rh/SmallList.hpp>
+
+namespace {
+
+size_t g_allocations = 0;
+
+struct CountingAllocator {
+  static void* allocate(size_t size, size_t alignment) {
+    ++g_allocations;
+    return DefaultAllocator::allocate(size, alignment);
+  }
+
+  static void deallocate(void* pointer, size_t size, size_t alignment) noexcept {
+    DefaultAllocator::deallocate(pointer, size, alignment);
+  }
+};
+
+constexpr size_t LISTS_COUNT = 1000000;
+
+// a million lists of 0..max_length items each
+template <typename ListT>
+void buildLists(benchmark::State& state) {
+  size_t max_length = static_cast<size_t>(state.range(0));
+
+  g_allocations = 0;
+
+  for (auto _ : state) {
+    for (size_t index = 0; index < LISTS_COUNT; ++index) {
+      ListT list;
+      size_t length = index % (max_length + 1);
+
+      for (size_t item = 0; item < length; ++item)
+        list.append(static_cast<int>(item));
+
+      benchmark::DoNotOptimize(list.begin());
+    }
+  }
+
+  double lists = static_cast<double>(state.iterations() * LISTS_COUNT);
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * LISTS_COUNT));
+  state.counters["allocations per list"] = static_cast<double>(g_allocations) / lists;
+}
+
+}
+
+using CountedList      = rh::List<int, CountingAllocator>;
+using CountedSmallList = rh::SmallList<int, 8, CountingAllocator>;
+
+// up to 8 items fit inline, longer lists spill to the heap
+BENCHMARK(buildLists<CountedList>)->Arg(4)->Arg(8)->Arg(16)->Unit(benchmark::kMillisecond);
+BENCHMARK(buildLists<CountedSmallList>)->Arg(4)->Arg(8)->Arg(16)->Unit(benchmark::kMillisecond);
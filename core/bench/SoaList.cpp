@@ -0,0 +1,74 @@
+#include <benchmark/benchmark.h>
+
+#include <rh/List.hpp>
+#include <rh/SoaList.hpp>
+
+namespace {
+
+// ten fields, of which the sweep touches two
+struct Particle {
+  float x, y, z;
+  float dx, dy, dz;
+  float mass, charge, age, lifetime;
+};
+
+using ParticleColumns = rh::SoaList<float, float, float, float, float, float, float, float, float, float>;
+
+Particle particle(size_t seed) {
+  float value = static_cast<float>(seed % 1024);
+  return { value, value, value, 1.0f, 0.5f, 0.25f, 1.0f, -1.0f, 0.0f, 60.0f };
+}
+
+// x += dx over every row
+void sweepList(benchmark::State& state) {
+  size_t count = static_cast<size_t>(state.range(0));
+  rh::List<Particle> particles;
+
+  particles.reserve(count);
+  for (size_t index = 0; index < count; ++index)
+    particles.append(particle(index));
+
+  for (auto _ : state) {
+    for (Particle& item : particles)
+      item.x += item.dx;
+
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * count));
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * count * sizeof(Particle)));
+}
+
+void sweepSoaList(benchmark::State& state) {
+  size_t count = static_cast<size_t>(state.range(0));
+  ParticleColumns particles;
+
+  particles.reserve(count);
+  for (size_t index = 0; index < count; ++index) {
+    Particle item = particle(index);
+    particles.append(
+      item.x, item.y, item.z,
+      item.dx, item.dy, item.dz,
+      item.mass, item.charge, item.age, item.lifetime
+    );
+  }
+
+  for (auto _ : state) {
+    auto x = particles.column<0>();
+    auto dx = particles.column<3>();
+
+    for (size_t index = 0; index < count; ++index)
+      x[index] += dx[index];
+
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * count));
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * count * 2 * sizeof(float)));
+}
+
+} // namespace
+
+// 2.5 MiB of rows is past L2, 40 and 160 MiB are past L3
+BENCHMARK(sweepList)->Arg(1 << 16)->Arg(1 << 20)->Arg(1 << 22)->Unit(benchmark::kMicrosecond);
+BENCHMARK(sweepSoaList)->Arg(1 << 16)->Arg(1 << 20)->Arg(1 << 22)->Unit(benchmark::kMicrosecond);
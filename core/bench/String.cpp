@@ -0,0 +1,54 @@
+#include <benchmark/benchmark.h>
+
+#include <rh/String.hpp>
+
+namespace {
+
+size_t g_allocations = 0;
+
+struct CountingAllocator {
+  static void* allocate(size_t size, size_t alignment) {
+    ++g_allocations;
+    return DefaultAllocator::allocate(size, alignment);
+  }
+
+  static void deallocate(void* pointer, size_t size, size_t alignment) noexcept {
+    DefaultAllocator::deallocate(pointer, size, alignment);
+  }
+};
+
+using CountedString = rh::BasicString<char32_t, CountingAllocator>;
+
+// identifiers and map keys of 1..length characters
+void buildShortStrings(benchmark::State& state) {
+  size_t max_length = static_cast<size_t>(state.range(0));
+  size_t built = 0;
+  size_t inline_built = 0;
+
+  g_allocations = 0;
+
+  for (auto _ : state) {
+    for (size_t length = 1; length <= max_length; ++length) {
+      CountedString string;
+
+      for (size_t index = 0; index < length; ++index)
+        string.append(U'a' + static_cast<char32_t>(index % 26));
+
+      benchmark::DoNotOptimize(string.data());
+      ++built;
+
+      // without inline storage, each of them took at least one allocation
+      if (string.capacity() == CountedString::INLINE_CAPACITY)
+        ++inline_built;
+    }
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(built));
+  state.counters["inline capacity"] = static_cast<double>(CountedString::INLINE_CAPACITY);
+  state.counters["allocations avoided per million"] = 1e6 * static_cast<double>(inline_built) / static_cast<double>(built);
+  state.counters["allocations per million"] = 1e6 * static_cast<double>(g_allocations) / static_cast<double>(built);
+}
+
+}
+
+BENCHMARK(buildShortStrings)->Arg(4)->Arg(8)->Arg(16)->Arg(32);
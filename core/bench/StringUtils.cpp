@@ -0,0 +1,141 @@
+#include <benchmark/benchmark.h>
+
+#include <rh/String.hpp>
+
+#include <vector>
+
+namespace {
+
+using Utils = rh::_Hidden::StringUtils;
+
+// "abc...xyzabc..." without the character searched for, null-terminated
+std::vector<char32_t> makeText(size_t length) {
+  std::vector<char32_t> text(length + 1);
+
+  for (size_t index = 0; index < length; ++index)
+    text[index] = U'a' + static_cast<char32_t>(index % 26);
+
+  text[length] = 0;
+  return text;
+}
+
+struct Scalar {
+  static size_t length(const char32_t* string) { return Utils::lengthScalar(string); }
+
+  static ssize_t find(const char32_t* string, size_t count, char32_t character) {
+    return Utils::findScalar(string, count, character);
+  }
+
+  static bool isSubStringEqual(const char32_t* string, const char32_t* other, size_t count) {
+    return Utils::isSubStringEqualScalar(string, 0, other, count);
+  }
+
+  static ssize_t findShort(const char32_t* string, size_t count, const char32_t* needle, size_t needle_count) {
+    return Utils::findShortScalar(string, count, needle, needle_count);
+  }
+};
+
+#if _RHLIB_SIMD_SSE2
+struct Vector {
+  static size_t length(const char32_t* string) { return Utils::lengthVector(string); }
+
+  static ssize_t find(const char32_t* string, size_t count, char32_t character) {
+    return Utils::findVector(string, count, character);
+  }
+
+  static bool isSubStringEqual(const char32_t* string, const char32_t* other, size_t count) {
+    return Utils::isSubStringEqualVector(string, 0, other, count);
+  }
+
+  static ssize_t findShort(const char32_t* string, size_t count, const char32_t* needle, size_t needle_count) {
+    return Utils::findShortVector(string, count, needle, needle_count);
+  }
+};
+#endif
+
+void setBytes(benchmark::State& state) {
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0) * static_cast<int64_t>(sizeof(char32_t)));
+}
+
+template <typename KernelsT>
+void length(benchmark::State& state) {
+  std::vector<char32_t> text = makeText(static_cast<size_t>(state.range(0)));
+
+  for (auto _ : state) {
+    const char32_t* string = text.data();
+    benchmark::DoNotOptimize(string);
+
+    benchmark::DoNotOptimize(KernelsT::length(string));
+  }
+
+  setBytes(state);
+}
+
+template <typename KernelsT>
+void findCharacter(benchmark::State& state) {
+  size_t count = static_cast<size_t>(state.range(0));
+  std::vector<char32_t> text = makeText(count);
+
+  for (auto _ : state) {
+    const char32_t* string = text.data();
+    benchmark::DoNotOptimize(string);
+
+    benchmark::DoNotOptimize(KernelsT::find(string, count, U'!'));
+  }
+
+  setBytes(state);
+}
+
+template <typename KernelsT>
+void isSubStringEqual(benchmark::State& state) {
+  size_t count = static_cast<size_t>(state.range(0));
+  std::vector<char32_t> text = makeText(count);
+  std::vector<char32_t> copy = text;
+
+  for (auto _ : state) {
+    const char32_t* string = text.data();
+    benchmark::DoNotOptimize(string);
+
+    benchmark::DoNotOptimize(KernelsT::isSubStringEqual(string, copy.data(), count));
+  }
+
+  setBytes(state);
+}
+
+// needle, which matches only at the very end
+template <typename KernelsT>
+void findShort(benchmark::State& state) {
+  size_t count = static_cast<size_t>(state.range(0));
+  std::vector<char32_t> text = makeText(count);
+  const char32_t needle[] = { U'x', U'y', U'!' };
+
+  text[count - 1] = U'!';
+  text[count - 2] = U'y';
+  text[count - 3] = U'x';
+
+  for (auto _ : state) {
+    const char32_t* string = text.data();
+    benchmark::DoNotOptimize(string);
+
+    benchmark::DoNotOptimize(KernelsT::findShort(string, count, needle, 3));
+  }
+
+  setBytes(state);
+}
+
+}
+
+#define RHLIB_STRING_UTILS_BENCHMARK(kernel, kernels) \
+  BENCHMARK(kernel<kernels>)->Name(#kernel "/" #kernels)->RangeMultiplier(8)->Range(16, 64 * 1024)
+
+RHLIB_STRING_UTILS_BENCHMARK(length, Scalar);
+RHLIB_STRING_UTILS_BENCHMARK(findCharacter, Scalar);
+RHLIB_STRING_UTILS_BENCHMARK(isSubStringEqual, Scalar);
+RHLIB_STRING_UTILS_BENCHMARK(findShort, Scalar);
+
+#if _RHLIB_SIMD_SSE2
+RHLIB_STRING_UTILS_BENCHMARK(length, Vector);
+RHLIB_STRING_UTILS_BENCHMARK(findCharacter, Vector);
+RHLIB_STRING_UTILS_BENCHMARK(isSubStringEqual, Vector);
+RHLIB_STRING_UTILS_BENCHMARK(findShort, Vector);
+#endif
@@ -0,0 +1,220 @@
+#include <benchmark/benchmark.h>
+
+#include <rh/Utf8String.hpp>
+
+namespace {
+
+using Utils = rh::_Hidden::Utf8Utils;
+
+// 1 MB of ASCII or of mixed 1..4-byte text
+Utf8String makeText(bool ascii) {
+  const char8_t* piece = ascii
+    ? u8"plain ASCII words, numbers 0123456789 and punctuation. "
+    : u8"ASCII, кириллица, € and 😀 mixed together. ";
+
+  Utf8String text;
+  while (text.length() < 1024 * 1024)
+    text.append(piece);
+
+  return text;
+}
+
+void setBytes(benchmark::State& state, Utf8String const& text) {
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(text.length()));
+}
+
+// decodeOne() over the whole text, which is what validation did before SIMD
+void validateScalar(benchmark::State& state) {
+  Utf8String text = makeText(state.range(0) != 0);
+
+  for (auto _ : state) {
+    size_t index = 0;
+
+    while (index < text.length()) {
+      char32_t code_point;
+      size_t size = Utils::decodeOne(text.data(), text.length(), index, code_point);
+
+      if (size == 0)
+        break;
+
+      index += size;
+    }
+
+    benchmark::DoNotOptimize(index);
+  }
+
+  setBytes(state, text);
+}
+
+// Plain per-byte loop with no lookup tables or SIMD, what a hand-written decoder would
+//  look like. Returns the number of code points written, or -1 on invalid input
+ssize_t naiveDecode(const char8_t* string, size_t length, char32_t* destination) {
+  size_t written = 0;
+  size_t index = 0;
+
+  while (index < length) {
+    uint8_t lead = string[index];
+    size_t size;
+    char32_t code_point;
+
+    if (lead < 0x80) {
+      destination[written++] = lead;
+      ++index;
+      continue;
+    }
+
+    if ((lead & 0xE0) == 0xC0) {
+      size = 2;
+      code_point = lead & 0x1F;
+    }
+    else if ((lead & 0xF0) == 0xE0) {
+      size = 3;
+      code_point = lead & 0x0F;
+    }
+    else if ((lead & 0xF8) == 0xF0) {
+      size = 4;
+      code_point = lead & 0x07;
+    }
+    else {
+      return -1;
+    }
+
+    if (index + size > length)
+      return -1;
+
+    for (size_t offset = 1; offset < size; ++offset) {
+      uint8_t byte = string[index + offset];
+
+      if ((byte & 0xC0) != 0x80)
+        return -1;
+
+      code_point = (code_point << 6) | (byte & 0x3F);
+    }
+
+    if (code_point > 0x10FFFF || (code_point >= 0xD800 && code_point <= 0xDFFF))
+      return -1;
+
+    if (code_point < (size == 2 ? 0x80u : size == 3 ? 0x800u : 0x10000u))
+      return -1;
+
+    destination[written++] = code_point;
+    index += size;
+  }
+
+  return static_cast<ssize_t>(written);
+}
+
+size_t naiveEncode(const char32_t* string, size_t length, char8_t* destination) {
+  size_t written = 0;
+
+  for (size_t index = 0; index < length; ++index) {
+    char32_t code_point = string[index];
+
+    if (code_point < 0x80) {
+      destination[written++] = static_cast<char8_t>(code_point);
+    }
+    else if (code_point < 0x800) {
+      destination[written++] = static_cast<char8_t>(0xC0 | (code_point >> 6));
+      destination[written++] = static_cast<char8_t>(0x80 | (code_point & 0x3F));
+    }
+    else if (code_point < 0x10000) {
+      destination[written++] = static_cast<char8_t>(0xE0 | (code_point >> 12));
+      destination[written++] = static_cast<char8_t>(0x80 | ((code_point >> 6) & 0x3F));
+      destination[written++] = static_cast<char8_t>(0x80 | (code_point & 0x3F));
+    }
+    else {
+      destination[written++] = static_cast<char8_t>(0xF0 | (code_point >> 18));
+      destination[written++] = static_cast<char8_t>(0x80 | ((code_point >> 12) & 0x3F));
+      destination[written++] = static_cast<char8_t>(0x80 | ((code_point >> 6) & 0x3F));
+      destination[written++] = static_cast<char8_t>(0x80 | (code_point & 0x3F));
+    }
+  }
+
+  return written;
+}
+
+void validate(benchmark::State& state) {
+  Utf8String text = makeText(state.range(0) != 0);
+
+  for (auto _ : state)
+    benchmark::DoNotOptimize(utf8::isValid(text));
+
+  setBytes(state, text);
+}
+
+void decode(benchmark::State& state) {
+  Utf8String text = makeText(state.range(0) != 0);
+  String decoded;
+
+  for (auto _ : state) {
+    decoded.clear();
+    utf8::decodeTo(decoded, text);
+    benchmark::DoNotOptimize(decoded.data());
+  }
+
+  setBytes(state, text);
+}
+
+void decodeNaive(benchmark::State& state) {
+  Utf8String text = makeText(state.range(0) != 0);
+  String decoded;
+
+  decoded.resizeForOverwrite(text.length());
+
+  for (auto _ : state)
+    benchmark::DoNotOptimize(naiveDecode(text.data(), text.length(), decoded.data()));
+
+  setBytes(state, text);
+}
+
+void encode(benchmark::State& state) {
+  Utf8String text = makeText(state.range(0) != 0);
+  String decoded = utf8::decode(text);
+  Utf8String encoded;
+
+  for (auto _ : state) {
+    encoded.clear();
+    utf8::encodeTo(encoded, decoded);
+    benchmark::DoNotOptimize(encoded.data());
+  }
+
+  setBytes(state, text);
+}
+
+void encodeNaive(benchmark::State& state) {
+  Utf8String text = makeText(state.range(0) != 0);
+  String decoded = utf8::decode(text);
+  Utf8String encoded;
+
+  encoded.resizeForOverwrite(text.length());
+
+  for (auto _ : state)
+    benchmark::DoNotOptimize(naiveEncode(decoded.data(), decoded.length(), encoded.data()));
+
+  setBytes(state, text);
+}
+
+// Not a timing: bytes taken by the same text as Utf8String and as String, object
+//  included
+void footprint(benchmark::State& state) {
+  Utf8String text = makeText(state.range(0) != 0);
+  String decoded = utf8::decode(text);
+
+  for (auto _ : state)
+    benchmark::DoNotOptimize(decoded.data());
+
+  state.counters["utf8_bytes"] = static_cast<double>(sizeof(Utf8String) + text.capacity() * sizeof(char8_t));
+  state.counters["string_bytes"] = static_cast<double>(sizeof(String) + decoded.capacity() * sizeof(char32_t));
+  state.counters["code_points"] = static_cast<double>(decoded.length());
+}
+
+}
+
+// argument: 1 - ASCII text, 0 - mixed text
+BENCHMARK(validateScalar)->Arg(1)->Arg(0);
+BENCHMARK(validate)->Arg(1)->Arg(0);
+BENCHMARK(decodeNaive)->Arg(1)->Arg(0);
+BENCHMARK(decode)->Arg(1)->Arg(0);
+BENCHMARK(encodeNaive)->Arg(1)->Arg(0);
+BENCHMARK(encode)->Arg(1)->Arg(0);
+BENCHMARK(footprint)->Arg(1)->Arg(0)->Iterations(1);
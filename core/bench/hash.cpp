@@ -0,0 +1,75 @@
+#include <benchmark/benchmark.h>
+
+#include <rh/hash.hpp>
+#include <rh/String.hpp>
+
+#include <functional>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+std::vector<char32_t> makeText(size_t length) {
+  std::vector<char32_t> text(length);
+
+  for (size_t index = 0; index < length; ++index)
+    text[index] = U'a' + static_cast<char32_t>((index * 7) % 26);
+
+  return text;
+}
+
+void setBytes(benchmark::State& state) {
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0) * static_cast<int64_t>(sizeof(char32_t)));
+}
+
+void stringViewHash(benchmark::State& state) {
+  std::vector<char32_t> text = makeText(static_cast<size_t>(state.range(0)));
+  StringView view{text.data(), text.size()};
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(view);
+    benchmark::DoNotOptimize(view.hash());
+  }
+
+  setBytes(state);
+}
+
+void stdHash(benchmark::State& state) {
+  std::vector<char32_t> text = makeText(static_cast<size_t>(state.range(0)));
+  std::u32string_view view{text.data(), text.size()};
+  std::hash<std::u32string_view> hasher;
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(view);
+    benchmark::DoNotOptimize(hasher(view));
+  }
+
+  setBytes(state);
+}
+
+void integerHash(benchmark::State& state) {
+  uint64_t value = 0;
+
+  for (auto _ : state)
+    benchmark::DoNotOptimize(hash::integer(value++));
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+void stdIntegerHash(benchmark::State& state) {
+  uint64_t value = 0;
+  std::hash<uint64_t> hasher;
+
+  for (auto _ : state)
+    benchmark::DoNotOptimize(hasher(value++));
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+}
+
+// lengths in code units: identifiers, short texts and long payloads
+BENCHMARK(stringViewHash)->RangeMultiplier(4)->Range(4, 64 * 1024);
+BENCHMARK(stdHash)->RangeMultiplier(4)->Range(4, 64 * 1024);
+BENCHMARK(integerHash);
+BENCHMARK(stdIntegerHash);
@@ -0,0 +1,150 @@
+#include <benchmark/benchmark.h>
+
+#include <rh/numbers.hpp>
+#include <rh/String.hpp>
+
+#include <charconv>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr size_t VALUES_COUNT = 4096;
+
+// 1..19 digits, evenly by length
+std::vector<int64_t> makeIntegers() {
+  std::mt19937_64 random(42);
+  std::vector<int64_t> result;
+
+  for (size_t index = 0; index < VALUES_COUNT; ++index) {
+    int64_t value = static_cast<int64_t>(random() >> 1);
+
+    for (size_t digits = index % 19; digits > 0; --digits)
+      value /= 10;
+
+    result.push_back(index % 2 ? value : -value);
+  }
+
+  return result;
+}
+
+std::vector<double> makeDoubles() {
+  std::mt19937_64 random(42);
+  std::uniform_real_distribution<double> mantissa(-1.0, 1.0);
+  std::uniform_int_distribution<int> exponent(-30, 30);
+  std::vector<double> result;
+
+  for (size_t index = 0; index < VALUES_COUNT; ++index)
+    result.push_back(mantissa(random) * std::pow(10.0, exponent(random)));
+
+  return result;
+}
+
+template <typename T>
+std::vector<T> makeValues() {
+  if constexpr (rh::Integral<T>)
+    return makeIntegers();
+  else
+    return makeDoubles();
+}
+
+template <typename T>
+void rhToChars(benchmark::State& state) {
+  std::vector<T> values = makeValues<T>();
+  char32_t buffer[MAX_NUMBER_LENGTH];
+  size_t index = 0;
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(toChars(buffer, values[index++ % VALUES_COUNT]));
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+template <typename T>
+void stdToChars(benchmark::State& state) {
+  std::vector<T> values = makeValues<T>();
+  char buffer[64];
+  size_t index = 0;
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(std::to_chars(buffer, buffer + sizeof(buffer), values[index++ % VALUES_COUNT]).ptr);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+// appending to String, which was a round trip through std::to_string and std::u32string
+template <typename T>
+void rhToString(benchmark::State& state) {
+  std::vector<T> values = makeValues<T>();
+  String string;
+  size_t index = 0;
+
+  for (auto _ : state) {
+    string.clear();
+    toChars(string, values[index++ % VALUES_COUNT]);
+    benchmark::DoNotOptimize(string.data());
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+template <typename T>
+void rhParseNumber(benchmark::State& state) {
+  std::vector<String> strings;
+  size_t index = 0;
+
+  for (T value : makeValues<T>()) {
+    String string;
+    toChars(string, value);
+    strings.push_back(std::move(string));
+  }
+
+  for (auto _ : state) {
+    T value;
+    benchmark::DoNotOptimize(parseNumber(strings[index++ % VALUES_COUNT], value));
+    benchmark::DoNotOptimize(value);
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+template <typename T>
+void stdFromChars(benchmark::State& state) {
+  std::vector<std::string> strings;
+  size_t index = 0;
+
+  for (T value : makeValues<T>()) {
+    char buffer[64];
+    strings.emplace_back(buffer, std::to_chars(buffer, buffer + sizeof(buffer), value).ptr);
+  }
+
+  for (auto _ : state) {
+    std::string const& string = strings[index++ % VALUES_COUNT];
+    T value;
+
+    benchmark::DoNotOptimize(std::from_chars(string.data(), string.data() + string.size(), value).ptr);
+    benchmark::DoNotOptimize(value);
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+}
+
+BENCHMARK(rhToChars<int64_t>);
+BENCHMARK(stdToChars<int64_t>);
+BENCHMARK(rhToString<int64_t>);
+BENCHMARK(rhParseNumber<int64_t>);
+BENCHMARK(stdFromChars<int64_t>);
+
+BENCHMARK(rhToChars<double>);
+BENCHMARK(stdToChars<double>);
+BENCHMARK(rhToString<double>);
+BENCHMARK(rhParseNumber<double>);
+BENCHMARK(stdFromChars<double>);
@@ -0,0 +1,81 @@
+#include <benchmark/benchmark.h>
+
+#include <rh/List.hpp>
+#include <rh/sort.hpp>
+
+#include <algorithm>
+#include <random>
+
+namespace {
+
+template <typename T>
+rh::List<T> const& shuffled(size_t count) {
+  static rh::List<T> values;
+
+  if (values.length() != count) {
+    std::mt19937_64 random(1);
+    values.clear();
+
+    for (size_t index = 0; index < count; ++index) {
+      if constexpr (rh::FloatingPoint<T>)
+        values.append(static_cast<T>(static_cast<int64_t>(random() % 2000001) - 1000000) / 8);
+      else
+        values.append(static_cast<T>(random()));
+    }
+  }
+
+  return values;
+}
+
+// SortT sorts a List in place, input is copied outside the timing
+template <typename T, typename SortT>
+void run(benchmark::State& state, SortT const& sortItems) {
+  size_t count = static_cast<size_t>(state.range(0));
+  rh::List<T> const& input = shuffled<T>(count);
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    rh::List<T> items = input;
+    state.ResumeTiming();
+
+    sortItems(items);
+    benchmark::DoNotOptimize(items.data());
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * count));
+}
+
+template <typename T>
+void rhSort(benchmark::State& state) {
+  run<T>(state, [](rh::List<T>& items) { rh::sort(items); });
+}
+
+template <typename T>
+void stdSort(benchmark::State& state) {
+  run<T>(state, [](rh::List<T>& items) { std::sort(items.begin(), items.end()); });
+}
+
+template <typename T>
+void rhStableSort(benchmark::State& state) {
+  run<T>(state, [](rh::List<T>& items) { rh::stableSort(items); });
+}
+
+template <typename T>
+void stdStableSort(benchmark::State& state) {
+  run<T>(state, [](rh::List<T>& items) { std::stable_sort(items.begin(), items.end()); });
+}
+
+// second argument is threads, the last merge round is split between them too
+void parallelSort(benchmark::State& state) {
+  size_t threads = static_cast<size_t>(state.range(1));
+  run<uint64_t>(state, [threads](rh::List<uint64_t>& items) { rh::parallelSort(items, rh::Less{}, threads); });
+}
+
+} // namespace
+
+// up to 1G keys: input and its copy take 16 GiB at the largest size
+BENCHMARK(rhSort<uint64_t>)->Arg(1 << 10)->Arg(1 << 20)->Arg(1 << 26)->Arg(1 << 28)->Arg(1 << 30)->Unit(benchmark::kMicrosecond);
+BENCHMARK(stdSort<uint64_t>)->Arg(1 << 10)->Arg(1 << 20)->Arg(1 << 26)->Arg(1 << 28)->Arg(1 << 30)->Unit(benchmark::kMicrosecond);
+BENCHMARK(rhStableSort<double>)->Arg(100)->Arg(1 << 20)->Unit(benchmark::kMicrosecond);
+BENCHMARK(stdStableSort<double>)->Arg(100)->Arg(1 << 20)->Unit(benchmark::kMicrosecond);
+BENCHMARK(parallelSort)->ArgsProduct({ { 1 << 24, 1 << 26, 1 << 28, 1 << 30 }, { 1, 2, 4, 8 } })->Unit(benchmark::kMillisecond)->UseRealTime();
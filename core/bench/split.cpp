@@ -0,0 +1,119 @@
+#include <benchmark/benchmark.h>
+
+#include <rh/String.hpp>
+
+#include <vector>
+
+namespace {
+
+// CSV-like text of about "length" code units, built once per length
+StringView csv(size_t length) {
+  static size_t built_length = 0;
+  static String text;
+
+  if (built_length != length) {
+    const char32_t* rows[] = {
+      U"1024,alpha,  some text with spaces  ,3.14159,true\n",
+      U"7,beta,,2.71828,false\r\n",
+      U"65536,gamma,another field, -1.5,true\n",
+    };
+
+    text = String{};
+    text.reserve(length + 64);
+
+    for (size_t row = 0; text.length() < length; ++row)
+      text.append(rows[row % 3]);
+
+    built_length = length;
+  }
+
+  return text;
+}
+
+void setBytes(benchmark::State& state, StringView text) {
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(text.length() * sizeof(char32_t)));
+}
+
+// lines, then fields of each line, trimmed
+void splitLinesAndFields(benchmark::State& state) {
+  StringView text = csv(static_cast<size_t>(state.range(0)));
+
+  for (auto _ : state) {
+    size_t total = 0;
+
+    for (StringView line : text.lines()) {
+      for (StringView field : line.split(U','))
+        total += field.trim().length();
+    }
+
+    benchmark::DoNotOptimize(total);
+  }
+
+  setBytes(state, text);
+}
+
+// fields and lines at once
+void splitAny(benchmark::State& state) {
+  StringView text = csv(static_cast<size_t>(state.range(0)));
+
+  for (auto _ : state) {
+    size_t count = 0;
+
+    for (StringView field : text.splitAny(U",\n"))
+      count += field.length();
+
+    benchmark::DoNotOptimize(count);
+  }
+
+  setBytes(state, text);
+}
+
+void splitSubString(benchmark::State& state) {
+  StringView text = csv(static_cast<size_t>(state.range(0)));
+
+  for (auto _ : state) {
+    size_t count = 0;
+
+    for (StringView piece : text.split(StringView{U"true"}))
+      count += piece.length();
+
+    benchmark::DoNotOptimize(count);
+  }
+
+  setBytes(state, text);
+}
+
+// what the ranges replace: every field is copied into its own String
+void copyFields(benchmark::State& state) {
+  StringView text = csv(static_cast<size_t>(state.range(0)));
+
+  for (auto _ : state) {
+    std::vector<String> fields;
+    size_t begin = 0;
+
+    while (begin <= text.length()) {
+      StringView rest = text.subView(begin, text.length() - begin);
+      ssize_t end = rest.findAny(U",\n");
+
+      if (end == -1) {
+        fields.push_back(String{rest});
+        break;
+      }
+
+      fields.push_back(String{rest.subView(0, static_cast<size_t>(end))});
+      begin += static_cast<size_t>(end) + 1;
+    }
+
+    benchmark::DoNotOptimize(fields.data());
+  }
+
+  setBytes(state, text);
+}
+
+}
+
+// 16M code units (64 MB) and 256M code units (1 GB)
+BENCHMARK(splitLinesAndFields)->Arg(1 << 24)->Arg(1 << 28)->Unit(benchmark::kMillisecond);
+BENCHMARK(splitAny)->Arg(1 << 24)->Arg(1 << 28)->Unit(benchmark::kMillisecond);
+BENCHMARK(splitSubString)->Arg(1 << 24)->Arg(1 << 28)->Unit(benchmark::kMillisecond);
+BENCHMARK(copyFields)->Arg(1 << 24)->Unit(benchmark::kMillisecond);
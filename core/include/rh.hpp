@@ -55,6 +55,28 @@
 # define _RHLIB_BITNESS 32
 #endif
 
+// Define _RHLIB_NO_SIMD to force scalar code paths
+#if !defined(_RHLIB_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64))
+# define _RHLIB_SIMD_SSE2 1
+#else
+# define _RHLIB_SIMD_SSE2 0
+#endif
+
+#if _RHLIB_SIMD_SSE2 && defined(__SSSE3__)
+# define _RHLIB_SIMD_SSSE3 1
+#else
+# define _RHLIB_SIMD_SSSE3 0
+#endif
+
+#if _RHLIB_SIMD_SSE2 && defined(__AVX2__)
+# define _RHLIB_SIMD_AVX2 1
+#else
+# define _RHLIB_SIMD_AVX2 0
+#endif
+
+// For functions, which are allowed to read past the end of buffer (but never crossing a page)
+#define _RHLIB_NO_SANITIZE_ADDRESS __attribute__((no_sanitize("address")))
+
 static_assert((_RHLIB_BITNESS & 0b111) == 0, "Invalid _RHLIB_BITNESS");
 static_assert(sizeof(void*) == (_RHLIB_BITNESS >> 3), "Invalid void* size. Predicted bitness missmatched");
 
@@ -121,6 +143,7 @@ struct byte {
     : value(0) {}
 
   template <typename T>
+    requires requires(T&& arg) { static_cast<uint8_t>(arg); }
   constexpr byte(T&& arg) noexcept
     : value(static_cast<uint8_t>(arg)) {}
 
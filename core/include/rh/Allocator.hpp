@@ -0,0 +1,252 @@
+#pragma once
+#define _RHLIB_INCLUDED_ALLOCATOR
+
+#include <rh.hpp>
+
+#include <stdlib.h>
+
+#include <new>
+
+#include <rh/TypeTraits.hpp>
+
+_RHLIB_BEGIN
+
+// Source of raw memory for containers. allocate() never returns nullptr, it throws
+//  std::bad_alloc instead. size and alignment passed to deallocate() are the same
+//  as they were for allocate()
+template <typename T>
+concept Allocator = requires(T allocator, void* pointer, size_t size, size_t alignment) {
+  { allocator.allocate(size, alignment) } -> ConvertibleTo<void*>;
+  allocator.deallocate(pointer, size, alignment);
+};
+
+// Optional: resizes a block, keeping min(old_size, new_size) bytes of its content.
+// Containers use it only for items, which are trivially relocatable
+template <typename T>
+concept ReallocatingAllocator = Allocator<T> && requires(T allocator, void* pointer, size_t size, size_t alignment) {
+  { allocator.reallocate(pointer, size, size, alignment) } -> ConvertibleTo<void*>;
+};
+
+// Optional: tells if a block was allocated by this allocator
+template <typename T>
+concept OwningAllocator = Allocator<T> && requires(T const allocator, const void* pointer) {
+  { allocator.owns(pointer) } -> ConvertibleTo<bool>;
+};
+
+// Global heap, used by containers unless another allocator is given. Stateless,
+//  so it takes no space inside of a container
+struct DefaultAllocator {
+  [[nodiscard]]
+  static void* allocate(size_t size, size_t alignment) {
+    if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+      return ::operator new(size, std::align_val_t{alignment});
+
+    void* pointer = malloc(size);
+
+    if (!pointer)
+      throw std::bad_alloc{};
+
+    return pointer;
+  }
+
+  [[nodiscard]]
+  static void* reallocate(void* pointer, size_t old_size, size_t new_size, size_t alignment) {
+    if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+      void* new_pointer = allocate(new_size, alignment);
+
+      __builtin_memcpy(new_pointer, pointer, old_size < new_size ? old_size : new_size);
+      deallocate(pointer, old_size, alignment);
+
+      return new_pointer;
+    }
+
+    void* new_pointer = realloc(pointer, new_size);
+
+    if (!new_pointer)
+      throw std::bad_alloc{};
+
+    return new_pointer;
+  }
+
+  static void deallocate(void* pointer, size_t, size_t alignment) noexcept {
+    if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+      ::operator delete(pointer, std::align_val_t{alignment});
+    else
+      free(pointer);
+  }
+};
+
+// Bump allocator: blocks are carved one after another from big chunks, and all of
+//  them are freed at once by reset() or destructor. deallocate() takes back only the
+//  latest block, so a container growing alone in an arena doesn't waste it.
+// Not thread-safe
+class Arena {
+public:
+  static constexpr size_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+
+private:
+  // Placed at the beginning of each chunk
+  struct Chunk {
+    Chunk* previous;
+    size_t size;
+  };
+
+  static constexpr size_t CHUNK_ALIGNMENT   = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+  static constexpr size_t CHUNK_HEADER_SIZE = (sizeof(Chunk) + CHUNK_ALIGNMENT - 1) & ~(CHUNK_ALIGNMENT - 1);
+
+  Chunk* m_chunk     = nullptr;
+  byte*  m_position  = nullptr;
+  byte*  m_end       = nullptr;
+  byte*  m_latest    = nullptr; // latest block, which can be resized in place
+  size_t m_chunkSize = DEFAULT_CHUNK_SIZE;
+
+public:
+  inline explicit Arena(size_t chunk_size = DEFAULT_CHUNK_SIZE) noexcept
+    : m_chunkSize(chunk_size) {}
+
+  Arena(Arena const&) = delete;
+  Arena& operator=(Arena const&) = delete;
+
+  inline ~Arena() {
+    _freeChunks(m_chunk);
+  }
+
+public:
+  [[nodiscard]]
+  inline void* allocate(size_t size, size_t alignment) {
+    byte* block = _alignUp(m_position, alignment);
+
+    if (!m_chunk || block > m_end || size > static_cast<size_t>(m_end - block)) {
+      _addChunk(size + alignment);
+      block = _alignUp(m_position, alignment);
+    }
+
+    m_position = block + size;
+    m_latest = block;
+
+    return block;
+  }
+
+  [[nodiscard]]
+  inline void* reallocate(void* pointer, size_t old_size, size_t new_size, size_t alignment) {
+    byte* block = static_cast<byte*>(pointer);
+
+    if (block == m_latest && new_size <= static_cast<size_t>(m_end - block)) {
+      m_position = block + new_size;
+      return block;
+    }
+
+    void* new_pointer = allocate(new_size, alignment);
+    __builtin_memcpy(new_pointer, pointer, old_size < new_size ? old_size : new_size);
+
+    return new_pointer;
+  }
+
+  inline void deallocate(void* pointer, size_t, size_t) noexcept {
+    if (static_cast<byte*>(pointer) == m_latest) {
+      m_position = m_latest;
+      m_latest = nullptr;
+    }
+  }
+
+  [[nodiscard]]
+  inline bool owns(const void* pointer) const noexcept {
+    for (Chunk* chunk = m_chunk; chunk; chunk = chunk->previous) {
+      auto begin = reinterpret_cast<const byte*>(chunk);
+
+      if (pointer >= begin + CHUNK_HEADER_SIZE && pointer < begin + chunk->size)
+        return true;
+    }
+
+    return false;
+  }
+
+  // Frees all blocks at once. The latest chunk is kept for reuse
+  inline void reset() noexcept {
+    if (!m_chunk)
+      return;
+
+    _freeChunks(m_chunk->previous);
+
+    m_chunk->previous = nullptr;
+    m_position = reinterpret_cast<byte*>(m_chunk) + CHUNK_HEADER_SIZE;
+    m_latest = nullptr;
+  }
+
+private:
+  [[nodiscard]]
+  static byte* _alignUp(byte* pointer, size_t alignment) noexcept {
+    uintptr_t address = reinterpret_cast<uintptr_t>(pointer);
+    return reinterpret_cast<byte*>((address + alignment - 1) & ~(alignment - 1));
+  }
+
+  inline void _addChunk(size_t min_size) {
+    size_t size = CHUNK_HEADER_SIZE + (min_size > m_chunkSize ? min_size : m_chunkSize);
+    auto chunk = static_cast<Chunk*>(DefaultAllocator::allocate(size, CHUNK_ALIGNMENT));
+
+    chunk->previous = m_chunk;
+    chunk->size = size;
+
+    m_chunk = chunk;
+    m_position = reinterpret_cast<byte*>(chunk) + CHUNK_HEADER_SIZE;
+    m_end = reinterpret_cast<byte*>(chunk) + size;
+    m_latest = nullptr;
+  }
+
+  static void _freeChunks(Chunk* chunk) noexcept {
+    while (chunk) {
+      Chunk* previous = chunk->previous;
+      DefaultAllocator::deallocate(chunk, chunk->size, CHUNK_ALIGNMENT);
+      chunk = previous;
+    }
+  }
+};
+
+// Refers to an Arena, which must outlive containers using it:
+//  Arena arena;
+//  List<Item, ArenaAllocator> items{ArenaAllocator{arena}};
+class ArenaAllocator {
+private:
+  Arena* m_arena;
+
+public:
+  constexpr ArenaAllocator(Arena& arena) noexcept
+    : m_arena(&arena) {}
+
+public:
+  [[nodiscard]]
+  inline void* allocate(size_t size, size_t alignment) {
+    return m_arena->allocate(size, alignment);
+  }
+
+  [[nodiscard]]
+  inline void* reallocate(void* pointer, size_t old_size, size_t new_size, size_t alignment) {
+    return m_arena->reallocate(pointer, old_size, new_size, alignment);
+  }
+
+  inline void deallocate(void* pointer, size_t size, size_t alignment) noexcept {
+    m_arena->deallocate(pointer, size, alignment);
+  }
+
+  [[nodiscard]]
+  inline bool owns(const void* pointer) const noexcept {
+    return m_arena->owns(pointer);
+  }
+
+  [[nodiscard]]
+  constexpr Arena& arena() const noexcept {
+    return *m_arena;
+  }
+};
+
+static_assert(ReallocatingAllocator<DefaultAllocator>);
+static_assert(ReallocatingAllocator<ArenaAllocator> && OwningAllocator<ArenaAllocator>);
+
+_RHLIB_END
+
+_RHLIB_GLOBAL_CLASS(Allocator);
+_RHLIB_GLOBAL_CLASS(ReallocatingAllocator);
+_RHLIB_GLOBAL_CLASS(OwningAllocator);
+_RHLIB_GLOBAL_CLASS(DefaultAllocator);
+_RHLIB_GLOBAL_CLASS(Arena);
+_RHLIB_GLOBAL_CLASS(ArenaAllocator);
@@ -4,6 +4,7 @@
 #include <rh.hpp>
 
 #include <rh/InitList.hpp>
+#include <rh/TypeTraits.hpp>
 
 _RHLIB_BEGIN
 
@@ -62,12 +63,12 @@ public:
 
   [[nodiscard]]
   constexpr T* end() noexcept {
-    return m_values + count();
+    return m_values + Count;
   }
 
   [[nodiscard]]
   constexpr T const* end() const noexcept {
-    return m_values + count();
+    return m_values + Count;
   }
 
   [[nodiscard]]
@@ -92,13 +93,24 @@ public:
 
 private:
   constexpr void _copyOther(Array const& other) noexcept {
+    if constexpr (is_trivially_copyable<T>) {
+      if !consteval {
+        __builtin_memcpy(static_cast<void*>(m_values), static_cast<const void*>(other.m_values), sizeof(m_values));
+        return;
+      }
+    }
+
     for (size_t i = 0; i < Count; ++i)
       m_values[i] = other[i];
   }
 
   constexpr void _stealOther(Array& other) noexcept {
-    for (size_t i = 0; i < Count; ++i)
-      m_values[i] = move(other[i]);
+    if constexpr (is_trivially_copyable<T>)
+      _copyOther(other);
+    else {
+      for (size_t i = 0; i < Count; ++i)
+        m_values[i] = move(other[i]);
+    }
   }
 
 private:
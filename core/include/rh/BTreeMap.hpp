@@ -0,0 +1,1198 @@
+#pragma once
+#define _RHLIB_INCLUDED_BTREEMAP
+
+#include <rh.hpp>
+
+#include <rh/Allocator.hpp>
+#include <rh/List.hpp>
+#include <rh/Pair.hpp>
+#include <rh/TypeTraits.hpp>
+#include <rh/exceptions.hpp>
+
+_RHLIB_BEGIN
+
+_RHLIB_HIDDEN_BEGIN
+
+// Raw storage for values of a node, sets have none
+template <typename V, size_t Capacity>
+struct BTreeValues {
+  alignas(V) uint8_t bytes[Capacity * sizeof(V)];
+};
+
+template <size_t Capacity>
+struct BTreeValues<void, Capacity> {};
+
+template <typename IteratorT>
+class BTreeRange {
+private:
+  IteratorT m_begin;
+  IteratorT m_end;
+
+public:
+  constexpr BTreeRange(IteratorT begin, IteratorT end) noexcept
+    : m_begin(begin), m_end(end) {}
+
+public:
+  [[nodiscard]]
+  constexpr IteratorT begin() const noexcept {
+    return m_begin;
+  }
+
+  [[nodiscard]]
+  constexpr IteratorT end() const noexcept {
+    return m_end;
+  }
+};
+
+// B-tree, shared by BTreeMap and BTreeSet (V is void there).
+// Every node keeps its keys in one array of about 4 cache lines, and values in another
+//  one, so a search inside of a node touches only keys. Arithmetic keys are searched
+//  by a branchless linear count, which compilers vectorize, other keys by a branchless
+//  binary search. Entries live in internal nodes too, all leaves are at the same depth.
+// String-like keys are compared through their views by Less, so views and literals
+//  are looked up without temporary strings
+template <typename K, typename V, Comparator<K> CompareT, Allocator AllocatorT>
+class BTree {
+public:
+  static constexpr bool HAS_VALUES = !is_void<V>;
+
+  static constexpr size_t NODE_KEYS_SIZE = 256;
+
+  static constexpr size_t MAX_KEYS =
+    NODE_KEYS_SIZE / sizeof(K) < 5   ? 5   :
+    NODE_KEYS_SIZE / sizeof(K) > 127 ? 127 : NODE_KEYS_SIZE / sizeof(K);
+
+  // Split of a full node gives two nodes with at least MIN_KEYS
+  static constexpr size_t MIN_KEYS = (MAX_KEYS - 1) / 2;
+
+private:
+  static constexpr bool COMPARES_VIEWS = is_same_type<CompareT, Less> && requires { typename K::view_type; };
+
+  struct Internal;
+
+  struct Node {
+    Internal* parent   = nullptr;
+    uint8_t   position = 0; // in children of parent
+    uint8_t   count    = 0;
+    bool      isLeaf   = true;
+
+    alignas(K) uint8_t keyBytes[MAX_KEYS * sizeof(K)];
+    BTreeValues<V, MAX_KEYS> valueBytes;
+
+    [[nodiscard]]
+    K* keys() noexcept {
+      return reinterpret_cast<K*>(keyBytes);
+    }
+
+    [[nodiscard]]
+    K const* keys() const noexcept {
+      return reinterpret_cast<K const*>(keyBytes);
+    }
+
+    [[nodiscard]]
+    auto values() noexcept requires HAS_VALUES {
+      return reinterpret_cast<V*>(valueBytes.bytes);
+    }
+  };
+
+  struct Internal : Node {
+    Node* children[MAX_KEYS + 1];
+  };
+
+  struct Storage {
+    Node*  root  = nullptr;
+    size_t count = 0;
+  };
+
+  // stateless comparator and allocator take no space
+  CompressedPair<CompareT, CompressedPair<AllocatorT, Storage>> m_storage;
+
+public:
+  template <bool IsConst>
+  class Iterator {
+  private:
+    friend class BTree;
+
+    template <bool>
+    friend class Iterator;
+
+    Node*  m_node  = nullptr;
+    size_t m_index = 0;
+
+  public:
+    constexpr Iterator() noexcept = default;
+
+    constexpr Iterator(Node* node, size_t index) noexcept
+      : m_node(node), m_index(index) {}
+
+    // const iterator from a mutable one
+    template <bool OtherConst>
+      requires (IsConst && !OtherConst)
+    constexpr Iterator(Iterator<OtherConst> const& other) noexcept
+      : m_node(other.m_node), m_index(other.m_index) {}
+
+  public:
+    [[nodiscard]]
+    constexpr K const& key() const noexcept {
+      return m_node->keys()[m_index];
+    }
+
+    [[nodiscard]]
+    constexpr auto& value() const noexcept requires HAS_VALUES {
+      using ValueT = conditional<IsConst, V const, V>;
+      return static_cast<ValueT&>(m_node->values()[m_index]);
+    }
+
+    [[nodiscard]]
+    constexpr decltype(auto) operator*() const noexcept {
+      if constexpr (HAS_VALUES)
+        return PairRef<K const, conditional<IsConst, V const, V>>{key(), value()};
+      else
+        return key();
+    }
+
+    // In-order: down to the leftmost leaf of the right subtree, or up to the first parent,
+    //  which has entries to the right
+    constexpr Iterator& operator++() noexcept {
+      if (!m_node->isLeaf) {
+        m_node = static_cast<Internal*>(m_node)->children[m_index + 1];
+
+        while (!m_node->isLeaf)
+          m_node = static_cast<Internal*>(m_node)->children[0];
+
+        m_index = 0;
+        return *this;
+      }
+
+      ++m_index;
+
+      while (m_index == m_node->count) {
+        if (!m_node->parent) {
+          *this = Iterator{};
+          break;
+        }
+
+        m_index = m_node->position;
+        m_node = m_node->parent;
+      }
+
+      return *this;
+    }
+
+    [[nodiscard]]
+    constexpr bool operator==(Iterator const& other) const noexcept {
+      return m_node == other.m_node && m_index == other.m_index;
+    }
+  };
+
+public:
+  constexpr BTree() noexcept = default;
+
+  constexpr explicit BTree(CompareT const& compare, AllocatorT const& allocator) noexcept
+    : m_storage(compare, CompressedPair<AllocatorT, Storage>{allocator, Storage{}}) {}
+
+  constexpr BTree(BTree const& other)
+    : BTree(other.m_storage.getFirst(), other._allocator())
+  {
+    operator=(other);
+  }
+
+  constexpr BTree(BTree&& other) noexcept
+    : BTree(move(other.m_storage.getFirst()), move(other._allocator()))
+  {
+    _stealOther(other);
+  }
+
+  constexpr BTree& operator=(BTree const& other) {
+    if (this == &other)
+      return *this;
+
+    clear();
+
+    Iterator<true> source = other.begin();
+
+    buildSorted(other.length(), [&](K* key, auto*... value) {
+      constructAt(key, source.key());
+
+      if constexpr (HAS_VALUES)
+        constructAt(value..., source.value());
+
+      ++source;
+    });
+
+    return *this;
+  }
+
+  constexpr BTree& operator=(BTree&& other) noexcept {
+    if (this != &other) {
+      clear();
+      m_storage.getFirst() = move(other.m_storage.getFirst());
+      _allocator() = move(other._allocator());
+      _stealOther(other);
+    }
+
+    return *this;
+  }
+
+  constexpr ~BTree() {
+    clear();
+  }
+
+public:
+  [[nodiscard]]
+  constexpr AllocatorT const& allocator() const noexcept {
+    return m_storage.getSecond().getFirst();
+  }
+
+  [[nodiscard]]
+  constexpr Iterator<false> begin() noexcept {
+    return { _leftmostLeaf(), 0 };
+  }
+
+  [[nodiscard]]
+  constexpr Iterator<true> begin() const noexcept {
+    return { _leftmostLeaf(), 0 };
+  }
+
+  [[nodiscard]]
+  constexpr Iterator<false> end() noexcept {
+    return {};
+  }
+
+  [[nodiscard]]
+  constexpr Iterator<true> end() const noexcept {
+    return {};
+  }
+
+  [[nodiscard]]
+  constexpr bool isEmpty() const noexcept {
+    return m_storage.count == 0;
+  }
+
+  [[nodiscard]]
+  constexpr size_t length() const noexcept {
+    return m_storage.count;
+  }
+
+  constexpr void clear() noexcept {
+    if (m_storage.root)
+      _destroy(m_storage.root);
+
+    m_storage.root = nullptr;
+    m_storage.count = 0;
+  }
+
+  template <typename LookupT>
+  [[nodiscard]]
+  constexpr Iterator<false> find(LookupT const& key) const {
+    auto const& lookup = _normalize(key);
+
+    for (Node* node = m_storage.root; node;) {
+      size_t index = _lowerIndex(node, lookup);
+
+      if (index < node->count && !_less(lookup, _normalize(node->keys()[index])))
+        return { node, index };
+
+      if (node->isLeaf)
+        break;
+
+      node = static_cast<Internal*>(node)->children[index];
+    }
+
+    return {};
+  }
+
+  // The first entry, which isn't less than key (IsUpper = false), or is greater than key
+  template <bool IsUpper, typename LookupT>
+  [[nodiscard]]
+  constexpr Iterator<false> bound(LookupT const& key) const {
+    auto const& lookup = _normalize(key);
+    Iterator<false> result;
+
+    for (Node* node = m_storage.root; node;) {
+      size_t index = _lowerIndex(node, lookup);
+
+      if constexpr (IsUpper) {
+        if (index < node->count && !_less(lookup, _normalize(node->keys()[index])))
+          ++index;
+      }
+
+      if (index < node->count)
+        result = { node, index };
+
+      if (node->isLeaf)
+        break;
+
+      node = static_cast<Internal*>(node)->children[index];
+    }
+
+    return result;
+  }
+
+  // Calls construct(K* raw_key, V* raw_value) only if there's no such key yet (sets get no raw_value).
+  // Returns the entry and whether it's new
+  template <typename LookupT, typename ConstructT>
+  constexpr Pair<Iterator<false>, bool> findOrConstruct(LookupT const& key, ConstructT&& construct) {
+    auto const& lookup = _normalize(key);
+
+    if (!m_storage.root)
+      m_storage.root = _newNode(true);
+
+    Node* node = m_storage.root;
+
+    for (;;) {
+      size_t index = _lowerIndex(node, lookup);
+
+      if (index < node->count && !_less(lookup, _normalize(node->keys()[index])))
+        return { Iterator<false>{node, index}, false };
+
+      if (!node->isLeaf) {
+        node = static_cast<Internal*>(node)->children[index];
+        continue;
+      }
+
+      // full leaf is split, and the search goes on from the parent, which got the middle key
+      if (node->count == MAX_KEYS) {
+        _split(node);
+        node = node->parent;
+        continue;
+      }
+
+      _moveEntries(node, index + 1, node, index, node->count - index);
+
+      try {
+        if constexpr (HAS_VALUES)
+          construct(&node->keys()[index], &node->values()[index]);
+        else
+          construct(&node->keys()[index]);
+      }
+      catch (...) {
+        _moveEntries(node, index, node, index + 1, node->count - index);
+        throw;
+      }
+
+      ++node->count;
+      ++m_storage.count;
+
+      return { Iterator<false>{node, index}, true };
+    }
+  }
+
+  template <typename LookupT>
+  constexpr bool erase(LookupT const& key) {
+    Iterator<false> found = find(key);
+
+    if (found == end())
+      return false;
+
+    _eraseAt(found.m_node, found.m_index);
+    return true;
+  }
+
+  // Tree must be empty. Each call of construct(K* raw_key, V* raw_value) gives the next entry,
+  //  keys must be strictly ascending. Entries are appended at the right edge, which leaves
+  //  nodes full, instead of half-full after splits
+  template <typename ConstructT>
+  constexpr void buildSorted(size_t count, ConstructT&& construct) {
+    if (count == 0)
+      return;
+
+    Node* leaf = m_storage.root = _newNode(true);
+    K const* previous = nullptr;
+
+    for (size_t entry = 0; entry < count; ++entry) {
+      Node* node = leaf;
+      size_t depth = 0;
+
+      // the entry goes to the lowest node on the right edge, which has space
+      while (node->count == MAX_KEYS) {
+        if (!node->parent)
+          _growRoot();
+
+        node = node->parent;
+        ++depth;
+      }
+
+      Node* edge = _newEdge(depth);
+      size_t index = node->count;
+
+      try {
+        if constexpr (HAS_VALUES)
+          construct(&node->keys()[index], &node->values()[index]);
+        else
+          construct(&node->keys()[index]);
+      }
+      catch (...) {
+        if (edge)
+          _destroy(edge);
+
+        clear();
+        throw;
+      }
+
+      ++node->count;
+      ++m_storage.count;
+
+      // keys right of the new entry go to a new edge under it
+      if (edge) {
+        static_cast<Internal*>(node)->children[node->count] = edge;
+        _adopt(static_cast<Internal*>(node), node->count);
+
+        leaf = edge;
+
+        while (!leaf->isLeaf)
+          leaf = static_cast<Internal*>(leaf)->children[0];
+      }
+
+      if (previous && !_less(_normalize(*previous), _normalize(node->keys()[index]))) {
+        clear();
+        throw KeyError(U"keys aren't strictly ascending in sorted input of BTreeMap/BTreeSet");
+      }
+
+      previous = &node->keys()[index];
+    }
+
+    _fixRightEdge();
+  }
+
+private:
+  [[nodiscard]]
+  constexpr AllocatorT& _allocator() noexcept {
+    return m_storage.getSecond().getFirst();
+  }
+
+  [[nodiscard]]
+  constexpr AllocatorT const& _allocator() const noexcept {
+    return m_storage.getSecond().getFirst();
+  }
+
+  template <typename LookupT>
+  [[nodiscard]]
+  static constexpr decltype(auto) _normalize(LookupT const& key) {
+    if constexpr (COMPARES_VIEWS)
+      return typename K::view_type{key};
+    else
+      return key;
+  }
+
+  template <typename LeftT, typename RightT>
+  [[nodiscard]]
+  constexpr bool _less(LeftT const& left, RightT const& right) const {
+    return m_storage.getFirst()(left, right);
+  }
+
+  // Index of the first key, which isn't less than lookup
+  template <typename LookupT>
+  [[nodiscard]]
+  constexpr size_t _lowerIndex(Node const* node, LookupT const& lookup) const {
+    K const* keys = node->keys();
+    size_t count = node->count;
+
+    if constexpr ((Integral<K> || FloatingPoint<K>) && is_same_type<LookupT, K> && is_same_type<CompareT, Less>) {
+      size_t index = 0;
+
+      for (size_t i = 0; i < count; ++i)
+        index += static_cast<size_t>(keys[i] < lookup);
+
+      return index;
+    }
+    else {
+      if (count == 0)
+        return 0;
+
+      K const* base = keys;
+
+      while (count > 1) {
+        size_t half = count / 2;
+        base = _less(_normalize(base[half]), lookup) ? base + half : base;
+        count -= half;
+      }
+
+      return static_cast<size_t>(base - keys) + static_cast<size_t>(_less(_normalize(*base), lookup));
+    }
+  }
+
+  [[nodiscard]]
+  constexpr Node* _leftmostLeaf() const noexcept {
+    Node* node = m_storage.root;
+
+    if (node) {
+      while (!node->isLeaf)
+        node = static_cast<Internal*>(node)->children[0];
+    }
+
+    return node;
+  }
+
+  [[nodiscard]]
+  constexpr Node* _newNode(bool is_leaf) {
+    if (is_leaf) {
+      void* memory = _allocator().allocate(sizeof(Node), alignof(Node));
+      return new (memory) Node;
+    }
+
+    void* memory = _allocator().allocate(sizeof(Internal), alignof(Internal));
+    Internal* node = new (memory) Internal;
+
+    node->isLeaf = false;
+    return node;
+  }
+
+  constexpr void _freeNode(Node* node) noexcept {
+    if (node->isLeaf)
+      _allocator().deallocate(node, sizeof(Node), alignof(Node));
+    else
+      _allocator().deallocate(node, sizeof(Internal), alignof(Internal));
+  }
+
+  // Destroys entries of the subtree and frees its nodes
+  constexpr void _destroy(Node* node) noexcept {
+    ListUtils::destruct(node->keys(), node->count);
+
+    if constexpr (HAS_VALUES)
+      ListUtils::destruct(node->values(), node->count);
+
+    if (!node->isLeaf) {
+      for (size_t i = 0; i <= node->count; ++i)
+        _destroy(static_cast<Internal*>(node)->children[i]);
+    }
+
+    _freeNode(node);
+  }
+
+  // This tree must be empty
+  constexpr void _stealOther(BTree& other) noexcept {
+    m_storage.root = other.m_storage.root;
+    m_storage.count = other.m_storage.count;
+
+    other.m_storage.root = nullptr;
+    other.m_storage.count = 0;
+  }
+
+  // Moves items into raw memory, ranges may overlap
+  template <typename T>
+  static constexpr void _relocate(T* destination, T* source, size_t count) {
+    if constexpr (is_trivially_relocatable<T>) {
+      if (count != 0)
+        __builtin_memmove(static_cast<void*>(destination), static_cast<const void*>(source), count * sizeof(T));
+    }
+    else if (destination < source) {
+      for (size_t i = 0; i < count; ++i) {
+        constructAt(&destination[i], move(source[i]));
+        destructAt(&source[i]);
+      }
+    }
+    else {
+      for (size_t i = count; i > 0; --i) {
+        constructAt(&destination[i - 1], move(source[i - 1]));
+        destructAt(&source[i - 1]);
+      }
+    }
+  }
+
+  // Moves entries [from, from + count) of source into raw slots of destination, which can be the same node
+  static constexpr void _moveEntries(Node* destination, size_t to, Node* source, size_t from, size_t count) {
+    _relocate(destination->keys() + to, source->keys() + from, count);
+
+    if constexpr (HAS_VALUES)
+      _relocate(destination->values() + to, source->values() + from, count);
+  }
+
+  static constexpr void _moveChildren(Internal* destination, size_t to, Internal* source, size_t from, size_t count) noexcept {
+    if (count != 0)
+      __builtin_memmove(destination->children + to, source->children + from, count * sizeof(Node*));
+
+    for (size_t i = to; i < to + count; ++i)
+      _adopt(destination, i);
+  }
+
+  static constexpr void _adopt(Internal* parent, size_t index) noexcept {
+    Node* child = parent->children[index];
+
+    child->parent = parent;
+    child->position = static_cast<uint8_t>(index);
+  }
+
+  // New root above the old one, without keys yet
+  constexpr void _growRoot() {
+    Internal* root = static_cast<Internal*>(_newNode(false));
+
+    root->children[0] = m_storage.root;
+    _adopt(root, 0);
+
+    m_storage.root = root;
+  }
+
+  // Full node gives its middle entry to the parent and upper half to a new right sibling
+  constexpr void _split(Node* node) {
+    if (!node->parent)
+      _growRoot();
+    else if (node->parent->count == MAX_KEYS)
+      _split(node->parent);
+
+    Internal* parent = node->parent;
+    size_t position = node->position;
+
+    Node* sibling = _newNode(node->isLeaf);
+
+    size_t middle = node->count / 2;
+    size_t right_count = node->count - middle - 1;
+
+    _moveEntries(sibling, 0, node, middle + 1, right_count);
+
+    if (!node->isLeaf)
+      _moveChildren(static_cast<Internal*>(sibling), 0, static_cast<Internal*>(node), middle + 1, right_count + 1);
+
+    _moveEntries(parent, position + 1, parent, position, parent->count - position);
+    _moveChildren(parent, position + 2, parent, position + 1, parent->count - position);
+
+    _moveEntries(parent, position, node, middle, 1);
+
+    parent->children[position + 1] = sibling;
+    _adopt(parent, position + 1);
+
+    node->count = static_cast<uint8_t>(middle);
+    sibling->count = static_cast<uint8_t>(right_count);
+    ++parent->count;
+  }
+
+  // Chain of empty nodes, which is depth levels high, nullptr for 0
+  constexpr Node* _newEdge(size_t depth) {
+    Node* edge = nullptr;
+
+    for (size_t level = 0; level < depth; ++level) {
+      Node* node;
+
+      try {
+        node = _newNode(level == 0);
+      }
+      catch (...) {
+        if (edge)
+          _destroy(edge);
+
+        throw;
+      }
+
+      if (edge) {
+        static_cast<Internal*>(node)->children[0] = edge;
+        _adopt(static_cast<Internal*>(node), 0);
+      }
+
+      edge = node;
+    }
+
+    return edge;
+  }
+
+  // Nodes on the right edge after buildSorted() may be short of entries,
+  //  they take them from left siblings, which are full
+  constexpr void _fixRightEdge() {
+    for (Node* node = m_storage.root; !node->isLeaf;) {
+      Internal* internal = static_cast<Internal*>(node);
+      Node* last = internal->children[internal->count];
+
+      while (last->count < MIN_KEYS)
+        _rotateRight(internal, internal->count - 1);
+
+      node = last;
+    }
+  }
+
+  constexpr void _destructEntry(Node* node, size_t index) noexcept {
+    destructAt(&node->keys()[index]);
+
+    if constexpr (HAS_VALUES)
+      destructAt(&node->values()[index]);
+  }
+
+  constexpr void _eraseAt(Node* node, size_t index) {
+    _destructEntry(node, index);
+
+    if (node->isLeaf)
+      _moveEntries(node, index, node, index + 1, node->count - index - 1);
+    else {
+      // the greatest entry of the left subtree takes place of the erased one
+      Node* leaf = static_cast<Internal*>(node)->children[index];
+
+      while (!leaf->isLeaf)
+        leaf = static_cast<Internal*>(leaf)->children[leaf->count];
+
+      _moveEntries(node, index, leaf, leaf->count - 1, 1);
+      node = leaf;
+    }
+
+    --node->count;
+    --m_storage.count;
+
+    _rebalance(node);
+  }
+
+  // Restores MIN_KEYS in node and its ancestors by rotations and merges
+  constexpr void _rebalance(Node* node) {
+    while (node->count < MIN_KEYS) {
+      Internal* parent = node->parent;
+
+      if (!parent) {
+        if (node->count == 0) {
+          if (node->isLeaf)
+            m_storage.root = nullptr;
+          else {
+            m_storage.root = static_cast<Internal*>(node)->children[0];
+            m_storage.root->parent = nullptr;
+            m_storage.root->position = 0;
+          }
+
+          _freeNode(node);
+        }
+
+        return;
+      }
+
+      size_t position = node->position;
+
+      if (position > 0 && parent->children[position - 1]->count > MIN_KEYS)
+        return _rotateRight(parent, position - 1);
+
+      if (position < parent->count && parent->children[position + 1]->count > MIN_KEYS)
+        return _rotateLeft(parent, position);
+
+      _merge(parent, position > 0 ? position - 1 : position);
+      node = parent;
+    }
+  }
+
+  // Last entry of children[index] goes through the separator to the front of children[index + 1]
+  constexpr void _rotateRight(Internal* parent, size_t index) {
+    Node* left = parent->children[index];
+    Node* right = parent->children[index + 1];
+
+    _moveEntries(right, 1, right, 0, right->count);
+    _moveEntries(right, 0, parent, index, 1);
+    _moveEntries(parent, index, left, left->count - 1, 1);
+
+    if (!right->isLeaf) {
+      Internal* internal = static_cast<Internal*>(right);
+
+      _moveChildren(internal, 1, internal, 0, right->count + 1);
+      internal->children[0] = static_cast<Internal*>(left)->children[left->count];
+      _adopt(internal, 0);
+    }
+
+    --left->count;
+    ++right->count;
+  }
+
+  // First entry of children[index + 1] goes through the separator to the end of children[index]
+  constexpr void _rotateLeft(Internal* parent, size_t index) {
+    Node* left = parent->children[index];
+    Node* right = parent->children[index + 1];
+
+    _moveEntries(left, left->count, parent, index, 1);
+    _moveEntries(parent, index, right, 0, 1);
+    _moveEntries(right, 0, right, 1, right->count - 1);
+
+    if (!right->isLeaf) {
+      Internal* internal = static_cast<Internal*>(left);
+
+      internal->children[left->count + 1] = static_cast<Internal*>(right)->children[0];
+      _adopt(internal, left->count + 1);
+      _moveChildren(static_cast<Internal*>(right), 0, static_cast<Internal*>(right), 1, right->count);
+    }
+
+    ++left->count;
+    --right->count;
+  }
+
+  // children[index + 1] and the separator join children[index]
+  constexpr void _merge(Internal* parent, size_t index) {
+    Node* left = parent->children[index];
+    Node* right = parent->children[index + 1];
+
+    _moveEntries(left, left->count, parent, index, 1);
+    _moveEntries(left, left->count + 1, right, 0, right->count);
+
+    if (!left->isLeaf)
+      _moveChildren(static_cast<Internal*>(left), left->count + 1, static_cast<Internal*>(right), 0, right->count + 1);
+
+    left->count = static_cast<uint8_t>(left->count + right->count + 1);
+
+    _moveEntries(parent, index, parent, index + 1, parent->count - index - 1);
+    _moveChildren(parent, index + 1, parent, index + 2, parent->count - index - 1);
+    --parent->count;
+
+    right->count = 0;
+    _freeNode(right);
+  }
+};
+
+_RHLIB_HIDDEN_END
+
+// Ordered map in a B-tree with wide nodes, see _Hidden::BTree.
+// Iteration goes in order of keys and gives entries with "first" and "second" references,
+//  range() gives keys in [from, to). Insertion and erase invalidate iterators and pointers
+template <typename K, typename V, Comparator<K> CompareT = Less, Allocator AllocatorT = DefaultAllocator>
+class BTreeMap {
+public:
+  using key_type       = K;
+  using value_type     = V;
+  using allocator_type = AllocatorT;
+
+private:
+  using Tree = _RHLIBH BTree<K, V, CompareT, AllocatorT>;
+
+  Tree m_tree;
+
+public:
+  constexpr BTreeMap() noexcept = default;
+
+  constexpr explicit BTreeMap(CompareT const& compare, AllocatorT const& allocator = AllocatorT{}) noexcept
+    : m_tree(compare, allocator) {}
+
+  constexpr explicit BTreeMap(AllocatorT const& allocator) noexcept
+    requires (!is_same_type<CompareT, AllocatorT>)
+    : m_tree(CompareT{}, allocator) {}
+
+  // Entries must be sorted by strictly ascending keys, otherwise KeyError is thrown.
+  // Builds full nodes in O(n), without searches and splits
+  template <typename ListAllocatorT>
+  [[nodiscard]]
+  static constexpr BTreeMap fromSorted(List<Pair<K, V>, ListAllocatorT> const& entries) {
+    BTreeMap map;
+    Pair<K, V> const* entry = entries.data();
+
+    map.m_tree.buildSorted(entries.length(), [&](K* key, V* value) {
+      constructAt(key, entry->first);
+      constructAt(value, entry->second);
+      ++entry;
+    });
+
+    return map;
+  }
+
+  template <typename ListAllocatorT>
+  [[nodiscard]]
+  static constexpr BTreeMap fromSorted(List<Pair<K, V>, ListAllocatorT>&& entries) {
+    BTreeMap map;
+    Pair<K, V>* entry = entries.data();
+
+    map.m_tree.buildSorted(entries.length(), [&](K* key, V* value) {
+      constructAt(key, move(entry->first));
+      constructAt(value, move(entry->second));
+      ++entry;
+    });
+
+    return map;
+  }
+
+public:
+  [[nodiscard]]
+  constexpr AllocatorT const& allocator() const noexcept {
+    return m_tree.allocator();
+  }
+
+  [[nodiscard]]
+  constexpr auto begin() noexcept {
+    return m_tree.begin();
+  }
+
+  [[nodiscard]]
+  constexpr auto begin() const noexcept {
+    return m_tree.begin();
+  }
+
+  [[nodiscard]]
+  constexpr auto end() noexcept {
+    return m_tree.end();
+  }
+
+  [[nodiscard]]
+  constexpr auto end() const noexcept {
+    return m_tree.end();
+  }
+
+  [[nodiscard]]
+  constexpr bool isEmpty() const noexcept {
+    return m_tree.isEmpty();
+  }
+
+  [[nodiscard]]
+  constexpr size_t length() const noexcept {
+    return m_tree.length();
+  }
+
+  constexpr void clear() noexcept {
+    m_tree.clear();
+  }
+
+  // nullptr if there's no such key
+  template <typename LookupT>
+  [[nodiscard]]
+  constexpr V* find(LookupT const& key) {
+    auto found = m_tree.find(key);
+    return found == m_tree.end() ? nullptr : &found.value();
+  }
+
+  template <typename LookupT>
+  [[nodiscard]]
+  constexpr V const* find(LookupT const& key) const {
+    auto found = m_tree.find(key);
+    return found == m_tree.end() ? nullptr : &found.value();
+  }
+
+  template <typename LookupT>
+  [[nodiscard]]
+  constexpr bool contains(LookupT const& key) const {
+    return m_tree.find(key) != m_tree.end();
+  }
+
+  template <typename LookupT>
+  [[nodiscard]]
+  constexpr V& at(LookupT const& key) {
+    if (V* value = find(key))
+      return *value;
+
+    throw KeyError(U"key not found in BTreeMap::at()");
+  }
+
+  template <typename LookupT>
+  [[nodiscard]]
+  constexpr V const& at(LookupT const& key) const {
+    if (V const* value = find(key))
+      return *value;
+
+    throw KeyError(U"key not found in BTreeMap::at()");
+  }
+
+  // The first entry with key not less than the given one
+  template <typename LookupT>
+  [[nodiscard]]
+  constexpr auto lowerBound(LookupT const& key) {
+    return m_tree.template bound<false>(key);
+  }
+
+  template <typename LookupT>
+  [[nodiscard]]
+  constexpr auto lowerBound(LookupT const& key) const {
+    return typename Tree::template Iterator<true>{m_tree.template bound<false>(key)};
+  }
+
+  // The first entry with key greater than the given one
+  template <typename LookupT>
+  [[nodiscard]]
+  constexpr auto upperBound(LookupT const& key) {
+    return m_tree.template bound<true>(key);
+  }
+
+  template <typename LookupT>
+  [[nodiscard]]
+  constexpr auto upperBound(LookupT const& key) const {
+    return typename Tree::template Iterator<true>{m_tree.template bound<true>(key)};
+  }
+
+  // Entries with keys in [from, to)
+  template <typename FromT, typename ToT>
+  [[nodiscard]]
+  constexpr auto range(FromT const& from, ToT const& to) {
+    return _RHLIBH BTreeRange{lowerBound(from), lowerBound(to)};
+  }
+
+  template <typename FromT, typename ToT>
+  [[nodiscard]]
+  constexpr auto range(FromT const& from, ToT const& to) const {
+    return _RHLIBH BTreeRange{lowerBound(from), lowerBound(to)};
+  }
+
+  // Value is default-constructed if there's no such key
+  template <typename KeyT>
+  constexpr V& operator[](KeyT&& key) {
+    return *emplace(forward<KeyT>(key)).first;
+  }
+
+  // Constructs value from args only if there's no such key yet.
+  // Returns the value and whether it's new
+  template <typename KeyT, typename... ArgsT>
+  constexpr Pair<V*, bool> emplace(KeyT&& key, ArgsT&&... args) {
+    auto [entry, is_new] = m_tree.findOrConstruct(key, [&](K* raw_key, V* raw_value) {
+      constructAt(raw_key, forward<KeyT>(key));
+
+      try {
+        constructAt(raw_value, forward<ArgsT>(args)...);
+      }
+      catch (...) {
+        destructAt(raw_key);
+        throw;
+      }
+    });
+
+    return { &entry.value(), is_new };
+  }
+
+  // Doesn't replace existing value, returns whether value was inserted
+  template <typename KeyT, typename ValueT>
+  constexpr bool insert(KeyT&& key, ValueT&& value) {
+    return emplace(forward<KeyT>(key), forward<ValueT>(value)).second;
+  }
+
+  constexpr bool insert(Pair<K, V> const& entry) {
+    return emplace(entry.first, entry.second).second;
+  }
+
+  constexpr bool insert(Pair<K, V>&& entry) {
+    return emplace(move(entry.first), move(entry.second)).second;
+  }
+
+  // Inserts or replaces value
+  template <typename KeyT, typename ValueT>
+  constexpr void set(KeyT&& key, ValueT&& value) {
+    auto [existing, is_new] = emplace(forward<KeyT>(key), forward<ValueT>(value));
+
+    if (!is_new)
+      *existing = forward<ValueT>(value);
+  }
+
+  // Returns whether there was such key
+  template <typename LookupT>
+  constexpr bool erase(LookupT const& key) {
+    return m_tree.erase(key);
+  }
+};
+
+// Ordered set, built just like BTreeMap
+template <typename K, Comparator<K> CompareT = Less, Allocator AllocatorT = DefaultAllocator>
+class BTreeSet {
+public:
+  using key_type       = K;
+  using value_type     = K;
+  using allocator_type = AllocatorT;
+
+private:
+  using Tree = _RHLIBH BTree<K, void, CompareT, AllocatorT>;
+
+  Tree m_tree;
+
+public:
+  constexpr BTreeSet() noexcept = default;
+
+  constexpr explicit BTreeSet(CompareT const& compare, AllocatorT const& allocator = AllocatorT{}) noexcept
+    : m_tree(compare, allocator) {}
+
+  constexpr explicit BTreeSet(AllocatorT const& allocator) noexcept
+    requires (!is_same_type<CompareT, AllocatorT>)
+    : m_tree(CompareT{}, allocator) {}
+
+  // Keys must be strictly ascending, otherwise KeyError is thrown
+  template <typename ListAllocatorT>
+  [[nodiscard]]
+  static constexpr BTreeSet fromSorted(List<K, ListAllocatorT> const& keys) {
+    BTreeSet set;
+    K const* source = keys.data();
+
+    set.m_tree.buildSorted(keys.length(), [&](K* key) {
+      constructAt(key, *source++);
+    });
+
+    return set;
+  }
+
+  template <typename ListAllocatorT>
+  [[nodiscard]]
+  static constexpr BTreeSet fromSorted(List<K, ListAllocatorT>&& keys) {
+    BTreeSet set;
+    K* source = keys.data();
+
+    set.m_tree.buildSorted(keys.length(), [&](K* key) {
+      constructAt(key, move(*source++));
+    });
+
+    return set;
+  }
+
+public:
+  [[nodiscard]]
+  constexpr AllocatorT const& allocator() const noexcept {
+    return m_tree.allocator();
+  }
+
+  // Keys are never changed through iteration
+  [[nodiscard]]
+  constexpr auto begin() const noexcept {
+    return m_tree.begin();
+  }
+
+  [[nodiscard]]
+  constexpr auto end() const noexcept {
+    return m_tree.end();
+  }
+
+  [[nodiscard]]
+  constexpr bool isEmpty() const noexcept {
+    return m_tree.isEmpty();
+  }
+
+  [[nodiscard]]
+  constexpr size_t length() const noexcept {
+    return m_tree.length();
+  }
+
+  constexpr void clear() noexcept {
+    m_tree.clear();
+  }
+
+  // nullptr if there's no such key
+  template <typename LookupT>
+  [[nodiscard]]
+  constexpr K const* find(LookupT const& key) const {
+    auto found = m_tree.find(key);
+    return found == m_tree.end() ? nullptr : &found.key();
+  }
+
+  template <typename LookupT>
+  [[nodiscard]]
+  constexpr bool contains(LookupT const& key) const {
+    return m_tree.find(key) != m_tree.end();
+  }
+
+  template <typename LookupT>
+  [[nodiscard]]
+  constexpr auto lowerBound(LookupT const& key) const {
+    return typename Tree::template Iterator<true>{m_tree.template bound<false>(key)};
+  }
+
+  template <typename LookupT>
+  [[nodiscard]]
+  constexpr auto upperBound(LookupT const& key) const {
+    return typename Tree::template Iterator<true>{m_tree.template bound<true>(key)};
+  }
+
+  // Keys in [from, to)
+  template <typename FromT, typename ToT>
+  [[nodiscard]]
+  constexpr auto range(FromT const& from, ToT const& to) const {
+    return _RHLIBH BTreeRange{lowerBound(from), lowerBound(to)};
+  }
+
+  // Returns whether key was inserted
+  template <typename KeyT>
+  constexpr bool insert(KeyT&& key) {
+    return m_tree.findOrConstruct(key, [&](K* raw_key) {
+      constructAt(raw_key, forward<KeyT>(key));
+    }).second;
+  }
+
+  // Returns whether there was such key
+  template <typename LookupT>
+  constexpr bool erase(LookupT const& key) {
+    return m_tree.erase(key);
+  }
+};
+
+// Nodes don't point back to the tree
+template <typename K, typename V, typename CompareT, typename AllocatorT>
+static constexpr bool is_trivially_relocatable<BTreeMap<K, V, CompareT, AllocatorT>> =
+  is_trivially_relocatable<CompareT> && is_trivially_relocatable<AllocatorT>;
+
+template <typename K, typename CompareT, typename AllocatorT>
+static constexpr bool is_trivially_relocatable<BTreeSet<K, CompareT, AllocatorT>> =
+  is_trivially_relocatable<CompareT> && is_trivially_relocatable<AllocatorT>;
+
+_RHLIB_END
@@ -0,0 +1,644 @@
+#pragma once
+#define _RHLIB_INCLUDED_BITLIST
+
+#include <rh.hpp>
+
+#include <rh/Allocator.hpp>
+#include <rh/Array.hpp>
+#include <rh/List.hpp>
+#include <rh/Span.hpp>
+#include <rh/TypeTraits.hpp>
+#include <rh/exceptions.hpp>
+#include <rh/simd.hpp>
+
+_RHLIB_BEGIN
+
+_RHLIB_HIDDEN_BEGIN
+
+// Algorithms over packed words, bit i is bit (i % 64) of word (i / 64).
+// Bits past the length are kept zero, so words are compared and counted as they are
+struct BitUtils {
+  static constexpr size_t WORD_BITS = 64;
+
+  [[nodiscard]]
+  static constexpr size_t wordsFor(size_t bits) noexcept {
+    return (bits + WORD_BITS - 1) / WORD_BITS;
+  }
+
+  // Valid bits of the last word
+  [[nodiscard]]
+  static constexpr uint64_t tailMask(size_t bits) noexcept {
+    return bits % WORD_BITS == 0 ? ~uint64_t{0} : (uint64_t{1} << bits % WORD_BITS) - 1;
+  }
+
+  struct And {
+    static constexpr uint64_t apply(uint64_t left, uint64_t right) noexcept { return left & right; }
+#if _RHLIB_SIMD_SSE2
+    static inline Vector32::type apply(Vector32::type left, Vector32::type right) noexcept { return Vector32::bitAnd(left, right); }
+#endif
+  };
+
+  struct Or {
+    static constexpr uint64_t apply(uint64_t left, uint64_t right) noexcept { return left | right; }
+#if _RHLIB_SIMD_SSE2
+    static inline Vector32::type apply(Vector32::type left, Vector32::type right) noexcept { return Vector32::bitOr(left, right); }
+#endif
+  };
+
+  struct Xor {
+    static constexpr uint64_t apply(uint64_t left, uint64_t right) noexcept { return left ^ right; }
+#if _RHLIB_SIMD_SSE2
+    static inline Vector32::type apply(Vector32::type left, Vector32::type right) noexcept { return Vector32::bitXor(left, right); }
+#endif
+  };
+
+  struct AndNot {
+    static constexpr uint64_t apply(uint64_t left, uint64_t right) noexcept { return left & ~right; }
+#if _RHLIB_SIMD_SSE2
+    static inline Vector32::type apply(Vector32::type left, Vector32::type right) noexcept { return Vector32::bitAndNot(left, right); }
+#endif
+  };
+
+  // destination[i] = OpT(destination[i], source[i])
+  template <typename OpT>
+  static constexpr void combine(uint64_t* destination, const uint64_t* source, size_t count) noexcept {
+    size_t i = 0;
+
+#if _RHLIB_SIMD_SSE2
+    if !consteval {
+      constexpr size_t STEP = Vector32::SIZE / sizeof(uint64_t);
+
+      for (; i + STEP <= count; i += STEP)
+        Vector32::store(destination + i, OpT::apply(Vector32::load(destination + i), Vector32::load(source + i)));
+    }
+#endif
+
+    for (; i < count; ++i)
+      destination[i] = OpT::apply(destination[i], source[i]);
+  }
+
+  [[nodiscard]]
+  static constexpr size_t count(const uint64_t* words, size_t count) noexcept {
+    size_t i = 0;
+    size_t total = 0;
+
+#if _RHLIB_SIMD_AVX2
+    if !consteval {
+      total = countVector(words, count);
+      i = count - count % 4;
+    }
+#endif
+
+    for (; i < count; ++i)
+      total += static_cast<size_t>(__builtin_popcountll(words[i]));
+
+    return total;
+  }
+
+#if _RHLIB_SIMD_AVX2
+  // Counts whole blocks of 4 words: popcount of every nibble through a lookup table,
+  //  then bytes are summed into 64-bit lanes
+  [[nodiscard]]
+  static inline size_t countVector(const uint64_t* words, size_t count) noexcept {
+    __m256i const table = _mm256_setr_epi8(
+      0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+      0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4
+    );
+    __m256i const low_mask = _mm256_set1_epi8(0x0F);
+
+    __m256i totals = _mm256_setzero_si256();
+
+    for (size_t i = 0; i + 4 <= count; i += 4) {
+      __m256i block = Vector32::load(words + i);
+
+      __m256i low  = _mm256_shuffle_epi8(table, _mm256_and_si256(block, low_mask));
+      __m256i high = _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(block, 4), low_mask));
+
+      totals = _mm256_add_epi64(totals, _mm256_sad_epu8(_mm256_add_epi8(low, high), _mm256_setzero_si256()));
+    }
+
+    return static_cast<size_t>(
+      _mm256_extract_epi64(totals, 0) + _mm256_extract_epi64(totals, 1) +
+      _mm256_extract_epi64(totals, 2) + _mm256_extract_epi64(totals, 3)
+    );
+  }
+#endif
+
+  // Index of the first set bit at or after "from", or -1
+  [[nodiscard]]
+  static constexpr ssize_t findNext(const uint64_t* words, size_t bits, size_t from) noexcept {
+    if (from >= bits)
+      return -1;
+
+    size_t index = from / WORD_BITS;
+    uint64_t word = words[index] & (~uint64_t{0} << from % WORD_BITS);
+
+    for (size_t count = wordsFor(bits); word == 0;) {
+      if (++index == count)
+        return -1;
+
+      word = words[index];
+    }
+
+    return static_cast<ssize_t>(index * WORD_BITS + countTrailingZeros(word));
+  }
+
+  // Position of the n-th (from 0) set bit of word, which has more than n of them
+  [[nodiscard]]
+  static constexpr size_t selectInWord(uint64_t word, size_t n) noexcept {
+    for (; n != 0; --n)
+      word &= word - 1;
+
+    return countTrailingZeros(word);
+  }
+
+  [[nodiscard]]
+  static constexpr bool equal(const uint64_t* left, const uint64_t* right, size_t count) noexcept {
+    for (size_t i = 0; i < count; ++i) {
+      if (left[i] != right[i])
+        return false;
+    }
+
+    return true;
+  }
+};
+
+_RHLIB_HIDDEN_END
+
+// Indices of set bits, in increasing order
+class SetBits {
+public:
+  class Iterator {
+  private:
+    const uint64_t* m_words = nullptr;
+    size_t          m_count = 0;
+    size_t          m_index = 0;
+    uint64_t        m_word  = 0; // bits, which aren't visited yet
+
+  public:
+    constexpr Iterator() noexcept = default;
+
+    constexpr Iterator(const uint64_t* words, size_t count, size_t index) noexcept
+      : m_words(words), m_count(count), m_index(index)
+    {
+      if (m_index != m_count) {
+        m_word = m_words[m_index];
+        _skipEmpty();
+      }
+    }
+
+  public:
+    [[nodiscard]]
+    constexpr size_t operator*() const noexcept {
+      return m_index * _RHLIBH BitUtils::WORD_BITS + _RHLIBH countTrailingZeros(m_word);
+    }
+
+    constexpr Iterator& operator++() noexcept {
+      m_word &= m_word - 1;
+      _skipEmpty();
+      return *this;
+    }
+
+    [[nodiscard]]
+    constexpr bool operator==(Iterator const& other) const noexcept {
+      return m_index == other.m_index && m_word == other.m_word;
+    }
+
+  private:
+    constexpr void _skipEmpty() noexcept {
+      while (m_word == 0 && ++m_index != m_count)
+        m_word = m_words[m_index];
+    }
+  };
+
+private:
+  Span<uint64_t const> m_words;
+
+public:
+  constexpr explicit SetBits(Span<uint64_t const> words) noexcept
+    : m_words(words) {}
+
+public:
+  [[nodiscard]]
+  constexpr Iterator begin() const noexcept {
+    return { m_words.data(), m_words.length(), 0 };
+  }
+
+  [[nodiscard]]
+  constexpr Iterator end() const noexcept {
+    return { m_words.data(), m_words.length(), m_words.length() };
+  }
+};
+
+// Dynamic list of bits, packed into 64-bit words. Bulk operations go word by word,
+//  several words per instruction where SIMD is available
+template <Allocator AllocatorT = DefaultAllocator>
+class BasicBitList {
+public:
+  using allocator_type = AllocatorT;
+
+private:
+  using Utils = _RHLIBH BitUtils;
+
+  List<uint64_t, AllocatorT> m_words;
+  size_t                     m_length = 0;
+
+public:
+  constexpr BasicBitList() noexcept = default;
+
+  constexpr explicit BasicBitList(AllocatorT const& allocator) noexcept
+    : m_words(allocator) {}
+
+  constexpr explicit BasicBitList(size_t length, bool value = false) {
+    resize(length, value);
+  }
+
+public:
+  [[nodiscard]]
+  constexpr AllocatorT const& allocator() const noexcept {
+    return m_words.allocator();
+  }
+
+  [[nodiscard]]
+  constexpr Span<uint64_t const> words() const noexcept {
+    return { m_words.data(), m_words.length() };
+  }
+
+  [[nodiscard]]
+  constexpr bool isEmpty() const noexcept {
+    return m_length == 0;
+  }
+
+  [[nodiscard]]
+  constexpr size_t length() const noexcept {
+    return m_length;
+  }
+
+  constexpr void reserve(size_t bits) {
+    m_words.reserve(Utils::wordsFor(bits));
+  }
+
+  constexpr void clear() noexcept {
+    m_words.clear();
+    m_length = 0;
+  }
+
+  // new bits are set to value
+  constexpr void resize(size_t length, bool value = false) {
+    size_t old_length = m_length;
+
+    m_words.resize(Utils::wordsFor(length));
+    m_length = length;
+
+    if (value && length > old_length) {
+      if (old_length % Utils::WORD_BITS != 0)
+        m_words[old_length / Utils::WORD_BITS] |= ~Utils::tailMask(old_length);
+
+      for (size_t i = Utils::wordsFor(old_length); i < m_words.length(); ++i)
+        m_words[i] = ~uint64_t{0};
+    }
+
+    _clearTail();
+  }
+
+  constexpr void append(bool value) {
+    if (m_length % Utils::WORD_BITS == 0)
+      m_words.append(0);
+
+    m_words[m_length / Utils::WORD_BITS] |= static_cast<uint64_t>(value) << m_length % Utils::WORD_BITS;
+    ++m_length;
+  }
+
+  [[nodiscard]]
+  constexpr bool test(size_t index) const noexcept {
+    return (m_words[index / Utils::WORD_BITS] >> index % Utils::WORD_BITS) & 1;
+  }
+
+  constexpr void set(size_t index, bool value = true) noexcept {
+    uint64_t bit = uint64_t{1} << index % Utils::WORD_BITS;
+    uint64_t& word = m_words[index / Utils::WORD_BITS];
+
+    word = value ? word | bit : word & ~bit;
+  }
+
+  constexpr void reset(size_t index) noexcept {
+    set(index, false);
+  }
+
+  constexpr void flip(size_t index) noexcept {
+    m_words[index / Utils::WORD_BITS] ^= uint64_t{1} << index % Utils::WORD_BITS;
+  }
+
+  constexpr void setAll() noexcept {
+    for (uint64_t& word : m_words)
+      word = ~uint64_t{0};
+
+    _clearTail();
+  }
+
+  constexpr void resetAll() noexcept {
+    for (uint64_t& word : m_words)
+      word = 0;
+  }
+
+  constexpr void flipAll() noexcept {
+    for (uint64_t& word : m_words)
+      word = ~word;
+
+    _clearTail();
+  }
+
+  // Number of set bits
+  [[nodiscard]]
+  constexpr size_t count() const noexcept {
+    return Utils::count(m_words.data(), m_words.length());
+  }
+
+  [[nodiscard]]
+  constexpr bool any() const noexcept {
+    return findFirstSet() >= 0;
+  }
+
+  // Index of the first set bit, or -1
+  [[nodiscard]]
+  constexpr ssize_t findFirstSet() const noexcept {
+    return Utils::findNext(m_words.data(), m_length, 0);
+  }
+
+  // Index of the first set bit at or after index, or -1
+  [[nodiscard]]
+  constexpr ssize_t findNextSet(size_t index) const noexcept {
+    return Utils::findNext(m_words.data(), m_length, index);
+  }
+
+  [[nodiscard]]
+  constexpr SetBits setBits() const noexcept {
+    return SetBits(words());
+  }
+
+  // Bulk operations need lists of the same length
+  constexpr BasicBitList& operator&=(BasicBitList const& other) {
+    return _combine<Utils::And>(other);
+  }
+
+  constexpr BasicBitList& operator|=(BasicBitList const& other) {
+    return _combine<Utils::Or>(other);
+  }
+
+  constexpr BasicBitList& operator^=(BasicBitList const& other) {
+    return _combine<Utils::Xor>(other);
+  }
+
+  // Clears bits, which are set in other
+  constexpr BasicBitList& andNot(BasicBitList const& other) {
+    return _combine<Utils::AndNot>(other);
+  }
+
+  [[nodiscard]]
+  constexpr bool operator==(BasicBitList const& other) const noexcept {
+    return m_length == other.m_length && Utils::equal(m_words.data(), other.m_words.data(), m_words.length());
+  }
+
+  [[nodiscard]]
+  constexpr bool operator[](size_t index) const noexcept {
+    return test(index);
+  }
+
+private:
+  template <typename OpT>
+  constexpr BasicBitList& _combine(BasicBitList const& other) {
+    if (m_length != other.m_length)
+      throw IndexError(U"lengths of BitLists differ");
+
+    Utils::combine<OpT>(m_words.data(), other.m_words.data(), m_words.length());
+    return *this;
+  }
+
+  constexpr void _clearTail() noexcept {
+    if (!m_words.isEmpty())
+      m_words[m_words.length() - 1] &= Utils::tailMask(m_length);
+  }
+};
+
+using BitList = BasicBitList<>;
+
+template <typename AllocatorT>
+static constexpr bool is_trivially_relocatable<BasicBitList<AllocatorT>> = is_trivially_relocatable<AllocatorT>;
+
+// Fixed number of bits in an Array of words, without heap
+template <size_t Bits>
+class BitArray {
+public:
+  static_assert(Bits > 0, "BitArray must have at least one bit");
+
+  static constexpr size_t WORDS = _RHLIBH BitUtils::wordsFor(Bits);
+
+private:
+  using Utils = _RHLIBH BitUtils;
+
+  Array<uint64_t, WORDS> m_words;
+
+public:
+  constexpr BitArray() noexcept {
+    resetAll();
+  }
+
+public:
+  [[nodiscard]]
+  constexpr Span<uint64_t const> words() const noexcept {
+    return { m_words.data(), WORDS };
+  }
+
+  [[nodiscard]]
+  constexpr bool isEmpty() const noexcept {
+    return false;
+  }
+
+  [[nodiscard]]
+  constexpr size_t length() const noexcept {
+    return Bits;
+  }
+
+  [[nodiscard]]
+  constexpr bool test(size_t index) const noexcept {
+    return (m_words[index / Utils::WORD_BITS] >> index % Utils::WORD_BITS) & 1;
+  }
+
+  constexpr void set(size_t index, bool value = true) noexcept {
+    uint64_t bit = uint64_t{1} << index % Utils::WORD_BITS;
+    uint64_t& word = m_words[index / Utils::WORD_BITS];
+
+    word = value ? word | bit : word & ~bit;
+  }
+
+  constexpr void reset(size_t index) noexcept {
+    set(index, false);
+  }
+
+  constexpr void flip(size_t index) noexcept {
+    m_words[index / Utils::WORD_BITS] ^= uint64_t{1} << index % Utils::WORD_BITS;
+  }
+
+  constexpr void setAll() noexcept {
+    for (uint64_t& word : m_words)
+      word = ~uint64_t{0};
+
+    m_words[WORDS - 1] &= Utils::tailMask(Bits);
+  }
+
+  constexpr void resetAll() noexcept {
+    for (uint64_t& word : m_words)
+      word = 0;
+  }
+
+  constexpr void flipAll() noexcept {
+    for (uint64_t& word : m_words)
+      word = ~word;
+
+    m_words[WORDS - 1] &= Utils::tailMask(Bits);
+  }
+
+  [[nodiscard]]
+  constexpr size_t count() const noexcept {
+    return Utils::count(m_words.data(), WORDS);
+  }
+
+  [[nodiscard]]
+  constexpr bool any() const noexcept {
+    return findFirstSet() >= 0;
+  }
+
+  [[nodiscard]]
+  constexpr ssize_t findFirstSet() const noexcept {
+    return Utils::findNext(m_words.data(), Bits, 0);
+  }
+
+  [[nodiscard]]
+  constexpr ssize_t findNextSet(size_t index) const noexcept {
+    return Utils::findNext(m_words.data(), Bits, index);
+  }
+
+  [[nodiscard]]
+  constexpr SetBits setBits() const noexcept {
+    return SetBits(words());
+  }
+
+  constexpr BitArray& operator&=(BitArray const& other) noexcept {
+    Utils::combine<Utils::And>(m_words.data(), other.m_words.data(), WORDS);
+    return *this;
+  }
+
+  constexpr BitArray& operator|=(BitArray const& other) noexcept {
+    Utils::combine<Utils::Or>(m_words.data(), other.m_words.data(), WORDS);
+    return *this;
+  }
+
+  constexpr BitArray& operator^=(BitArray const& other) noexcept {
+    Utils::combine<Utils::Xor>(m_words.data(), other.m_words.data(), WORDS);
+    return *this;
+  }
+
+  constexpr BitArray& andNot(BitArray const& other) noexcept {
+    Utils::combine<Utils::AndNot>(m_words.data(), other.m_words.data(), WORDS);
+    return *this;
+  }
+
+  [[nodiscard]]
+  constexpr bool operator==(BitArray const& other) const noexcept {
+    return Utils::equal(m_words.data(), other.m_words.data(), WORDS);
+  }
+
+  [[nodiscard]]
+  constexpr bool operator[](size_t index) const noexcept {
+    return test(index);
+  }
+};
+
+// Rank/select index over bits of a BitList or BitArray, which must not change while
+//  the index is used. Keeps number of set bits before every block of 512 bits, so
+//  rank() reads at most 8 words, and select() searches blocks first
+template <Allocator AllocatorT = DefaultAllocator>
+class BasicBitRank {
+private:
+  using Utils = _RHLIBH BitUtils;
+
+  static constexpr size_t BLOCK_WORDS = 8;
+  static constexpr size_t BLOCK_BITS  = BLOCK_WORDS * Utils::WORD_BITS;
+
+  Span<uint64_t const>       m_words;
+  size_t                     m_length = 0;
+  List<uint64_t, AllocatorT> m_blocks; // set bits before block, and the total at the end
+
+public:
+  template <typename BitsT>
+    requires requires(BitsT const& bits) { { bits.words() } -> ConvertibleTo<Span<uint64_t const>>; }
+  constexpr explicit BasicBitRank(BitsT const& bits, AllocatorT const& allocator = AllocatorT{})
+    : m_words(bits.words()), m_length(bits.length()), m_blocks(allocator)
+  {
+    size_t total = 0;
+
+    m_blocks.reserve(m_words.length() / BLOCK_WORDS + 2);
+
+    for (size_t i = 0; i < m_words.length(); i += BLOCK_WORDS) {
+      m_blocks.append(total);
+      total += Utils::count(m_words.data() + i, m_words.length() - i < BLOCK_WORDS ? m_words.length() - i : BLOCK_WORDS);
+    }
+
+    m_blocks.append(total);
+  }
+
+public:
+  // Number of set bits
+  [[nodiscard]]
+  constexpr size_t count() const noexcept {
+    return m_blocks[m_blocks.length() - 1];
+  }
+
+  // Number of set bits before index, index may be equal to length
+  [[nodiscard]]
+  constexpr size_t rank(size_t index) const noexcept {
+    if (index >= m_length)
+      return count();
+
+    size_t word = index / Utils::WORD_BITS;
+    size_t block_start = word - word % BLOCK_WORDS;
+
+    size_t result = m_blocks[index / BLOCK_BITS] + Utils::count(m_words.data() + block_start, word - block_start);
+    return result + static_cast<size_t>(__builtin_popcountll(m_words[word] & ((uint64_t{1} << index % Utils::WORD_BITS) - 1)));
+  }
+
+  // Index of the n-th (from 0) set bit, or -1 if there are n or fewer of them
+  [[nodiscard]]
+  constexpr ssize_t select(size_t n) const noexcept {
+    if (n >= count())
+      return -1;
+
+    // last block, which starts with at most n set bits
+    size_t low = 0;
+    size_t high = m_blocks.length() - 1;
+
+    while (high - low > 1) {
+      size_t middle = (low + high) / 2;
+
+      if (m_blocks[middle] <= n)
+        low = middle;
+      else
+        high = middle;
+    }
+
+    n -= m_blocks[low];
+
+    for (size_t word = low * BLOCK_WORDS;; ++word) {
+      size_t bits = static_cast<size_t>(__builtin_popcountll(m_words[word]));
+
+      if (n < bits)
+        return static_cast<ssize_t>(word * Utils::WORD_BITS + Utils::selectInWord(m_words[word], n));
+
+      n -= bits;
+    }
+  }
+};
+
+using BitRank = BasicBitRank<>;
+
+_RHLIB_END
@@ -0,0 +1,405 @@
+#pragma once
+#define _RHLIB_INCLUDED_DEQUE
+
+#include <rh.hpp>
+
+#include <rh/Allocator.hpp>
+#include <rh/Pair.hpp>
+#include <rh/TypeTraits.hpp>
+#include <rh/simd.hpp>
+
+_RHLIB_BEGIN
+
+// Double-ended queue. Items live in fixed-size chunks, and an index of chunk pointers
+//  maps position of an item to its chunk with a shift and a mask. Push and pop at both
+//  ends are O(1) and never move other items, so references stay valid until their item
+//  is popped. Index is recentered or grown only when an end runs out of chunk slots.
+// One emptied chunk is kept aside, so a queue going back and forth over a chunk
+//  boundary doesn't allocate on every push
+// Items aren't contiguous, so iterators don't convert to pointers and Deque is only
+//  Iterable, not IterableOf
+template <typename T, Allocator AllocatorT = DefaultAllocator>
+class Deque {
+public:
+  using value_type     = T;
+  using allocator_type = AllocatorT;
+
+  static constexpr size_t CHUNK_SIZE = 4096;
+
+  // Power of two, so positions split into chunk and offset without division
+  static constexpr size_t CHUNK_LENGTH =
+    sizeof(T) * 16 > CHUNK_SIZE ? 16 : _RHLIBH roundUpToPowerOfTwo(CHUNK_SIZE / sizeof(T) + 1) / 2;
+
+private:
+  static constexpr size_t CHUNK_SHIFT = __builtin_ctzll(CHUNK_LENGTH);
+  static constexpr size_t CHUNK_MASK  = CHUNK_LENGTH - 1;
+
+  static constexpr size_t MIN_CHUNK_SLOTS = 8;
+
+  // Item i is at position head + i. Chunks are allocated only for positions of items
+  struct Storage {
+    T**    chunks     = nullptr;
+    size_t chunkSlots = 0;
+    size_t head       = 0;
+    size_t count      = 0;
+    T*     spare      = nullptr;
+  };
+
+  // stateless allocator takes no space
+  CompressedPair<AllocatorT, Storage> m_storage;
+
+public:
+  template <bool IsConst>
+  class Iterator {
+  private:
+    friend class Deque;
+
+    template <bool>
+    friend class Iterator;
+
+    using ValueT = conditional<IsConst, T const, T>;
+
+    T* const* m_chunks   = nullptr;
+    size_t    m_position = 0;
+
+  public:
+    constexpr Iterator() noexcept = default;
+
+    constexpr Iterator(T* const* chunks, size_t position) noexcept
+      : m_chunks(chunks), m_position(position) {}
+
+    // const iterator from a mutable one
+    template <bool OtherConst>
+      requires (IsConst && !OtherConst)
+    constexpr Iterator(Iterator<OtherConst> const& other) noexcept
+      : m_chunks(other.m_chunks), m_position(other.m_position) {}
+
+  public:
+    [[nodiscard]]
+    constexpr ValueT& operator*() const noexcept {
+      return m_chunks[m_position >> CHUNK_SHIFT][m_position & CHUNK_MASK];
+    }
+
+    [[nodiscard]]
+    constexpr ValueT* operator->() const noexcept {
+      return &operator*();
+    }
+
+    constexpr Iterator& operator++() noexcept {
+      ++m_position;
+      return *this;
+    }
+
+    constexpr Iterator& operator--() noexcept {
+      --m_position;
+      return *this;
+    }
+
+    [[nodiscard]]
+    constexpr bool operator==(Iterator const& other) const noexcept {
+      return m_position == other.m_position;
+    }
+  };
+
+public:
+  constexpr Deque() noexcept = default;
+
+  constexpr explicit Deque(AllocatorT const& allocator) noexcept
+    : m_storage(allocator, Storage{}) {}
+
+  constexpr Deque(Deque const& other)
+    : m_storage(other.m_storage.getFirst(), Storage{})
+  {
+    operator=(other);
+  }
+
+  constexpr Deque(Deque&& other) noexcept
+    : m_storage(move(other.m_storage.getFirst()), Storage{})
+  {
+    _stealOther(other);
+  }
+
+  constexpr Deque& operator=(Deque const& other) {
+    if (this != &other) {
+      clear();
+
+      for (T const& item : other)
+        append(item);
+    }
+
+    return *this;
+  }
+
+  constexpr Deque& operator=(Deque&& other) noexcept {
+    if (this != &other) {
+      _release();
+      m_storage.getFirst() = move(other.m_storage.getFirst());
+      _stealOther(other);
+    }
+
+    return *this;
+  }
+
+  constexpr ~Deque() {
+    _release();
+  }
+
+public:
+  [[nodiscard]]
+  constexpr AllocatorT const& allocator() const noexcept {
+    return m_storage.getFirst();
+  }
+
+  [[nodiscard]]
+  constexpr Iterator<false> begin() noexcept {
+    return { m_storage.chunks, m_storage.head };
+  }
+
+  [[nodiscard]]
+  constexpr Iterator<true> begin() const noexcept {
+    return { m_storage.chunks, m_storage.head };
+  }
+
+  [[nodiscard]]
+  constexpr Iterator<false> end() noexcept {
+    return { m_storage.chunks, m_storage.head + m_storage.count };
+  }
+
+  [[nodiscard]]
+  constexpr Iterator<true> end() const noexcept {
+    return { m_storage.chunks, m_storage.head + m_storage.count };
+  }
+
+  [[nodiscard]]
+  constexpr bool isEmpty() const noexcept {
+    return m_storage.count == 0;
+  }
+
+  [[nodiscard]]
+  constexpr size_t length() const noexcept {
+    return m_storage.count;
+  }
+
+  // Deque must not be empty
+  [[nodiscard]]
+  constexpr T& front() noexcept {
+    return operator[](0);
+  }
+
+  [[nodiscard]]
+  constexpr T const& front() const noexcept {
+    return operator[](0);
+  }
+
+  [[nodiscard]]
+  constexpr T& back() noexcept {
+    return operator[](m_storage.count - 1);
+  }
+
+  [[nodiscard]]
+  constexpr T const& back() const noexcept {
+    return operator[](m_storage.count - 1);
+  }
+
+  constexpr void append(T&& movedValue) {
+    emplaceBack(move(movedValue));
+  }
+
+  constexpr void append(T const& value) {
+    emplaceBack(value);
+  }
+
+  constexpr void prepend(T&& movedValue) {
+    emplaceFront(move(movedValue));
+  }
+
+  constexpr void prepend(T const& value) {
+    emplaceFront(value);
+  }
+
+  template <typename... ArgsT>
+  constexpr T& emplaceBack(ArgsT&&... args) {
+    if (m_storage.head + m_storage.count == m_storage.chunkSlots << CHUNK_SHIFT)
+      _reindex(false);
+
+    size_t position = m_storage.head + m_storage.count;
+    T* item = _itemFor(position, m_storage.count == 0 || (position & CHUNK_MASK) == 0, forward<ArgsT>(args)...);
+
+    ++m_storage.count;
+    return *item;
+  }
+
+  template <typename... ArgsT>
+  constexpr T& emplaceFront(ArgsT&&... args) {
+    if (m_storage.head == 0)
+      _reindex(true);
+
+    size_t position = m_storage.head - 1;
+    T* item = _itemFor(position, m_storage.count == 0 || (m_storage.head & CHUNK_MASK) == 0, forward<ArgsT>(args)...);
+
+    --m_storage.head;
+    ++m_storage.count;
+    return *item;
+  }
+
+  // Deque must not be empty
+  constexpr void popBack() noexcept {
+    size_t position = m_storage.head + m_storage.count - 1;
+
+    destructAt(&_at(position));
+    --m_storage.count;
+
+    if (m_storage.count == 0 || (position & CHUNK_MASK) == 0)
+      _freeChunk(position >> CHUNK_SHIFT);
+  }
+
+  // Deque must not be empty
+  constexpr void popFront() noexcept {
+    size_t position = m_storage.head;
+
+    destructAt(&_at(position));
+    ++m_storage.head;
+    --m_storage.count;
+
+    if (m_storage.count == 0 || (m_storage.head & CHUNK_MASK) == 0)
+      _freeChunk(position >> CHUNK_SHIFT);
+  }
+
+  constexpr void clear() noexcept {
+    while (m_storage.count != 0)
+      popBack();
+  }
+
+  // Frees the kept aside chunk, and the index if nothing is left
+  constexpr void shrinkToFit() noexcept {
+    _freeSpare();
+
+    if (m_storage.count == 0)
+      _freeIndex();
+  }
+
+  [[nodiscard]]
+  constexpr T const& operator[](size_t index) const noexcept {
+    return _at(m_storage.head + index);
+  }
+
+  [[nodiscard]]
+  constexpr T& operator[](size_t index) noexcept {
+    return _at(m_storage.head + index);
+  }
+
+private:
+  [[nodiscard]]
+  constexpr T& _at(size_t position) const noexcept {
+    return m_storage.chunks[position >> CHUNK_SHIFT][position & CHUNK_MASK];
+  }
+
+  // Constructs an item at position, allocating its chunk first if it's a new one
+  template <typename... ArgsT>
+  constexpr T* _itemFor(size_t position, bool newChunk, ArgsT&&... args) {
+    T*& chunk = m_storage.chunks[position >> CHUNK_SHIFT];
+
+    if (newChunk) {
+      if (m_storage.spare) {
+        chunk = m_storage.spare;
+        m_storage.spare = nullptr;
+      }
+      else
+        chunk = static_cast<T*>(m_storage.getFirst().allocate(CHUNK_LENGTH * sizeof(T), alignof(T)));
+    }
+
+    T* item = &chunk[position & CHUNK_MASK];
+
+    try {
+      constructAt(item, forward<ArgsT>(args)...);
+    }
+    catch (...) {
+      if (newChunk)
+        _freeChunk(position >> CHUNK_SHIFT);
+
+      throw;
+    }
+
+    return item;
+  }
+
+  constexpr void _freeChunk(size_t slot) noexcept {
+    T* chunk = m_storage.chunks[slot];
+
+    if (m_storage.spare)
+      m_storage.getFirst().deallocate(chunk, CHUNK_LENGTH * sizeof(T), alignof(T));
+    else
+      m_storage.spare = chunk;
+  }
+
+  // Makes room for one more chunk before the first one or after the last one.
+  // Used chunks move to the middle of the index, which doubles if they take more than half of it
+  constexpr void _reindex(bool atFront) {
+    size_t first  = m_storage.head >> CHUNK_SHIFT;
+    size_t offset = m_storage.head & CHUNK_MASK;
+    size_t used   = m_storage.count == 0 ? 0 : ((m_storage.head + m_storage.count - 1) >> CHUNK_SHIFT) - first + 1;
+
+    size_t slots = m_storage.chunkSlots;
+
+    while (slots < 2 * (used + 1))
+      slots = slots < MIN_CHUNK_SLOTS ? MIN_CHUNK_SLOTS : slots * 2;
+
+    // at least one free slot on each side
+    size_t new_first = (slots - used) / 2;
+
+    // slots outside of used chunks are never read, so they aren't cleared
+    if (slots == m_storage.chunkSlots)
+      __builtin_memmove(m_storage.chunks + new_first, m_storage.chunks + first, used * sizeof(T*));
+    else {
+      T** chunks = static_cast<T**>(m_storage.getFirst().allocate(slots * sizeof(T*), alignof(T*)));
+
+      if (used != 0)
+        __builtin_memcpy(chunks + new_first, m_storage.chunks + first, used * sizeof(T*));
+
+      _freeIndex();
+
+      m_storage.chunks = chunks;
+      m_storage.chunkSlots = slots;
+    }
+
+    // nothing to keep an offset for, start in the middle of a chunk
+    if (m_storage.count == 0)
+      offset = atFront ? CHUNK_LENGTH / 2 : 0;
+
+    m_storage.head = (new_first << CHUNK_SHIFT) | offset;
+  }
+
+  constexpr void _freeSpare() noexcept {
+    if (m_storage.spare)
+      m_storage.getFirst().deallocate(m_storage.spare, CHUNK_LENGTH * sizeof(T), alignof(T));
+
+    m_storage.spare = nullptr;
+  }
+
+  constexpr void _freeIndex() noexcept {
+    if (m_storage.chunks)
+      m_storage.getFirst().deallocate(m_storage.chunks, m_storage.chunkSlots * sizeof(T*), alignof(T*));
+
+    m_storage.chunks = nullptr;
+    m_storage.chunkSlots = 0;
+    m_storage.head = 0;
+  }
+
+  // Destroys items and frees everything
+  constexpr void _release() noexcept {
+    clear();
+    _freeSpare();
+    _freeIndex();
+  }
+
+  // This deque must be empty and hold no memory
+  constexpr void _stealOther(Deque& other) noexcept {
+    m_storage.getSecond() = other.m_storage.getSecond();
+    other.m_storage.getSecond() = Storage{};
+  }
+};
+
+template <typename T, typename AllocatorT>
+static constexpr bool is_trivially_relocatable<Deque<T, AllocatorT>> = is_trivially_relocatable<AllocatorT>;
+
+_RHLIB_END
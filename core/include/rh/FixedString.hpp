@@ -0,0 +1,280 @@
+#pragma once
+#define _RHLIB_INCLUDED_FIXEDSTRING
+
+#include <rh.hpp>
+
+#include <rh/String.hpp>
+#include <rh/hash.hpp>
+#include <rh/simd.hpp>
+
+_RHLIB_BEGIN
+
+// String literal, which can be used as a template parameter:
+//  template <FixedString Name> struct Command {};  Command<U"list">
+// Size includes null-terminator
+template <size_t Size>
+struct FixedString {
+  using type       = FixedString;
+  using value_type = char32_t;
+
+  static_assert(Size > 0, "FixedString must hold at least a null-terminator");
+
+  // public, because template parameters must be structural types
+  char32_t characters[Size] = {};
+
+  constexpr FixedString() noexcept = default;
+
+  constexpr FixedString(const char32_t (&string)[Size]) noexcept {
+    for (size_t index = 0; index < Size; ++index)
+      characters[index] = string[index];
+  }
+
+  // ASCII only, use U"" literals for anything else
+  constexpr FixedString(const char (&string)[Size]) noexcept {
+    for (size_t index = 0; index < Size; ++index)
+      characters[index] = static_cast<char32_t>(static_cast<unsigned char>(string[index]));
+  }
+
+public:
+  constexpr operator StringView() const noexcept {
+    return view();
+  }
+
+public:
+  [[nodiscard]]
+  constexpr StringView view() const noexcept {
+    return StringView{characters, Size - 1};
+  }
+
+  [[nodiscard]]
+  constexpr const char32_t* data() const noexcept {
+    return characters;
+  }
+
+  [[nodiscard]]
+  static constexpr size_t length() noexcept {
+    return Size - 1;
+  }
+
+  [[nodiscard]]
+  static constexpr bool isEmpty() noexcept {
+    return Size == 1;
+  }
+
+  [[nodiscard]]
+  constexpr ssize_t find(StringView string) const noexcept {
+    return view().find(string);
+  }
+
+  [[nodiscard]]
+  constexpr ssize_t find(char32_t character) const noexcept {
+    return view().find(character);
+  }
+
+  [[nodiscard]]
+  constexpr bool contains(StringView string) const noexcept {
+    return view().contains(string);
+  }
+
+  [[nodiscard]]
+  constexpr bool startsWith(StringView string) const noexcept {
+    return view().startsWith(string);
+  }
+
+  [[nodiscard]]
+  constexpr bool endsWith(StringView string) const noexcept {
+    return view().endsWith(string);
+  }
+
+  [[nodiscard]]
+  constexpr uint64_t hash(uint64_t seed = 0) const noexcept {
+    return view().hash(seed);
+  }
+
+public:
+  template <size_t OtherSize>
+  [[nodiscard]]
+  constexpr bool operator==(FixedString<OtherSize> const& other) const noexcept {
+    return view() == other.view();
+  }
+
+  [[nodiscard]]
+  constexpr bool operator==(StringView other) const noexcept {
+    return view() == other;
+  }
+
+  [[nodiscard]]
+  constexpr char32_t operator[](size_t index) const noexcept {
+    return characters[index];
+  }
+};
+
+// Maps a string to the index of equal case, or -1.
+// Few cases are compared one by one (length goes first), more cases get a perfect hash table
+//  built at compile time, so lookup is one hash and one comparison
+template <FixedString... Cases>
+class StringSwitch {
+public:
+  using type = StringSwitch;
+
+  static constexpr size_t CASES_COUNT = sizeof...(Cases);
+
+  // Up to this many cases linear search is cheaper than hashing
+  static constexpr size_t LINEAR_CASES_COUNT = 4;
+
+  static_assert(CASES_COUNT > 0, "StringSwitch needs at least one case");
+  static_assert(CASES_COUNT < 0xFFFF, "Too many cases for StringSwitch");
+
+private:
+  static constexpr StringView CASES[CASES_COUNT] = { Cases.view()... };
+
+  // Hash and displace: key's hash picks a bucket, bucket's displacement picks a slot
+  static constexpr size_t BUCKETS_COUNT = _RHLIBH roundUpToPowerOfTwo((CASES_COUNT + 1) / 2);
+  static constexpr size_t SLOTS_COUNT   = _RHLIBH roundUpToPowerOfTwo(CASES_COUNT * 2);
+
+  static constexpr uint16_t EMPTY_SLOT       = 0xFFFF;
+  static constexpr uint16_t MAX_DISPLACEMENT = 0xFFFF;
+
+  struct Table {
+    uint16_t displacements[BUCKETS_COUNT] = {};
+    uint16_t slots[SLOTS_COUNT]           = {};
+    bool     isValid                      = false;
+  };
+
+  static constexpr bool _hasDuplicates() noexcept {
+    for (size_t first = 0; first < CASES_COUNT; ++first) {
+      for (size_t second = first + 1; second < CASES_COUNT; ++second) {
+        if (CASES[first] == CASES[second])
+          return true;
+      }
+    }
+
+    return false;
+  }
+
+  static_assert(!_hasDuplicates(), "StringSwitch cases must be unique");
+
+  [[nodiscard]]
+  static constexpr size_t _slotFor(uint64_t string_hash, uint16_t displacement) noexcept {
+    return hash::combine(string_hash, displacement) & (SLOTS_COUNT - 1);
+  }
+
+  static constexpr Table _buildTable() noexcept {
+    Table table;
+
+    for (uint16_t& slot : table.slots)
+      slot = EMPTY_SLOT;
+
+    uint64_t hashes[CASES_COUNT] = {};
+    size_t bucket_sizes[BUCKETS_COUNT] = {};
+
+    for (size_t index = 0; index < CASES_COUNT; ++index) {
+      hashes[index] = CASES[index].hash();
+      ++bucket_sizes[hashes[index] & (BUCKETS_COUNT - 1)];
+    }
+
+    bool is_placed[BUCKETS_COUNT] = {};
+
+    // the biggest buckets are the hardest to place, so they go first, while the table is empty
+    for (size_t placed_count = 0; placed_count < BUCKETS_COUNT; ++placed_count) {
+      size_t bucket = 0;
+      size_t bucket_size = 0;
+
+      for (size_t candidate = 0; candidate < BUCKETS_COUNT; ++candidate) {
+        if (!is_placed[candidate] && bucket_sizes[candidate] >= bucket_size) {
+          bucket = candidate;
+          bucket_size = bucket_sizes[candidate];
+        }
+      }
+
+      is_placed[bucket] = true;
+
+      if (bucket_size == 0)
+        continue;
+
+      bool is_found = false;
+
+      for (uint32_t displacement = 0; !is_found && displacement < MAX_DISPLACEMENT; ++displacement) {
+        size_t taken[CASES_COUNT] = {};
+        size_t taken_count = 0;
+
+        is_found = true;
+
+        for (size_t index = 0; is_found && index < CASES_COUNT; ++index) {
+          if ((hashes[index] & (BUCKETS_COUNT - 1)) != bucket)
+            continue;
+
+          size_t slot = _slotFor(hashes[index], static_cast<uint16_t>(displacement));
+
+          if (table.slots[slot] != EMPTY_SLOT)
+            is_found = false;
+
+          for (size_t taken_index = 0; is_found && taken_index < taken_count; ++taken_index) {
+            if (taken[taken_index] == slot)
+              is_found = false;
+          }
+
+          taken[taken_count++] = slot;
+        }
+
+        if (!is_found)
+          continue;
+
+        table.displacements[bucket] = static_cast<uint16_t>(displacement);
+
+        for (size_t index = 0; index < CASES_COUNT; ++index) {
+          if ((hashes[index] & (BUCKETS_COUNT - 1)) == bucket)
+            table.slots[_slotFor(hashes[index], static_cast<uint16_t>(displacement))] = static_cast<uint16_t>(index);
+        }
+      }
+
+      if (!is_found)
+        return table;
+    }
+
+    table.isValid = true;
+    return table;
+  }
+
+  static constexpr Table TABLE = CASES_COUNT > LINEAR_CASES_COUNT ? _buildTable() : Table{ .isValid = true };
+
+  static_assert(TABLE.isValid, "Failed to build perfect hash for StringSwitch cases");
+
+public:
+  [[nodiscard]]
+  static constexpr ssize_t find(StringView string) noexcept {
+    if constexpr (CASES_COUNT <= LINEAR_CASES_COUNT) {
+      for (size_t index = 0; index < CASES_COUNT; ++index) {
+        if (CASES[index] == string)
+          return static_cast<ssize_t>(index);
+      }
+
+      return -1;
+    }
+    else {
+      uint64_t string_hash = string.hash();
+      uint16_t index = TABLE.slots[_slotFor(string_hash, TABLE.displacements[string_hash & (BUCKETS_COUNT - 1)])];
+
+      if (index == EMPTY_SLOT || CASES[index] != string)
+        return -1;
+
+      return static_cast<ssize_t>(index);
+    }
+  }
+};
+
+// switch (stringSwitch<U"add", U"remove", U"list">(command)) {
+//   case 0: ...
+//   case -1: unknown command
+// }
+template <FixedString... Cases>
+[[nodiscard]]
+constexpr ssize_t stringSwitch(StringView string) noexcept {
+  return StringSwitch<Cases...>::find(string);
+}
+
+_RHLIB_END
+
+_RHLIB_GLOBAL_CLASS(FixedString);
+_RHLIB_GLOBAL_CLASS(StringSwitch);
+_RHLIB_GLOBAL_CLASS(stringSwitch);
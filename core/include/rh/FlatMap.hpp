@@ -0,0 +1,641 @@
+#pragma once
+#define _RHLIB_INCLUDED_FLATMAP
+
+#include <rh.hpp>
+
+#include <rh/Allocator.hpp>
+#include <rh/List.hpp>
+#include <rh/Pair.hpp>
+#include <rh/TypeTraits.hpp>
+#include <rh/exceptions.hpp>
+#include <rh/sort.hpp>
+
+_RHLIB_BEGIN
+
+_RHLIB_HIDDEN_BEGIN
+
+// Algorithms over sorted keys, shared by FlatMap and FlatSet
+struct FlatUtils {
+  // Index of the first key, which isn't less than lookup. The loop has a fixed count
+  //  of steps for a given count of keys, and each of them is a conditional move
+  template <typename K, typename LookupT, typename LessT>
+  [[nodiscard]]
+  static constexpr size_t lowerIndex(K const* keys, size_t count, LookupT const& lookup, LessT const& less) {
+    if (count == 0)
+      return 0;
+
+    K const* base = keys;
+
+    while (count > 1) {
+      size_t half = count / 2;
+      base = less(base[half], lookup) ? base + half : base;
+      count -= half;
+    }
+
+    return static_cast<size_t>(base - keys) + static_cast<size_t>(less(*base, lookup));
+  }
+};
+
+_RHLIB_HIDDEN_END
+
+// Sorted keys and their values in two Lists: lookups are binary searches over keys only,
+//  and the whole map is two allocations. Single insert and erase shift the tail, so it
+//  fits read-mostly tables, which are filled by insertBatch(): it sorts new entries and
+//  merges them with existing ones in O(n + m log m).
+// String-like keys are compared through their views by Less, like in BTreeMap
+template <typename K, typename V, Comparator<K> CompareT = Less, Allocator AllocatorT = DefaultAllocator>
+class FlatMap {
+public:
+  using key_type       = K;
+  using value_type     = V;
+  using allocator_type = AllocatorT;
+
+private:
+  using Utils = _RHLIBH FlatUtils;
+
+  static constexpr bool COMPARES_VIEWS = is_same_type<CompareT, Less> && requires { typename K::view_type; };
+
+  struct Storage {
+    List<K, AllocatorT> keys;
+    List<V, AllocatorT> values;
+  };
+
+  // stateless comparator takes no space
+  CompressedPair<CompareT, Storage> m_storage;
+
+public:
+  template <bool IsConst>
+  class Iterator {
+  private:
+    using ValueT = conditional<IsConst, V const, V>;
+
+    K const* m_key   = nullptr;
+    ValueT*  m_value = nullptr;
+
+  public:
+    constexpr Iterator() noexcept = default;
+
+    constexpr Iterator(K const* key, ValueT* value) noexcept
+      : m_key(key), m_value(value) {}
+
+  public:
+    [[nodiscard]]
+    constexpr K const& key() const noexcept {
+      return *m_key;
+    }
+
+    [[nodiscard]]
+    constexpr ValueT& value() const noexcept {
+      return *m_value;
+    }
+
+    [[nodiscard]]
+    constexpr PairRef<K const, ValueT> operator*() const noexcept {
+      return { *m_key, *m_value };
+    }
+
+    constexpr Iterator& operator++() noexcept {
+      ++m_key;
+      ++m_value;
+      return *this;
+    }
+
+    constexpr Iterator& operator--() noexcept {
+      --m_key;
+      --m_value;
+      return *this;
+    }
+
+    [[nodiscard]]
+    constexpr bool operator==(Iterator const& other) const noexcept {
+      return m_key == other.m_key;
+    }
+  };
+
+public:
+  constexpr FlatMap() noexcept = default;
+
+  constexpr explicit FlatMap(CompareT const& compare, AllocatorT const& allocator = AllocatorT{}) noexcept
+    : m_storage(compare, Storage{List<K, AllocatorT>(allocator), List<V, AllocatorT>(allocator)}) {}
+
+  constexpr explicit FlatMap(AllocatorT const& allocator) noexcept
+    requires (!is_same_type<CompareT, AllocatorT>)
+    : FlatMap(CompareT{}, allocator) {}
+
+  // Entries don't have to be sorted, the first one of equal keys is kept
+  template <typename ListAllocatorT>
+  constexpr explicit FlatMap(List<Pair<K, V>, ListAllocatorT> entries) : FlatMap() {
+    insertBatch(move(entries));
+  }
+
+public:
+  [[nodiscard]]
+  constexpr AllocatorT const& allocator() const noexcept {
+    return m_storage.keys.allocator();
+  }
+
+  // Sorted keys, and values in the same order
+  [[nodiscard]]
+  constexpr List<K, AllocatorT> const& keys() const noexcept {
+    return m_storage.keys;
+  }
+
+  [[nodiscard]]
+  constexpr List<V, AllocatorT> const& values() const noexcept {
+    return m_storage.values;
+  }
+
+  [[nodiscard]]
+  constexpr Iterator<false> begin() noexcept {
+    return { m_storage.keys.begin(), m_storage.values.begin() };
+  }
+
+  [[nodiscard]]
+  constexpr Iterator<true> begin() const noexcept {
+    return { m_storage.keys.begin(), m_storage.values.begin() };
+  }
+
+  [[nodiscard]]
+  constexpr Iterator<false> end() noexcept {
+    return { m_storage.keys.end(), m_storage.values.end() };
+  }
+
+  [[nodiscard]]
+  constexpr Iterator<true> end() const noexcept {
+    return { m_storage.keys.end(), m_storage.values.end() };
+  }
+
+  [[nodiscard]]
+  constexpr bool isEmpty() const noexcept {
+    return m_storage.keys.isEmpty();
+  }
+
+  [[nodiscard]]
+  constexpr size_t length() const noexcept {
+    return m_storage.keys.length();
+  }
+
+  constexpr void reserve(size_t count) {
+    m_storage.keys.reserve(count);
+    m_storage.values.reserve(count);
+  }
+
+  [[nodiscard]]
+  constexpr size_t capacity() const noexcept {
+    return m_storage.keys.capacity();
+  }
+
+  constexpr void shrinkToFit() {
+    m_storage.keys.shrinkToFit();
+    m_storage.values.shrinkToFit();
+  }
+
+  constexpr void clear() noexcept {
+    m_storage.keys.clear();
+    m_storage.values.clear();
+  }
+
+  // nullptr if there's no such key
+  template <typename LookupT>
+  [[nodiscard]]
+  constexpr V* find(LookupT const& key) {
+    ssize_t index = _findIndex(key);
+    return index < 0 ? nullptr : &m_storage.values[static_cast<size_t>(index)];
+  }
+
+  template <typename LookupT>
+  [[nodiscard]]
+  constexpr V const* find(LookupT const& key) const {
+    ssize_t index = _findIndex(key);
+    return index < 0 ? nullptr : &m_storage.values[static_cast<size_t>(index)];
+  }
+
+  template <typename LookupT>
+  [[nodiscard]]
+  constexpr bool contains(LookupT const& key) const {
+    return _findIndex(key) >= 0;
+  }
+
+  template <typename LookupT>
+  [[nodiscard]]
+  constexpr V& at(LookupT const& key) {
+    if (V* value = find(key))
+      return *value;
+
+    throw KeyError(U"key not found in FlatMap::at()");
+  }
+
+  template <typename LookupT>
+  [[nodiscard]]
+  constexpr V const& at(LookupT const& key) const {
+    if (V const* value = find(key))
+      return *value;
+
+    throw KeyError(U"key not found in FlatMap::at()");
+  }
+
+  // The first entry with key not less than the given one
+  template <typename LookupT>
+  [[nodiscard]]
+  constexpr Iterator<false> lowerBound(LookupT const& key) {
+    size_t index = _lowerIndex(key);
+    return { m_storage.keys.begin() + index, m_storage.values.begin() + index };
+  }
+
+  template <typename LookupT>
+  [[nodiscard]]
+  constexpr Iterator<true> lowerBound(LookupT const& key) const {
+    size_t index = _lowerIndex(key);
+    return { m_storage.keys.begin() + index, m_storage.values.begin() + index };
+  }
+
+  // The first entry with key greater than the given one
+  template <typename LookupT>
+  [[nodiscard]]
+  constexpr Iterator<false> upperBound(LookupT const& key) {
+    size_t index = _upperIndex(key);
+    return { m_storage.keys.begin() + index, m_storage.values.begin() + index };
+  }
+
+  template <typename LookupT>
+  [[nodiscard]]
+  constexpr Iterator<true> upperBound(LookupT const& key) const {
+    size_t index = _upperIndex(key);
+    return { m_storage.keys.begin() + index, m_storage.values.begin() + index };
+  }
+
+  // Value is default-constructed if there's no such key
+  template <typename KeyT>
+  constexpr V& operator[](KeyT&& key) {
+    return *emplace(forward<KeyT>(key)).first;
+  }
+
+  // Constructs value from args only if there's no such key yet.
+  // Returns the value and whether it's new
+  template <typename KeyT, typename... ArgsT>
+  constexpr Pair<V*, bool> emplace(KeyT&& key, ArgsT&&... args) {
+    size_t index = _lowerIndex(key);
+
+    if (index < length() && !_less(key, m_storage.keys[index]))
+      return { &m_storage.values[index], false };
+
+    m_storage.values.emplace(static_cast<ssize_t>(index), forward<ArgsT>(args)...);
+
+    try {
+      m_storage.keys.emplace(static_cast<ssize_t>(index), forward<KeyT>(key));
+    }
+    catch (...) {
+      m_storage.values.erase(static_cast<ssize_t>(index));
+      throw;
+    }
+
+    return { &m_storage.values[index], true };
+  }
+
+  // Doesn't replace existing value, returns whether value was inserted
+  template <typename KeyT, typename ValueT>
+  constexpr bool insert(KeyT&& key, ValueT&& value) {
+    return emplace(forward<KeyT>(key), forward<ValueT>(value)).second;
+  }
+
+  constexpr bool insert(Pair<K, V> const& entry) {
+    return emplace(entry.first, entry.second).second;
+  }
+
+  constexpr bool insert(Pair<K, V>&& entry) {
+    return emplace(move(entry.first), move(entry.second)).second;
+  }
+
+  // Inserts or replaces value
+  template <typename KeyT, typename ValueT>
+  constexpr void set(KeyT&& key, ValueT&& value) {
+    auto [existing, is_new] = emplace(forward<KeyT>(key), forward<ValueT>(value));
+
+    if (!is_new)
+      *existing = forward<ValueT>(value);
+  }
+
+  // Like insert() for each entry, but sorts them and merges with existing ones at once.
+  // Existing values aren't replaced, the first one of equal new keys is kept
+  template <typename ListAllocatorT>
+  constexpr void insertBatch(List<Pair<K, V>, ListAllocatorT> entries) {
+    stableSort(entries, [this](Pair<K, V> const& left, Pair<K, V> const& right) {
+      return _less(left.first, right.first);
+    });
+
+    List<K, AllocatorT> keys(allocator());
+    List<V, AllocatorT> values(allocator());
+
+    keys.reserve(length() + entries.length());
+    values.reserve(length() + entries.length());
+
+    size_t old = 0;
+
+    for (Pair<K, V>& entry : entries) {
+      for (; old < length() && _less(m_storage.keys[old], entry.first); ++old) {
+        keys.append(move(m_storage.keys[old]));
+        values.append(move(m_storage.values[old]));
+      }
+
+      // equal to an existing key, or to the previous new one
+      if (old < length() && !_less(entry.first, m_storage.keys[old]))
+        continue;
+
+      if (!keys.isEmpty() && !_less(keys[keys.length() - 1], entry.first))
+        continue;
+
+      keys.append(move(entry.first));
+      values.append(move(entry.second));
+    }
+
+    for (; old < length(); ++old) {
+      keys.append(move(m_storage.keys[old]));
+      values.append(move(m_storage.values[old]));
+    }
+
+    m_storage.keys = move(keys);
+    m_storage.values = move(values);
+  }
+
+  // Returns whether there was such key
+  template <typename LookupT>
+  constexpr bool erase(LookupT const& key) {
+    ssize_t index = _findIndex(key);
+
+    if (index < 0)
+      return false;
+
+    m_storage.keys.erase(index);
+    m_storage.values.erase(index);
+    return true;
+  }
+
+private:
+  template <typename LookupT>
+  [[nodiscard]]
+  static constexpr decltype(auto) _normalize(LookupT const& key) {
+    if constexpr (COMPARES_VIEWS)
+      return typename K::view_type{key};
+    else
+      return key;
+  }
+
+  template <typename LeftT, typename RightT>
+  [[nodiscard]]
+  constexpr bool _less(LeftT const& left, RightT const& right) const {
+    return m_storage.getFirst()(_normalize(left), _normalize(right));
+  }
+
+  template <typename LookupT>
+  [[nodiscard]]
+  constexpr size_t _lowerIndex(LookupT const& key) const {
+    auto const& lookup = _normalize(key);
+
+    return Utils::lowerIndex(m_storage.keys.data(), length(), lookup, [this](K const& left, auto const& right) {
+      return m_storage.getFirst()(_normalize(left), right);
+    });
+  }
+
+  template <typename LookupT>
+  [[nodiscard]]
+  constexpr size_t _upperIndex(LookupT const& key) const {
+    size_t index = _lowerIndex(key);
+
+    if (index < length() && !_less(key, m_storage.keys[index]))
+      ++index;
+
+    return index;
+  }
+
+  // -1 if there's no such key
+  template <typename LookupT>
+  [[nodiscard]]
+  constexpr ssize_t _findIndex(LookupT const& key) const {
+    size_t index = _lowerIndex(key);
+
+    if (index < length() && !_less(key, m_storage.keys[index]))
+      return static_cast<ssize_t>(index);
+
+    return -1;
+  }
+};
+
+// Sorted keys in a List, built just like FlatMap
+template <typename K, Comparator<K> CompareT = Less, Allocator AllocatorT = DefaultAllocator>
+class FlatSet {
+public:
+  using key_type       = K;
+  using value_type     = K;
+  using allocator_type = AllocatorT;
+
+private:
+  using Utils = _RHLIBH FlatUtils;
+
+  static constexpr bool COMPARES_VIEWS = is_same_type<CompareT, Less> && requires { typename K::view_type; };
+
+  // stateless comparator takes no space
+  CompressedPair<CompareT, List<K, AllocatorT>> m_storage;
+
+public:
+  constexpr FlatSet() noexcept = default;
+
+  constexpr explicit FlatSet(CompareT const& compare, AllocatorT const& allocator = AllocatorT{}) noexcept
+    : m_storage(compare, List<K, AllocatorT>(allocator)) {}
+
+  constexpr explicit FlatSet(AllocatorT const& allocator) noexcept
+    requires (!is_same_type<CompareT, AllocatorT>)
+    : FlatSet(CompareT{}, allocator) {}
+
+  // Keys don't have to be sorted or unique
+  template <typename ListAllocatorT>
+  constexpr explicit FlatSet(List<K, ListAllocatorT> keys) : FlatSet() {
+    insertBatch(move(keys));
+  }
+
+public:
+  [[nodiscard]]
+  constexpr AllocatorT const& allocator() const noexcept {
+    return _keys().allocator();
+  }
+
+  // Sorted keys
+  [[nodiscard]]
+  constexpr List<K, AllocatorT> const& keys() const noexcept {
+    return _keys();
+  }
+
+  [[nodiscard]]
+  constexpr K const* begin() const noexcept {
+    return _keys().begin();
+  }
+
+  [[nodiscard]]
+  constexpr K const* end() const noexcept {
+    return _keys().end();
+  }
+
+  [[nodiscard]]
+  constexpr bool isEmpty() const noexcept {
+    return _keys().isEmpty();
+  }
+
+  [[nodiscard]]
+  constexpr size_t length() const noexcept {
+    return _keys().length();
+  }
+
+  constexpr void reserve(size_t count) {
+    _keys().reserve(count);
+  }
+
+  [[nodiscard]]
+  constexpr size_t capacity() const noexcept {
+    return _keys().capacity();
+  }
+
+  constexpr void shrinkToFit() {
+    _keys().shrinkToFit();
+  }
+
+  constexpr void clear() noexcept {
+    _keys().clear();
+  }
+
+  // nullptr if there's no such key
+  template <typename LookupT>
+  [[nodiscard]]
+  constexpr K const* find(LookupT const& key) const {
+    size_t index = _lowerIndex(key);
+
+    if (index < length() && !_less(key, _keys()[index]))
+      return &_keys()[index];
+
+    return nullptr;
+  }
+
+  template <typename LookupT>
+  [[nodiscard]]
+  constexpr bool contains(LookupT const& key) const {
+    return find(key) != nullptr;
+  }
+
+  // The first key not less than the given one
+  template <typename LookupT>
+  [[nodiscard]]
+  constexpr K const* lowerBound(LookupT const& key) const {
+    return begin() + _lowerIndex(key);
+  }
+
+  // The first key greater than the given one
+  template <typename LookupT>
+  [[nodiscard]]
+  constexpr K const* upperBound(LookupT const& key) const {
+    size_t index = _lowerIndex(key);
+
+    if (index < length() && !_less(key, _keys()[index]))
+      ++index;
+
+    return begin() + index;
+  }
+
+  // Returns whether key was inserted
+  template <typename KeyT>
+  constexpr bool insert(KeyT&& key) {
+    size_t index = _lowerIndex(key);
+
+    if (index < length() && !_less(key, _keys()[index]))
+      return false;
+
+    _keys().emplace(static_cast<ssize_t>(index), forward<KeyT>(key));
+    return true;
+  }
+
+  // Like insert() for each key, but sorts them and merges with existing ones at once
+  template <typename ListAllocatorT>
+  constexpr void insertBatch(List<K, ListAllocatorT> keys) {
+    stableSort(keys, [this](K const& left, K const& right) {
+      return _less(left, right);
+    });
+
+    List<K, AllocatorT> merged(allocator());
+    merged.reserve(length() + keys.length());
+
+    size_t old = 0;
+
+    for (K& key : keys) {
+      for (; old < length() && _less(_keys()[old], key); ++old)
+        merged.append(move(_keys()[old]));
+
+      if (old < length() && !_less(key, _keys()[old]))
+        continue;
+
+      if (!merged.isEmpty() && !_less(merged[merged.length() - 1], key))
+        continue;
+
+      merged.append(move(key));
+    }
+
+    for (; old < length(); ++old)
+      merged.append(move(_keys()[old]));
+
+    _keys() = move(merged);
+  }
+
+  // Returns whether there was such key
+  template <typename LookupT>
+  constexpr bool erase(LookupT const& key) {
+    size_t index = _lowerIndex(key);
+
+    if (index >= length() || _less(key, _keys()[index]))
+      return false;
+
+    _keys().erase(static_cast<ssize_t>(index));
+    return true;
+  }
+
+private:
+  [[nodiscard]]
+  constexpr List<K, AllocatorT>& _keys() noexcept {
+    return m_storage.getSecond();
+  }
+
+  [[nodiscard]]
+  constexpr List<K, AllocatorT> const& _keys() const noexcept {
+    return m_storage.getSecond();
+  }
+
+  template <typename LookupT>
+  [[nodiscard]]
+  static constexpr decltype(auto) _normalize(LookupT const& key) {
+    if constexpr (COMPARES_VIEWS)
+      return typename K::view_type{key};
+    else
+      return key;
+  }
+
+  template <typename LeftT, typename RightT>
+  [[nodiscard]]
+  constexpr bool _less(LeftT const& left, RightT const& right) const {
+    return m_storage.getFirst()(_normalize(left), _normalize(right));
+  }
+
+  template <typename LookupT>
+  [[nodiscard]]
+  constexpr size_t _lowerIndex(LookupT const& key) const {
+    auto const& lookup = _normalize(key);
+
+    return Utils::lowerIndex(_keys().data(), length(), lookup, [this](K const& left, auto const& right) {
+      return m_storage.getFirst()(_normalize(left), right);
+    });
+  }
+};
+
+template <typename K, typename V, typename CompareT, typename AllocatorT>
+static constexpr bool is_trivially_relocatable<FlatMap<K, V, CompareT, AllocatorT>> =
+  is_trivially_relocatable<CompareT> && is_trivially_relocatable<AllocatorT>;
+
+template <typename K, typename CompareT, typename AllocatorT>
+static constexpr bool is_trivially_relocatable<FlatSet<K, CompareT, AllocatorT>> =
+  is_trivially_relocatable<CompareT> && is_trivially_relocatable<AllocatorT>;
+
+_RHLIB_END
@@ -0,0 +1,814 @@
+#pragma once
+#define _RHLIB_INCLUDED_HASHMAP
+
+#include <rh.hpp>
+
+#include <rh/Allocator.hpp>
+#include <rh/List.hpp>
+#include <rh/Pair.hpp>
+#include <rh/TypeTraits.hpp>
+#include <rh/exceptions.hpp>
+#include <rh/hash.hpp>
+#include <rh/simd.hpp>
+
+_RHLIB_BEGIN
+
+// String-like keys are looked up through their views: without temporary strings,
+//  and with literals too. Hasher of the view must give the same hash as Hasher of the key
+template <typename KeyT, typename LookupT>
+concept ViewLookup = requires(LookupT const& key) {
+  typename KeyT::view_type;
+  { key } -> ConvertibleTo<typename KeyT::view_type>;
+};
+
+_RHLIB_HIDDEN_BEGIN
+
+// Control byte of every slot: EMPTY, DELETED, or 7 low bits of hash of the entry in it
+struct HashControl {
+  static constexpr int8_t EMPTY   = -128;
+  static constexpr int8_t DELETED = -2;
+
+  [[nodiscard]]
+  static constexpr bool isFull(int8_t control) noexcept {
+    return control >= 0;
+  }
+};
+
+// Control bytes of 16 slots, which are compared at once.
+// Masks have one bit per slot
+class HashGroup {
+public:
+  static constexpr size_t SIZE = 16;
+
+private:
+#if _RHLIB_SIMD_SSE2
+  __m128i m_controls;
+
+public:
+  // controls must be aligned by SIZE
+  inline explicit HashGroup(const int8_t* controls) noexcept
+    : m_controls(_mm_load_si128(reinterpret_cast<const __m128i*>(controls))) {}
+
+  [[nodiscard]]
+  inline uint32_t match(int8_t control) const noexcept {
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(m_controls, _mm_set1_epi8(control))));
+  }
+
+  // EMPTY and DELETED are the only negative controls, so their sign bits are the mask
+  [[nodiscard]]
+  inline uint32_t matchFree() const noexcept {
+    return static_cast<uint32_t>(_mm_movemask_epi8(m_controls));
+  }
+#else
+  const int8_t* m_controls;
+
+public:
+  constexpr explicit HashGroup(const int8_t* controls) noexcept
+    : m_controls(controls) {}
+
+  [[nodiscard]]
+  constexpr uint32_t match(int8_t control) const noexcept {
+    uint32_t mask = 0;
+
+    for (uint32_t index = 0; index < SIZE; ++index)
+      mask |= static_cast<uint32_t>(m_controls[index] == control) << index;
+
+    return mask;
+  }
+
+  [[nodiscard]]
+  constexpr uint32_t matchFree() const noexcept {
+    uint32_t mask = 0;
+
+    for (uint32_t index = 0; index < SIZE; ++index)
+      mask |= static_cast<uint32_t>(!HashControl::isFull(m_controls[index])) << index;
+
+    return mask;
+  }
+#endif
+
+  [[nodiscard]]
+  inline uint32_t matchEmpty() const noexcept {
+    return match(HashControl::EMPTY);
+  }
+};
+
+// Open addressing table, shared by HashMap and HashSet (Swiss table layout).
+// Slots are split into aligned groups of 16, and a probe checks the whole group
+//  with one vector comparison of control bytes. Probing visits groups in triangular
+//  order and stops at a group with an EMPTY slot, so erased slots become DELETED,
+//  unless their group has never been full.
+// Entries and control bytes share one allocation. KeyOfT::get() extracts a key from entry
+template <typename KeyT, typename EntryT, typename KeyOfT, Allocator AllocatorT>
+class HashTable {
+public:
+  static constexpr size_t MIN_CAPACITY = HashGroup::SIZE;
+
+private:
+  using Utils = ListUtils;
+
+  static constexpr size_t ALIGNMENT = alignof(EntryT) > HashGroup::SIZE ? alignof(EntryT) : HashGroup::SIZE;
+
+  struct Storage {
+    int8_t* controls   = nullptr;
+    EntryT* entries    = nullptr;
+    size_t  capacity   = 0;
+    size_t  count      = 0;
+    size_t  growthLeft = 0; // EMPTY slots, which can be filled before load factor is exceeded
+  };
+
+  // stateless allocator takes no space
+  CompressedPair<AllocatorT, Storage> m_storage;
+
+public:
+  template <bool IsConst>
+  class Iterator {
+  private:
+    using EntryPointer = conditional<IsConst, EntryT const*, EntryT*>;
+
+    const int8_t* m_control = nullptr;
+    const int8_t* m_end     = nullptr;
+    EntryPointer  m_entry   = nullptr;
+
+  public:
+    constexpr Iterator() noexcept = default;
+
+    constexpr Iterator(const int8_t* control, const int8_t* end, EntryPointer entry) noexcept
+      : m_control(control), m_end(end), m_entry(entry)
+    {
+      _skipFree();
+    }
+
+  public:
+    [[nodiscard]]
+    constexpr auto& operator*() const noexcept {
+      return *m_entry;
+    }
+
+    [[nodiscard]]
+    constexpr EntryPointer operator->() const noexcept {
+      return m_entry;
+    }
+
+    constexpr Iterator& operator++() noexcept {
+      ++m_control;
+      ++m_entry;
+      _skipFree();
+      return *this;
+    }
+
+    [[nodiscard]]
+    constexpr bool operator==(Iterator const& other) const noexcept {
+      return m_control == other.m_control;
+    }
+
+  private:
+    constexpr void _skipFree() noexcept {
+      while (m_control != m_end && !HashControl::isFull(*m_control)) {
+        ++m_control;
+        ++m_entry;
+      }
+    }
+  };
+
+public:
+  constexpr HashTable() noexcept = default;
+
+  constexpr explicit HashTable(AllocatorT const& allocator) noexcept
+    : m_storage(allocator, Storage{}) {}
+
+  constexpr HashTable(HashTable const& other)
+    : m_storage(other.m_storage.getFirst(), Storage{})
+  {
+    operator=(other);
+  }
+
+  constexpr HashTable(HashTable&& other) noexcept
+    : m_storage(move(other.m_storage.getFirst()), Storage{})
+  {
+    _stealOther(other);
+  }
+
+  constexpr HashTable& operator=(HashTable const& other) {
+    if (this == &other)
+      return *this;
+
+    clear();
+    reserve(other.length());
+
+    for (EntryT const& entry : other) {
+      uint64_t hash = _hashOf(entry);
+      size_t index = _prepareSlot(hash);
+
+      constructAt(&m_storage.entries[index], entry);
+      _occupy(index, hash);
+    }
+
+    return *this;
+  }
+
+  constexpr HashTable& operator=(HashTable&& other) noexcept {
+    if (this != &other) {
+      _release();
+      m_storage.getFirst() = move(other.m_storage.getFirst());
+      _stealOther(other);
+    }
+
+    return *this;
+  }
+
+  constexpr ~HashTable() {
+    _release();
+  }
+
+public:
+  [[nodiscard]]
+  constexpr AllocatorT const& allocator() const noexcept {
+    return m_storage.getFirst();
+  }
+
+  [[nodiscard]]
+  constexpr Iterator<false> begin() noexcept {
+    return { m_storage.controls, m_storage.controls + m_storage.capacity, m_storage.entries };
+  }
+
+  [[nodiscard]]
+  constexpr Iterator<true> begin() const noexcept {
+    return { m_storage.controls, m_storage.controls + m_storage.capacity, m_storage.entries };
+  }
+
+  [[nodiscard]]
+  constexpr Iterator<false> end() noexcept {
+    return { m_storage.controls + m_storage.capacity, m_storage.controls + m_storage.capacity, m_storage.entries + m_storage.capacity };
+  }
+
+  [[nodiscard]]
+  constexpr Iterator<true> end() const noexcept {
+    return { m_storage.controls + m_storage.capacity, m_storage.controls + m_storage.capacity, m_storage.entries + m_storage.capacity };
+  }
+
+  [[nodiscard]]
+  constexpr bool isEmpty() const noexcept {
+    return m_storage.count == 0;
+  }
+
+  [[nodiscard]]
+  constexpr size_t length() const noexcept {
+    return m_storage.count;
+  }
+
+  // Count of slots. Table grows, when 7/8 of them are used
+  [[nodiscard]]
+  constexpr size_t capacity() const noexcept {
+    return m_storage.capacity;
+  }
+
+  // Makes space for count entries without further growth
+  constexpr void reserve(size_t count) {
+    if (count > _maxLoad(m_storage.capacity))
+      _resize(_capacityFor(count));
+  }
+
+  // Rebuilds table for max(count, length()) entries, dropping all DELETED slots.
+  // rehash(0) shrinks table to fit
+  constexpr void rehash(size_t count) {
+    if (count < m_storage.count)
+      count = m_storage.count;
+
+    if (count == 0) {
+      _release();
+      return;
+    }
+
+    _resize(_capacityFor(count));
+  }
+
+  constexpr void clear() noexcept {
+    _destructEntries();
+
+    if (m_storage.capacity != 0)
+      __builtin_memset(m_storage.controls, HashControl::EMPTY, m_storage.capacity);
+
+    m_storage.count = 0;
+    m_storage.growthLeft = _maxLoad(m_storage.capacity);
+  }
+
+  template <typename LookupT>
+  [[nodiscard]]
+  constexpr EntryT* find(LookupT const& key) const {
+    if (m_storage.count == 0)
+      return nullptr;
+
+    auto const& lookup = _normalize(key);
+    ssize_t index = _findIndex(lookup, _hash(lookup));
+
+    return index < 0 ? nullptr : &m_storage.entries[index];
+  }
+
+  // Calls construct(EntryT* raw_memory) only if there's no entry with this key yet.
+  // Returns the entry and whether it's new
+  template <typename LookupT, typename ConstructT>
+  constexpr Pair<EntryT*, bool> findOrConstruct(LookupT const& key, ConstructT&& construct) {
+    auto const& lookup = _normalize(key);
+    uint64_t hash = _hash(lookup);
+
+    if (m_storage.count != 0) {
+      ssize_t index = _findIndex(lookup, hash);
+
+      if (index >= 0)
+        return { &m_storage.entries[index], false };
+    }
+
+    size_t index = _prepareSlot(hash);
+    construct(&m_storage.entries[index]);
+    _occupy(index, hash);
+
+    return { &m_storage.entries[index], true };
+  }
+
+  template <typename LookupT>
+  constexpr bool erase(LookupT const& key) {
+    if (m_storage.count == 0)
+      return false;
+
+    auto const& lookup = _normalize(key);
+    ssize_t index = _findIndex(lookup, _hash(lookup));
+
+    if (index < 0)
+      return false;
+
+    destructAt(&m_storage.entries[index]);
+
+    // probes never went past a group, which has an EMPTY slot
+    size_t group = static_cast<size_t>(index) & ~(HashGroup::SIZE - 1);
+
+    if (HashGroup{m_storage.controls + group}.matchEmpty() != 0) {
+      m_storage.controls[index] = HashControl::EMPTY;
+      ++m_storage.growthLeft;
+    }
+    else
+      m_storage.controls[index] = HashControl::DELETED;
+
+    --m_storage.count;
+    return true;
+  }
+
+private:
+  // Views for string-like keys, keys themselves otherwise
+  template <typename LookupT>
+  [[nodiscard]]
+  static constexpr decltype(auto) _normalize(LookupT const& key) {
+    if constexpr (is_same_type<LookupT, KeyT>)
+      return key;
+    else if constexpr (ViewLookup<KeyT, LookupT>)
+      return typename KeyT::view_type{key};
+    else
+      return KeyT(key);
+  }
+
+  template <typename LookupT>
+  [[nodiscard]]
+  static constexpr uint64_t _hash(LookupT const& key) noexcept {
+    return Hasher<LookupT>{}(key);
+  }
+
+  [[nodiscard]]
+  static constexpr uint64_t _hashOf(EntryT const& entry) noexcept {
+    return _hash(KeyOfT::get(entry));
+  }
+
+  [[nodiscard]]
+  static constexpr int8_t _controlOf(uint64_t hash) noexcept {
+    return static_cast<int8_t>(hash & 0x7F);
+  }
+
+  [[nodiscard]]
+  static constexpr size_t _maxLoad(size_t capacity) noexcept {
+    return capacity - capacity / 8;
+  }
+
+  [[nodiscard]]
+  static constexpr size_t _capacityFor(size_t count) noexcept {
+    size_t capacity = roundUpToPowerOfTwo(count + count / 7 + 1);
+
+    if (capacity < MIN_CAPACITY)
+      capacity = MIN_CAPACITY;
+
+    while (_maxLoad(capacity) < count)
+      capacity *= 2;
+
+    return capacity;
+  }
+
+  // Visits groups in triangular order, which covers all of them when count of groups is a power of two
+  class ProbeSequence {
+  private:
+    size_t m_group;
+    size_t m_step = 0;
+    size_t m_mask;
+
+  public:
+    constexpr ProbeSequence(uint64_t hash, size_t capacity) noexcept
+      : m_group(static_cast<size_t>(hash >> 7)), m_mask(capacity / HashGroup::SIZE - 1)
+    {
+      m_group &= m_mask;
+    }
+
+    [[nodiscard]]
+    constexpr size_t offset() const noexcept {
+      return m_group * HashGroup::SIZE;
+    }
+
+    constexpr void next() noexcept {
+      ++m_step;
+      m_group = (m_group + m_step) & m_mask;
+    }
+  };
+
+  // Table must have a capacity
+  template <typename LookupT>
+  [[nodiscard]]
+  constexpr ssize_t _findIndex(LookupT const& lookup, uint64_t hash) const noexcept {
+    int8_t control = _controlOf(hash);
+
+    for (ProbeSequence probe(hash, m_storage.capacity);; probe.next()) {
+      HashGroup group(m_storage.controls + probe.offset());
+
+      for (uint32_t mask = group.match(control); mask != 0; mask &= mask - 1) {
+        size_t index = probe.offset() + countTrailingZeros(mask);
+
+        if (KeyOfT::get(m_storage.entries[index]) == lookup)
+          return static_cast<ssize_t>(index);
+      }
+
+      if (group.matchEmpty() != 0)
+        return -1;
+    }
+  }
+
+  // Table must have a capacity
+  [[nodiscard]]
+  constexpr size_t _findFree(uint64_t hash) const noexcept {
+    for (ProbeSequence probe(hash, m_storage.capacity);; probe.next()) {
+      uint32_t mask = HashGroup{m_storage.controls + probe.offset()}.matchFree();
+
+      if (mask != 0)
+        return probe.offset() + countTrailingZeros(mask);
+    }
+  }
+
+  // Finds a free slot for a new entry, growing the table if needed
+  constexpr size_t _prepareSlot(uint64_t hash) {
+    if (m_storage.capacity == 0)
+      _resize(MIN_CAPACITY);
+
+    size_t index = _findFree(hash);
+
+    if (m_storage.growthLeft == 0 && m_storage.controls[index] == HashControl::EMPTY) {
+      // table full of DELETED slots is cleaned up without growth
+      bool is_crowded = (m_storage.count + 1) * 32 > m_storage.capacity * 25;
+
+      _resize(is_crowded ? m_storage.capacity * 2 : m_storage.capacity);
+      index = _findFree(hash);
+    }
+
+    return index;
+  }
+
+  // Marks slot with constructed entry as full
+  constexpr void _occupy(size_t index, uint64_t hash) noexcept {
+    if (m_storage.controls[index] == HashControl::EMPTY)
+      --m_storage.growthLeft;
+
+    m_storage.controls[index] = _controlOf(hash);
+    ++m_storage.count;
+  }
+
+  constexpr void _resize(size_t new_capacity) {
+    Storage prev = m_storage.getSecond();
+
+    size_t entries_offset = (new_capacity + alignof(EntryT) - 1) & ~(alignof(EntryT) - 1);
+    auto buffer = static_cast<uint8_t*>(m_storage.getFirst().allocate(entries_offset + new_capacity * sizeof(EntryT), ALIGNMENT));
+
+    m_storage.controls = reinterpret_cast<int8_t*>(buffer);
+    m_storage.entries = reinterpret_cast<EntryT*>(buffer + entries_offset);
+    m_storage.capacity = new_capacity;
+    m_storage.growthLeft = _maxLoad(new_capacity) - prev.count;
+
+    __builtin_memset(m_storage.controls, HashControl::EMPTY, new_capacity);
+
+    for (size_t index = 0; index < prev.capacity; ++index) {
+      if (!HashControl::isFull(prev.controls[index]))
+        continue;
+
+      uint64_t hash = _hashOf(prev.entries[index]);
+      size_t new_index = _findFree(hash);
+
+      Utils::relocate(&m_storage.entries[new_index], &prev.entries[index], 1);
+      m_storage.controls[new_index] = _controlOf(hash);
+    }
+
+    if (prev.capacity != 0)
+      _freeBuffer(prev);
+  }
+
+  constexpr void _destructEntries() noexcept {
+    if constexpr (!is_trivially_destructible<EntryT>) {
+      for (size_t index = 0; index < m_storage.capacity; ++index) {
+        if (HashControl::isFull(m_storage.controls[index]))
+          destructAt(&m_storage.entries[index]);
+      }
+    }
+  }
+
+  constexpr void _freeBuffer(Storage const& storage) noexcept {
+    size_t entries_offset = reinterpret_cast<uint8_t*>(storage.entries) - reinterpret_cast<uint8_t*>(storage.controls);
+    m_storage.getFirst().deallocate(storage.controls, entries_offset + storage.capacity * sizeof(EntryT), ALIGNMENT);
+  }
+
+  // Destroys entries and frees the buffer, table becomes empty without capacity
+  constexpr void _release() noexcept {
+    _destructEntries();
+
+    if (m_storage.capacity != 0)
+      _freeBuffer(m_storage.getSecond());
+
+    m_storage.getSecond() = Storage{};
+  }
+
+  // This table must be released
+  constexpr void _stealOther(HashTable& other) noexcept {
+    m_storage.getSecond() = other.m_storage.getSecond();
+    other.m_storage.getSecond() = Storage{};
+  }
+};
+
+template <typename KeyT, typename ValueT>
+struct HashMapKeyOf {
+  [[nodiscard]]
+  static constexpr KeyT const& get(Pair<KeyT, ValueT> const& entry) noexcept {
+    return entry.first;
+  }
+};
+
+template <typename KeyT>
+struct HashSetKeyOf {
+  [[nodiscard]]
+  static constexpr KeyT const& get(KeyT const& entry) noexcept {
+    return entry;
+  }
+};
+
+_RHLIB_HIDDEN_END
+
+// Unordered map with entries stored inline in one flat array, see _Hidden::HashTable.
+// Keys are hashed with Hasher<K>, specialize it (or add "hash()" member) for own types.
+// Insertion and rehash invalidate pointers to entries. Keys must not be changed through iteration
+template <typename K, typename V, Allocator AllocatorT = DefaultAllocator>
+class HashMap {
+public:
+  using key_type       = K;
+  using value_type     = V;
+  using entry_type     = Pair<K, V>;
+  using allocator_type = AllocatorT;
+
+private:
+  using Table = _RHLIBH HashTable<K, Pair<K, V>, _RHLIBH HashMapKeyOf<K, V>, AllocatorT>;
+
+  Table m_table;
+
+public:
+  constexpr HashMap() noexcept = default;
+
+  constexpr explicit HashMap(AllocatorT const& allocator) noexcept
+    : m_table(allocator) {}
+
+public:
+  [[nodiscard]]
+  constexpr AllocatorT const& allocator() const noexcept {
+    return m_table.allocator();
+  }
+
+  [[nodiscard]]
+  constexpr auto begin() noexcept {
+    return m_table.begin();
+  }
+
+  [[nodiscard]]
+  constexpr auto begin() const noexcept {
+    return m_table.begin();
+  }
+
+  [[nodiscard]]
+  constexpr auto end() noexcept {
+    return m_table.end();
+  }
+
+  [[nodiscard]]
+  constexpr auto end() const noexcept {
+    return m_table.end();
+  }
+
+  [[nodiscard]]
+  constexpr bool isEmpty() const noexcept {
+    return m_table.isEmpty();
+  }
+
+  [[nodiscard]]
+  constexpr size_t length() const noexcept {
+    return m_table.length();
+  }
+
+  [[nodiscard]]
+  constexpr size_t capacity() const noexcept {
+    return m_table.capacity();
+  }
+
+  constexpr void reserve(size_t count) {
+    m_table.reserve(count);
+  }
+
+  constexpr void rehash(size_t count) {
+    m_table.rehash(count);
+  }
+
+  constexpr void clear() noexcept {
+    m_table.clear();
+  }
+
+  // nullptr if there's no such key
+  template <typename LookupT>
+  [[nodiscard]]
+  constexpr V* find(LookupT const& key) {
+    Pair<K, V>* entry = m_table.find(key);
+    return entry ? &entry->second : nullptr;
+  }
+
+  template <typename LookupT>
+  [[nodiscard]]
+  constexpr V const* find(LookupT const& key) const {
+    Pair<K, V> const* entry = m_table.find(key);
+    return entry ? &entry->second : nullptr;
+  }
+
+  template <typename LookupT>
+  [[nodiscard]]
+  constexpr bool contains(LookupT const& key) const {
+    return m_table.find(key) != nullptr;
+  }
+
+  template <typename LookupT>
+  [[nodiscard]]
+  constexpr V& at(LookupT const& key) {
+    if (V* value = find(key))
+      return *value;
+
+    throw KeyError(U"key not found in HashMap::at()");
+  }
+
+  template <typename LookupT>
+  [[nodiscard]]
+  constexpr V const& at(LookupT const& key) const {
+    if (V const* value = find(key))
+      return *value;
+
+    throw KeyError(U"key not found in HashMap::at()");
+  }
+
+  // Value is default-constructed if there's no such key
+  template <typename KeyT>
+  constexpr V& operator[](KeyT&& key) {
+    return *emplace(forward<KeyT>(key)).first;
+  }
+
+  // Constructs value from args only if there's no such key yet.
+  // Returns the value and whether it's new
+  template <typename KeyT, typename... ArgsT>
+  constexpr Pair<V*, bool> emplace(KeyT&& key, ArgsT&&... args) {
+    auto [entry, is_new] = m_table.findOrConstruct(key, [&](Pair<K, V>* memory) {
+      constructAt(memory, K(forward<KeyT>(key)), V(forward<ArgsT>(args)...));
+    });
+
+    return { &entry->second, is_new };
+  }
+
+  // Doesn't replace existing value, returns whether value was inserted
+  template <typename KeyT, typename ValueT>
+  constexpr bool insert(KeyT&& key, ValueT&& value) {
+    return emplace(forward<KeyT>(key), forward<ValueT>(value)).second;
+  }
+
+  // Inserts or replaces value
+  template <typename KeyT, typename ValueT>
+  constexpr void set(KeyT&& key, ValueT&& value) {
+    auto [existing, is_new] = emplace(forward<KeyT>(key), forward<ValueT>(value));
+
+    if (!is_new)
+      *existing = forward<ValueT>(value);
+  }
+
+  // Returns whether there was such key
+  template <typename LookupT>
+  constexpr bool erase(LookupT const& key) {
+    return m_table.erase(key);
+  }
+};
+
+// Unordered set, built just like HashMap
+template <typename K, Allocator AllocatorT = DefaultAllocator>
+class HashSet {
+public:
+  using key_type       = K;
+  using value_type     = K;
+  using allocator_type = AllocatorT;
+
+private:
+  using Table = _RHLIBH HashTable<K, K, _RHLIBH HashSetKeyOf<K>, AllocatorT>;
+
+  Table m_table;
+
+public:
+  constexpr HashSet() noexcept = default;
+
+  constexpr explicit HashSet(AllocatorT const& allocator) noexcept
+    : m_table(allocator) {}
+
+public:
+  [[nodiscard]]
+  constexpr AllocatorT const& allocator() const noexcept {
+    return m_table.allocator();
+  }
+
+  // Keys are never changed through iteration
+  [[nodiscard]]
+  constexpr auto begin() const noexcept {
+    return m_table.begin();
+  }
+
+  [[nodiscard]]
+  constexpr auto end() const noexcept {
+    return m_table.end();
+  }
+
+  [[nodiscard]]
+  constexpr bool isEmpty() const noexcept {
+    return m_table.isEmpty();
+  }
+
+  [[nodiscard]]
+  constexpr size_t length() const noexcept {
+    return m_table.length();
+  }
+
+  [[nodiscard]]
+  constexpr size_t capacity() const noexcept {
+    return m_table.capacity();
+  }
+
+  constexpr void reserve(size_t count) {
+    m_table.reserve(count);
+  }
+
+  constexpr void rehash(size_t count) {
+    m_table.rehash(count);
+  }
+
+  constexpr void clear() noexcept {
+    m_table.clear();
+  }
+
+  // nullptr if there's no such key
+  template <typename LookupT>
+  [[nodiscard]]
+  constexpr K const* find(LookupT const& key) const {
+    return m_table.find(key);
+  }
+
+  template <typename LookupT>
+  [[nodiscard]]
+  constexpr bool contains(LookupT const& key) const {
+    return m_table.find(key) != nullptr;
+  }
+
+  // Returns whether key was inserted
+  template <typename KeyT>
+  constexpr bool insert(KeyT&& key) {
+    return m_table.findOrConstruct(key, [&](K* memory) {
+      constructAt(memory, forward<KeyT>(key));
+    }).second;
+  }
+
+  // Returns whether there was such key
+  template <typename LookupT>
+  constexpr bool erase(LookupT const& key) {
+    return m_table.erase(key);
+  }
+};
+
+template <typename K, typename V, typename AllocatorT>
+static constexpr bool is_trivially_relocatable<HashMap<K, V, AllocatorT>> = is_trivially_relocatable<AllocatorT>;
+
+template <typename K, typename AllocatorT>
+static constexpr bool is_trivially_relocatable<HashSet<K, AllocatorT>> = is_trivially_relocatable<AllocatorT>;
+
+_RHLIB_END
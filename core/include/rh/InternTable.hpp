@@ -0,0 +1,208 @@
+#pragma once
+#define _RHLIB_INCLUDED_INTERNTABLE
+
+#include <rh.hpp>
+
+#include <rh/SpinLock.hpp>
+#include <rh/String.hpp>
+
+_RHLIB_BEGIN
+
+class InternTable;
+
+_RHLIB_HIDDEN_BEGIN
+
+// Interned string. Immutable after it's published, lives as long as the table
+struct AtomEntry {
+  uint64_t hash;
+  size_t   length;
+
+  // characters (with null-terminator) are stored right after the entry
+  [[nodiscard]]
+  inline const char32_t* characters() const noexcept {
+    return reinterpret_cast<const char32_t*>(this + 1);
+  }
+};
+
+_RHLIB_HIDDEN_END
+
+// Handle of an interned string. Equality and hashing are O(1),
+//  but atoms are comparable only if they came from the same table
+class Atom {
+public:
+  using type = Atom;
+
+private:
+  const _RHLIBH AtomEntry* m_entry = nullptr; // nullptr for empty string
+
+  friend class InternTable;
+
+  constexpr Atom(const _RHLIBH AtomEntry* entry) noexcept
+    : m_entry(entry) {}
+
+public:
+  constexpr Atom() noexcept = default;
+
+  // Interns string in InternTable::global()
+  explicit Atom(StringView string);
+
+public:
+  inline operator StringView() const noexcept {
+    return view();
+  }
+
+public:
+  [[nodiscard]]
+  inline StringView view() const noexcept {
+    return m_entry ? StringView{m_entry->characters(), m_entry->length} : StringView{};
+  }
+
+  [[nodiscard]]
+  inline const char32_t* data() const noexcept {
+    return view().data();
+  }
+
+  [[nodiscard]]
+  constexpr size_t length() const noexcept {
+    return m_entry ? m_entry->length : 0;
+  }
+
+  [[nodiscard]]
+  constexpr bool isEmpty() const noexcept {
+    return m_entry == nullptr;
+  }
+
+  [[nodiscard]]
+  constexpr uint64_t hash() const noexcept {
+    return m_entry ? m_entry->hash : 0;
+  }
+
+public:
+  [[nodiscard]]
+  constexpr bool operator==(Atom other) const noexcept {
+    return m_entry == other.m_entry;
+  }
+
+  [[nodiscard]]
+  constexpr bool operator!=(Atom other) const noexcept {
+    return m_entry != other.m_entry;
+  }
+};
+
+// Maps strings to stable atoms. Lookups of already interned strings are lock-free,
+//  insertions lock only one of SHARDS_COUNT shards.
+// Characters are stored in per-shard arenas, which are freed only with the table
+class InternTable {
+public:
+  using type = InternTable;
+
+  static constexpr size_t SHARDS_COUNT = 32;
+
+  // Approximate, if other threads are interning at the same time
+  struct Statistics {
+    size_t hits;
+    size_t misses;
+    size_t atoms;
+    size_t arenaBytes; // allocated for characters, including unused tails of blocks
+    size_t tableBytes; // allocated for hash tables, including retired ones
+  };
+
+public:
+  InternTable() noexcept = default;
+  ~InternTable() noexcept;
+
+  InternTable(InternTable const&) = delete;
+  InternTable& operator=(InternTable const&) = delete;
+
+public:
+  // Table used by Atom(StringView)
+  [[nodiscard]]
+  static InternTable& global() noexcept;
+
+  [[nodiscard]]
+  Atom intern(StringView string);
+
+  // Doesn't insert. Returns empty atom if string isn't interned
+  [[nodiscard]]
+  Atom find(StringView string) const noexcept;
+
+  [[nodiscard]]
+  Statistics statistics() const noexcept;
+
+private:
+  struct Slots {
+    _RHLIBH AtomEntry** entries;
+    size_t              mask;
+
+    // Readers may still use replaced tables, so they're freed only with the whole table
+    Slots*              previous;
+  };
+
+  struct ArenaBlock {
+    ArenaBlock* next;
+  };
+
+  // Counters are updated with atomics, because statistics() reads them without locking.
+  // They change only under the lock, so lock-free readers of slots aren't disturbed
+  struct alignas(64) Shard {
+    SpinLock    lock;
+    Slots*      slots      = nullptr;
+    size_t      count      = 0;
+
+    ArenaBlock* blocks     = nullptr;
+    byte*       current    = nullptr;
+    size_t      remaining  = 0;
+
+    size_t      misses     = 0;
+    size_t      arenaBytes = 0;
+    size_t      tableBytes = 0;
+  };
+
+  // Hits are counted apart from shards, each thread in its own cache line (unless there
+  //  are more threads than counters), so the lock-free path writes only there
+  struct alignas(64) HitCounter {
+    size_t hits = 0;
+  };
+
+  static constexpr size_t INITIAL_SLOTS_COUNT = 64;
+  static constexpr size_t ARENA_BLOCK_SIZE    = 64 * 1024;
+  static constexpr size_t SHARD_SHIFT         = 59;
+
+  static constexpr size_t HIT_COUNTERS_COUNT  = 16;
+
+  static_assert(SHARDS_COUNT == 1ull << (64 - SHARD_SHIFT), "Invalid SHARD_SHIFT");
+
+  Shard      m_shards[SHARDS_COUNT];
+  HitCounter m_hitCounters[HIT_COUNTERS_COUNT];
+
+private:
+  [[nodiscard]]
+  static uint64_t _hash(StringView string) noexcept;
+
+  [[nodiscard]]
+  static const _RHLIBH AtomEntry* _lookup(Shard const& shard, StringView string, uint64_t hash) noexcept;
+
+  // top bits of hash pick the shard, low bits pick the slot
+  [[nodiscard]]
+  inline Shard& _shardFor(uint64_t hash) noexcept {
+    return m_shards[hash >> SHARD_SHIFT];
+  }
+
+  [[nodiscard]]
+  inline Shard const& _shardFor(uint64_t hash) const noexcept {
+    return m_shards[hash >> SHARD_SHIFT];
+  }
+
+  void _countHit() noexcept;
+
+  static void _grow(Shard& shard);
+  static byte* _allocateInArena(Shard& shard, size_t size);
+};
+
+inline Atom::Atom(StringView string)
+  : Atom(InternTable::global().intern(string)) {}
+
+_RHLIB_END
+
+_RHLIB_GLOBAL_CLASS(Atom);
+_RHLIB_GLOBAL_CLASS(InternTable);
@@ -0,0 +1,371 @@
+#pragma once
+#define _RHLIB_INCLUDED_INTRUSIVEHASHTABLE
+
+#include <rh.hpp>
+
+#include <rh/Allocator.hpp>
+#include <rh/HashMap.hpp>
+#include <rh/IntrusiveList.hpp>
+#include <rh/Pair.hpp>
+#include <rh/TypeTraits.hpp>
+#include <rh/hash.hpp>
+#include <rh/simd.hpp>
+
+_RHLIB_BEGIN
+
+// Links of an object in IntrusiveHashTable, kept inside of the object together with
+//  the hash of its key. Copying a hook gives an unlinked one
+struct IntrusiveHashHook {
+  IntrusiveHashHook*  next = nullptr;
+  IntrusiveHashHook** link = nullptr; // pointer, which points to this hook
+  uint64_t            hash = 0;
+
+  constexpr IntrusiveHashHook() noexcept = default;
+
+  constexpr IntrusiveHashHook(IntrusiveHashHook const&) noexcept {}
+
+  constexpr IntrusiveHashHook& operator=(IntrusiveHashHook const&) noexcept {
+    return *this;
+  }
+
+  [[nodiscard]]
+  constexpr bool isLinked() const noexcept {
+    return link != nullptr;
+  }
+};
+
+// Hash table of objects, which embed their links as Hook member and are looked up by
+//  their Key member. Buckets are chains of hooks, every hook knows the pointer to itself,
+//  so any object is erased in O(1). Erase never allocates, insert only when the table
+//  grows, which reserve() does up front.
+// Table doesn't own objects: they must outlive their membership, and their keys must not
+//  change while they are in the table. T must be standard-layout, as for IntrusiveList
+template <typename T, IntrusiveHashHook T::*Hook, auto Key, Allocator AllocatorT = DefaultAllocator>
+class IntrusiveHashTable {
+public:
+  using value_type     = T;
+  using key_type       = typename _RHLIBH member_pointer_wrapper<decltype(Key)>::type;
+  using allocator_type = AllocatorT;
+
+  static_assert(is_same_type<typename _RHLIBH member_pointer_wrapper<decltype(Key)>::object_type, T>, "Key must be a member of T");
+
+private:
+  using Utils = _RHLIBH IntrusiveUtils;
+
+  static constexpr size_t MIN_BUCKETS = 8;
+
+  struct Storage {
+    IntrusiveHashHook** buckets     = nullptr;
+    size_t              bucketCount = 0; // power of two
+    size_t              count       = 0;
+  };
+
+  // stateless allocator takes no space
+  CompressedPair<AllocatorT, Storage> m_storage;
+
+public:
+  template <bool IsConst>
+  class Iterator {
+  private:
+    using ValueT = conditional<IsConst, T const, T>;
+
+    IntrusiveHashHook* const* m_bucket = nullptr;
+    IntrusiveHashHook* const* m_end    = nullptr;
+    IntrusiveHashHook*        m_hook   = nullptr;
+
+  public:
+    constexpr Iterator() noexcept = default;
+
+    constexpr Iterator(IntrusiveHashHook* const* bucket, IntrusiveHashHook* const* end) noexcept
+      : m_bucket(bucket), m_end(end)
+    {
+      _skipEmpty();
+    }
+
+  public:
+    [[nodiscard]]
+    constexpr ValueT& operator*() const noexcept {
+      return *Utils::ownerOf<Hook>(m_hook);
+    }
+
+    [[nodiscard]]
+    constexpr ValueT* operator->() const noexcept {
+      return Utils::ownerOf<Hook>(m_hook);
+    }
+
+    constexpr Iterator& operator++() noexcept {
+      m_hook = m_hook->next;
+
+      if (!m_hook) {
+        ++m_bucket;
+        _skipEmpty();
+      }
+
+      return *this;
+    }
+
+    [[nodiscard]]
+    constexpr bool operator==(Iterator const& other) const noexcept {
+      return m_hook == other.m_hook;
+    }
+
+  private:
+    constexpr void _skipEmpty() noexcept {
+      for (; m_bucket != m_end; ++m_bucket) {
+        if (*m_bucket) {
+          m_hook = *m_bucket;
+          return;
+        }
+      }
+
+      m_hook = nullptr;
+    }
+  };
+
+public:
+  constexpr IntrusiveHashTable() noexcept = default;
+
+  constexpr explicit IntrusiveHashTable(AllocatorT const& allocator) noexcept
+    : m_storage(allocator, Storage{}) {}
+
+  IntrusiveHashTable(IntrusiveHashTable const&) = delete;
+  IntrusiveHashTable& operator=(IntrusiveHashTable const&) = delete;
+
+  // First hook of every chain points into the buckets, which stay where they are
+  constexpr IntrusiveHashTable(IntrusiveHashTable&& other) noexcept
+    : m_storage(move(other.m_storage.getFirst()), Storage{})
+  {
+    _stealOther(other);
+  }
+
+  constexpr IntrusiveHashTable& operator=(IntrusiveHashTable&& other) noexcept {
+    if (this != &other) {
+      _release();
+      m_storage.getFirst() = move(other.m_storage.getFirst());
+      _stealOther(other);
+    }
+
+    return *this;
+  }
+
+  constexpr ~IntrusiveHashTable() {
+    _release();
+  }
+
+public:
+  [[nodiscard]]
+  constexpr AllocatorT const& allocator() const noexcept {
+    return m_storage.getFirst();
+  }
+
+  [[nodiscard]]
+  constexpr Iterator<false> begin() noexcept {
+    return { m_storage.buckets, m_storage.buckets + m_storage.bucketCount };
+  }
+
+  [[nodiscard]]
+  constexpr Iterator<true> begin() const noexcept {
+    return { m_storage.buckets, m_storage.buckets + m_storage.bucketCount };
+  }
+
+  [[nodiscard]]
+  constexpr Iterator<false> end() noexcept {
+    return {};
+  }
+
+  [[nodiscard]]
+  constexpr Iterator<true> end() const noexcept {
+    return {};
+  }
+
+  [[nodiscard]]
+  constexpr bool isEmpty() const noexcept {
+    return m_storage.count == 0;
+  }
+
+  [[nodiscard]]
+  constexpr size_t length() const noexcept {
+    return m_storage.count;
+  }
+
+  [[nodiscard]]
+  constexpr size_t bucketCount() const noexcept {
+    return m_storage.bucketCount;
+  }
+
+  // Inserts of up to count objects won't allocate
+  constexpr void reserve(size_t count) {
+    if (count > m_storage.bucketCount)
+      _rehash(_RHLIBH roundUpToPowerOfTwo(count));
+  }
+
+  // Returns false, if an object with the same key is already there.
+  // Object must not be in a table through Hook
+  constexpr bool insert(T& item) {
+    uint64_t hash = _hash(item.*Key);
+
+    if (_find(item.*Key, hash))
+      return false;
+
+    if (m_storage.count == m_storage.bucketCount)
+      _rehash(m_storage.bucketCount < MIN_BUCKETS ? MIN_BUCKETS : m_storage.bucketCount * 2);
+
+    IntrusiveHashHook* hook = &(item.*Hook);
+    hook->hash = hash;
+
+    _link(&m_storage.buckets[hash & (m_storage.bucketCount - 1)], hook);
+    ++m_storage.count;
+
+    return true;
+  }
+
+  template <typename LookupT>
+  [[nodiscard]]
+  constexpr T* find(LookupT const& key) const {
+    auto const& lookup = _normalize(key);
+    IntrusiveHashHook* hook = _find(lookup, _hash(lookup));
+
+    return hook ? Utils::ownerOf<Hook>(hook) : nullptr;
+  }
+
+  template <typename LookupT>
+  [[nodiscard]]
+  constexpr bool contains(LookupT const& key) const {
+    return find(key) != nullptr;
+  }
+
+  // Object must be in this table
+  constexpr void erase(T& item) noexcept {
+    _unlink(&(item.*Hook));
+    --m_storage.count;
+  }
+
+  // Unlinks and returns the object with key, or returns nullptr
+  template <typename LookupT>
+  constexpr T* extract(LookupT const& key) {
+    T* item = find(key);
+
+    if (item)
+      erase(*item);
+
+    return item;
+  }
+
+  // Unlinks all objects, keeps buckets
+  constexpr void clear() noexcept {
+    for (size_t i = 0; i < m_storage.bucketCount; ++i) {
+      for (IntrusiveHashHook* hook = m_storage.buckets[i]; hook;) {
+        IntrusiveHashHook* next = hook->next;
+
+        hook->next = nullptr;
+        hook->link = nullptr;
+        hook = next;
+      }
+
+      m_storage.buckets[i] = nullptr;
+    }
+
+    m_storage.count = 0;
+  }
+
+private:
+  // Views for string-like keys, keys themselves otherwise
+  template <typename LookupT>
+  [[nodiscard]]
+  static constexpr decltype(auto) _normalize(LookupT const& key) {
+    if constexpr (is_same_type<LookupT, key_type>)
+      return key;
+    else if constexpr (ViewLookup<key_type, LookupT>)
+      return typename key_type::view_type{key};
+    else
+      return key_type(key);
+  }
+
+  template <typename LookupT>
+  [[nodiscard]]
+  static constexpr uint64_t _hash(LookupT const& key) noexcept {
+    return Hasher<LookupT>{}(key);
+  }
+
+  template <typename LookupT>
+  [[nodiscard]]
+  constexpr IntrusiveHashHook* _find(LookupT const& lookup, uint64_t hash) const {
+    if (m_storage.count == 0)
+      return nullptr;
+
+    for (IntrusiveHashHook* hook = m_storage.buckets[hash & (m_storage.bucketCount - 1)]; hook; hook = hook->next) {
+      if (hook->hash == hash && Utils::ownerOf<Hook>(hook)->*Key == lookup)
+        return hook;
+    }
+
+    return nullptr;
+  }
+
+  static constexpr void _link(IntrusiveHashHook** bucket, IntrusiveHashHook* hook) noexcept {
+    hook->next = *bucket;
+    hook->link = bucket;
+
+    if (hook->next)
+      hook->next->link = &hook->next;
+
+    *bucket = hook;
+  }
+
+  static constexpr void _unlink(IntrusiveHashHook* hook) noexcept {
+    *hook->link = hook->next;
+
+    if (hook->next)
+      hook->next->link = hook->link;
+
+    hook->next = nullptr;
+    hook->link = nullptr;
+  }
+
+  // Hooks keep their hashes, so keys aren't hashed again
+  constexpr void _rehash(size_t bucket_count) {
+    auto** buckets = static_cast<IntrusiveHashHook**>(
+      m_storage.getFirst().allocate(bucket_count * sizeof(IntrusiveHashHook*), alignof(IntrusiveHashHook*))
+    );
+
+    for (size_t i = 0; i < bucket_count; ++i)
+      buckets[i] = nullptr;
+
+    for (size_t i = 0; i < m_storage.bucketCount; ++i) {
+      for (IntrusiveHashHook* hook = m_storage.buckets[i]; hook;) {
+        IntrusiveHashHook* next = hook->next;
+
+        _link(&buckets[hook->hash & (bucket_count - 1)], hook);
+        hook = next;
+      }
+    }
+
+    _freeBuckets();
+
+    m_storage.buckets = buckets;
+    m_storage.bucketCount = bucket_count;
+  }
+
+  constexpr void _freeBuckets() noexcept {
+    if (m_storage.buckets)
+      m_storage.getFirst().deallocate(m_storage.buckets, m_storage.bucketCount * sizeof(IntrusiveHashHook*), alignof(IntrusiveHashHook*));
+  }
+
+  constexpr void _release() noexcept {
+    clear();
+    _freeBuckets();
+
+    m_storage.buckets = nullptr;
+    m_storage.bucketCount = 0;
+  }
+
+  // This table must be empty and hold no buckets
+  constexpr void _stealOther(IntrusiveHashTable& other) noexcept {
+    m_storage.getSecond() = other.m_storage.getSecond();
+    other.m_storage.getSecond() = Storage{};
+  }
+};
+
+template <typename T, IntrusiveHashHook T::*Hook, auto Key, typename AllocatorT>
+static constexpr bool is_trivially_relocatable<IntrusiveHashTable<T, Hook, Key, AllocatorT>> = is_trivially_relocatable<AllocatorT>;
+
+_RHLIB_END
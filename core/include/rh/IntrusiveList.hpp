@@ -0,0 +1,286 @@
+#pragma once
+#define _RHLIB_INCLUDED_INTRUSIVELIST
+
+#include <rh.hpp>
+
+#include <rh/TypeTraits.hpp>
+
+_RHLIB_BEGIN
+
+_RHLIB_HIDDEN_BEGIN
+
+template <typename>
+struct member_pointer_wrapper;
+
+template <typename T, typename M>
+struct member_pointer_wrapper<M T::*> {
+  using object_type = T;
+  using type        = M;
+};
+
+struct IntrusiveUtils {
+  // Offset of a data member, read from the member pointer itself: for standard-layout
+  //  types both Itanium and MSVC ABIs keep it as a plain offset. Computed once per member
+  template <auto Member>
+  static inline const size_t MEMBER_OFFSET = []() noexcept -> size_t {
+    if constexpr (sizeof(Member) == sizeof(uint32_t))
+      return __builtin_bit_cast(uint32_t, Member);
+    else
+      return static_cast<size_t>(__builtin_bit_cast(uint64_t, Member));
+  }();
+
+  // Object, which has hook as its Member
+  template <auto Member, typename HookT>
+  [[nodiscard]]
+  static inline typename member_pointer_wrapper<decltype(Member)>::object_type* ownerOf(HookT* hook) noexcept {
+    using T = typename member_pointer_wrapper<decltype(Member)>::object_type;
+    static_assert(__is_standard_layout(T), "intrusive containers need standard-layout objects");
+
+    return reinterpret_cast<T*>(reinterpret_cast<uint8_t*>(hook) - MEMBER_OFFSET<Member>);
+  }
+};
+
+_RHLIB_HIDDEN_END
+
+// Links of an object in IntrusiveList, kept inside of the object.
+// Copy of an object isn't linked anywhere, so copying a hook gives an unlinked one
+struct IntrusiveListHook {
+  IntrusiveListHook* previous = nullptr;
+  IntrusiveListHook* next     = nullptr;
+
+  constexpr IntrusiveListHook() noexcept = default;
+
+  constexpr IntrusiveListHook(IntrusiveListHook const&) noexcept {}
+
+  constexpr IntrusiveListHook& operator=(IntrusiveListHook const&) noexcept {
+    return *this;
+  }
+
+  [[nodiscard]]
+  constexpr bool isLinked() const noexcept {
+    return next != nullptr;
+  }
+};
+
+// Doubly linked list of objects, which embed their links as Hook member, so linking
+//  and unlinking never allocate and any object is unlinked in O(1). List doesn't own
+//  objects: they must outlive their membership and be erased before destruction.
+// Object can be in several lists at once through several hooks. T must be standard-layout,
+//  so the object is found from its hook by the offset of Hook
+template <typename T, IntrusiveListHook T::*Hook>
+class IntrusiveList {
+public:
+  using value_type = T;
+
+private:
+  using Utils = _RHLIBH IntrusiveUtils;
+
+  // first is m_head.next and last is m_head.previous, empty list links to itself
+  IntrusiveListHook m_head;
+  size_t            m_count = 0;
+
+public:
+  template <bool IsConst>
+  class Iterator {
+  private:
+    friend class IntrusiveList;
+
+    using ValueT = conditional<IsConst, T const, T>;
+
+    IntrusiveListHook* m_hook = nullptr;
+
+  public:
+    constexpr Iterator() noexcept = default;
+
+    constexpr explicit Iterator(IntrusiveListHook* hook) noexcept
+      : m_hook(hook) {}
+
+  public:
+    [[nodiscard]]
+    constexpr ValueT& operator*() const noexcept {
+      return *Utils::ownerOf<Hook>(m_hook);
+    }
+
+    [[nodiscard]]
+    constexpr ValueT* operator->() const noexcept {
+      return Utils::ownerOf<Hook>(m_hook);
+    }
+
+    constexpr Iterator& operator++() noexcept {
+      m_hook = m_hook->next;
+      return *this;
+    }
+
+    constexpr Iterator& operator--() noexcept {
+      m_hook = m_hook->previous;
+      return *this;
+    }
+
+    [[nodiscard]]
+    constexpr bool operator==(Iterator const& other) const noexcept {
+      return m_hook == other.m_hook;
+    }
+  };
+
+public:
+  constexpr IntrusiveList() noexcept {
+    m_head.previous = &m_head;
+    m_head.next = &m_head;
+  }
+
+  IntrusiveList(IntrusiveList const&) = delete;
+  IntrusiveList& operator=(IntrusiveList const&) = delete;
+
+  constexpr IntrusiveList(IntrusiveList&& other) noexcept : IntrusiveList() {
+    _stealOther(other);
+  }
+
+  constexpr IntrusiveList& operator=(IntrusiveList&& other) noexcept {
+    if (this != &other) {
+      clear();
+      _stealOther(other);
+    }
+
+    return *this;
+  }
+
+  constexpr ~IntrusiveList() {
+    clear();
+  }
+
+public:
+  [[nodiscard]]
+  constexpr Iterator<false> begin() noexcept {
+    return Iterator<false>(m_head.next);
+  }
+
+  [[nodiscard]]
+  constexpr Iterator<true> begin() const noexcept {
+    return Iterator<true>(m_head.next);
+  }
+
+  [[nodiscard]]
+  constexpr Iterator<false> end() noexcept {
+    return Iterator<false>(&m_head);
+  }
+
+  [[nodiscard]]
+  constexpr Iterator<true> end() const noexcept {
+    return Iterator<true>(const_cast<IntrusiveListHook*>(&m_head));
+  }
+
+  [[nodiscard]]
+  constexpr bool isEmpty() const noexcept {
+    return m_count == 0;
+  }
+
+  [[nodiscard]]
+  constexpr size_t length() const noexcept {
+    return m_count;
+  }
+
+  // List must not be empty
+  [[nodiscard]]
+  constexpr T& front() const noexcept {
+    return *Utils::ownerOf<Hook>(m_head.next);
+  }
+
+  [[nodiscard]]
+  constexpr T& back() const noexcept {
+    return *Utils::ownerOf<Hook>(m_head.previous);
+  }
+
+  // Item must not be in a list through Hook
+  constexpr void append(T& item) noexcept {
+    _linkBefore(&m_head, &(item.*Hook));
+  }
+
+  constexpr void prepend(T& item) noexcept {
+    _linkBefore(m_head.next, &(item.*Hook));
+  }
+
+  // Position must be in this list
+  constexpr void insertBefore(T& position, T& item) noexcept {
+    _linkBefore(&(position.*Hook), &(item.*Hook));
+  }
+
+  // Item must be in this list
+  constexpr void erase(T& item) noexcept {
+    _unlink(&(item.*Hook));
+  }
+
+  // For LRU order: item goes to the end, whether it's in the list or not
+  constexpr void moveToBack(T& item) noexcept {
+    if ((item.*Hook).isLinked())
+      _unlink(&(item.*Hook));
+
+    append(item);
+  }
+
+  // List must not be empty, returns the unlinked item
+  constexpr T& popFront() noexcept {
+    T& item = front();
+    _unlink(m_head.next);
+    return item;
+  }
+
+  constexpr T& popBack() noexcept {
+    T& item = back();
+    _unlink(m_head.previous);
+    return item;
+  }
+
+  // Unlinks all items
+  constexpr void clear() noexcept {
+    for (IntrusiveListHook* hook = m_head.next; hook != &m_head;) {
+      IntrusiveListHook* next = hook->next;
+
+      hook->previous = nullptr;
+      hook->next = nullptr;
+      hook = next;
+    }
+
+    m_head.previous = &m_head;
+    m_head.next = &m_head;
+    m_count = 0;
+  }
+
+private:
+  constexpr void _linkBefore(IntrusiveListHook* position, IntrusiveListHook* hook) noexcept {
+    hook->previous = position->previous;
+    hook->next = position;
+
+    position->previous->next = hook;
+    position->previous = hook;
+
+    ++m_count;
+  }
+
+  constexpr void _unlink(IntrusiveListHook* hook) noexcept {
+    hook->previous->next = hook->next;
+    hook->next->previous = hook->previous;
+
+    hook->previous = nullptr;
+    hook->next = nullptr;
+
+    --m_count;
+  }
+
+  // This list must be empty
+  constexpr void _stealOther(IntrusiveList& other) noexcept {
+    if (other.isEmpty())
+      return;
+
+    m_head.next = other.m_head.next;
+    m_head.previous = other.m_head.previous;
+    m_head.next->previous = &m_head;
+    m_head.previous->next = &m_head;
+    m_count = other.m_count;
+
+    other.m_head.previous = &other.m_head;
+    other.m_head.next = &other.m_head;
+    other.m_count = 0;
+  }
+};
+
+_RHLIB_END
@@ -3,103 +3,277 @@
 
 #include <rh.hpp>
 
+#include <memory>
+
+#include <rh/Allocator.hpp>
 #include <rh/InitList.hpp>
+#include <rh/Pair.hpp>
+#include <rh/TypeTraits.hpp>
 #include <rh/exceptions.hpp>
 
 _RHLIB_BEGIN
 
-template <typename T>
+_RHLIB_HIDDEN_BEGIN
+
+// Algorithms over raw storage, where only the first "length" items are constructed.
+// Trivially relocatable items are moved around with memcpy/memmove at runtime, and
+//  one by one in constant evaluation. Shared by List and SmallList
+struct ListUtils {
+  template <typename T>
+  static constexpr void destruct(T* items, size_t count) noexcept {
+    if constexpr (!is_trivially_destructible<T>) {
+      for (size_t i = 0; i < count; ++i)
+        destructAt(&items[i]);
+    }
+  }
+
+  // Moves items into raw memory, source becomes raw memory
+  template <typename T>
+  static constexpr void relocate(T* destination, T* source, size_t count) {
+    if constexpr (is_trivially_relocatable<T>) {
+      if !consteval {
+        if (count != 0)
+          __builtin_memcpy(static_cast<void*>(destination), static_cast<const void*>(source), count * sizeof(T));
+
+        return;
+      }
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+      constructAt(&destination[i], move(source[i]));
+      destructAt(&source[i]);
+    }
+  }
+
+  // Copies items into raw memory
+  template <typename T>
+  static constexpr void copy(T* destination, T const* source, size_t count) {
+    if constexpr (is_trivially_copyable<T>) {
+      if !consteval {
+        if (count != 0)
+          __builtin_memcpy(static_cast<void*>(destination), static_cast<const void*>(source), count * sizeof(T));
+
+        return;
+      }
+    }
+
+    for (size_t i = 0; i < count; ++i)
+      constructAt(&destination[i], source[i]);
+  }
+
+  // Opens a gap at index for one item, there must be space for length + 1 items.
+  // For relocatable items the gap is raw memory, otherwise it holds a moved-from item
+  template <typename T>
+  static constexpr void shiftForInsert(T* items, size_t length, size_t index) {
+    if constexpr (is_trivially_relocatable<T>) {
+      if !consteval {
+        __builtin_memmove(static_cast<void*>(items + index + 1), static_cast<const void*>(items + index), (length - index) * sizeof(T));
+        return;
+      }
+
+      for (size_t i = length; i > index; --i) {
+        constructAt(&items[i], move(items[i - 1]));
+        destructAt(&items[i - 1]);
+      }
+    }
+    else {
+      constructAt(&items[length], move(items[length - 1]));
+
+      for (size_t i = length - 1; i > index; --i)
+        items[i] = move(items[i - 1]);
+    }
+  }
+
+  // Puts value into the gap, opened by shiftForInsert()
+  template <typename T>
+  static constexpr void fillShifted(T* items, size_t index, T&& value) {
+    if constexpr (is_trivially_relocatable<T>)
+      constructAt(&items[index], move(value));
+    else
+      items[index] = move(value);
+  }
+
+  // Removes count items starting at first, range must be valid
+  template <typename T>
+  static constexpr void erase(T* items, size_t length, size_t first, size_t count) {
+    size_t tail = length - first - count;
+
+    if constexpr (is_trivially_relocatable<T>) {
+      destruct(items + first, count);
+
+      if !consteval {
+        if (tail != 0)
+          __builtin_memmove(static_cast<void*>(items + first), static_cast<const void*>(items + first + count), tail * sizeof(T));
+
+        return;
+      }
+
+      // tail doesn't overlap the raw gap it's relocated to, when it's done from the front
+      relocate(items + first, items + first + count, tail);
+    }
+    else {
+      for (size_t i = first; i < first + tail; ++i)
+        items[i] = move(items[i + count]);
+
+      destruct(items + first + tail, count);
+    }
+  }
+
+  // Negative index counts from the end, index equal to length is the end itself
+  static constexpr size_t checkInsertIndex(ssize_t index, size_t length, const char32_t* error) {
+    ssize_t signed_length = static_cast<ssize_t>(length);
+
+    if (index > signed_length || index < -signed_length)
+      throw IndexError(error);
+
+    return static_cast<size_t>(index < 0 ? index + signed_length : index);
+  }
+
+  // Returns position of the first erased item
+  static constexpr size_t checkEraseRange(ssize_t index, size_t count, size_t length, const char32_t* index_error, const char32_t* count_error) {
+    ssize_t signed_length = static_cast<ssize_t>(length);
+
+    if (index >= signed_length || index < -signed_length)
+      throw IndexError(index_error);
+
+    size_t first = static_cast<size_t>(index < 0 ? index + signed_length : index);
+
+    if (count > length - first)
+      throw IndexError(count_error);
+
+    return first;
+  }
+};
+
+_RHLIB_HIDDEN_END
+
+// Items live in raw storage: only the first length() slots are constructed.
+// Trivially relocatable items are moved around with memcpy/memmove, and their
+//  storage grows with reallocate(), which may extend it without copying at all.
+// Allocator travels with the items on move, copy assignment keeps own allocator
+template <typename T, Allocator AllocatorT = DefaultAllocator>
 class List {
 public:
-  using value_type = T;
+  using value_type     = T;
+  using allocator_type = AllocatorT;
 
 private:
-  T*     m_items     = nullptr;
-  size_t m_count     = 0;
-  size_t m_allocated = 0;
+  using Utils = _RHLIBH ListUtils;
+
+  static constexpr bool USES_REALLOC = is_trivially_relocatable<T> && ReallocatingAllocator<AllocatorT>;
+
+  struct Storage {
+    T*     items     = nullptr;
+    size_t count     = 0;
+    size_t allocated = 0;
+  };
+
+  // stateless allocator takes no space
+  CompressedPair<AllocatorT, Storage> m_storage;
 
 public:
   constexpr List() noexcept = default;
 
+  constexpr explicit List(AllocatorT const& allocator) noexcept
+    : m_storage(allocator, Storage{}) {}
+
   constexpr List(size_t preallocate) : List() {
     _reallocate(preallocate);
   }
 
   constexpr List(size_t count, T const& value = {}) : List() {
     _needAllocated(count);
-    
-    m_count = count;
+
+    m_storage.count = count;
     for (size_t i = 0; i < count; ++i)
-      constructAt(&m_items[i], value);
+      constructAt(&m_storage.items[i], value);
   }
 
   constexpr List(InitList<T> init) : List() {
     _initFromRange(init.begin(), init.end());
   }
 
-  constexpr List(List const& other) : List() {
+  constexpr List(List const& other)
+    : m_storage(other.m_storage.getFirst(), Storage{})
+  {
     operator=(other);
   }
 
-  constexpr List(List&& other) noexcept {
+  constexpr List(List&& other) noexcept
+    : m_storage(move(other.m_storage.getFirst()), Storage{})
+  {
     _stealOther(other);
   }
 
   constexpr List& operator=(List const& other) {
-    _initFromRange(other.begin(), other.end());
+    if (this != &other)
+      _initFromRange(other.begin(), other.end());
+
     return *this;
   }
 
   constexpr List& operator=(List&& other) noexcept {
-    List::~List();
-    _stealOther(other);
+    if (this != &other) {
+      List::~List();
+      m_storage.getFirst() = move(other.m_storage.getFirst());
+      _stealOther(other);
+    }
+
     return *this;
   }
 
   constexpr ~List() {
     clear();
-    _reallocate(0);
+    _freeItems(m_storage.items, m_storage.allocated);
+
+    m_storage.items = nullptr;
+    m_storage.allocated = 0;
   }
 
 public:
+  [[nodiscard]]
+  constexpr AllocatorT const& allocator() const noexcept {
+    return m_storage.getFirst();
+  }
+
   [[nodiscard]]
   constexpr T* data() noexcept {
-    return m_items;
+    return m_storage.items;
   }
 
   [[nodiscard]]
   constexpr const T* data() const noexcept {
-    return m_items;
+    return m_storage.items;
   }
 
   [[nodiscard]]
   constexpr T* begin() noexcept {
-    return m_items;
+    return m_storage.items;
   }
 
   [[nodiscard]]
   constexpr const T* begin() const noexcept {
-    return m_items;
+    return m_storage.items;
   }
 
   [[nodiscard]]
   constexpr T* end() noexcept {
-    return m_items + m_count;
+    return m_storage.items + m_storage.count;
   }
 
   [[nodiscard]]
   constexpr const T* end() const noexcept {
-    return m_items + m_count;
+    return m_storage.items + m_storage.count;
   }
 
   [[nodiscard]]
   constexpr bool isEmpty() const noexcept {
-    return m_count == 0;
+    return m_storage.count == 0;
   }
 
   [[nodiscard]]
   constexpr size_t length() const noexcept {
-    return m_count;
+    return m_storage.count;
   }
 
   constexpr void reserve(size_t count) {
@@ -108,172 +282,150 @@ public:
 
   [[nodiscard]]
   constexpr size_t capacity() const noexcept {
-    return m_allocated;
+    return m_storage.allocated;
   }
 
   constexpr void shrinkToFit() {
-    if (m_allocated > m_count)
-      _reallocate(m_count);
+    if (m_storage.allocated > m_storage.count)
+      _reallocate(m_storage.count);
   }
 
   constexpr void clear() noexcept {
-    for (size_t i = 0; i < m_count; ++i)
-      destructAt(&m_items[i]);
-
-    m_count = 0;
+    Utils::destruct(m_storage.items, m_storage.count);
+    m_storage.count = 0;
   }
 
   constexpr void resize(size_t newCount) {
     _needAllocated(newCount);
 
-    if (m_count < newCount) {
+    if (m_storage.count < newCount) {
       // new elements
-      for (size_t i = m_count; i < newCount; ++i)
-        constructAt(&m_items[i]);
+      for (size_t i = m_storage.count; i < newCount; ++i)
+        constructAt(&m_storage.items[i]);
     }
-    else if (m_count > newCount) {
+    else if (m_storage.count > newCount) {
       // remove some
-      for (size_t i = newCount; i < m_count; ++i)
-        destructAt(&m_items[i]);
+      Utils::destruct(m_storage.items + newCount, m_storage.count - newCount);
     }
 
-    m_count = newCount;
+    m_storage.count = newCount;
   }
 
   constexpr void insert(ssize_t index, T&& movedValue) {
-    if (index > m_count || index < -m_count)
-      throw IndexError(U"invalid index for List::insert()");
-
-    if (index == m_count)
-      return append(index, forward<T>(movedValue));
+    size_t position = Utils::checkInsertIndex(index, m_storage.count, U"invalid index for List::insert()");
 
-    if (index < 0)
-      index += m_count;
+    if (position == m_storage.count)
+      return append(forward<T>(movedValue));
 
-    _needAllocated(m_count + 1);
-    _shiftForInsert(index);
+    _needAllocated(m_storage.count + 1);
+    Utils::shiftForInsert(m_storage.items, m_storage.count, position);
+    Utils::fillShifted(m_storage.items, position, forward<T>(movedValue));
 
-    m_items[index] = forward<T>(movedValue);
-    ++m_count;
+    ++m_storage.count;
   }
 
   constexpr void insert(ssize_t index, T const& value) {
-    if (index > m_count || index < -m_count)
-      throw IndexError(U"invalid index for List::insert()");
+    size_t position = Utils::checkInsertIndex(index, m_storage.count, U"invalid index for List::insert()");
 
-    if (index == m_count)
-      return append(index, value);
+    if (position == m_storage.count)
+      return append(value);
 
-    if (index < 0)
-      index += m_count;
+    // value may be an item of this list, so it's copied before items are shifted
+    T copy = value;
 
-    _needAllocated(m_count + 1);
-    _shiftForInsert(index);
+    _needAllocated(m_storage.count + 1);
+    Utils::shiftForInsert(m_storage.items, m_storage.count, position);
+    Utils::fillShifted(m_storage.items, position, move(copy));
 
-    m_items[index] = value;
-    ++m_count;
+    ++m_storage.count;
   }
 
   constexpr void append(T&& movedValue) {
-    _needAllocated(m_count + 1);
-    constructAt(&m_items[m_count], forward<T>(movedValue));
-    ++m_count;
+    _needAllocated(m_storage.count + 1);
+    constructAt(&m_storage.items[m_storage.count], forward<T>(movedValue));
+    ++m_storage.count;
   }
 
   constexpr void append(T const& value) {
-    _needAllocated(m_count + 1);
-    constructAt(&m_items[m_count], value);
-    ++m_count;
+    if (m_storage.count == m_storage.allocated) {
+      // value may be an item of this list, which is freed by growth
+      T copy = value;
+      return append(move(copy));
+    }
+
+    constructAt(&m_storage.items[m_storage.count], value);
+    ++m_storage.count;
   }
 
   template <typename... ArgsT>
   constexpr void emplace(ssize_t index, ArgsT&&... args) {
-    if (index > m_count || index < -m_count)
-      throw IndexError(U"invalid index for List::emplace()");
-
-    if (index == m_count)
-      return emplaceBack(index, forward<ArgsT>(args)...);
+    size_t position = Utils::checkInsertIndex(index, m_storage.count, U"invalid index for List::emplace()");
 
-    if (index < 0)
-      index += m_count;
+    if (position == m_storage.count)
+      return emplaceBack(forward<ArgsT>(args)...);
 
-    _needAllocated(m_count + 1);
-    _shiftForInsert(index);
+    T value(forward<ArgsT>(args)...);
 
-    destructAt(&m_items[index]);
-    constructAt(&m_items[index], forward<ArgsT>(args)...);
+    _needAllocated(m_storage.count + 1);
+    Utils::shiftForInsert(m_storage.items, m_storage.count, position);
+    Utils::fillShifted(m_storage.items, position, move(value));
 
-    ++m_count;
+    ++m_storage.count;
   }
 
   template <typename... ArgsT>
   constexpr void emplaceBack(ArgsT&&... args) {
-    _needAllocated(m_count + 1);
-    constructAt(&m_items[m_count], forward<ArgsT>(args)...);
-    ++m_count;
+    _needAllocated(m_storage.count + 1);
+    constructAt(&m_storage.items[m_storage.count], forward<ArgsT>(args)...);
+    ++m_storage.count;
   }
 
   constexpr void erase(ssize_t index, size_t count = 1) {
-    if (index >= m_count || index < -m_count)
-      throw IndexError(U"invalid index for List::erase()");
+    size_t first = Utils::checkEraseRange(
+      index, count, m_storage.count,
+      U"invalid index for List::erase()",
+      U"invalid count for List::erase()"
+    );
 
-    if (index < 0)
-      index += m_count;
-
-    for (size_t i = 0; i < count; ++i)
-      destructAt(&m_items[index + i]);
-
-    for (size_t i = index + count; i < m_count; ++i) {
-      if (i - count < index + count)
-        constructAt(&m_items[i - count], move(&m_items[i]));
-      else {
-        m_items[i - count] = move(&m_items[i]);
-        if (i < m_count - count)
-          destructAt(&m_items[i]);
-      }
-    }
-
-    m_count -= count;
+    Utils::erase(m_storage.items, m_storage.count, first, count);
+    m_storage.count -= count;
   }
 
 public:
   [[nodiscard]]
   constexpr T const& operator[](size_t index) const noexcept {
-    return m_items[index];
+    return m_storage.items[index];
   }
 
   [[nodiscard]]
   constexpr T& operator[](size_t index) noexcept {
-    return m_items[index];
+    return m_storage.items[index];
   }
 
 private:
   constexpr void _initFromRange(T const* begin, T const* end) {
     size_t count = static_cast<size_t>(end - begin);
-    
+
+    clear();
     _needAllocated(count);
-    m_count = count;
 
-    for (auto it = begin, dest = m_items; it != end; ++it, ++dest)
-      *dest = *it; // copy only here, can't move because it's const
+    Utils::copy(m_storage.items, begin, count);
+
+    m_storage.count = count;
   }
 
   constexpr void _stealOther(List& other) noexcept {
-    m_items = other.m_items;
-    m_count = other.m_count;
-    m_allocated = other.m_allocated;
-    other.m_items = nullptr;
-    other.m_count = 0;
-    other.m_allocated = 0;
+    m_storage.getSecond() = other.m_storage.getSecond();
+    other.m_storage.getSecond() = Storage{};
   }
 
   constexpr void _needAllocated(size_t size) {
-    if (m_allocated < size)
+    if (m_storage.allocated < size)
       _grow(size);
   }
 
   constexpr void _grow(size_t min_size) {
-    size_t want_allocate = m_allocated + m_allocated / 2;
+    size_t want_allocate = m_storage.allocated + m_storage.allocated / 2;
 
     if (want_allocate < min_size)
       want_allocate = min_size;
@@ -282,40 +434,60 @@ private:
   }
 
   constexpr void _reallocate(size_t new_size) {
-    if (new_size < m_count)
-      new_size = m_count;
+    if (new_size < m_storage.count)
+      new_size = m_storage.count;
 
-    T* prev_buffer = m_items;
-    size_t prev_allocated = m_allocated;
+    if (new_size == m_storage.allocated)
+      return;
 
-    m_allocated = new_size;
-    m_items = nullptr;
+    if constexpr (USES_REALLOC) {
+      if !consteval {
+        if (m_storage.items && new_size != 0) {
+          void* items = m_storage.getFirst().reallocate(m_storage.items, m_storage.allocated * sizeof(T), new_size * sizeof(T), alignof(T));
 
-    if (new_size > 0) {
-      m_items = new T[new_size];
-
-      if (prev_buffer) {
-        for (size_t i = 0; i < m_count; ++i)
-          constructAt(&m_items[i], move(prev_buffer[i]));
+          m_storage.items = static_cast<T*>(items);
+          m_storage.allocated = new_size;
+          return;
+        }
       }
     }
 
+    T* prev_buffer = m_storage.items;
+    size_t prev_allocated = m_storage.allocated;
+
+    m_storage.items = new_size > 0 ? _allocateItems(new_size) : nullptr;
+    m_storage.allocated = new_size;
+
     if (prev_buffer) {
-      for (size_t i = 0; i < m_count; ++i)
-        destructAt(&prev_buffer[i]);
+      Utils::relocate(m_storage.items, prev_buffer, m_storage.count);
+      _freeItems(prev_buffer, prev_allocated);
+    }
+  }
 
-      delete[] prev_buffer;
+  // std::allocator is the only way to get raw storage during constant evaluation
+  [[nodiscard]]
+  constexpr T* _allocateItems(size_t count) {
+    if consteval {
+      return std::allocator<T>{}.allocate(count);
     }
+
+    return static_cast<T*>(m_storage.getFirst().allocate(count * sizeof(T), alignof(T)));
   }
 
-  constexpr void _shiftForInsert(size_t index) {
-    for (ssize_t i = m_count - 1; i >= index; --i) {
-      if (i == m_count - 1)
-        constructAt(&m_items[i + 1], move(m_items[i]));
-      else
-        m_items[i + 1] = move(m_items[i]);
+  constexpr void _freeItems(T* items, size_t count) noexcept {
+    if (!items)
+      return;
+
+    if consteval {
+      std::allocator<T>{}.deallocate(items, count);
+      return;
     }
+
+    m_storage.getFirst().deallocate(items, count * sizeof(T), alignof(T));
   }
 };
 
+template <typename T, typename AllocatorT>
+static constexpr bool is_trivially_relocatable<List<T, AllocatorT>> = is_trivially_relocatable<AllocatorT>;
+
 _RHLIB_END
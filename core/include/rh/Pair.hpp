@@ -3,6 +3,8 @@
 
 #include <rh.hpp>
 
+#include <rh/TypeTraits.hpp>
+
 _RHLIB_BEGIN
 
 template <typename T, typename K>
@@ -25,6 +27,16 @@ struct Pair {
   constexpr K const& getSecond() const noexcept { return second; }
 };
 
+template <typename T, typename K>
+static constexpr bool is_trivially_relocatable<Pair<T, K>> = is_trivially_relocatable<T> && is_trivially_relocatable<K>;
+
+// References to a key and a value, which containers give out, when they store them apart
+template <typename T, typename K>
+struct PairRef {
+  T& first;
+  K& second;
+};
+
 // Pair, where types can be empty without unnecessary memory usage:
 //  if type is empty, and we're creating a variable of that type,
 //  this variable always will take more than 0 bytes, i.e.:
@@ -0,0 +1,319 @@
+#pragma once
+#define _RHLIB_INCLUDED_RINGBUFFER
+
+#include <rh.hpp>
+
+#include <rh/Allocator.hpp>
+#include <rh/Pair.hpp>
+#include <rh/TypeTraits.hpp>
+#include <rh/exceptions.hpp>
+#include <rh/simd.hpp>
+
+_RHLIB_BEGIN
+
+// Fixed-capacity queue over one allocation. Capacity is rounded up to a power of two,
+//  so positions wrap around with a mask. Push and pop at both ends are O(1) and never
+//  move other items; pushing into a full buffer throws
+// Items wrap around the end of the allocation, so iterators don't convert to pointers
+//  and RingBuffer is only Iterable, not IterableOf
+template <typename T, Allocator AllocatorT = DefaultAllocator>
+class RingBuffer {
+public:
+  using value_type     = T;
+  using allocator_type = AllocatorT;
+
+private:
+  // Item i is at (head + i) & (capacity - 1)
+  struct Storage {
+    T*     items    = nullptr;
+    size_t capacity = 0;
+    size_t head     = 0;
+    size_t count    = 0;
+  };
+
+  // stateless allocator takes no space
+  CompressedPair<AllocatorT, Storage> m_storage;
+
+public:
+  template <bool IsConst>
+  class Iterator {
+  private:
+    friend class RingBuffer;
+
+    template <bool>
+    friend class Iterator;
+
+    using ValueT = conditional<IsConst, T const, T>;
+
+    T*     m_items    = nullptr;
+    size_t m_mask     = 0;
+    size_t m_position = 0; // not wrapped, so end differs from begin of a full buffer
+
+  public:
+    constexpr Iterator() noexcept = default;
+
+    constexpr Iterator(T* items, size_t mask, size_t position) noexcept
+      : m_items(items), m_mask(mask), m_position(position) {}
+
+    // const iterator from a mutable one
+    template <bool OtherConst>
+      requires (IsConst && !OtherConst)
+    constexpr Iterator(Iterator<OtherConst> const& other) noexcept
+      : m_items(other.m_items), m_mask(other.m_mask), m_position(other.m_position) {}
+
+  public:
+    [[nodiscard]]
+    constexpr ValueT& operator*() const noexcept {
+      return m_items[m_position & m_mask];
+    }
+
+    [[nodiscard]]
+    constexpr ValueT* operator->() const noexcept {
+      return &operator*();
+    }
+
+    constexpr Iterator& operator++() noexcept {
+      ++m_position;
+      return *this;
+    }
+
+    constexpr Iterator& operator--() noexcept {
+      --m_position;
+      return *this;
+    }
+
+    [[nodiscard]]
+    constexpr bool operator==(Iterator const& other) const noexcept {
+      return m_position == other.m_position;
+    }
+  };
+
+public:
+  constexpr RingBuffer() noexcept = default;
+
+  constexpr explicit RingBuffer(size_t capacity, AllocatorT const& allocator = AllocatorT{})
+    : m_storage(allocator, Storage{})
+  {
+    if (capacity != 0) {
+      capacity = _RHLIBH roundUpToPowerOfTwo(capacity);
+
+      m_storage.items = static_cast<T*>(m_storage.getFirst().allocate(capacity * sizeof(T), alignof(T)));
+      m_storage.capacity = capacity;
+    }
+  }
+
+  constexpr RingBuffer(RingBuffer const& other)
+    : RingBuffer(other.m_storage.capacity, other.m_storage.getFirst())
+  {
+    for (T const& item : other)
+      append(item);
+  }
+
+  constexpr RingBuffer(RingBuffer&& other) noexcept
+    : m_storage(move(other.m_storage.getFirst()), Storage{})
+  {
+    _stealOther(other);
+  }
+
+  // Takes capacity of other
+  constexpr RingBuffer& operator=(RingBuffer const& other) {
+    if (this != &other) {
+      if (m_storage.capacity != other.m_storage.capacity) {
+        _release();
+
+        RingBuffer copy(other.m_storage.capacity, m_storage.getFirst());
+        _stealOther(copy);
+      }
+      else
+        clear();
+
+      for (T const& item : other)
+        append(item);
+    }
+
+    return *this;
+  }
+
+  constexpr RingBuffer& operator=(RingBuffer&& other) noexcept {
+    if (this != &other) {
+      _release();
+      m_storage.getFirst() = move(other.m_storage.getFirst());
+      _stealOther(other);
+    }
+
+    return *this;
+  }
+
+  constexpr ~RingBuffer() {
+    _release();
+  }
+
+public:
+  [[nodiscard]]
+  constexpr AllocatorT const& allocator() const noexcept {
+    return m_storage.getFirst();
+  }
+
+  [[nodiscard]]
+  constexpr Iterator<false> begin() noexcept {
+    return { m_storage.items, m_storage.capacity - 1, m_storage.head };
+  }
+
+  [[nodiscard]]
+  constexpr Iterator<true> begin() const noexcept {
+    return { m_storage.items, m_storage.capacity - 1, m_storage.head };
+  }
+
+  [[nodiscard]]
+  constexpr Iterator<false> end() noexcept {
+    return { m_storage.items, m_storage.capacity - 1, m_storage.head + m_storage.count };
+  }
+
+  [[nodiscard]]
+  constexpr Iterator<true> end() const noexcept {
+    return { m_storage.items, m_storage.capacity - 1, m_storage.head + m_storage.count };
+  }
+
+  [[nodiscard]]
+  constexpr bool isEmpty() const noexcept {
+    return m_storage.count == 0;
+  }
+
+  [[nodiscard]]
+  constexpr bool isFull() const noexcept {
+    return m_storage.count == m_storage.capacity;
+  }
+
+  [[nodiscard]]
+  constexpr size_t length() const noexcept {
+    return m_storage.count;
+  }
+
+  [[nodiscard]]
+  constexpr size_t capacity() const noexcept {
+    return m_storage.capacity;
+  }
+
+  // Buffer must not be empty
+  [[nodiscard]]
+  constexpr T& front() noexcept {
+    return operator[](0);
+  }
+
+  [[nodiscard]]
+  constexpr T const& front() const noexcept {
+    return operator[](0);
+  }
+
+  [[nodiscard]]
+  constexpr T& back() noexcept {
+    return operator[](m_storage.count - 1);
+  }
+
+  [[nodiscard]]
+  constexpr T const& back() const noexcept {
+    return operator[](m_storage.count - 1);
+  }
+
+  constexpr void append(T&& movedValue) {
+    emplaceBack(move(movedValue));
+  }
+
+  constexpr void append(T const& value) {
+    emplaceBack(value);
+  }
+
+  constexpr void prepend(T&& movedValue) {
+    emplaceFront(move(movedValue));
+  }
+
+  constexpr void prepend(T const& value) {
+    emplaceFront(value);
+  }
+
+  template <typename... ArgsT>
+  constexpr T& emplaceBack(ArgsT&&... args) {
+    _checkNotFull();
+
+    T* item = &m_storage.items[(m_storage.head + m_storage.count) & (m_storage.capacity - 1)];
+    constructAt(item, forward<ArgsT>(args)...);
+
+    ++m_storage.count;
+    return *item;
+  }
+
+  template <typename... ArgsT>
+  constexpr T& emplaceFront(ArgsT&&... args) {
+    _checkNotFull();
+
+    size_t head = (m_storage.head - 1) & (m_storage.capacity - 1);
+
+    T* item = &m_storage.items[head];
+    constructAt(item, forward<ArgsT>(args)...);
+
+    m_storage.head = head;
+    ++m_storage.count;
+    return *item;
+  }
+
+  // Buffer must not be empty
+  constexpr void popBack() noexcept {
+    destructAt(&back());
+    --m_storage.count;
+  }
+
+  // Buffer must not be empty
+  constexpr void popFront() noexcept {
+    destructAt(&front());
+    m_storage.head = (m_storage.head + 1) & (m_storage.capacity - 1);
+    --m_storage.count;
+  }
+
+  constexpr void clear() noexcept {
+    if constexpr (!is_trivially_destructible<T>) {
+      while (m_storage.count != 0)
+        popBack();
+    }
+
+    m_storage.head = 0;
+    m_storage.count = 0;
+  }
+
+  [[nodiscard]]
+  constexpr T const& operator[](size_t index) const noexcept {
+    return m_storage.items[(m_storage.head + index) & (m_storage.capacity - 1)];
+  }
+
+  [[nodiscard]]
+  constexpr T& operator[](size_t index) noexcept {
+    return m_storage.items[(m_storage.head + index) & (m_storage.capacity - 1)];
+  }
+
+private:
+  constexpr void _checkNotFull() const {
+    if (isFull())
+      throw RuntimeError(U"RingBuffer is full");
+  }
+
+  // Destroys items and frees the storage
+  constexpr void _release() noexcept {
+    clear();
+
+    if (m_storage.items)
+      m_storage.getFirst().deallocate(m_storage.items, m_storage.capacity * sizeof(T), alignof(T));
+
+    m_storage.items = nullptr;
+    m_storage.capacity = 0;
+  }
+
+  // This buffer must be empty and hold no memory
+  constexpr void _stealOther(RingBuffer& other) noexcept {
+    m_storage.getSecond() = other.m_storage.getSecond();
+    other.m_storage.getSecond() = Storage{};
+  }
+};
+
+template <typename T, typename AllocatorT>
+static constexpr bool is_trivially_relocatable<RingBuffer<T, AllocatorT>> = is_trivially_relocatable<AllocatorT>;
+
+_RHLIB_END
@@ -0,0 +1,252 @@
+#pragma once
+#define _RHLIB_INCLUDED_SHAREDSTRING
+
+#include <rh.hpp>
+
+#include <rh/String.hpp>
+
+_RHLIB_BEGIN
+
+// Immutable string with atomic reference counter. Copies are O(1) and safe to pass
+//  between threads. Header and characters share one allocation, unless the buffer is
+//  taken from String by share(): then only the header is allocated
+template <typename CharT>
+class BasicSharedString {
+public:
+  using type       = BasicSharedString;
+  using value_type = CharT;
+  using view_type  = BasicStringView<CharT>;
+
+private:
+  using StringType = BasicString<CharT>;
+
+  struct Header {
+    size_t references;
+    size_t length;
+    size_t capacity;
+    CharT* characters; // right after the header, or heap buffer of String
+  };
+
+  Header* m_header = nullptr; // nullptr for empty string
+
+  template <typename, Allocator>
+  friend class BasicString;
+
+public:
+  BasicSharedString() noexcept = default;
+
+  BasicSharedString(view_type string) {
+    if (string.isEmpty())
+      return;
+
+    size_t length = string.length();
+    auto header = static_cast<Header*>(DefaultAllocator::allocate(_combinedSize(length + 1), alignof(Header)));
+    auto buffer = reinterpret_cast<CharT*>(header + 1);
+
+    for (size_t index = 0; index < length; ++index)
+      buffer[index] = string[index];
+
+    buffer[length] = 0;
+
+    constructAt(header, Header{1, length, length + 1, buffer});
+    m_header = header;
+  }
+
+  BasicSharedString(const CharT* string)
+    : BasicSharedString(view_type{string}) {}
+
+  BasicSharedString(BasicSharedString const& other) noexcept
+    : m_header(other.m_header)
+  {
+    if (m_header)
+      __atomic_fetch_add(&m_header->references, 1, __ATOMIC_RELAXED);
+  }
+
+  BasicSharedString(BasicSharedString&& other) noexcept
+    : m_header(other.m_header)
+  {
+    other.m_header = nullptr;
+  }
+
+  BasicSharedString& operator=(BasicSharedString const& other) noexcept {
+    if (other.m_header)
+      __atomic_fetch_add(&other.m_header->references, 1, __ATOMIC_RELAXED);
+
+    _release();
+    m_header = other.m_header;
+
+    return *this;
+  }
+
+  BasicSharedString& operator=(BasicSharedString&& other) noexcept {
+    if (this != &other) {
+      _release();
+      m_header = other.m_header;
+      other.m_header = nullptr;
+    }
+
+    return *this;
+  }
+
+  ~BasicSharedString() {
+    _release();
+  }
+
+public:
+  operator view_type() const noexcept {
+    return view();
+  }
+
+public:
+  [[nodiscard]]
+  view_type view() const noexcept {
+    return m_header ? view_type{_characters(), m_header->length} : view_type{};
+  }
+
+  [[nodiscard]]
+  const CharT* data() const noexcept {
+    return view().data();
+  }
+
+  [[nodiscard]]
+  size_t length() const noexcept {
+    return m_header ? m_header->length : 0;
+  }
+
+  [[nodiscard]]
+  bool isEmpty() const noexcept {
+    return m_header == nullptr;
+  }
+
+  // Approximate, if other threads copy or destroy this string at the same time
+  [[nodiscard]]
+  size_t references() const noexcept {
+    return m_header ? __atomic_load_n(&m_header->references, __ATOMIC_RELAXED) : 0;
+  }
+
+  [[nodiscard]]
+  StringType toString() const& {
+    return StringType{view()};
+  }
+
+  // Adopts the buffer if it came from String and this is the only reference, copies otherwise
+  [[nodiscard]]
+  StringType toString() && {
+    StringType result;
+
+    if (!m_header)
+      return result;
+
+    // acquire pairs with the release in _release() of other owners
+    if (_isAdopted() && __atomic_load_n(&m_header->references, __ATOMIC_ACQUIRE) == 1) {
+      result._attachHeap(m_header->characters, m_header->length, m_header->capacity);
+      delete m_header;
+      m_header = nullptr;
+      return result;
+    }
+
+    result = view();
+    _release();
+    m_header = nullptr;
+
+    return result;
+  }
+
+public:
+  [[nodiscard]]
+  bool operator==(BasicSharedString const& other) const noexcept {
+    return m_header == other.m_header || view() == other.view();
+  }
+
+  [[nodiscard]]
+  bool operator==(view_type other) const noexcept {
+    return view() == other;
+  }
+
+  [[nodiscard]]
+  bool operator==(const CharT* other) const noexcept {
+    return view() == other;
+  }
+
+  [[nodiscard]]
+  bool operator!=(BasicSharedString const& other) const noexcept {
+    return !(*this == other);
+  }
+
+  [[nodiscard]]
+  bool operator!=(view_type other) const noexcept {
+    return !(*this == other);
+  }
+
+  [[nodiscard]]
+  bool operator!=(const CharT* other) const noexcept {
+    return !(*this == other);
+  }
+
+private:
+  [[nodiscard]]
+  const CharT* _characters() const noexcept {
+    return m_header->characters;
+  }
+
+  [[nodiscard]]
+  static constexpr size_t _combinedSize(size_t capacity) noexcept {
+    return sizeof(Header) + capacity * sizeof(CharT);
+  }
+
+  // Characters were taken from String, so they're in a separate allocation
+  [[nodiscard]]
+  bool _isAdopted() const noexcept {
+    return m_header->characters != reinterpret_cast<CharT*>(m_header + 1);
+  }
+
+  // Takes heap buffer of string (must be on heap), string becomes empty
+  [[nodiscard]]
+  static BasicSharedString _adopt(StringType& string) {
+    BasicSharedString result;
+
+    // allocated first, so string is intact if it throws
+    result.m_header = new Header{1, string.m_length, string.m_allocated, nullptr};
+    result.m_header->characters = string._detachHeap();
+
+    return result;
+  }
+
+  void _release() noexcept {
+    if (!m_header || __atomic_fetch_sub(&m_header->references, 1, __ATOMIC_ACQ_REL) != 1)
+      return;
+
+    if (_isAdopted()) {
+      DefaultAllocator allocator;
+      StringType::_freeHeap(allocator, m_header->characters, m_header->capacity);
+      delete m_header;
+    }
+    else
+      DefaultAllocator::deallocate(m_header, _combinedSize(m_header->capacity), alignof(Header));
+  }
+};
+
+using SharedString = BasicSharedString<char32_t>;
+
+template <typename CharT>
+static constexpr bool is_trivially_relocatable<BasicSharedString<CharT>> = true;
+
+template <typename CharT, Allocator AllocatorT>
+BasicSharedString<CharT> BasicString<CharT, AllocatorT>::share() && {
+  // shared buffers are always freed by DefaultAllocator
+  if constexpr (IS_DEFAULT_ALLOCATOR) {
+    if (!_isInline())
+      return BasicSharedString<CharT>::_adopt(*this);
+  }
+
+  return BasicSharedString<CharT>{view_type{*this}};
+}
+
+template <typename CharT, Allocator AllocatorT>
+BasicSharedString<CharT> BasicString<CharT, AllocatorT>::share() const& {
+  return BasicSharedString<CharT>{view_type{*this}};
+}
+
+_RHLIB_END
+
+_RHLIB_GLOBAL_CLASS(SharedString);
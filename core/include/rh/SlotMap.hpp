@@ -0,0 +1,257 @@
+#pragma once
+#define _RHLIB_INCLUDED_SLOTMAP
+
+#include <rh.hpp>
+
+#include <rh/Allocator.hpp>
+#include <rh/List.hpp>
+#include <rh/TypeTraits.hpp>
+#include <rh/exceptions.hpp>
+
+_RHLIB_BEGIN
+
+// Stable reference to an item of SlotMap: index of its slot and generation of the slot.
+// Default handle never refers to anything
+struct SlotHandle {
+  uint32_t index      = UINT32_MAX;
+  uint32_t generation = 0;
+
+  [[nodiscard]]
+  constexpr bool operator==(SlotHandle const&) const noexcept = default;
+
+  [[nodiscard]]
+  constexpr uint64_t hash() const noexcept {
+    return (static_cast<uint64_t>(generation) << 32 | index) * 0x9E3779B97F4A7C15ull;
+  }
+};
+
+// Items are dense in one List, so iteration is the same as over List. Handles point
+//  to slots, and slots point to items, so items can move: erase moves the last item
+//  into the hole. Slot generation is odd while the slot is taken and changes on every
+//  erase, so handles of erased items are detected in O(1) and never reach a new item
+//  (until a slot is reused 2^31 times)
+template <typename T, Allocator AllocatorT = DefaultAllocator>
+class SlotMap {
+public:
+  using value_type     = T;
+  using allocator_type = AllocatorT;
+  using handle_type    = SlotHandle;
+
+private:
+  static constexpr uint32_t NO_SLOT = UINT32_MAX;
+
+  // Taken slot keeps index of its item, free one keeps index of the next free slot
+  struct Slot {
+    uint32_t target;
+    uint32_t generation;
+  };
+
+  List<T, AllocatorT>        m_items;
+  List<uint32_t, AllocatorT> m_itemSlots; // slot of every item
+  List<Slot, AllocatorT>     m_slots;
+  uint32_t                   m_freeSlot = NO_SLOT;
+
+public:
+  constexpr SlotMap() noexcept = default;
+
+  constexpr explicit SlotMap(AllocatorT const& allocator) noexcept
+    : m_items(allocator), m_itemSlots(allocator), m_slots(allocator) {}
+
+public:
+  [[nodiscard]]
+  constexpr AllocatorT const& allocator() const noexcept {
+    return m_items.allocator();
+  }
+
+  [[nodiscard]]
+  constexpr T* data() noexcept {
+    return m_items.data();
+  }
+
+  [[nodiscard]]
+  constexpr const T* data() const noexcept {
+    return m_items.data();
+  }
+
+  [[nodiscard]]
+  constexpr T* begin() noexcept {
+    return m_items.begin();
+  }
+
+  [[nodiscard]]
+  constexpr const T* begin() const noexcept {
+    return m_items.begin();
+  }
+
+  [[nodiscard]]
+  constexpr T* end() noexcept {
+    return m_items.end();
+  }
+
+  [[nodiscard]]
+  constexpr const T* end() const noexcept {
+    return m_items.end();
+  }
+
+  [[nodiscard]]
+  constexpr bool isEmpty() const noexcept {
+    return m_items.isEmpty();
+  }
+
+  [[nodiscard]]
+  constexpr size_t length() const noexcept {
+    return m_items.length();
+  }
+
+  constexpr void reserve(size_t count) {
+    m_items.reserve(count);
+    m_itemSlots.reserve(count);
+    m_slots.reserve(count);
+  }
+
+  [[nodiscard]]
+  constexpr size_t capacity() const noexcept {
+    return m_items.capacity();
+  }
+
+  // Handles of all items become stale
+  constexpr void clear() noexcept {
+    for (uint32_t slot : m_itemSlots)
+      _freeSlot(slot);
+
+    m_items.clear();
+    m_itemSlots.clear();
+  }
+
+  template <typename... ArgsT>
+  constexpr SlotHandle emplace(ArgsT&&... args) {
+    m_items.emplaceBack(forward<ArgsT>(args)...);
+
+    uint32_t item = static_cast<uint32_t>(m_items.length() - 1);
+
+    try {
+      m_itemSlots.append(NO_SLOT);
+      m_itemSlots[item] = _takeSlot(item);
+    }
+    catch (...) {
+      if (m_itemSlots.length() > item)
+        m_itemSlots.erase(-1);
+
+      m_items.erase(-1);
+      throw;
+    }
+
+    return handleAt(item);
+  }
+
+  constexpr SlotHandle insert(T&& movedValue) {
+    return emplace(move(movedValue));
+  }
+
+  constexpr SlotHandle insert(T const& value) {
+    return emplace(value);
+  }
+
+  // Returns false for a stale handle
+  constexpr bool erase(SlotHandle handle) {
+    if (!contains(handle))
+      return false;
+
+    uint32_t item = m_slots[handle.index].target;
+    uint32_t last = static_cast<uint32_t>(m_items.length() - 1);
+
+    if (item != last) {
+      m_items[item] = move(m_items[last]);
+      m_itemSlots[item] = m_itemSlots[last];
+      m_slots[m_itemSlots[item]].target = item;
+    }
+
+    m_items.erase(-1);
+    m_itemSlots.erase(-1);
+    _freeSlot(handle.index);
+
+    return true;
+  }
+
+  [[nodiscard]]
+  constexpr bool contains(SlotHandle handle) const noexcept {
+    return handle.index < m_slots.length() && m_slots[handle.index].generation == handle.generation;
+  }
+
+  [[nodiscard]]
+  constexpr T* find(SlotHandle handle) noexcept {
+    return contains(handle) ? &m_items[m_slots[handle.index].target] : nullptr;
+  }
+
+  [[nodiscard]]
+  constexpr T const* find(SlotHandle handle) const noexcept {
+    return contains(handle) ? &m_items[m_slots[handle.index].target] : nullptr;
+  }
+
+  [[nodiscard]]
+  constexpr T& at(SlotHandle handle) {
+    if (!contains(handle))
+      throw KeyError(U"stale handle for SlotMap::at()");
+
+    return m_items[m_slots[handle.index].target];
+  }
+
+  [[nodiscard]]
+  constexpr T const& at(SlotHandle handle) const {
+    if (!contains(handle))
+      throw KeyError(U"stale handle for SlotMap::at()");
+
+    return m_items[m_slots[handle.index].target];
+  }
+
+  // Handle of the item at index of iteration order
+  [[nodiscard]]
+  constexpr SlotHandle handleAt(size_t index) const noexcept {
+    uint32_t slot = m_itemSlots[index];
+    return { slot, m_slots[slot].generation };
+  }
+
+  [[nodiscard]]
+  constexpr T const& operator[](size_t index) const noexcept {
+    return m_items[index];
+  }
+
+  [[nodiscard]]
+  constexpr T& operator[](size_t index) noexcept {
+    return m_items[index];
+  }
+
+private:
+  constexpr uint32_t _takeSlot(uint32_t item) {
+    if (m_freeSlot != NO_SLOT) {
+      uint32_t slot = m_freeSlot;
+      Slot& taken = m_slots[slot];
+
+      m_freeSlot = taken.target;
+      taken.target = item;
+      ++taken.generation;
+
+      return slot;
+    }
+
+    if (m_slots.length() == NO_SLOT)
+      throw RuntimeError(U"SlotMap is out of slots");
+
+    m_slots.append(Slot{ item, 1 });
+    return static_cast<uint32_t>(m_slots.length() - 1);
+  }
+
+  constexpr void _freeSlot(uint32_t slot) noexcept {
+    Slot& freed = m_slots[slot];
+
+    freed.target = m_freeSlot;
+    ++freed.generation;
+
+    m_freeSlot = slot;
+  }
+};
+
+template <typename T, typename AllocatorT>
+static constexpr bool is_trivially_relocatable<SlotMap<T, AllocatorT>> = is_trivially_relocatable<AllocatorT>;
+
+_RHLIB_END
@@ -0,0 +1,390 @@
+#pragma once
+#define _RHLIB_INCLUDED_SMALLLIST
+
+#include <rh.hpp>
+
+#include <rh/Allocator.hpp>
+#include <rh/InitList.hpp>
+#include <rh/List.hpp>
+#include <rh/Pair.hpp>
+#include <rh/TypeTraits.hpp>
+
+_RHLIB_BEGIN
+
+// List, which keeps up to InlineCapacity items inside of itself and goes to the heap
+//  only beyond that. Insert/erase/emplace work exactly like in List.
+// Inline items can't be stolen, so moving a small list moves its items one by one
+template <typename T, size_t InlineCapacity, Allocator AllocatorT = DefaultAllocator>
+class SmallList {
+public:
+  using value_type     = T;
+  using allocator_type = AllocatorT;
+
+  static constexpr size_t INLINE_CAPACITY = InlineCapacity;
+
+  static_assert(InlineCapacity > 0, "SmallList must have inline space for at least one item");
+
+private:
+  using Utils = _RHLIBH ListUtils;
+
+  static constexpr bool USES_REALLOC = is_trivially_relocatable<T> && ReallocatingAllocator<AllocatorT>;
+
+  // "local" is active while allocated == InlineCapacity, "heap" otherwise
+  struct Storage {
+    union {
+      T* heap = nullptr;
+      alignas(T) uint8_t local[InlineCapacity * sizeof(T)];
+    };
+
+    size_t count     = 0;
+    size_t allocated = InlineCapacity;
+  };
+
+  // stateless allocator takes no space
+  CompressedPair<AllocatorT, Storage> m_storage;
+
+public:
+  constexpr SmallList() noexcept = default;
+
+  constexpr explicit SmallList(AllocatorT const& allocator) noexcept
+    : m_storage(allocator, Storage{}) {}
+
+  constexpr SmallList(size_t count, T const& value) : SmallList() {
+    _needAllocated(count);
+
+    for (size_t i = 0; i < count; ++i)
+      constructAt(&data()[i], value);
+
+    m_storage.count = count;
+  }
+
+  constexpr SmallList(InitList<T> init) : SmallList() {
+    _initFromRange(init.begin(), init.end());
+  }
+
+  constexpr SmallList(SmallList const& other)
+    : m_storage(other.m_storage.getFirst(), Storage{})
+  {
+    operator=(other);
+  }
+
+  constexpr SmallList(SmallList&& other) noexcept
+    : m_storage(move(other.m_storage.getFirst()), Storage{})
+  {
+    _stealOther(other);
+  }
+
+  constexpr SmallList& operator=(SmallList const& other) {
+    if (this != &other)
+      _initFromRange(other.begin(), other.end());
+
+    return *this;
+  }
+
+  constexpr SmallList& operator=(SmallList&& other) noexcept {
+    if (this != &other) {
+      _release();
+      m_storage.getFirst() = move(other.m_storage.getFirst());
+      _stealOther(other);
+    }
+
+    return *this;
+  }
+
+  constexpr ~SmallList() {
+    _release();
+  }
+
+public:
+  [[nodiscard]]
+  constexpr AllocatorT const& allocator() const noexcept {
+    return m_storage.getFirst();
+  }
+
+  [[nodiscard]]
+  constexpr T* data() noexcept {
+    return _isInline() ? reinterpret_cast<T*>(m_storage.local) : m_storage.heap;
+  }
+
+  [[nodiscard]]
+  constexpr const T* data() const noexcept {
+    return _isInline() ? reinterpret_cast<const T*>(m_storage.local) : m_storage.heap;
+  }
+
+  [[nodiscard]]
+  constexpr T* begin() noexcept {
+    return data();
+  }
+
+  [[nodiscard]]
+  constexpr const T* begin() const noexcept {
+    return data();
+  }
+
+  [[nodiscard]]
+  constexpr T* end() noexcept {
+    return data() + m_storage.count;
+  }
+
+  [[nodiscard]]
+  constexpr const T* end() const noexcept {
+    return data() + m_storage.count;
+  }
+
+  [[nodiscard]]
+  constexpr bool isEmpty() const noexcept {
+    return m_storage.count == 0;
+  }
+
+  [[nodiscard]]
+  constexpr size_t length() const noexcept {
+    return m_storage.count;
+  }
+
+  constexpr void reserve(size_t count) {
+    _needAllocated(count);
+  }
+
+  [[nodiscard]]
+  constexpr size_t capacity() const noexcept {
+    return m_storage.allocated;
+  }
+
+  // Items come back inline, if they fit
+  constexpr void shrinkToFit() {
+    if (m_storage.allocated > m_storage.count)
+      _reallocate(m_storage.count);
+  }
+
+  constexpr void clear() noexcept {
+    Utils::destruct(data(), m_storage.count);
+    m_storage.count = 0;
+  }
+
+  constexpr void resize(size_t newCount) {
+    _needAllocated(newCount);
+
+    T* items = data();
+
+    if (m_storage.count < newCount) {
+      for (size_t i = m_storage.count; i < newCount; ++i)
+        constructAt(&items[i]);
+    }
+    else if (m_storage.count > newCount)
+      Utils::destruct(items + newCount, m_storage.count - newCount);
+
+    m_storage.count = newCount;
+  }
+
+  constexpr void insert(ssize_t index, T&& movedValue) {
+    size_t position = Utils::checkInsertIndex(index, m_storage.count, U"invalid index for SmallList::insert()");
+
+    if (position == m_storage.count)
+      return append(forward<T>(movedValue));
+
+    _needAllocated(m_storage.count + 1);
+    Utils::shiftForInsert(data(), m_storage.count, position);
+    Utils::fillShifted(data(), position, forward<T>(movedValue));
+
+    ++m_storage.count;
+  }
+
+  constexpr void insert(ssize_t index, T const& value) {
+    size_t position = Utils::checkInsertIndex(index, m_storage.count, U"invalid index for SmallList::insert()");
+
+    if (position == m_storage.count)
+      return append(value);
+
+    // value may be an item of this list, so it's copied before items are shifted
+    T copy = value;
+
+    _needAllocated(m_storage.count + 1);
+    Utils::shiftForInsert(data(), m_storage.count, position);
+    Utils::fillShifted(data(), position, move(copy));
+
+    ++m_storage.count;
+  }
+
+  constexpr void append(T&& movedValue) {
+    _needAllocated(m_storage.count + 1);
+    constructAt(&data()[m_storage.count], forward<T>(movedValue));
+    ++m_storage.count;
+  }
+
+  constexpr void append(T const& value) {
+    if (m_storage.count == m_storage.allocated) {
+      // value may be an item of this list, which is moved by growth
+      T copy = value;
+      return append(move(copy));
+    }
+
+    constructAt(&data()[m_storage.count], value);
+    ++m_storage.count;
+  }
+
+  template <typename... ArgsT>
+  constexpr void emplace(ssize_t index, ArgsT&&... args) {
+    size_t position = Utils::checkInsertIndex(index, m_storage.count, U"invalid index for SmallList::emplace()");
+
+    if (position == m_storage.count)
+      return emplaceBack(forward<ArgsT>(args)...);
+
+    T value(forward<ArgsT>(args)...);
+
+    _needAllocated(m_storage.count + 1);
+    Utils::shiftForInsert(data(), m_storage.count, position);
+    Utils::fillShifted(data(), position, move(value));
+
+    ++m_storage.count;
+  }
+
+  template <typename... ArgsT>
+  constexpr void emplaceBack(ArgsT&&... args) {
+    _needAllocated(m_storage.count + 1);
+    constructAt(&data()[m_storage.count], forward<ArgsT>(args)...);
+    ++m_storage.count;
+  }
+
+  constexpr void erase(ssize_t index, size_t count = 1) {
+    size_t first = Utils::checkEraseRange(
+      index, count, m_storage.count,
+      U"invalid index for SmallList::erase()",
+      U"invalid count for SmallList::erase()"
+    );
+
+    Utils::erase(data(), m_storage.count, first, count);
+    m_storage.count -= count;
+  }
+
+public:
+  [[nodiscard]]
+  constexpr T const& operator[](size_t index) const noexcept {
+    return data()[index];
+  }
+
+  [[nodiscard]]
+  constexpr T& operator[](size_t index) noexcept {
+    return data()[index];
+  }
+
+private:
+  [[nodiscard]]
+  constexpr bool _isInline() const noexcept {
+    return m_storage.allocated == InlineCapacity;
+  }
+
+  constexpr void _initFromRange(T const* begin, T const* end) {
+    size_t count = static_cast<size_t>(end - begin);
+
+    clear();
+    _needAllocated(count);
+
+    Utils::copy(data(), begin, count);
+
+    m_storage.count = count;
+  }
+
+  // Destroys items and frees the heap, list becomes empty and inline
+  constexpr void _release() noexcept {
+    clear();
+
+    if (!_isInline())
+      _freeItems(m_storage.heap, m_storage.allocated);
+
+    m_storage.heap = nullptr;
+    m_storage.allocated = InlineCapacity;
+  }
+
+  // This list must be empty and inline
+  constexpr void _stealOther(SmallList& other) {
+    if (other._isInline())
+      Utils::relocate(data(), other.data(), other.m_storage.count);
+    else {
+      m_storage.heap = other.m_storage.heap;
+      m_storage.allocated = other.m_storage.allocated;
+
+      other.m_storage.heap = nullptr;
+      other.m_storage.allocated = InlineCapacity;
+    }
+
+    m_storage.count = other.m_storage.count;
+    other.m_storage.count = 0;
+  }
+
+  constexpr void _needAllocated(size_t size) {
+    if (m_storage.allocated < size)
+      _grow(size);
+  }
+
+  constexpr void _grow(size_t min_size) {
+    size_t want_allocate = m_storage.allocated + m_storage.allocated / 2;
+
+    if (want_allocate < min_size)
+      want_allocate = min_size;
+
+    _reallocate(want_allocate);
+  }
+
+  // goes to the heap only past InlineCapacity, comes back inline if new_size fits
+  constexpr void _reallocate(size_t new_size) {
+    if (new_size < m_storage.count)
+      new_size = m_storage.count;
+
+    if (new_size < InlineCapacity)
+      new_size = InlineCapacity;
+
+    if (new_size == m_storage.allocated)
+      return;
+
+    size_t prev_allocated = m_storage.allocated;
+
+    if (new_size == InlineCapacity) {
+      // previous items are on the heap here, because inline is the smallest possible
+      T* prev_items = m_storage.heap;
+
+      Utils::relocate(reinterpret_cast<T*>(m_storage.local), prev_items, m_storage.count);
+      m_storage.allocated = InlineCapacity;
+
+      _freeItems(prev_items, prev_allocated);
+      return;
+    }
+
+    if constexpr (USES_REALLOC) {
+      if (!_isInline()) {
+        void* items = m_storage.getFirst().reallocate(m_storage.heap, prev_allocated * sizeof(T), new_size * sizeof(T), alignof(T));
+
+        m_storage.heap = static_cast<T*>(items);
+        m_storage.allocated = new_size;
+        return;
+      }
+    }
+
+    T* items = _allocateItems(new_size);
+    T* prev_items = data();
+    bool was_inline = _isInline();
+
+    Utils::relocate(items, prev_items, m_storage.count);
+
+    if (!was_inline)
+      _freeItems(prev_items, prev_allocated);
+
+    m_storage.heap = items;
+    m_storage.allocated = new_size;
+  }
+
+  [[nodiscard]]
+  constexpr T* _allocateItems(size_t count) {
+    return static_cast<T*>(m_storage.getFirst().allocate(count * sizeof(T), alignof(T)));
+  }
+
+  constexpr void _freeItems(T* items, size_t count) noexcept {
+    m_storage.getFirst().deallocate(items, count * sizeof(T), alignof(T));
+  }
+};
+
+// Inline items are found through capacity, not through a pointer, so they can be moved by memcpy
+template <typename T, size_t InlineCapacity, typename AllocatorT>
+static constexpr bool is_trivially_relocatable<SmallList<T, InlineCapacity, AllocatorT>> =
+  is_trivially_relocatable<T> && is_trivially_relocatable<AllocatorT>;
+
+_RHLIB_END
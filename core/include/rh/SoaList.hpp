@@ -0,0 +1,434 @@
+#pragma once
+#define _RHLIB_INCLUDED_SOALIST
+
+#include <rh.hpp>
+
+#include <rh/Allocator.hpp>
+#include <rh/List.hpp>
+#include <rh/Pair.hpp>
+#include <rh/Span.hpp>
+#include <rh/TypeTraits.hpp>
+
+_RHLIB_BEGIN
+
+_RHLIB_HIDDEN_BEGIN
+
+// At least a cache line, so columns don't share lines
+template <typename... Types>
+[[nodiscard]]
+constexpr size_t soaColumnAlignment() noexcept {
+  size_t alignment = 64;
+
+  ((alignment = alignof(Types) > alignment ? alignof(Types) : alignment), ...);
+  return alignment;
+}
+
+_RHLIB_HIDDEN_END
+
+// List of rows, stored as a structure of arrays: every field has its own column, so
+//  a loop over some fields reads only their cache lines. All columns live in one
+//  allocation, each of them starts at COLUMN_ALIGNMENT.
+// Rows are appended, inserted and erased like items of List, and are reached either
+//  through column spans or through Row proxies
+template <Allocator AllocatorT, typename... Fields>
+class BasicSoaList {
+public:
+  using allocator_type = AllocatorT;
+
+  static constexpr size_t COLUMNS = sizeof...(Fields);
+
+  static constexpr size_t COLUMN_ALIGNMENT = _RHLIBH soaColumnAlignment<Fields...>();
+
+  template <size_t Index>
+  using field_type = type_at<Index, Fields...>;
+
+  static_assert(COLUMNS > 0, "SoaList must have at least one field");
+
+private:
+  using Utils = _RHLIBH ListUtils;
+
+  static constexpr size_t FIELD_SIZES[COLUMNS] = { sizeof(Fields)... };
+
+  using Indices = make_index_sequence<COLUMNS>;
+
+  struct Storage {
+    uint8_t* block     = nullptr;
+    size_t   count     = 0;
+    size_t   allocated = 0;
+  };
+
+  // stateless allocator takes no space
+  CompressedPair<AllocatorT, Storage> m_storage;
+
+public:
+  // Fields of one row, by reference
+  template <bool IsConst>
+  class Row {
+  private:
+    using ListT = conditional<IsConst, BasicSoaList const, BasicSoaList>;
+
+    ListT* m_list  = nullptr;
+    size_t m_index = 0;
+
+  public:
+    constexpr Row(ListT* list, size_t index) noexcept
+      : m_list(list), m_index(index) {}
+
+  public:
+    template <size_t Index>
+    [[nodiscard]]
+    constexpr auto& get() const noexcept {
+      return m_list->template _column<Index>()[m_index];
+    }
+
+    [[nodiscard]]
+    constexpr size_t index() const noexcept {
+      return m_index;
+    }
+  };
+
+  template <bool IsConst>
+  class Iterator {
+  private:
+    using ListT = conditional<IsConst, BasicSoaList const, BasicSoaList>;
+
+    ListT* m_list  = nullptr;
+    size_t m_index = 0;
+
+  public:
+    constexpr Iterator() noexcept = default;
+
+    constexpr Iterator(ListT* list, size_t index) noexcept
+      : m_list(list), m_index(index) {}
+
+  public:
+    [[nodiscard]]
+    constexpr Row<IsConst> operator*() const noexcept {
+      return { m_list, m_index };
+    }
+
+    constexpr Iterator& operator++() noexcept {
+      ++m_index;
+      return *this;
+    }
+
+    constexpr Iterator& operator--() noexcept {
+      --m_index;
+      return *this;
+    }
+
+    [[nodiscard]]
+    constexpr bool operator==(Iterator const& other) const noexcept {
+      return m_index == other.m_index;
+    }
+  };
+
+public:
+  constexpr BasicSoaList() noexcept = default;
+
+  constexpr explicit BasicSoaList(AllocatorT const& allocator) noexcept
+    : m_storage(allocator, Storage{}) {}
+
+  constexpr BasicSoaList(BasicSoaList const& other)
+    : m_storage(other.m_storage.getFirst(), Storage{})
+  {
+    operator=(other);
+  }
+
+  constexpr BasicSoaList(BasicSoaList&& other) noexcept
+    : m_storage(move(other.m_storage.getFirst()), Storage{})
+  {
+    _stealOther(other);
+  }
+
+  constexpr BasicSoaList& operator=(BasicSoaList const& other) {
+    if (this != &other) {
+      clear();
+      _needAllocated(other.m_storage.count);
+
+      [&]<size_t... I>(IndexSequence<I...>) {
+        (Utils::copy(_column<I>(), other._column<I>(), other.m_storage.count), ...);
+      }(Indices{});
+
+      m_storage.count = other.m_storage.count;
+    }
+
+    return *this;
+  }
+
+  constexpr BasicSoaList& operator=(BasicSoaList&& other) noexcept {
+    if (this != &other) {
+      _release();
+      m_storage.getFirst() = move(other.m_storage.getFirst());
+      _stealOther(other);
+    }
+
+    return *this;
+  }
+
+  constexpr ~BasicSoaList() {
+    _release();
+  }
+
+public:
+  [[nodiscard]]
+  constexpr AllocatorT const& allocator() const noexcept {
+    return m_storage.getFirst();
+  }
+
+  // Items of one field, valid until the list reallocates
+  template <size_t Index>
+  [[nodiscard]]
+  constexpr Span<field_type<Index>> column() noexcept {
+    return { _column<Index>(), m_storage.count };
+  }
+
+  template <size_t Index>
+  [[nodiscard]]
+  constexpr Span<field_type<Index> const> column() const noexcept {
+    return { _column<Index>(), m_storage.count };
+  }
+
+  [[nodiscard]]
+  constexpr Iterator<false> begin() noexcept {
+    return { this, 0 };
+  }
+
+  [[nodiscard]]
+  constexpr Iterator<true> begin() const noexcept {
+    return { this, 0 };
+  }
+
+  [[nodiscard]]
+  constexpr Iterator<false> end() noexcept {
+    return { this, m_storage.count };
+  }
+
+  [[nodiscard]]
+  constexpr Iterator<true> end() const noexcept {
+    return { this, m_storage.count };
+  }
+
+  [[nodiscard]]
+  constexpr bool isEmpty() const noexcept {
+    return m_storage.count == 0;
+  }
+
+  [[nodiscard]]
+  constexpr size_t length() const noexcept {
+    return m_storage.count;
+  }
+
+  constexpr void reserve(size_t count) {
+    _needAllocated(count);
+  }
+
+  [[nodiscard]]
+  constexpr size_t capacity() const noexcept {
+    return m_storage.allocated;
+  }
+
+  constexpr void shrinkToFit() {
+    if (m_storage.allocated > m_storage.count)
+      _reallocate(m_storage.count);
+  }
+
+  constexpr void clear() noexcept {
+    _destructRows(0, m_storage.count);
+    m_storage.count = 0;
+  }
+
+  // new rows are default-constructed
+  constexpr void resize(size_t newCount) {
+    _needAllocated(newCount);
+
+    if (m_storage.count < newCount) {
+      for (size_t i = m_storage.count; i < newCount; ++i)
+        _constructRow(i);
+    }
+    else if (m_storage.count > newCount)
+      _destructRows(newCount, m_storage.count);
+
+    m_storage.count = newCount;
+  }
+
+  // One value for every field
+  template <typename... ArgsT>
+    requires (sizeof...(ArgsT) == COLUMNS)
+  constexpr void append(ArgsT&&... values) {
+    // values may be items of this list, so they are copied before growing
+    if (m_storage.count == m_storage.allocated)
+      return _appendGrowing(Fields(forward<ArgsT>(values))...);
+
+    _constructRow(m_storage.count, forward<ArgsT>(values)...);
+    ++m_storage.count;
+  }
+
+  template <typename... ArgsT>
+    requires (sizeof...(ArgsT) == COLUMNS)
+  constexpr void insert(ssize_t index, ArgsT&&... values) {
+    size_t position = Utils::checkInsertIndex(index, m_storage.count, U"invalid index for SoaList::insert()");
+
+    if (position == m_storage.count)
+      return append(forward<ArgsT>(values)...);
+
+    _insertShifted(position, Fields(forward<ArgsT>(values))...);
+  }
+
+  constexpr void erase(ssize_t index, size_t count = 1) {
+    size_t first = Utils::checkEraseRange(
+      index, count, m_storage.count,
+      U"invalid index for SoaList::erase()",
+      U"invalid count for SoaList::erase()"
+    );
+
+    [&]<size_t... I>(IndexSequence<I...>) {
+      (Utils::erase(_column<I>(), m_storage.count, first, count), ...);
+    }(Indices{});
+
+    m_storage.count -= count;
+  }
+
+public:
+  [[nodiscard]]
+  constexpr Row<true> operator[](size_t index) const noexcept {
+    return { this, index };
+  }
+
+  [[nodiscard]]
+  constexpr Row<false> operator[](size_t index) noexcept {
+    return { this, index };
+  }
+
+private:
+  // Columns take whole multiples of COLUMN_ALIGNMENT, so every one of them stays aligned
+  static constexpr size_t _columnBytes(size_t fieldSize, size_t capacity) noexcept {
+    return (fieldSize * capacity + COLUMN_ALIGNMENT - 1) & ~(COLUMN_ALIGNMENT - 1);
+  }
+
+  static constexpr size_t _offsetOf(size_t column, size_t capacity) noexcept {
+    size_t offset = 0;
+
+    for (size_t i = 0; i < column; ++i)
+      offset += _columnBytes(FIELD_SIZES[i], capacity);
+
+    return offset;
+  }
+
+  template <size_t Index>
+  [[nodiscard]]
+  constexpr field_type<Index>* _column() noexcept {
+    return reinterpret_cast<field_type<Index>*>(m_storage.block + _offsetOf(Index, m_storage.allocated));
+  }
+
+  template <size_t Index>
+  [[nodiscard]]
+  constexpr field_type<Index> const* _column() const noexcept {
+    return reinterpret_cast<field_type<Index> const*>(m_storage.block + _offsetOf(Index, m_storage.allocated));
+  }
+
+  template <typename... ArgsT>
+  constexpr void _constructRow(size_t row, ArgsT&&... values) {
+    [&]<size_t... I>(IndexSequence<I...>) {
+      size_t constructed = 0;
+
+      try {
+        if constexpr (sizeof...(ArgsT) == 0)
+          ((constructAt(&_column<I>()[row]), ++constructed), ...);
+        else
+          ((constructAt(&_column<I>()[row], forward<ArgsT>(values)), ++constructed), ...);
+      }
+      catch (...) {
+        ((I < constructed ? destructAt(&_column<I>()[row]) : void()), ...);
+        throw;
+      }
+    }(Indices{});
+  }
+
+  constexpr void _destructRows(size_t first, size_t last) noexcept {
+    [&]<size_t... I>(IndexSequence<I...>) {
+      (Utils::destruct(_column<I>() + first, last - first), ...);
+    }(Indices{});
+  }
+
+  constexpr void _appendGrowing(Fields&&... values) {
+    _grow(m_storage.count + 1);
+    _constructRow(m_storage.count, move(values)...);
+    ++m_storage.count;
+  }
+
+  constexpr void _insertShifted(size_t position, Fields&&... values) {
+    _needAllocated(m_storage.count + 1);
+
+    [&]<size_t... I>(IndexSequence<I...>) {
+      (Utils::shiftForInsert(_column<I>(), m_storage.count, position), ...);
+      (Utils::fillShifted(_column<I>(), position, move(values)), ...);
+    }(Indices{});
+
+    ++m_storage.count;
+  }
+
+  constexpr void _stealOther(BasicSoaList& other) noexcept {
+    m_storage.getSecond() = other.m_storage.getSecond();
+    other.m_storage.getSecond() = Storage{};
+  }
+
+  constexpr void _release() noexcept {
+    clear();
+    _freeBlock(m_storage.block, m_storage.allocated);
+
+    m_storage.block = nullptr;
+    m_storage.allocated = 0;
+  }
+
+  constexpr void _needAllocated(size_t size) {
+    if (m_storage.allocated < size)
+      _grow(size);
+  }
+
+  constexpr void _grow(size_t min_size) {
+    size_t want_allocate = m_storage.allocated + m_storage.allocated / 2;
+
+    if (want_allocate < min_size)
+      want_allocate = min_size;
+
+    _reallocate(want_allocate);
+  }
+
+  // Offsets of columns depend on capacity, so every column is relocated
+  constexpr void _reallocate(size_t new_size) {
+    if (new_size < m_storage.count)
+      new_size = m_storage.count;
+
+    if (new_size == m_storage.allocated)
+      return;
+
+    Storage previous = m_storage.getSecond();
+
+    m_storage.block = new_size > 0
+      ? static_cast<uint8_t*>(m_storage.getFirst().allocate(_offsetOf(COLUMNS, new_size), COLUMN_ALIGNMENT))
+      : nullptr;
+    m_storage.allocated = new_size;
+
+    if (previous.block) {
+      [&]<size_t... I>(IndexSequence<I...>) {
+        (Utils::relocate(_column<I>(), reinterpret_cast<field_type<I>*>(previous.block + _offsetOf(I, previous.allocated)), previous.count), ...);
+      }(Indices{});
+
+      _freeBlock(previous.block, previous.allocated);
+    }
+  }
+
+  constexpr void _freeBlock(uint8_t* block, size_t allocated) noexcept {
+    if (block)
+      m_storage.getFirst().deallocate(block, _offsetOf(COLUMNS, allocated), COLUMN_ALIGNMENT);
+  }
+};
+
+template <typename... Fields>
+using SoaList = BasicSoaList<DefaultAllocator, Fields...>;
+
+template <typename AllocatorT, typename... Fields>
+static constexpr bool is_trivially_relocatable<BasicSoaList<AllocatorT, Fields...>> = is_trivially_relocatable<AllocatorT>;
+
+_RHLIB_END
@@ -0,0 +1,64 @@
+#pragma once
+#define _RHLIB_INCLUDED_SPAN
+
+#include <rh.hpp>
+
+#include <rh/TypeTraits.hpp>
+
+_RHLIB_BEGIN
+
+// Non-owning view of contiguous items, valid while their storage doesn't move
+template <typename T>
+class Span {
+public:
+  using value_type = T;
+
+private:
+  T*     m_items  = nullptr;
+  size_t m_length = 0;
+
+public:
+  constexpr Span() noexcept = default;
+
+  constexpr Span(T* items, size_t length) noexcept
+    : m_items(items), m_length(length) {}
+
+  // const span from a mutable one
+  template <typename OtherT>
+    requires is_same_type<OtherT const, T>
+  constexpr Span(Span<OtherT> const& other) noexcept
+    : m_items(other.data()), m_length(other.length()) {}
+
+public:
+  [[nodiscard]]
+  constexpr T* data() const noexcept {
+    return m_items;
+  }
+
+  [[nodiscard]]
+  constexpr T* begin() const noexcept {
+    return m_items;
+  }
+
+  [[nodiscard]]
+  constexpr T* end() const noexcept {
+    return m_items + m_length;
+  }
+
+  [[nodiscard]]
+  constexpr bool isEmpty() const noexcept {
+    return m_length == 0;
+  }
+
+  [[nodiscard]]
+  constexpr size_t length() const noexcept {
+    return m_length;
+  }
+
+  [[nodiscard]]
+  constexpr T& operator[](size_t index) const noexcept {
+    return m_items[index];
+  }
+};
+
+_RHLIB_END
@@ -3,7 +3,11 @@
 
 #include <rh.hpp>
 
+#include <rh/Allocator.hpp>
+#include <rh/Pair.hpp>
 #include <rh/TypeTraits.hpp>
+#include <rh/hash.hpp>
+#include <rh/simd.hpp>
 
 #ifndef _RHLIB_NO_STL_COMPAT
 # include <string>
@@ -12,14 +16,188 @@
 
 _RHLIB_BEGIN
 
-class StringView;
-class String;
+template <typename CharT>
+class BasicStringView;
+
+template <typename CharT, Allocator AllocatorT = DefaultAllocator>
+class BasicString;
+
+using StringView = BasicStringView<char32_t>;
+using String     = BasicString<char32_t>;
+
+template <typename CharT>
+class BasicSharedString;
+
+template <typename CharT, typename DelimiterT>
+class BasicSplitRange;
 
 _RHLIB_HIDDEN_BEGIN
 
+template <typename CharT>
+struct TwoWaySearcher;
+
 struct StringUtils {
+  template <typename CharT>
+  static constexpr CharT EMPTY_STRING[1] = {};
+
   template <typename CharT, typename = enable_if<is_char_type<CharT>>>
   static constexpr size_t length(const CharT* string) {
+#if _RHLIB_SIMD_SSE2
+    if !consteval {
+      if constexpr (sizeof(CharT) == sizeof(uint32_t))
+        return lengthVector(string);
+    }
+#endif
+
+    return lengthScalar(string);
+  }
+
+  template <typename CharT, typename = enable_if<is_char_type<CharT>>>
+  static constexpr bool isSubStringEqual(const CharT* string, size_t index, const CharT* sub_string, size_t sub_string_length) noexcept {
+#if _RHLIB_SIMD_SSE2
+    if !consteval {
+      if constexpr (sizeof(CharT) == sizeof(uint32_t))
+        return isSubStringEqualVector(string, index, sub_string, sub_string_length);
+    }
+#endif
+
+    return isSubStringEqualScalar(string, index, sub_string, sub_string_length);
+  }
+
+  // Needles up to this length are searched by candidate filtering, longer ones by Two-Way
+  static constexpr size_t SHORT_NEEDLE_LENGTH = 32;
+
+  template <typename CharT, typename = enable_if<is_char_type<CharT>>>
+  static constexpr ssize_t find(
+    const CharT* string, size_t string_length,
+    const CharT* sub_string, size_t sub_string_length
+  ) noexcept {
+    if (sub_string_length > string_length)
+      return -1;
+
+    if (sub_string_length <= SHORT_NEEDLE_LENGTH)
+      return findShort(string, string_length, sub_string, sub_string_length);
+
+    return TwoWaySearcher<CharT>{sub_string, sub_string_length}.find(string, string_length);
+  }
+
+  // O(n * m), but with small m it's faster than Two-Way, which needs a setup
+  template <typename CharT, typename = enable_if<is_char_type<CharT>>>
+  static constexpr ssize_t findShort(
+    const CharT* string, size_t string_length,
+    const CharT* sub_string, size_t sub_string_length
+  ) noexcept {
+    if (sub_string_length == 0)
+      return 0;
+
+    if (sub_string_length > string_length)
+      return -1;
+
+    if (sub_string_length == 1)
+      return find(string, string_length, sub_string[0]);
+
+#if _RHLIB_SIMD_SSE2
+    if !consteval {
+      if constexpr (sizeof(CharT) == sizeof(uint32_t))
+        return findShortVector(string, string_length, sub_string, sub_string_length);
+    }
+#endif
+
+    return findShortScalar(string, string_length, sub_string, sub_string_length);
+  }
+
+  template <typename CharT, typename = enable_if<is_char_type<CharT>>>
+  static constexpr ssize_t find(
+    const CharT* string, size_t string_length,
+    CharT character
+  ) noexcept {
+#if _RHLIB_SIMD_SSE2
+    if !consteval {
+      if constexpr (sizeof(CharT) == sizeof(uint32_t))
+        return findVector(string, string_length, character);
+    }
+#endif
+
+    return findScalar(string, string_length, character);
+  }
+
+  // memcpy/memmove at runtime, plain loops in constant evaluation
+  template <typename CharT, typename = enable_if<is_char_type<CharT>>>
+  static constexpr void copyUnits(CharT* destination, const CharT* source, size_t count) noexcept {
+    if !consteval {
+      __builtin_memcpy(destination, source, count * sizeof(CharT));
+      return;
+    }
+
+    for (size_t index = 0; index < count; ++index)
+      destination[index] = source[index];
+  }
+
+  template <typename CharT, typename = enable_if<is_char_type<CharT>>>
+  static constexpr void moveUnits(CharT* destination, const CharT* source, size_t count) noexcept {
+    if !consteval {
+      __builtin_memmove(destination, source, count * sizeof(CharT));
+      return;
+    }
+
+    // backwards only if destination starts inside source, as unrelated pointers can't be ordered
+    if (isWithin(static_cast<const CharT*>(destination), source, count)) {
+      for (size_t index = count; index > 0; --index)
+        destination[index - 1] = source[index - 1];
+    }
+    else {
+      for (size_t index = 0; index < count; ++index)
+        destination[index] = source[index];
+    }
+  }
+
+  // Tells if pointer points into [begin, begin + count). Unrelated pointers can't be
+  //  ordered in constant evaluation, but they can be compared for equality
+  template <typename CharT, typename = enable_if<is_char_type<CharT>>>
+  [[nodiscard]]
+  static constexpr bool isWithin(const CharT* pointer, const CharT* begin, size_t count) noexcept {
+    if !consteval {
+      return reinterpret_cast<uintptr_t>(pointer) - reinterpret_cast<uintptr_t>(begin) < count * sizeof(CharT);
+    }
+
+    for (size_t index = 0; index < count; ++index) {
+      if (pointer == begin + index)
+        return true;
+    }
+
+    return false;
+  }
+
+  // Sets up to this length are searched with SIMD, one comparison per code unit of set
+  static constexpr size_t SMALL_SET_LENGTH = 8;
+
+  template <typename CharT, typename = enable_if<is_char_type<CharT>>>
+  static constexpr ssize_t findAny(
+    const CharT* string, size_t string_length,
+    const CharT* set, size_t set_length
+  ) noexcept {
+#if _RHLIB_SIMD_SSE2
+    if !consteval {
+      if constexpr (sizeof(CharT) == sizeof(uint32_t)) {
+        if (set_length <= SMALL_SET_LENGTH)
+          return findAnyVector(string, string_length, set, set_length);
+      }
+    }
+#endif
+
+    return findAnyScalar(string, string_length, set, set_length);
+  }
+
+  template <typename CharT, typename = enable_if<is_char_type<CharT>>>
+  [[nodiscard]]
+  static constexpr bool isWhitespace(CharT character) noexcept {
+    return character == ' ' || (character >= '\t' && character <= '\r');
+  }
+
+  // Scalar versions. Used in constant evaluation and when SIMD is unavailable
+
+  template <typename CharT, typename = enable_if<is_char_type<CharT>>>
+  static constexpr size_t lengthScalar(const CharT* string) {
     size_t result = 0;
 
     while (*string)
@@ -29,7 +207,7 @@ struct StringUtils {
   }
 
   template <typename CharT, typename = enable_if<is_char_type<CharT>>>
-  static constexpr bool isSubStringEqual(const CharT* string, size_t index, const CharT* sub_string, size_t sub_string_length) noexcept {
+  static constexpr bool isSubStringEqualScalar(const CharT* string, size_t index, const CharT* sub_string, size_t sub_string_length) noexcept {
     for (
       size_t string_index = 0;
       string_index < sub_string_length;
@@ -43,318 +221,1045 @@ struct StringUtils {
   }
 
   template <typename CharT, typename = enable_if<is_char_type<CharT>>>
-  static constexpr ssize_t find(
+  static constexpr ssize_t findScalar(
     const CharT* string, size_t string_length,
-    const CharT* sub_string, size_t sub_string_length
+    CharT character
   ) noexcept {
-    if (sub_string_length == string_length)
-      return isSubStringEqual(string, 0, string, sub_string_length) ? 0 : -1;
-    else if (sub_string_length > string_length)
-      return -1;
+    for (size_t index = 0; index < string_length; ++index) {
+      if (string[index] == character)
+        return index;
+    }
 
-    for (size_t search_end = string_length - sub_string_length, base_index = 0; base_index < search_end; ++base_index) {
-      if (isSubStringEqual(string, base_index, string, sub_string_length))
-        return base_index;
+    return -1;
+  }
+
+  template <typename CharT, typename = enable_if<is_char_type<CharT>>>
+  static constexpr ssize_t findAnyScalar(
+    const CharT* string, size_t string_length,
+    const CharT* set, size_t set_length
+  ) noexcept {
+    for (size_t index = 0; index < string_length; ++index) {
+      for (size_t set_index = 0; set_index < set_length; ++set_index) {
+        if (string[index] == set[set_index])
+          return index;
+      }
     }
 
     return -1;
   }
 
   template <typename CharT, typename = enable_if<is_char_type<CharT>>>
-  static constexpr ssize_t find(
+  static constexpr ssize_t findShortScalar(
+    const CharT* string, size_t string_length,
+    const CharT* sub_string, size_t sub_string_length
+  ) noexcept {
+    for (size_t index = 0; index + sub_string_length <= string_length; ++index) {
+      if (string[index] == sub_string[0] && isSubStringEqual(string, index, sub_string, sub_string_length))
+        return index;
+    }
+
+    return -1;
+  }
+
+#if _RHLIB_SIMD_SSE2
+  // Vector versions. Only for 32-bit code units, compare Vector32::LANES of them at once
+
+  // Uses aligned loads, so it may read past the terminator, but never into the next page
+  template <typename CharT, typename = enable_if<sizeof(CharT) == sizeof(uint32_t)>>
+  _RHLIB_NO_SANITIZE_ADDRESS
+  static inline size_t lengthVector(const CharT* string) noexcept {
+    using V = Vector32;
+
+    const CharT* it = string;
+
+    for (; reinterpret_cast<uintptr_t>(it) % V::SIZE != 0; ++it) {
+      if (!*it)
+        return static_cast<size_t>(it - string);
+    }
+
+    const V::type zero = V::broadcast(0);
+
+    for (;; it += V::LANES) {
+      uint32_t mask = V::equalMask(V::loadAligned(it), zero);
+      if (mask)
+        return static_cast<size_t>(it - string) + V::lane(mask);
+    }
+  }
+
+  template <typename CharT, typename = enable_if<sizeof(CharT) == sizeof(uint32_t)>>
+  static inline bool isSubStringEqualVector(const CharT* string, size_t index, const CharT* sub_string, size_t sub_string_length) noexcept {
+    using V = Vector32;
+
+    string += index;
+
+    size_t offset = 0;
+
+    for (; offset + V::LANES <= sub_string_length; offset += V::LANES) {
+      if (V::equalMask(V::load(string + offset), V::load(sub_string + offset)) != V::FULL_MASK)
+        return false;
+    }
+
+    for (; offset < sub_string_length; ++offset) {
+      if (string[offset] != sub_string[offset])
+        return false;
+    }
+
+    return true;
+  }
+
+  template <typename CharT, typename = enable_if<sizeof(CharT) == sizeof(uint32_t)>>
+  static inline ssize_t findVector(
     const CharT* string, size_t string_length,
     CharT character
   ) noexcept {
-    for (size_t index = 0; index < string_length; ++index) {
+    using V = Vector32;
+
+    const V::type needle = V::broadcast(static_cast<uint32_t>(character));
+
+    size_t index = 0;
+
+    for (; index + V::LANES <= string_length; index += V::LANES) {
+      uint32_t mask = V::equalMask(V::load(string + index), needle);
+      if (mask)
+        return index + V::lane(mask);
+    }
+
+    for (; index < string_length; ++index) {
       if (string[index] == character)
         return index;
     }
 
     return -1;
   }
+
+  // set_length must be at most SMALL_SET_LENGTH
+  template <typename CharT, typename = enable_if<sizeof(CharT) == sizeof(uint32_t)>>
+  static inline ssize_t findAnyVector(
+    const CharT* string, size_t string_length,
+    const CharT* set, size_t set_length
+  ) noexcept {
+    using V = Vector32;
+
+    V::type needles[SMALL_SET_LENGTH];
+
+    for (size_t set_index = 0; set_index < set_length; ++set_index)
+      needles[set_index] = V::broadcast(static_cast<uint32_t>(set[set_index]));
+
+    size_t index = 0;
+
+    for (; index + V::LANES <= string_length; index += V::LANES) {
+      const V::type chunk = V::load(string + index);
+      uint32_t mask = 0;
+
+      for (size_t set_index = 0; set_index < set_length; ++set_index)
+        mask |= V::equalMask(chunk, needles[set_index]);
+
+      if (mask)
+        return index + V::lane(mask);
+    }
+
+    ssize_t tail = findAnyScalar(string + index, string_length - index, set, set_length);
+
+    return tail == -1 ? -1 : static_cast<ssize_t>(index) + tail;
+  }
+
+  // Filters candidates by the first and the last code unit of sub-string, then verifies them.
+  // sub_string_length must be in [2, string_length]
+  template <typename CharT, typename = enable_if<sizeof(CharT) == sizeof(uint32_t)>>
+  static inline ssize_t findShortVector(
+    const CharT* string, size_t string_length,
+    const CharT* sub_string, size_t sub_string_length
+  ) noexcept {
+    using V = Vector32;
+
+    size_t last_offset = sub_string_length - 1;
+
+    const V::type first = V::broadcast(static_cast<uint32_t>(sub_string[0]));
+    const V::type last = V::broadcast(static_cast<uint32_t>(sub_string[last_offset]));
+
+    size_t index = 0;
+
+    for (; index + last_offset + V::LANES <= string_length; index += V::LANES) {
+      uint32_t mask =
+        V::equalMask(V::load(string + index), first) &
+        V::equalMask(V::load(string + index + last_offset), last);
+
+      while (mask) {
+        uint32_t lowest_bit = countTrailingZeros(mask);
+        size_t candidate = index + lowest_bit / sizeof(uint32_t);
+
+        if (isSubStringEqual(string, candidate + 1, sub_string + 1, sub_string_length - 2))
+          return candidate;
+
+        mask &= ~(0xFu << lowest_bit);
+      }
+    }
+
+    for (; index + sub_string_length <= string_length; ++index) {
+      if (string[index] == sub_string[0] && isSubStringEqual(string, index, sub_string, sub_string_length))
+        return index;
+    }
+
+    return -1;
+  }
+#endif
+};
+
+// Two-Way string matching (Crochemore & Perrin), with a bad-character shift like in Boyer-Moore-Horspool.
+// Linear in the worst case, sublinear on average. Needle isn't copied, so it must outlive the searcher
+template <typename CharT>
+struct TwoWaySearcher {
+  // Code units are bucketed by the low byte. Shift table stays conservative
+  //  because it remembers the last position of any code unit from bucket
+  static constexpr size_t BUCKETS = 256;
+
+  const CharT* needle           = nullptr;
+  size_t       length           = 0;
+  size_t       criticalPosition = 0;
+  size_t       period           = 0;
+  size_t       memoryAfterShift = 0;
+
+  // position + 1 of the last code unit from bucket, 0 if there's none
+  size_t lastPositions[BUCKETS] = {};
+
+  constexpr TwoWaySearcher() noexcept = default;
+
+  // length must be non-zero
+  constexpr TwoWaySearcher(const CharT* needle, size_t length) noexcept
+    : needle(needle), length(length)
+  {
+    for (size_t i = 0; i < length; ++i)
+      lastPositions[bucket(needle[i])] = i + 1;
+
+    size_t period_forward;
+    size_t suffix_forward = maximalSuffix(false, period_forward);
+    size_t period_backward;
+    size_t suffix_backward = maximalSuffix(true, period_backward);
+
+    // indices start at -1, so compare them shifted by one
+    if (suffix_backward + 1 > suffix_forward + 1) {
+      criticalPosition = suffix_backward;
+      period = period_backward;
+    }
+    else {
+      criticalPosition = suffix_forward;
+      period = period_forward;
+    }
+
+    if (StringUtils::isSubStringEqual(needle, period, needle, criticalPosition + 1))
+      memoryAfterShift = length - period; // periodic needle
+    else {
+      memoryAfterShift = 0;
+      period = max(criticalPosition, length - criticalPosition - 1) + 1;
+    }
+  }
+
+  [[nodiscard]]
+  constexpr ssize_t find(const CharT* string, size_t string_length) const noexcept {
+    size_t position = 0;
+    size_t memory = 0;
+
+    while (position + length <= string_length) {
+      const CharT* window = string + position;
+
+      size_t last_position = lastPositions[bucket(window[length - 1])];
+
+      if (last_position == 0) {
+        position += length;
+        memory = 0;
+        continue;
+      }
+
+      if (size_t shift = length - last_position) {
+        position += shift < memory ? memory : shift;
+        memory = 0;
+        continue;
+      }
+
+      // right half
+      size_t index = max(criticalPosition + 1, memory);
+
+      while (index < length && needle[index] == window[index])
+        ++index;
+
+      if (index < length) {
+        position += index - criticalPosition;
+        memory = 0;
+        continue;
+      }
+
+      // left half
+      index = criticalPosition + 1;
+
+      while (index > memory && needle[index - 1] == window[index - 1])
+        --index;
+
+      if (index <= memory)
+        return static_cast<ssize_t>(position);
+
+      position += period;
+      memory = memoryAfterShift;
+    }
+
+    return -1;
+  }
+
+  [[nodiscard]]
+  static constexpr size_t bucket(CharT character) noexcept {
+    return static_cast<uint32_t>(character) & (BUCKETS - 1);
+  }
+
+private:
+  // Returns starting index - 1 (may wrap around to SIZE_MAX) of the maximal suffix
+  constexpr size_t maximalSuffix(bool reversed_order, size_t& out_period) const noexcept {
+    size_t suffix = static_cast<size_t>(-1);
+    size_t candidate = 0;
+    size_t offset = 1;
+    size_t period = 1;
+
+    while (candidate + offset < length) {
+      CharT a = needle[suffix + offset];
+      CharT b = needle[candidate + offset];
+
+      if (a == b) {
+        if (offset == period) {
+          candidate += period;
+          offset = 1;
+        }
+        else {
+          ++offset;
+        }
+      }
+      else if (reversed_order ? a < b : a > b) {
+        candidate += offset;
+        offset = 1;
+        period = candidate - suffix;
+      }
+      else {
+        suffix = candidate++;
+        offset = period = 1;
+      }
+    }
+
+    out_period = period;
+    return suffix;
+  }
+};
+
+// Delimiters of BasicSplitRange. find() gives position and length of the next delimiter,
+//  piece() adjusts a piece before it's yielded
+struct DelimiterMatch {
+  ssize_t index;
+  size_t  length;
+};
+
+template <typename CharT>
+struct CharacterDelimiter {
+  static constexpr bool SKIPS_LAST_EMPTY_PIECE = false;
+
+  CharT character;
+
+  [[nodiscard]]
+  constexpr DelimiterMatch find(const CharT* string, size_t string_length) const noexcept {
+    return { StringUtils::find(string, string_length, character), 1 };
+  }
+
+  [[nodiscard]]
+  static constexpr BasicStringView<CharT> piece(BasicStringView<CharT> piece) noexcept {
+    return piece;
+  }
+};
+
+// Empty delimiter doesn't split anything
+template <typename CharT>
+struct SubStringDelimiter {
+  static constexpr bool SKIPS_LAST_EMPTY_PIECE = false;
+
+  const CharT* subString;
+  size_t       length;
+
+  [[nodiscard]]
+  constexpr DelimiterMatch find(const CharT* string, size_t string_length) const noexcept {
+    if (length == 0)
+      return { -1, 0 };
+
+    return { StringUtils::find(string, string_length, subString, length), length };
+  }
+
+  [[nodiscard]]
+  static constexpr BasicStringView<CharT> piece(BasicStringView<CharT> piece) noexcept {
+    return piece;
+  }
+};
+
+template <typename CharT>
+struct AnyCharacterDelimiter {
+  static constexpr bool SKIPS_LAST_EMPTY_PIECE = false;
+
+  const CharT* set;
+  size_t       length;
+
+  [[nodiscard]]
+  constexpr DelimiterMatch find(const CharT* string, size_t string_length) const noexcept {
+    return { StringUtils::findAny(string, string_length, set, length), 1 };
+  }
+
+  [[nodiscard]]
+  static constexpr BasicStringView<CharT> piece(BasicStringView<CharT> piece) noexcept {
+    return piece;
+  }
+};
+
+// "\n" and "\r\n", text ending with a line break has no empty line after it
+template <typename CharT>
+struct LineDelimiter {
+  static constexpr bool SKIPS_LAST_EMPTY_PIECE = true;
+
+  [[nodiscard]]
+  constexpr DelimiterMatch find(const CharT* string, size_t string_length) const noexcept {
+    return { StringUtils::find(string, string_length, static_cast<CharT>('\n')), 1 };
+  }
+
+  [[nodiscard]]
+  static constexpr BasicStringView<CharT> piece(BasicStringView<CharT> piece) noexcept {
+    if (!piece.isEmpty() && piece[piece.length() - 1] == '\r')
+      return BasicStringView<CharT>{piece.data(), piece.length() - 1};
+
+    return piece;
+  }
 };
 
 _RHLIB_HIDDEN_END
 
-class StringView {
+template <typename CharT>
+class BasicStringView {
+public:
+  using value_type = CharT;
+
 private:
-  char32_t const* m_string = U"";
+  CharT const* m_string = _RHLIBH StringUtils::EMPTY_STRING<CharT>;
+  size_t       m_length = 0;
 
 public:
-  constexpr StringView() noexcept = default;
+  constexpr BasicStringView() noexcept = default;
+
+  constexpr BasicStringView(const CharT* string) noexcept
+    : m_string(string ? string : _RHLIBH StringUtils::EMPTY_STRING<CharT>),
+      m_length(string ? _RHLIBH StringUtils::length(string) : 0) {}
 
-  constexpr StringView(const char32_t* string) noexcept
-    : m_string(string) {}
+  // string doesn't have to be null-terminated
+  constexpr BasicStringView(const CharT* string, size_t string_length) noexcept
+    : m_string(string ? string : _RHLIBH StringUtils::EMPTY_STRING<CharT>),
+      m_length(string ? string_length : 0) {}
 
 #ifndef _RHLIB_NO_STL_COMPAT
-  constexpr StringView(std::u32string_view string) noexcept
-    : m_string(string.data()) {}
+  constexpr BasicStringView(std::basic_string_view<CharT> string) noexcept
+    : BasicStringView(string.data(), string.length()) {}
 
-  constexpr StringView(std::u32string const& string) noexcept
-    : m_string(string.data()) {}
+  constexpr BasicStringView(std::basic_string<CharT> const& string) noexcept
+    : BasicStringView(string.data(), string.length()) {}
 #endif
 
-  constexpr StringView(StringView const& other) noexcept
-    : m_string(other.m_string) {}
-    
-  constexpr StringView(StringView&& other) noexcept
-    : m_string(other.m_string)
-  {
-    other.m_string = U"";
+  constexpr BasicStringView(BasicStringView const& other) noexcept
+    : m_string(other.m_string), m_length(other.m_length) {}
+    
+  constexpr BasicStringView(BasicStringView&& other) noexcept
+    : m_string(other.m_string), m_length(other.m_length)
+  {
+    other.m_string = _RHLIBH StringUtils::EMPTY_STRING<CharT>;
+    other.m_length = 0;
+  }
+
+  constexpr BasicStringView& operator=(BasicStringView const& other) {
+    m_string = other.m_string;
+    m_length = other.m_length;
+    return *this;
+  }
+
+  constexpr BasicStringView& operator=(BasicStringView&& other) noexcept {
+    m_string = other.m_string;
+    m_length = other.m_length;
+    other.m_string = _RHLIBH StringUtils::EMPTY_STRING<CharT>;
+    other.m_length = 0;
+    return *this;
+  }
+
+public:
+  // NOTE: view isn't guaranteed to be null-terminated (e.g. after subView())
+  constexpr operator const CharT*() const noexcept {
+    return m_string;
+  }
+
+#ifndef _RHLIB_NO_STL_COMPAT
+  constexpr operator std::basic_string_view<CharT>() const noexcept {
+    return std::basic_string_view<CharT>{m_string, m_length};
+  }
+  constexpr operator std::basic_string<CharT>() const noexcept {
+    return std::basic_string<CharT>{m_string, m_length};
+  }
+
+#endif
+
+public:
+  [[nodiscard]]
+  constexpr const CharT* data() const noexcept {
+    return m_string;
+  }
+
+  [[nodiscard]]
+  constexpr const CharT* begin() const noexcept {
+    return m_string;
+  }
+
+  [[nodiscard]]
+  constexpr const CharT* end() const noexcept {
+    return m_string + m_length;
+  }
+
+  [[nodiscard]]
+  constexpr bool isEmpty() const noexcept {
+    return m_length == 0;
+  }
+
+  [[nodiscard]]
+  constexpr size_t length() const noexcept {
+    return m_length;
+  }
+
+  // Out of range parts are clipped
+  [[nodiscard]]
+  constexpr BasicStringView subView(size_t index, size_t count) const noexcept {
+    if (index > m_length)
+      index = m_length;
+
+    if (count > m_length - index)
+      count = m_length - index;
+
+    return BasicStringView{m_string + index, count};
+  }
+
+  [[nodiscard]]
+  constexpr BasicStringView subView(size_t index) const noexcept {
+    return subView(index, m_length);
+  }
+
+  [[nodiscard]]
+  constexpr bool startsWith(const CharT* string, size_t string_length) const noexcept {
+    if (string_length > m_length)
+      return false;
+
+    return _RHLIBH StringUtils::isSubStringEqual(m_string, 0, string, string_length);
+  }
+
+  [[nodiscard]]
+  constexpr bool startsWith(BasicStringView string) const noexcept {
+    return startsWith(string.data(), string.length());
+  }
+
+  [[nodiscard]]
+  constexpr bool endsWith(const CharT* string, size_t string_length) const noexcept {
+    if (string_length > m_length)
+      return false;
+
+    return _RHLIBH StringUtils::isSubStringEqual(m_string, m_length - string_length, string, string_length);
+  }
+
+  [[nodiscard]]
+  constexpr bool endsWith(BasicStringView string) const noexcept {
+    return endsWith(string.data(), string.length());
+  }
+  
+  [[nodiscard]]
+  constexpr ssize_t find(const CharT* string, size_t string_length) const noexcept {
+    return _RHLIBH StringUtils::find(m_string, m_length, string, string_length);
+  }
+  
+  [[nodiscard]]
+  constexpr ssize_t find(CharT character) const noexcept {
+    return _RHLIBH StringUtils::find(m_string, m_length, character);
+  }
+
+  [[nodiscard]]
+  constexpr ssize_t find(BasicStringView string) const noexcept {
+    return find(string.data(), string.length());
+  }
+
+  [[nodiscard]]
+  constexpr bool contains(const CharT* string, size_t string_length) const noexcept {
+    return find(string, string_length) != -1;
+  }
+
+  [[nodiscard]]
+  constexpr bool contains(CharT character) const noexcept {
+    return find(character) != -1;
   }
 
-  constexpr StringView& operator=(StringView const& other) {
-    m_string = other.m_string;
-    return *this;
+  [[nodiscard]]
+  constexpr bool contains(BasicStringView string) const noexcept {
+    return contains(string.data(), string.length());
   }
 
-  constexpr StringView& operator=(StringView&& other) noexcept {
-    m_string = other.m_string;
-    other.m_string = U"";
-    return *this;
+  // Position of the first code unit, which is any of "set"
+  [[nodiscard]]
+  constexpr ssize_t findAny(BasicStringView set) const noexcept {
+    return _RHLIBH StringUtils::findAny(m_string, m_length, set.data(), set.length());
   }
 
-public:
-  constexpr operator const char32_t*() const noexcept {
-    return m_string;
+  // Lazy ranges of views into this string, nothing is copied or allocated.
+  // Like in most languages, "a,,b," split by ',' gives "a", "", "b", ""
+  [[nodiscard]]
+  constexpr BasicSplitRange<CharT, _RHLIBH CharacterDelimiter<CharT>> split(CharT delimiter) const noexcept {
+    return { *this, { delimiter } };
   }
 
-#ifndef _RHLIB_NO_STL_COMPAT
-  constexpr operator std::u32string_view() const noexcept {
-    return std::u32string_view{m_string};
+  // Delimiter must outlive the range
+  [[nodiscard]]
+  constexpr BasicSplitRange<CharT, _RHLIBH SubStringDelimiter<CharT>> split(BasicStringView delimiter) const noexcept {
+    return { *this, { delimiter.data(), delimiter.length() } };
   }
-  constexpr operator std::u32string() const noexcept {
-    return std::u32string{m_string};
+
+  // Splits by any code unit of "set", set must outlive the range
+  [[nodiscard]]
+  constexpr BasicSplitRange<CharT, _RHLIBH AnyCharacterDelimiter<CharT>> splitAny(BasicStringView set) const noexcept {
+    return { *this, { set.data(), set.length() } };
   }
 
-#endif
+  // Lines without their "\n" or "\r\n"
+  [[nodiscard]]
+  constexpr BasicSplitRange<CharT, _RHLIBH LineDelimiter<CharT>> lines() const noexcept {
+    return { *this, {} };
+  }
 
-public:
+  // Without leading and trailing whitespace
   [[nodiscard]]
-  constexpr const char32_t* data() const noexcept {
-    return m_string;
+  constexpr BasicStringView trim() const noexcept {
+    return trimStart().trimEnd();
   }
 
   [[nodiscard]]
-  constexpr const char32_t* begin() const noexcept {
-    return m_string;
+  constexpr BasicStringView trimStart() const noexcept {
+    size_t index = 0;
+
+    while (index < m_length && _RHLIBH StringUtils::isWhitespace(m_string[index]))
+      ++index;
+
+    return BasicStringView{m_string + index, m_length - index};
   }
 
   [[nodiscard]]
-  constexpr const char32_t* end() const noexcept {
-    return m_string + length();
+  constexpr BasicStringView trimEnd() const noexcept {
+    size_t length = m_length;
+
+    while (length > 0 && _RHLIBH StringUtils::isWhitespace(m_string[length - 1]))
+      --length;
+
+    return BasicStringView{m_string, length};
   }
 
+  // Same value at compile time and at runtime, and for String with the same characters
   [[nodiscard]]
-  constexpr bool isEmpty() const noexcept {
-    return m_string ? !m_string[0] : true;
+  constexpr uint64_t hash(uint64_t seed = 0) const noexcept {
+    return ::rh::hash::units(m_string, m_length, seed);
   }
 
+  // Lexicographic order of code units: negative, zero or positive
   [[nodiscard]]
-  constexpr size_t length() const noexcept {
-    return m_string ? _RHLIBH StringUtils::length(m_string) : 0;
+  constexpr int compare(BasicStringView string) const noexcept {
+    using UnitT = conditional<sizeof(CharT) == 1, uint8_t, conditional<sizeof(CharT) == 2, uint16_t, uint32_t>>;
+
+    size_t common_length = m_length < string.length() ? m_length : string.length();
+
+    for (size_t index = 0; index < common_length; ++index) {
+      UnitT left  = static_cast<UnitT>(m_string[index]);
+      UnitT right = static_cast<UnitT>(string.data()[index]);
+
+      if (left != right)
+        return left < right ? -1 : 1;
+    }
+
+    if (m_length == string.length())
+      return 0;
+
+    return m_length < string.length() ? -1 : 1;
   }
 
+public:
   [[nodiscard]]
-  constexpr bool startsWith(const char32_t* string, size_t string_length) const noexcept {
-    if (string_length > length())
+  constexpr bool operator==(BasicStringView string) const noexcept {
+    if (m_length != string.length())
       return false;
 
-    return _RHLIBH StringUtils::isSubStringEqual(m_string, 0, string, string_length);
+    return _RHLIBH StringUtils::isSubStringEqual(m_string, 0, string.data(), string.length());
   }
 
   [[nodiscard]]
-  constexpr bool startsWith(StringView string) const noexcept {
-    return startsWith(string.data(), string.length());
+  constexpr bool operator==(const CharT* string) const noexcept {
+    return *this == BasicStringView{string};
   }
 
   [[nodiscard]]
-  constexpr bool endsWith(const char32_t* string, size_t string_length) const noexcept {
-    size_t length = this->length();
-
-    if (string_length > length)
-      return false;
+  constexpr bool operator!=(BasicStringView string) const noexcept {
+    return !operator==(string);
+  }
 
-    return _RHLIBH StringUtils::isSubStringEqual(m_string, length - string_length, string, string_length);
+  [[nodiscard]]
+  constexpr bool operator!=(const CharT* string) const noexcept {
+    return !operator==(string);
   }
 
+  // Without these views would be ordered as pointers
   [[nodiscard]]
-  constexpr bool endsWith(StringView string) const noexcept {
-    return endsWith(string.data(), string.length());
+  constexpr bool operator<(BasicStringView string) const noexcept {
+    return compare(string) < 0;
   }
-  
+
   [[nodiscard]]
-  constexpr ssize_t find(const char32_t* string, size_t string_length) const noexcept {
-    return _RHLIBH StringUtils::find(m_string, length(), string, string_length);
+  constexpr bool operator<(const CharT* string) const noexcept {
+    return compare(BasicStringView{string}) < 0;
   }
-  
+
+  template <typename AllocatorT>
   [[nodiscard]]
-  constexpr ssize_t find(char32_t character) const noexcept {
-    return _RHLIBH StringUtils::find(m_string, length(), character);
+  constexpr bool operator<(BasicString<CharT, AllocatorT> const& string) const noexcept {
+    return compare(BasicStringView{string}) < 0;
   }
 
   [[nodiscard]]
-  constexpr ssize_t find(StringView string) const noexcept {
-    return find(string.data(), string.length());
+  constexpr CharT operator[](size_t index) const noexcept {
+    return m_string[index];
   }
+};
+
+// Lazy sequence of pieces between delimiters. Pieces are views into the original string,
+//  so it must outlive the range
+template <typename CharT, typename DelimiterT>
+class BasicSplitRange {
+public:
+  using type       = BasicSplitRange;
+  using value_type = BasicStringView<CharT>;
+
+  class Iterator {
+  private:
+    const BasicSplitRange* m_range           = nullptr;
+    const CharT*           m_piece           = nullptr;
+    size_t                 m_pieceLength     = 0;
+    size_t                 m_delimiterLength = 0;
+    bool                   m_isLast          = true;
+    bool                   m_isDone          = true;
+
+  public:
+    // End of any range
+    constexpr Iterator() noexcept = default;
+
+    constexpr Iterator(const BasicSplitRange* range) noexcept
+      : m_range(range), m_piece(range->m_string.data()), m_isDone(false)
+    {
+      _findPiece();
+    }
+
+  public:
+    [[nodiscard]]
+    constexpr value_type operator*() const noexcept {
+      return DelimiterT::piece(value_type{m_piece, m_pieceLength});
+    }
 
+    constexpr Iterator& operator++() noexcept {
+      if (m_isLast) {
+        m_isDone = true;
+        return *this;
+      }
+
+      m_piece += m_pieceLength + m_delimiterLength;
+      _findPiece();
+
+      return *this;
+    }
+
+    constexpr Iterator operator++(int) noexcept {
+      Iterator previous = *this;
+      ++*this;
+      return previous;
+    }
+
+    [[nodiscard]]
+    constexpr bool operator==(Iterator const& other) const noexcept {
+      if (m_isDone || other.m_isDone)
+        return m_isDone == other.m_isDone;
+
+      return m_piece == other.m_piece;
+    }
+
+    [[nodiscard]]
+    constexpr bool operator!=(Iterator const& other) const noexcept {
+      return !operator==(other);
+    }
+
+  private:
+    constexpr void _findPiece() noexcept {
+      const CharT* end = m_range->m_string.end();
+      size_t rest_length = static_cast<size_t>(end - m_piece);
+
+      _RHLIBH DelimiterMatch match = m_range->m_delimiter.find(m_piece, rest_length);
+
+      if (match.index == -1) {
+        m_pieceLength = rest_length;
+        m_delimiterLength = 0;
+        m_isLast = true;
+
+        if constexpr (DelimiterT::SKIPS_LAST_EMPTY_PIECE)
+          m_isDone = rest_length == 0;
+      }
+      else {
+        m_pieceLength = static_cast<size_t>(match.index);
+        m_delimiterLength = match.length;
+        m_isLast = false;
+      }
+    }
+  };
+
+private:
+  value_type m_string;
+  DelimiterT m_delimiter;
+
+public:
+  constexpr BasicSplitRange(value_type string, DelimiterT delimiter) noexcept
+    : m_string(string), m_delimiter(delimiter) {}
+
+public:
   [[nodiscard]]
-  constexpr bool contains(const char32_t* string, size_t string_length) const noexcept {
-    return find(string, string_length) != -1;
+  constexpr Iterator begin() const noexcept {
+    return Iterator{this};
   }
 
   [[nodiscard]]
-  constexpr bool contains(char32_t character) const noexcept {
-    return find(character) != -1;
+  constexpr Iterator end() const noexcept {
+    return Iterator{};
   }
 
+  // Walks the whole range
   [[nodiscard]]
-  constexpr bool contains(StringView string) const noexcept {
-    return contains(string.data(), string.length());
+  constexpr size_t count() const noexcept {
+    size_t result = 0;
+
+    for (Iterator it = begin(); it != end(); ++it)
+      ++result;
+
+    return result;
+  }
+};
+
+// Precomputed search for one needle over many strings.
+// Needle isn't copied, so it must outlive the searcher
+class Searcher {
+private:
+  StringView                       m_needle;
+  _RHLIBH TwoWaySearcher<char32_t> m_engine;
+
+public:
+  constexpr Searcher(StringView needle) noexcept
+    : m_needle(needle)
+  {
+    if (needle.length() > _RHLIBH StringUtils::SHORT_NEEDLE_LENGTH)
+      m_engine = _RHLIBH TwoWaySearcher<char32_t>{needle.data(), needle.length()};
   }
 
 public:
   [[nodiscard]]
-  constexpr bool operator==(StringView string) const noexcept {
-    return _RHLIBH StringUtils::isSubStringEqual(m_string, 0, string.data(), string.length());
+  constexpr StringView needle() const noexcept {
+    return m_needle;
   }
 
   [[nodiscard]]
-  constexpr bool operator!=(StringView string) const noexcept {
-    return !operator==(string);
+  constexpr ssize_t find(StringView string) const noexcept {
+    if (m_needle.length() <= _RHLIBH StringUtils::SHORT_NEEDLE_LENGTH)
+      return _RHLIBH StringUtils::findShort(string.data(), string.length(), m_needle.data(), m_needle.length());
+
+    return m_engine.find(string.data(), string.length());
   }
 
   [[nodiscard]]
-  constexpr char32_t operator[](size_t index) const noexcept {
-    return m_string[index];
+  constexpr bool contains(StringView string) const noexcept {
+    return find(string) != -1;
   }
 };
 
-class String {
+// Heap buffers come from AllocatorT, except during constant evaluation.
+// Allocator travels with the buffer on move, copy assignment keeps own allocator
+template <typename CharT, Allocator AllocatorT>
+class BasicString {
+public:
+  using value_type     = CharT;
+  using view_type      = BasicStringView<CharT>;
+  using allocator_type = AllocatorT;
+
+  // Capacity (including null-terminator) of the buffer stored inside the object itself
+  static constexpr size_t INLINE_CAPACITY = 4 * sizeof(void*) / sizeof(CharT);
+
 private:
-  char32_t* m_buffer    = nullptr;
-  size_t    m_allocated = 0;
+  template <typename>
+  friend class BasicSharedString;
+
+  static constexpr bool IS_DEFAULT_ALLOCATOR = is_same_type<AllocatorT, DefaultAllocator>;
+
+  struct InlineBuffer {
+    CharT chars[INLINE_CAPACITY] = {};
+  };
+
+  // "local" is active while m_allocated == INLINE_CAPACITY, "heap" otherwise
+  struct Storage {
+    union {
+      InlineBuffer local = {};
+      CharT*       heap;
+    };
+  };
+
+  // stateless allocator takes no space
+  CompressedPair<AllocatorT, Storage> m_storage;
+  size_t  m_length    = 0;
+  size_t  m_allocated = INLINE_CAPACITY;
 
 public:
-  constexpr String() noexcept = default;
+  constexpr BasicString() noexcept = default;
 
-  constexpr String(StringView string)
-    : String(string.data(), string.length()) {}
+  constexpr explicit BasicString(AllocatorT const& allocator) noexcept
+    : m_storage(allocator, Storage{}) {}
+
+  constexpr BasicString(view_type string)
+    : BasicString(string.data(), string.length()) {}
+
+  constexpr BasicString(view_type string, AllocatorT const& allocator)
+    : BasicString(allocator)
+  {
+    *this = string;
+  }
 
-  constexpr String(const char32_t* string, size_t string_length_in_chars)
-    : String()
+  constexpr BasicString(const CharT* string, size_t string_length_in_chars)
+    : BasicString()
   {
     _needAllocated(string_length_in_chars + 1);
 
-    for (size_t index = 0; index < string_length_in_chars; ++index)
-      m_buffer[index] = string[index];
+    _RHLIBH StringUtils::copyUnits(data(), string, string_length_in_chars);
 
-    m_buffer[string_length_in_chars] = 0;
+    _setLength(string_length_in_chars);
   }
 
-  constexpr String(size_t count, char32_t character = 0)
-    : String()
+  constexpr BasicString(size_t count, CharT character = 0)
+    : BasicString()
   {
-    _needAllocated(count);
+    _needAllocated(count + 1);
 
     for (size_t i = 0; i < count; ++i)
-      m_buffer[i] = character;
+      data()[i] = character;
+
+    _setLength(count);
   }
 
-  constexpr String(String const& other) : String() {
+  constexpr BasicString(BasicString const& other)
+    : BasicString(other.m_storage.getFirst())
+  {
     operator=(other);
   }
 
-  constexpr String(String&& other) noexcept {
+  constexpr BasicString(BasicString&& other) noexcept
+    : m_storage(move(other.m_storage.getFirst()), Storage{})
+  {
     _stealOther(other);
   }
 
-  constexpr String& operator=(String const& other) {
-    *this = StringView{other};
+  constexpr BasicString& operator=(BasicString const& other) {
+    *this = view_type{other};
     return *this;
   }
 
-  constexpr String& operator=(StringView other) {
+  constexpr BasicString& operator=(view_type other) {
     size_t length = other.length();
 
     _needAllocated(length + 1);
 
-    for (size_t i = 0; i < length; ++i)
-      m_buffer[i] = other[i];
+    // other may be a part of this string
+    _RHLIBH StringUtils::moveUnits(data(), other.data(), length);
 
-    m_buffer[length] = 0;
+    _setLength(length);
 
     return *this;
   }
 
-  constexpr String& operator=(String&& other) noexcept {
-    String::~String();
+  constexpr BasicString& operator=(BasicString&& other) noexcept {
+    BasicString::~BasicString();
+    m_storage.getFirst() = move(other.m_storage.getFirst());
     _stealOther(other);
     return *this;
   }
 
-  constexpr ~String() {
-    _reallocate(0);
+  constexpr ~BasicString() {
+    if (!_isInline())
+      _freeHeap(m_storage.getFirst(), m_storage.heap, m_allocated);
+  }
+
+public:
+  [[nodiscard]]
+  constexpr AllocatorT const& allocator() const noexcept {
+    return m_storage.getFirst();
   }
 
 public:
-  constexpr operator StringView() const noexcept {
-    return StringView(m_buffer);
+  constexpr operator view_type() const noexcept {
+    return view_type(data(), m_length);
   }
 
-  constexpr operator const char32_t*() const noexcept {
-    return m_buffer;
+  constexpr operator const CharT*() const noexcept {
+    return data();
   }
 
 #ifndef _RHLIB_NO_STL_COMPAT
-  constexpr operator std::u32string_view() const noexcept {
-    return std::u32string_view{m_buffer};
+  constexpr operator std::basic_string_view<CharT>() const noexcept {
+    return std::basic_string_view<CharT>{data(), m_length};
   }
 
-  constexpr operator std::u32string() const noexcept {
-    return std::u32string{m_buffer};
+  constexpr operator std::basic_string<CharT>() const noexcept {
+    return std::basic_string<CharT>{data(), m_length};
   }
 #endif
 
 public:
   [[nodiscard]]
-  constexpr char32_t* data() noexcept {
-    return m_buffer;
+  constexpr CharT* data() noexcept {
+    return _isInline() ? m_storage.local.chars : m_storage.heap;
   }
 
   [[nodiscard]]
-  constexpr const char32_t* data() const noexcept {
-    return m_buffer;
+  constexpr const CharT* data() const noexcept {
+    return _isInline() ? m_storage.local.chars : m_storage.heap;
   }
 
   [[nodiscard]]
-  constexpr char32_t* begin() noexcept {
-    return m_buffer;
+  constexpr CharT* begin() noexcept {
+    return data();
   }
 
   [[nodiscard]]
-  constexpr const char32_t* begin() const noexcept {
-    return m_buffer;
+  constexpr const CharT* begin() const noexcept {
+    return data();
   }
 
   [[nodiscard]]
-  constexpr char32_t* end() noexcept {
-    return m_buffer + length();
+  constexpr CharT* end() noexcept {
+    return data() + m_length;
   }
 
   [[nodiscard]]
-  constexpr const char32_t* end() const noexcept {
-    return m_buffer + length();
+  constexpr const CharT* end() const noexcept {
+    return data() + m_length;
   }
 
   [[nodiscard]]
   constexpr bool isEmpty() const noexcept {
-    return m_buffer ? !m_buffer[0] : true;
+    return m_length == 0;
   }
 
   [[nodiscard]]
   constexpr size_t length() const noexcept {
-    return m_buffer ? _RHLIBH StringUtils::length(m_buffer) : 0;
+    return m_length;
   }
 
   constexpr void reserve(size_t count) {
@@ -367,56 +1272,78 @@ public:
   }
 
   constexpr void shrinkToFit() {
-    size_t minimal = length() + 1;
+    size_t minimal = m_length + 1;
     if (m_allocated > minimal)
       _reallocate(minimal);
   }
 
   constexpr void clear() noexcept {
-    if (m_buffer)
-      m_buffer[0] = 0;
+    _setLength(0);
+  }
+
+  // Defined in rh/SharedString.hpp.
+  // Heap buffer is handed over without copying, string becomes empty.
+  // Strings with own allocator are copied
+  [[nodiscard]]
+  BasicSharedString<CharT> share() &&;
+
+  [[nodiscard]]
+  BasicSharedString<CharT> share() const&;
+
+  // new characters are filled with "character"
+  constexpr void resize(size_t count, CharT character = 0) {
+    _needAllocated(count + 1);
+
+    for (size_t index = m_length; index < count; ++index)
+      data()[index] = character;
+
+    _setLength(count);
+  }
+
+  // New characters are left uninitialized, they must be written before reading.
+  // Makes sense when they're overwritten right away, e.g. by a transcoder
+  constexpr void resizeForOverwrite(size_t count) {
+    _needAllocated(count + 1);
+    _setLength(count);
   }
 
-  constexpr String& insert(size_t index, size_t count, char32_t character) {
-    size_t length = this->length();
+  constexpr BasicString& insert(size_t index, size_t count, CharT character) {
+    size_t length = m_length;
 
     _needAllocated(length + count + 1);
     _moveRight(index, length - index, count);
 
     for (size_t i = 0; i < count; ++i, ++index)
-      m_buffer[index] = character;
+      data()[index] = character;
 
-    length += count;
-    m_buffer[length] = 0;
+    _setLength(length + count);
 
     return *this;
   }
 
-  constexpr String& insert(size_t index, char32_t character) {
+  constexpr BasicString& insert(size_t index, CharT character) {
     return insert(index, 1, character);
   }
 
-  constexpr String& insert(size_t index, const char32_t* string, size_t string_length) {
-    size_t length = this->length();
+  constexpr BasicString& insert(size_t index, const CharT* string, size_t string_length) {
+    size_t length = m_length;
 
     _needAllocated(length + string_length + 1);
     _moveRight(index, length - index, string_length);
 
-    for (size_t i = 0; i < string_length; ++i, ++index)
-      m_buffer[index] = string[i];
+    _RHLIBH StringUtils::copyUnits(data() + index, string, string_length);
 
-    length += string_length;
-    m_buffer[length] = 0;
+    _setLength(length + string_length);
 
     return *this;
   }
 
-  constexpr String& insert(size_t index, StringView string) {
+  constexpr BasicString& insert(size_t index, view_type string) {
     return insert(index, string.data(), string.length());
   }
 
-  constexpr String& erase(size_t index, size_t count = 1) noexcept {
-    size_t length = this->length();
+  constexpr BasicString& erase(size_t index, size_t count = 1) noexcept {
+    size_t length = m_length;
 
     if (index >= length)
       return *this; // FIXME: throw exception
@@ -426,14 +1353,13 @@ public:
 
     _moveLeft(index + count, length - (index + count), count);
 
-    length -= count;
-    m_buffer[length] = 0;
+    _setLength(length - count);
 
     return *this;
   }
 
-  constexpr String& erase(const char32_t* it, size_t count = 1) noexcept {
-    ssize_t index = static_cast<ssize_t>(it - m_buffer);
+  constexpr BasicString& erase(const CharT* it, size_t count = 1) noexcept {
+    ssize_t index = static_cast<ssize_t>(it - data());
 
     if (index < 0)
       return *this; // FIXME: throw exception
@@ -441,168 +1367,249 @@ public:
     return erase(index, count);
   }
 
-  constexpr String& append(size_t count, char32_t character) {
-    size_t length = this->length();
+  constexpr BasicString& append(size_t count, CharT character) {
+    size_t length = m_length;
 
     _needAllocated(length + count + 1);
 
     for (size_t counter = 0, index = length; counter < count; ++counter, ++index)
-      m_buffer[index] = character;
+      data()[index] = character;
 
-    length += count;
-    m_buffer[length] = 0;
+    _setLength(length + count);
 
     return *this;
   }
 
-  constexpr String& append(char32_t character) {
+  constexpr BasicString& append(CharT character) {
     return append(1, character);
   }
 
-  constexpr String& append(const char32_t* string, size_t string_length_in_characters) {
-    size_t length = this->length();
+  constexpr BasicString& append(const CharT* string, size_t string_length_in_characters) {
+    size_t length = m_length;
+
+    // characters of this string move, when the buffer grows
+    if (_RHLIBH StringUtils::isWithin(string, data(), m_allocated)) {
+      size_t offset = static_cast<size_t>(string - data());
 
-    _needAllocated(length + string_length_in_characters + 1);
+      _needAllocated(length + string_length_in_characters + 1);
+      string = data() + offset;
+    }
+    else {
+      _needAllocated(length + string_length_in_characters + 1);
+    }
 
-    for (size_t i = 0, index = length; i < string_length_in_characters; ++i, ++index)
-      m_buffer[index] = string[i];
+    _RHLIBH StringUtils::copyUnits(data() + length, string, string_length_in_characters);
 
-    length += string_length_in_characters;
-    m_buffer[length] = 0;
+    _setLength(length + string_length_in_characters);
 
     return *this;
   }
 
-  constexpr String& append(StringView string) noexcept {
+  constexpr BasicString& append(view_type string) noexcept {
     return append(string.data(), string.length());
   }
 
-  constexpr void push(char32_t character) {
-    size_t length = this->length();
+  constexpr void push(CharT character) {
+    size_t length = m_length;
 
     _needAllocated(length + 1 + 1);
 
-    m_buffer[length] = character;
-    m_buffer[length + 1] = 0;
+    data()[length] = character;
+    _setLength(length + 1);
   }
 
-  constexpr char32_t pop() noexcept {
-    size_t length = this->length();
-
-    if (length == 0)
+  constexpr CharT pop() noexcept {
+    if (m_length == 0)
       return 0;
 
-    char32_t character = m_buffer[--length];
-    m_buffer[length] = 0;
+    CharT character = data()[m_length - 1];
+    _setLength(m_length - 1);
 
     return character;
   }
 
   [[nodiscard]]
-  constexpr bool startsWith(const char32_t* string, size_t string_length) const noexcept {
-    if (string_length > length())
-      return false;
-
-    return _RHLIBH StringUtils::isSubStringEqual(m_buffer, 0, string, string_length);
+  constexpr bool startsWith(const CharT* string, size_t string_length) const noexcept {
+    return view_type{*this}.startsWith(string, string_length);
   }
 
   [[nodiscard]]
-  constexpr bool startsWith(StringView string) const noexcept {
+  constexpr bool startsWith(view_type string) const noexcept {
     return startsWith(string.data(), string.length());
   }
 
   [[nodiscard]]
-  constexpr bool endsWith(const char32_t* string, size_t string_length) const noexcept {
-    size_t length = this->length();
-
-    if (string_length > length)
-      return false;
-
-    return _RHLIBH StringUtils::isSubStringEqual(m_buffer, length - string_length, string, string_length);
+  constexpr bool endsWith(const CharT* string, size_t string_length) const noexcept {
+    return view_type{*this}.endsWith(string, string_length);
   }
 
   [[nodiscard]]
-  constexpr bool endsWith(StringView string) const noexcept {
+  constexpr bool endsWith(view_type string) const noexcept {
     return endsWith(string.data(), string.length());
   }
   
   [[nodiscard]]
-  constexpr ssize_t find(const char32_t* string, size_t string_length) const noexcept {
-    return _RHLIBH StringUtils::find(m_buffer, length(), string, string_length);
+  constexpr ssize_t find(const CharT* string, size_t string_length) const noexcept {
+    return _RHLIBH StringUtils::find(data(), m_length, string, string_length);
   }
   
   [[nodiscard]]
-  constexpr ssize_t find(char32_t character) const noexcept {
-    return _RHLIBH StringUtils::find(m_buffer, length(), character);
+  constexpr ssize_t find(CharT character) const noexcept {
+    return _RHLIBH StringUtils::find(data(), m_length, character);
   }
 
   [[nodiscard]]
-  constexpr ssize_t find(StringView string) const noexcept {
+  constexpr ssize_t find(view_type string) const noexcept {
     return find(string.data(), string.length());
   }
 
   [[nodiscard]]
-  constexpr bool contains(const char32_t* string, size_t string_length) const noexcept {
+  constexpr bool contains(const CharT* string, size_t string_length) const noexcept {
     return find(string, string_length) != -1;
   }
 
   [[nodiscard]]
-  constexpr bool contains(char32_t character) const noexcept {
+  constexpr bool contains(CharT character) const noexcept {
     return find(character) != -1;
   }
 
   [[nodiscard]]
-  constexpr bool contains(StringView string) const noexcept {
+  constexpr bool contains(view_type string) const noexcept {
     return contains(string.data(), string.length());
   }
 
+  [[nodiscard]]
+  constexpr uint64_t hash(uint64_t seed = 0) const noexcept {
+    return view_type{*this}.hash(seed);
+  }
+
+  [[nodiscard]]
+  constexpr int compare(view_type string) const noexcept {
+    return view_type{*this}.compare(string);
+  }
+
 public:
   [[nodiscard]]
-  constexpr bool operator==(String const& string) const noexcept {
-    return *this == StringView{string};
+  constexpr bool operator==(BasicString const& string) const noexcept {
+    return *this == view_type{string};
   }
 
   [[nodiscard]]
-  constexpr bool operator==(const char32_t* string) const noexcept {
-    return *this == StringView{string};
+  constexpr bool operator==(const CharT* string) const noexcept {
+    return *this == view_type{string};
   }
 
   [[nodiscard]]
-  constexpr bool operator==(StringView string) const noexcept {
-    return _RHLIBH StringUtils::isSubStringEqual(m_buffer, 0, string.data(), string.length());
+  constexpr bool operator==(view_type string) const noexcept {
+    return view_type{*this} == string;
   }
 
   [[nodiscard]]
-  constexpr bool operator!=(String const& string) const noexcept {
+  constexpr bool operator!=(BasicString const& string) const noexcept {
     return !operator==(string);
   }
 
   [[nodiscard]]
-  constexpr bool operator!=(const char32_t* string) const noexcept {
+  constexpr bool operator!=(const CharT* string) const noexcept {
     return !operator==(string);
   }
 
   [[nodiscard]]
-  constexpr bool operator!=(StringView string) const noexcept {
+  constexpr bool operator!=(view_type string) const noexcept {
     return !operator==(string);
   }
 
   [[nodiscard]]
-  constexpr char32_t& operator[](size_t index) noexcept {
-    return m_buffer[index];
+  constexpr bool operator<(BasicString const& string) const noexcept {
+    return compare(view_type{string}) < 0;
+  }
+
+  [[nodiscard]]
+  constexpr bool operator<(const CharT* string) const noexcept {
+    return compare(view_type{string}) < 0;
   }
 
   [[nodiscard]]
-  constexpr char32_t operator[](size_t index) const noexcept {
-    return m_buffer[index];
+  constexpr bool operator<(view_type string) const noexcept {
+    return compare(string) < 0;
+  }
+
+  [[nodiscard]]
+  constexpr CharT& operator[](size_t index) noexcept {
+    return data()[index];
+  }
+
+  [[nodiscard]]
+  constexpr CharT operator[](size_t index) const noexcept {
+    return data()[index];
   }
 
 private:
-  constexpr void _stealOther(String& other) noexcept {
-    m_buffer = other.m_buffer;
+  [[nodiscard]]
+  constexpr bool _isInline() const noexcept {
+    return m_allocated == INLINE_CAPACITY;
+  }
+
+  static constexpr size_t HEAP_ALIGNMENT = alignof(CharT);
+
+  // new[] is the only way to allocate during constant evaluation
+  [[nodiscard]]
+  static constexpr CharT* _allocateHeap(AllocatorT& allocator, size_t size) {
+    if consteval {
+      return new CharT[size];
+    }
+
+    return static_cast<CharT*>(allocator.allocate(size * sizeof(CharT), HEAP_ALIGNMENT));
+  }
+
+  static constexpr void _freeHeap(AllocatorT& allocator, CharT* buffer, size_t size) noexcept {
+    if consteval {
+      delete[] buffer;
+      return;
+    }
+
+    allocator.deallocate(buffer, size * sizeof(CharT), HEAP_ALIGNMENT);
+  }
+
+  // Gives away heap buffer (must be on heap), string becomes empty
+  [[nodiscard]]
+  constexpr CharT* _detachHeap() noexcept {
+    CharT* buffer = m_storage.heap;
+
+    m_storage.local = InlineBuffer{};
+    m_allocated = INLINE_CAPACITY;
+    _setLength(0);
+
+    return buffer;
+  }
+
+  // Takes buffer, allocated by _allocateHeap. allocated must be greater than INLINE_CAPACITY
+  constexpr void _attachHeap(CharT* buffer, size_t length, size_t allocated) noexcept {
+    if (!_isInline())
+      _freeHeap(m_storage.getFirst(), m_storage.heap, m_allocated);
+
+    m_storage.heap = buffer;
+    m_allocated = allocated;
+    _setLength(length);
+  }
+
+  constexpr void _stealOther(BasicString& other) noexcept {
+    if (other._isInline())
+      m_storage.local = other.m_storage.local;
+    else {
+      m_storage.heap = other.m_storage.heap;
+      other.m_storage.local = InlineBuffer{};
+    }
+
+    m_length = other.m_length;
     m_allocated = other.m_allocated;
-    other.m_buffer = nullptr;
-    other.m_allocated = 0;
+    other.m_allocated = INLINE_CAPACITY;
+    other._setLength(0);
+  }
+
+  constexpr void _setLength(size_t length) noexcept {
+    m_length = length;
+    data()[length] = 0;
   }
 
   constexpr void _needAllocated(size_t size) {
@@ -619,55 +1626,192 @@ private:
     _reallocate(want_allocate);
   }
 
+  // spills to the heap only past INLINE_CAPACITY, comes back inline if new_size fits
   constexpr void _reallocate(size_t new_size) {
-    char32_t* prev_buffer = m_buffer;
-    size_t prev_allocated = m_allocated;
+    if (new_size < INLINE_CAPACITY)
+      new_size = INLINE_CAPACITY;
 
-    m_allocated = new_size;
-    m_buffer = nullptr;
+    if (new_size == m_allocated)
+      return;
 
-    if (new_size > 0) {
-      m_buffer = new char32_t[new_size];
-      
-      for (size_t i = 0; i < m_allocated; ++i)
-        m_buffer[i] = 0;
+    size_t keep_length = min(m_length, new_size - 1);
 
-      if (prev_buffer) {
-        for (size_t i = 0; i < min(m_allocated, prev_allocated); ++i)
-          m_buffer[i] = prev_buffer[i];
-      }
+    if (new_size == INLINE_CAPACITY) {
+      // previous buffer is on the heap here, because inline is the smallest possible
+      CharT* prev_buffer = m_storage.heap;
+
+      m_storage.local = InlineBuffer{};
+
+      _RHLIBH StringUtils::copyUnits(m_storage.local.chars, prev_buffer, keep_length);
+
+      _freeHeap(m_storage.getFirst(), prev_buffer, m_allocated);
+    }
+    else if (!_reallocateHeap(new_size)) {
+      // only the kept characters and the terminator are written, the rest stays uninitialized
+      CharT* new_buffer = _allocateHeap(m_storage.getFirst(), new_size);
+      CharT* prev_buffer = data();
+
+      _RHLIBH StringUtils::copyUnits(new_buffer, prev_buffer, keep_length);
+
+      if (!_isInline())
+        _freeHeap(m_storage.getFirst(), prev_buffer, m_allocated);
+
+      m_storage.heap = new_buffer;
     }
 
-    if (prev_buffer)
-      delete[] prev_buffer;
+    m_allocated = new_size;
+    _setLength(keep_length);
+  }
+
+  // Resizes heap buffer with allocator's reallocate(), returns false if it isn't available
+  constexpr bool _reallocateHeap(size_t new_size) {
+    if constexpr (ReallocatingAllocator<AllocatorT>) {
+      if consteval {
+        return false;
+      }
+
+      if (_isInline())
+        return false;
+
+      void* buffer = m_storage.getFirst().reallocate(
+        m_storage.heap,
+        m_allocated * sizeof(CharT),
+        new_size * sizeof(CharT),
+        HEAP_ALIGNMENT
+      );
+
+      m_storage.heap = static_cast<CharT*>(buffer);
+      return true;
+    }
+    else
+      return false;
   }
 
   constexpr void _moveRight(size_t index, size_t count, size_t amount) noexcept {
-    char32_t* rbegin = m_buffer + index + count - 1;
-    char32_t* rend = m_buffer + index - 1;
+    _RHLIBH StringUtils::moveUnits(data() + index + amount, data() + index, count);
+  }
+
+  constexpr void _moveLeft(size_t index, size_t count, size_t amount) noexcept {
+    _RHLIBH StringUtils::moveUnits(data() + index - amount, data() + index, count);
+  }
+};
+
+// Lazy result of operator+ over strings. Total length is computed once,
+//  and the result is built with one exact-size allocation on conversion to String.
+// It keeps views of operands, so convert it before they're destroyed
+template <typename LeftT, typename RightT>
+class StringConcat {
+private:
+  LeftT  m_left;
+  RightT m_right;
+  size_t m_length;
+
+public:
+  constexpr StringConcat(LeftT const& left, RightT const& right) noexcept
+    : m_left(left), m_right(right), m_length(left.length() + right.length()) {}
+
+public:
+  constexpr operator String() const {
+    return toString();
+  }
+
+public:
+  [[nodiscard]]
+  constexpr size_t length() const noexcept {
+    return m_length;
+  }
+
+  [[nodiscard]]
+  constexpr String toString() const {
+    String result;
+    appendTo(result);
+    return result;
+  }
+
+  // Operands, which view destination itself, are copied out before it grows
+  constexpr void appendTo(String& destination) const {
+    if (overlaps(destination)) {
+      destination.append(toString());
+      return;
+    }
+
+    destination.reserve(destination.length() + m_length + 1);
+    _appendPart(destination, m_left);
+    _appendPart(destination, m_right);
+  }
+
+  // Tells if any operand views characters of string
+  [[nodiscard]]
+  constexpr bool overlaps(String const& string) const noexcept {
+    return _partOverlaps(m_left, string) || _partOverlaps(m_right, string);
+  }
+
+public:
+  [[nodiscard]]
+  constexpr bool operator==(StringView string) const {
+    return toString() == string;
+  }
 
-    for (char32_t* it = rbegin; it != rend; --it)
-      it[amount] = it[0];
+  [[nodiscard]]
+  constexpr bool operator!=(StringView string) const {
+    return !operator==(string);
   }
 
-  constexpr void _moveLeft(size_t index, size_t count, int amount) noexcept {
-    char32_t* begin = m_buffer + index;
-    char32_t* end = m_buffer + index + count;
+private:
+  template <typename PartT>
+  [[nodiscard]]
+  static constexpr bool _partOverlaps(PartT const& part, String const& string) noexcept {
+    if constexpr (requires { part.overlaps(string); })
+      return part.overlaps(string);
+    else
+      return part.length() > 0 && _RHLIBH StringUtils::isWithin(part.data(), string.data(), string.capacity());
+  }
 
-    for (char32_t* it = begin; it != end; ++it)
-      it[-amount] = it[0];
+  template <typename PartT>
+  static constexpr void _appendPart(String& destination, PartT const& part) {
+    if constexpr (requires { part.appendTo(destination); })
+      part.appendTo(destination);
+    else
+      destination.append(part);
   }
 };
 
+// No pointers into itself: inline characters are found through m_allocated
+template <typename CharT, typename AllocatorT>
+static constexpr bool is_trivially_relocatable<BasicString<CharT, AllocatorT>> = is_trivially_relocatable<AllocatorT>;
+
 _RHLIB_END
 
 _RHLIB_GLOBAL_CLASS(StringView);
+_RHLIB_GLOBAL_CLASS(Searcher);
 _RHLIB_GLOBAL_CLASS(String);
+_RHLIB_GLOBAL_CLASS(StringConcat);
 
-constexpr rh::String operator+(rh::StringView left, rh::StringView right) noexcept {
-  return rh::String{left}.append(right);
+constexpr rh::StringConcat<rh::StringView, rh::StringView> operator+(rh::StringView left, rh::StringView right) noexcept {
+  return { left, right };
+}
+
+template <typename LeftT, typename RightT>
+constexpr auto operator+(rh::StringConcat<LeftT, RightT> const& left, rh::StringView right) noexcept {
+  return rh::StringConcat<rh::StringConcat<LeftT, RightT>, rh::StringView>{ left, right };
+}
+
+template <typename LeftT, typename RightT>
+constexpr auto operator+(rh::StringView left, rh::StringConcat<LeftT, RightT> const& right) noexcept {
+  return rh::StringConcat<rh::StringView, rh::StringConcat<LeftT, RightT>>{ left, right };
+}
+
+template <typename LeftT, typename RightT, typename OtherLeftT, typename OtherRightT>
+constexpr auto operator+(rh::StringConcat<LeftT, RightT> const& left, rh::StringConcat<OtherLeftT, OtherRightT> const& right) noexcept {
+  return rh::StringConcat<rh::StringConcat<LeftT, RightT>, rh::StringConcat<OtherLeftT, OtherRightT>>{ left, right };
 }
 
 constexpr rh::String& operator+=(rh::String& left, rh::StringView right) noexcept {
   return left.append(right);
 }
+
+template <typename LeftT, typename RightT>
+constexpr rh::String& operator+=(rh::String& left, rh::StringConcat<LeftT, RightT> const& right) {
+  right.appendTo(left);
+  return left;
+}
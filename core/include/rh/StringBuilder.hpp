@@ -0,0 +1,114 @@
+#pragma once
+#define _RHLIB_INCLUDED_STRINGBUILDER
+
+#include <rh.hpp>
+
+#include <rh/String.hpp>
+
+_RHLIB_BEGIN
+
+// Accumulates pieces of string in one buffer, which grows twice each time it's full.
+// build() gives that buffer away, so nothing is copied at the end
+class StringBuilder {
+public:
+  using type = StringBuilder;
+
+  static constexpr size_t MINIMAL_CAPACITY = 64;
+
+private:
+  String m_string;
+
+public:
+  constexpr StringBuilder() noexcept = default;
+
+  constexpr StringBuilder(size_t preallocate) : StringBuilder() {
+    m_string.reserve(preallocate + 1);
+  }
+
+public:
+  [[nodiscard]]
+  constexpr size_t length() const noexcept {
+    return m_string.length();
+  }
+
+  [[nodiscard]]
+  constexpr bool isEmpty() const noexcept {
+    return m_string.isEmpty();
+  }
+
+  [[nodiscard]]
+  constexpr size_t capacity() const noexcept {
+    return m_string.capacity();
+  }
+
+  [[nodiscard]]
+  constexpr StringView view() const noexcept {
+    return m_string;
+  }
+
+  constexpr void reserve(size_t count) {
+    m_string.reserve(count + 1);
+  }
+
+  constexpr void clear() noexcept {
+    m_string.clear();
+  }
+
+  constexpr StringBuilder& append(char32_t character) {
+    _needSpace(1);
+    m_string.push(character);
+    return *this;
+  }
+
+  constexpr StringBuilder& append(size_t count, char32_t character) {
+    _needSpace(count);
+    m_string.append(count, character);
+    return *this;
+  }
+
+  // View of the builder itself is copied out before the buffer grows
+  constexpr StringBuilder& append(StringView string) {
+    if (string.length() > 0 && _RHLIBH StringUtils::isWithin(string.data(), m_string.data(), m_string.capacity()))
+      return append(String(string));
+
+    _needSpace(string.length());
+    m_string.append(string);
+    return *this;
+  }
+
+  template <typename LeftT, typename RightT>
+  constexpr StringBuilder& append(StringConcat<LeftT, RightT> const& string) {
+    if (string.overlaps(m_string))
+      return append(string.toString());
+
+    _needSpace(string.length());
+    string.appendTo(m_string);
+    return *this;
+  }
+
+  // Builder is empty after that
+  [[nodiscard]]
+  constexpr String build() noexcept {
+    return move(m_string);
+  }
+
+private:
+  constexpr void _needSpace(size_t count) {
+    size_t required = m_string.length() + count + 1;
+    size_t capacity = m_string.capacity();
+
+    if (required <= capacity)
+      return;
+
+    size_t want_allocate = capacity < MINIMAL_CAPACITY ? MINIMAL_CAPACITY : capacity * 2;
+
+    if (want_allocate < required)
+      want_allocate = required;
+
+    m_string.reserve(want_allocate);
+  }
+};
+
+_RHLIB_END
+
+_RHLIB_GLOBAL_CLASS(StringBuilder);
@@ -3,7 +3,8 @@
 
 #include <rh.hpp>
 
-#include <new> // for constructAt
+#include <memory> // for constructAt in constant evaluation
+#include <new>    // for constructAt
 
 _RHLIB_BEGIN
 
@@ -11,7 +12,7 @@ template <typename, typename>
 static constexpr bool is_same_type = false;
 
 template <typename T>
-static constexpr bool is_same_type<T, T> = false;
+static constexpr bool is_same_type<T, T> = true;
 
 template <typename T, typename Expected>
 concept Exactly = is_same_type<T, Expected>;
@@ -142,6 +143,41 @@ template <typename T, typename... Types>
 static constexpr bool is_any_type_of = _RHLIBH is_any_type_of_wrapper<T, Types...>::value;
 
 
+_RHLIB_HIDDEN_BEGIN
+
+template <size_t Index, typename... Types>
+struct type_at_wrapper;
+
+template <typename T, typename... OtherTypes>
+struct type_at_wrapper<0, T, OtherTypes...>
+  : type_wrapper<T> {};
+
+template <size_t Index, typename T, typename... OtherTypes>
+struct type_at_wrapper<Index, T, OtherTypes...>
+  : type_at_wrapper<Index - 1, OtherTypes...> {};
+
+_RHLIB_HIDDEN_END
+
+template <size_t Index, typename... Types>
+using type_at = unwrap_type<_RHLIBH type_at_wrapper<Index, Types...>>;
+
+
+template <typename T, T... Values>
+struct IntegerSequence {};
+
+template <size_t... Indices>
+using IndexSequence = IntegerSequence<size_t, Indices...>;
+
+// IndexSequence<0, 1, ..., Count - 1>
+#if __has_builtin(__make_integer_seq)
+template <size_t Count>
+using make_index_sequence = __make_integer_seq<IntegerSequence, size_t, Count>;
+#else
+template <size_t Count>
+using make_index_sequence = IntegerSequence<size_t, __integer_pack(Count)...>;
+#endif
+
+
 template <typename T>
 static constexpr bool is_integral_type = is_any_type_of<T,
   signed char, unsigned char,
@@ -156,10 +192,62 @@ static constexpr bool is_char_type = is_any_type_of<T,
   char, wchar_t, char8_t, char16_t, char32_t
 >;
 
+template <typename T>
+static constexpr bool is_floating_point_type = is_any_type_of<T,
+  float, double, long double
+>;
+
+template <typename T>
+concept Integral = is_integral_type<T>;
+
+template <typename T>
+concept FloatingPoint = is_floating_point_type<T>;
+
+template <typename T>
+concept LessComparable = requires(T const& left, T const& right) {
+  { left < right } -> ConvertibleTo<bool>;
+};
+
+// "compare(left, right)" tells if left goes before right. Must be a strict weak ordering
+template <typename CompareT, typename T>
+concept Comparator = requires(CompareT const& compare, T const& left, T const& right) {
+  { compare(left, right) } -> ConvertibleTo<bool>;
+};
+
+// Default comparator of ordered containers. Compares different types too
+struct Less {
+  template <typename T, typename K>
+  [[nodiscard]]
+  constexpr bool operator()(T const& left, K const& right) const noexcept(noexcept(left < right)) {
+    return left < right;
+  }
+};
+
+
+template <typename T>
+static constexpr bool is_trivially_copyable = __is_trivially_copyable(T);
+
+template <typename T>
+static constexpr bool is_trivially_destructible = __is_trivially_destructible(T);
+
+// Object can be moved to another address by copying its bytes, and the old bytes
+//  are then forgotten without calling destructor. Containers grow such items with
+//  memcpy/realloc. Most types without pointers into themselves are such, but only
+//  trivially copyable ones are known to be, others opt in with
+//  _RHLIB_MAKE_TRIVIALLY_RELOCATABLE or a partial specialization
+template <typename T>
+static constexpr bool is_trivially_relocatable = is_trivially_copyable<T>;
+
+// Must be used in the global namespace
+#define _RHLIB_MAKE_TRIVIALLY_RELOCATABLE(T)          \
+  _RHLIB_BEGIN                                       \
+  template <>                                        \
+  constexpr bool is_trivially_relocatable<T> = true; \
+  _RHLIB_END
 
 template <typename T>
 [[nodiscard]]
-constexpr auto move(T&& arg) noexcept {
+constexpr remove_reference<T>&& move(T&& arg) noexcept {
   return static_cast<remove_reference<T>&&>(arg);
 }
 
@@ -176,9 +264,15 @@ constexpr T&& forward(remove_reference<T>&& arg) noexcept {
   return static_cast<T&&>(arg);
 }
 
+// Placement new isn't allowed in constant evaluation, std::construct_at is
 template <typename T, typename... ArgsT>
 constexpr void constructAt(T* object, ArgsT&&... args) {
-  new (object) T (forward<ArgsT>(args)...);
+  if consteval {
+    std::construct_at(object, forward<ArgsT>(args)...);
+  }
+  else {
+    new (object) T (forward<ArgsT>(args)...);
+  }
 }
 
 template <typename T>
@@ -0,0 +1,497 @@
+#pragma once
+#define _RHLIB_INCLUDED_UTF8STRING
+
+#include <rh.hpp>
+
+#include <rh/String.hpp>
+#include <rh/exceptions.hpp>
+#include <rh/simd.hpp>
+
+_RHLIB_BEGIN
+
+// Same as String, but stores UTF-8 code units. Lengths are in bytes
+using Utf8StringView = BasicStringView<char8_t>;
+using Utf8String     = BasicString<char8_t>;
+
+_RHLIB_HIDDEN_BEGIN
+
+struct Utf8Utils {
+  // ASCII runs and validation are processed by blocks of this many code units
+  static constexpr size_t BLOCK_SIZE = 16;
+
+  // Returns length of the sequence or 0 if it's invalid (overlong, surrogate, out of range or truncated)
+  static constexpr size_t decodeOne(const char8_t* string, size_t length, size_t index, char32_t& out_code_point) noexcept {
+    uint32_t lead = string[index];
+
+    if (lead < 0x80) {
+      out_code_point = lead;
+      return 1;
+    }
+
+    size_t size;
+    uint32_t code_point;
+    uint32_t min_second = 0x80;
+    uint32_t max_second = 0xBF;
+
+    if (lead < 0xC2)
+      return 0;
+    else if (lead < 0xE0) {
+      size = 2;
+      code_point = lead & 0x1F;
+    }
+    else if (lead < 0xF0) {
+      size = 3;
+      code_point = lead & 0x0F;
+
+      if (lead == 0xE0)
+        min_second = 0xA0;
+      else if (lead == 0xED)
+        max_second = 0x9F;
+    }
+    else if (lead < 0xF5) {
+      size = 4;
+      code_point = lead & 0x07;
+
+      if (lead == 0xF0)
+        min_second = 0x90;
+      else if (lead == 0xF4)
+        max_second = 0x8F;
+    }
+    else
+      return 0;
+
+    if (size > length - index)
+      return 0;
+
+    uint32_t second = string[index + 1];
+
+    if (second < min_second || second > max_second)
+      return 0;
+
+    code_point = (code_point << 6) | (second & 0x3F);
+
+    for (size_t offset = 2; offset < size; ++offset) {
+      uint32_t next = string[index + offset];
+
+      if ((next & 0xC0) != 0x80)
+        return 0;
+
+      code_point = (code_point << 6) | (next & 0x3F);
+    }
+
+    out_code_point = code_point;
+    return size;
+  }
+
+  // Returns length of the sequence or 0 if code point is a surrogate or out of range
+  static constexpr size_t encodedSize(char32_t code_point) noexcept {
+    if (code_point < 0x80)
+      return 1;
+    if (code_point < 0x800)
+      return 2;
+    if (code_point < 0x10000)
+      return (code_point >= 0xD800 && code_point <= 0xDFFF) ? 0 : 3;
+    if (code_point <= 0x10FFFF)
+      return 4;
+
+    return 0;
+  }
+
+  // destination must have space for encodedSize(code_point) code units
+  static constexpr void encodeOne(char32_t code_point, size_t size, char8_t* destination) noexcept {
+    switch (size) {
+      case 1:
+        destination[0] = static_cast<char8_t>(code_point);
+        break;
+      case 2:
+        destination[0] = static_cast<char8_t>(0xC0 | (code_point >> 6));
+        destination[1] = static_cast<char8_t>(0x80 | (code_point & 0x3F));
+        break;
+      case 3:
+        destination[0] = static_cast<char8_t>(0xE0 | (code_point >> 12));
+        destination[1] = static_cast<char8_t>(0x80 | ((code_point >> 6) & 0x3F));
+        destination[2] = static_cast<char8_t>(0x80 | (code_point & 0x3F));
+        break;
+      default:
+        destination[0] = static_cast<char8_t>(0xF0 | (code_point >> 18));
+        destination[1] = static_cast<char8_t>(0x80 | ((code_point >> 12) & 0x3F));
+        destination[2] = static_cast<char8_t>(0x80 | ((code_point >> 6) & 0x3F));
+        destination[3] = static_cast<char8_t>(0x80 | (code_point & 0x3F));
+        break;
+    }
+  }
+
+  static constexpr ssize_t findInvalid(const char8_t* string, size_t length) noexcept {
+    size_t index = 0;
+
+#if _RHLIB_SIMD_SSSE3
+    if !consteval {
+      index = validPrefixLength(string, length);
+    }
+#endif
+
+    while (index < length) {
+#if _RHLIB_SIMD_SSE2
+      if !consteval {
+        if (string[index] < 0x80) {
+          index = asciiPrefixLength(string, length, index);
+          if (index == length)
+            break;
+        }
+      }
+#endif
+
+      char32_t code_point = 0;
+      size_t size = decodeOne(string, length, index, code_point);
+
+      if (size == 0)
+        return static_cast<ssize_t>(index);
+
+      index += size;
+    }
+
+    return -1;
+  }
+
+  static constexpr size_t countCodePoints(const char8_t* string, size_t length) noexcept {
+    size_t result = 0;
+    size_t index = 0;
+
+#if _RHLIB_SIMD_SSE2
+    if !consteval {
+      for (; index + BLOCK_SIZE <= length; index += BLOCK_SIZE)
+        result += BLOCK_SIZE - countContinuationBytes(string + index);
+    }
+#endif
+
+    for (; index < length; ++index) {
+      if ((string[index] & 0xC0) != 0x80)
+        ++result;
+    }
+
+    return result;
+  }
+
+  // Returns index of the first invalid sequence or -1. Writes at most "length" code points
+  static constexpr ssize_t decode(const char8_t* string, size_t length, char32_t* destination, size_t& out_written) noexcept {
+    size_t index = 0;
+    size_t written = 0;
+
+    while (index < length) {
+#if _RHLIB_SIMD_SSE2
+      if !consteval {
+        if (string[index] < 0x80 && length - index >= BLOCK_SIZE && isAsciiBlock(string + index)) {
+          widenBlock(string + index, destination + written);
+          index += BLOCK_SIZE;
+          written += BLOCK_SIZE;
+          continue;
+        }
+      }
+#endif
+
+      char32_t code_point = 0;
+      size_t size = decodeOne(string, length, index, code_point);
+
+      if (size == 0) {
+        out_written = written;
+        return static_cast<ssize_t>(index);
+      }
+
+      destination[written++] = code_point;
+      index += size;
+    }
+
+    out_written = written;
+    return -1;
+  }
+
+  // Returns -1 if string has a surrogate or out of range code point
+  static constexpr ssize_t encodedLength(const char32_t* string, size_t length) noexcept {
+    size_t result = 0;
+
+    for (size_t index = 0; index < length; ++index) {
+      size_t size = encodedSize(string[index]);
+
+      if (size == 0)
+        return -1;
+
+      result += size;
+    }
+
+    return static_cast<ssize_t>(result);
+  }
+
+  // string must be valid (see encodedLength)
+  static constexpr void encode(const char32_t* string, size_t length, char8_t* destination) noexcept {
+    size_t index = 0;
+
+    while (index < length) {
+#if _RHLIB_SIMD_SSE2
+      if !consteval {
+        if (string[index] < 0x80 && length - index >= BLOCK_SIZE && isAsciiBlock(string + index)) {
+          narrowBlock(string + index, destination);
+          index += BLOCK_SIZE;
+          destination += BLOCK_SIZE;
+          continue;
+        }
+      }
+#endif
+
+      size_t size = encodedSize(string[index]);
+      encodeOne(string[index], size, destination);
+
+      ++index;
+      destination += size;
+    }
+  }
+
+#if _RHLIB_SIMD_SSE2
+  static inline size_t asciiPrefixLength(const char8_t* string, size_t length, size_t index) noexcept {
+    for (; index + BLOCK_SIZE <= length; index += BLOCK_SIZE) {
+      uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(string + index))));
+      if (mask)
+        return index + countTrailingZeros(mask);
+    }
+
+    while (index < length && string[index] < 0x80)
+      ++index;
+
+    return index;
+  }
+
+#if _RHLIB_SIMD_SSSE3
+  // Checks whole blocks with SIMD while they're valid. Returns index, from which the rest
+  //  must be checked by decodeOne: the first invalid block or the tail, moved back to
+  //  the beginning of the sequence, which may continue into it
+  static inline size_t validPrefixLength(const char8_t* string, size_t length) noexcept {
+    __m128i prev_input = _mm_setzero_si128();
+    size_t index = 0;
+
+    for (; index + BLOCK_SIZE <= length; index += BLOCK_SIZE) {
+      __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(string + index));
+
+      // ASCII after ASCII can't be wrong
+      if (_mm_movemask_epi8(_mm_or_si128(input, prev_input)) != 0) {
+        __m128i errors = blockErrors(input, prev_input);
+
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(errors, _mm_setzero_si128())) != 0xFFFF)
+          break;
+      }
+
+      prev_input = input;
+    }
+
+    // sequence is at most 4 bytes long, so its beginning is among the 3 previous ones
+    for (size_t back = 1; back <= 3 && back <= index; ++back) {
+      if ((string[index - back] & 0xC0) != 0x80)
+        return index - back;
+    }
+
+    return index;
+  }
+
+  // Lookup algorithm by Keiser and Lemire. Each pair of adjacent bytes is classified by
+  //  three table lookups: high and low nibbles of the first byte, high nibble of the second.
+  //  An error bit survives only if all three lookups set it.
+  //  Third and fourth bytes of sequences are checked by the lead 2 and 3 bytes before them
+  static inline __m128i blockErrors(__m128i input, __m128i prev_input) noexcept {
+    constexpr char TOO_SHORT         = 1 << 0; // lead or ASCII after lead
+    constexpr char TOO_LONG          = 1 << 1; // continuation after ASCII
+    constexpr char OVERLONG_3        = 1 << 2; // E0 80..9F
+    constexpr char TOO_LARGE         = 1 << 3; // F4 90..BF, F5..FF
+    constexpr char SURROGATE         = 1 << 4; // ED A0..BF
+    constexpr char OVERLONG_2        = 1 << 5; // C0..C1
+    constexpr char OVERLONG_4        = 1 << 6; // F0 80..8F
+    constexpr char TOO_LARGE_1000    = 1 << 6; // F5..FF 80..8F
+    constexpr char TWO_CONTINUATIONS = static_cast<char>(1 << 7);
+    constexpr char CARRY             = TOO_SHORT | TOO_LONG | TWO_CONTINUATIONS;
+
+    const __m128i nibble_mask = _mm_set1_epi8(0x0F);
+
+    __m128i prev1 = _mm_alignr_epi8(input, prev_input, 15);
+
+    __m128i byte_1_high = _mm_shuffle_epi8(_mm_setr_epi8(
+      // 0_______: ASCII
+      TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+      // 10______: continuation
+      TWO_CONTINUATIONS, TWO_CONTINUATIONS, TWO_CONTINUATIONS, TWO_CONTINUATIONS,
+      // 1100____, 1101____: 2-byte lead
+      TOO_SHORT | OVERLONG_2,
+      TOO_SHORT,
+      // 1110____: 3-byte lead
+      TOO_SHORT | OVERLONG_3 | SURROGATE,
+      // 1111____: 4-byte lead
+      TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4
+    ), _mm_and_si128(_mm_srli_epi16(prev1, 4), nibble_mask));
+
+    __m128i byte_1_low = _mm_shuffle_epi8(_mm_setr_epi8(
+      CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4,          // ____0000
+      CARRY | OVERLONG_2,                                    // ____0001
+      CARRY,                                                 // ____0010
+      CARRY,                                                 // ____0011
+      CARRY | TOO_LARGE,                                     // ____0100
+      CARRY | TOO_LARGE | TOO_LARGE_1000,                    // ____0101
+      CARRY | TOO_LARGE | TOO_LARGE_1000,
+      CARRY | TOO_LARGE | TOO_LARGE_1000,
+      CARRY | TOO_LARGE | TOO_LARGE_1000,
+      CARRY | TOO_LARGE | TOO_LARGE_1000,
+      CARRY | TOO_LARGE | TOO_LARGE_1000,
+      CARRY | TOO_LARGE | TOO_LARGE_1000,
+      CARRY | TOO_LARGE | TOO_LARGE_1000,
+      CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE,        // ____1101
+      CARRY | TOO_LARGE | TOO_LARGE_1000,
+      CARRY | TOO_LARGE | TOO_LARGE_1000
+    ), _mm_and_si128(prev1, nibble_mask));
+
+    __m128i byte_2_high = _mm_shuffle_epi8(_mm_setr_epi8(
+      // 0_______: ASCII
+      TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+      // 1000____, 1001____, 101_____: continuation
+      TOO_LONG | OVERLONG_2 | TWO_CONTINUATIONS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4,
+      TOO_LONG | OVERLONG_2 | TWO_CONTINUATIONS | OVERLONG_3 | TOO_LARGE,
+      TOO_LONG | OVERLONG_2 | TWO_CONTINUATIONS | SURROGATE | TOO_LARGE,
+      TOO_LONG | OVERLONG_2 | TWO_CONTINUATIONS | SURROGATE | TOO_LARGE,
+      // 11______: lead
+      TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT
+    ), _mm_and_si128(_mm_srli_epi16(input, 4), nibble_mask));
+
+    __m128i special = _mm_and_si128(_mm_and_si128(byte_1_high, byte_1_low), byte_2_high);
+
+    // bytes 2 and 3 positions after E0..FF and F0..FF leads must be continuations
+    __m128i prev2 = _mm_alignr_epi8(input, prev_input, 14);
+    __m128i prev3 = _mm_alignr_epi8(input, prev_input, 13);
+
+    __m128i is_third = _mm_subs_epu8(prev2, _mm_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+    __m128i is_fourth = _mm_subs_epu8(prev3, _mm_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+    __m128i must_continue = _mm_and_si128(_mm_or_si128(is_third, is_fourth), _mm_set1_epi8(TWO_CONTINUATIONS));
+
+    return _mm_xor_si128(must_continue, special);
+  }
+#endif
+
+  static inline size_t countContinuationBytes(const char8_t* block) noexcept {
+    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+
+    // 0x80..0xBF are the only bytes below -64 when treated as signed
+    __m128i continuation = _mm_cmplt_epi8(bytes, _mm_set1_epi8(-64));
+
+    return static_cast<size_t>(__builtin_popcount(static_cast<uint32_t>(_mm_movemask_epi8(continuation))));
+  }
+
+  static inline bool isAsciiBlock(const char8_t* block) noexcept {
+    return _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(block))) == 0;
+  }
+
+  static inline bool isAsciiBlock(const char32_t* block) noexcept {
+    const __m128i* vectors = reinterpret_cast<const __m128i*>(block);
+
+    __m128i combined = _mm_or_si128(
+      _mm_or_si128(_mm_loadu_si128(vectors + 0), _mm_loadu_si128(vectors + 1)),
+      _mm_or_si128(_mm_loadu_si128(vectors + 2), _mm_loadu_si128(vectors + 3))
+    );
+
+    __m128i high_bits = _mm_and_si128(combined, _mm_set1_epi32(~0x7F));
+
+    return _mm_movemask_epi8(_mm_cmpeq_epi32(high_bits, _mm_setzero_si128())) == 0xFFFF;
+  }
+
+  static inline void widenBlock(const char8_t* block, char32_t* destination) noexcept {
+    const __m128i zero = _mm_setzero_si128();
+
+    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+    __m128i low = _mm_unpacklo_epi8(bytes, zero);
+    __m128i high = _mm_unpackhi_epi8(bytes, zero);
+
+    __m128i* vectors = reinterpret_cast<__m128i*>(destination);
+
+    _mm_storeu_si128(vectors + 0, _mm_unpacklo_epi16(low, zero));
+    _mm_storeu_si128(vectors + 1, _mm_unpackhi_epi16(low, zero));
+    _mm_storeu_si128(vectors + 2, _mm_unpacklo_epi16(high, zero));
+    _mm_storeu_si128(vectors + 3, _mm_unpackhi_epi16(high, zero));
+  }
+
+  static inline void narrowBlock(const char32_t* block, char8_t* destination) noexcept {
+    const __m128i* vectors = reinterpret_cast<const __m128i*>(block);
+
+    __m128i low = _mm_packs_epi32(_mm_loadu_si128(vectors + 0), _mm_loadu_si128(vectors + 1));
+    __m128i high = _mm_packs_epi32(_mm_loadu_si128(vectors + 2), _mm_loadu_si128(vectors + 3));
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(destination), _mm_packus_epi16(low, high));
+  }
+#endif
+};
+
+_RHLIB_HIDDEN_END
+
+namespace utf8 {
+
+// Index of the first byte of the first invalid sequence or -1
+[[nodiscard]]
+constexpr ssize_t findInvalid(Utf8StringView string) noexcept {
+  return _RHLIBH Utf8Utils::findInvalid(string.data(), string.length());
+}
+
+[[nodiscard]]
+constexpr bool isValid(Utf8StringView string) noexcept {
+  return findInvalid(string) == -1;
+}
+
+// string must be valid
+[[nodiscard]]
+constexpr size_t countCodePoints(Utf8StringView string) noexcept {
+  return _RHLIBH Utf8Utils::countCodePoints(string.data(), string.length());
+}
+
+// Appends decoded string to destination. Throws EncodingError if string isn't valid UTF-8
+constexpr void decodeTo(String& destination, Utf8StringView string) {
+  size_t prev_length = destination.length();
+
+  // each byte gives at most one code point. Nothing is filled, decoder overwrites it
+  destination.resizeForOverwrite(prev_length + string.length());
+
+  size_t written = 0;
+  ssize_t invalid_index = _RHLIBH Utf8Utils::decode(string.data(), string.length(), destination.data() + prev_length, written);
+
+  if (invalid_index != -1) {
+    destination.resizeForOverwrite(prev_length);
+    throw EncodingError(U"invalid UTF-8 sequence");
+  }
+
+  destination.resizeForOverwrite(prev_length + written);
+}
+
+[[nodiscard]]
+constexpr String decode(Utf8StringView string) {
+  String result;
+  decodeTo(result, string);
+  return result;
+}
+
+// Appends encoded string to destination. Throws EncodingError if string has surrogates or out of range code points
+constexpr void encodeTo(Utf8String& destination, StringView string) {
+  ssize_t encoded_length = _RHLIBH Utf8Utils::encodedLength(string.data(), string.length());
+
+  if (encoded_length == -1)
+    throw EncodingError(U"code point can't be encoded in UTF-8");
+
+  size_t prev_length = destination.length();
+
+  destination.resizeForOverwrite(prev_length + encoded_length);
+
+  _RHLIBH Utf8Utils::encode(string.data(), string.length(), destination.data() + prev_length);
+}
+
+[[nodiscard]]
+constexpr Utf8String encode(StringView string) {
+  Utf8String result;
+  encodeTo(result, string);
+  return result;
+}
+
+} // namespace utf8
+
+_RHLIB_END
+
+_RHLIB_GLOBAL_CLASS(Utf8StringView);
+_RHLIB_GLOBAL_CLASS(Utf8String);
+_RHLIB_GLOBAL_NS(utf8);
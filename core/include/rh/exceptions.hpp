@@ -77,4 +77,31 @@ public:
 inline IndexError::IndexError(StringView info) noexcept
   : RuntimeError(info, typeid(IndexError)) {}
 
+// Key isn't found in a container
+class KeyError final : public RuntimeError {
+public:
+  inline KeyError(StringView info = U"key not found") noexcept;
+};
+
+inline KeyError::KeyError(StringView info) noexcept
+  : RuntimeError(info, typeid(KeyError)) {}
+
+// Malformed encoded text
+class EncodingError final : public RuntimeError {
+public:
+  inline EncodingError(StringView info = U"invalid encoding") noexcept;
+};
+
+inline EncodingError::EncodingError(StringView info) noexcept
+  : RuntimeError(info, typeid(EncodingError)) {}
+
+// Text doesn't match expected syntax
+class ParseError final : public RuntimeError {
+public:
+  inline ParseError(StringView info = U"invalid syntax") noexcept;
+};
+
+inline ParseError::ParseError(StringView info) noexcept
+  : RuntimeError(info, typeid(ParseError)) {}
+
 _RHLIB_END
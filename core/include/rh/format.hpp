@@ -0,0 +1,380 @@
+#pragma once
+#define _RHLIB_INCLUDED_FORMAT
+
+#include <rh.hpp>
+
+#include <rh/FixedString.hpp>
+#include <rh/List.hpp>
+#include <rh/Pair.hpp>
+#include <rh/String.hpp>
+#include <rh/TypeTraits.hpp>
+#include <rh/numbers.hpp>
+
+_RHLIB_BEGIN
+
+// Describes how values of type T are written by format(). Specialize it for own types:
+//
+//   template <>
+//   struct rh::Formatter<Point> {
+//     // Upper bound of characters, which write() puts
+//     static constexpr size_t maxLength(Point const& point) noexcept;
+//
+//     // Writes into already reserved space, returns end of the written characters
+//     static constexpr char32_t* write(char32_t* destination, Point const& point) noexcept;
+//   };
+template <typename T>
+struct Formatter;
+
+template <typename T>
+concept Formattable = requires(T const& value, char32_t* destination) {
+  { Formatter<T>::maxLength(value) } -> ConvertibleTo<size_t>;
+  { Formatter<T>::write(destination, value) } -> ConvertibleTo<char32_t*>;
+};
+
+_RHLIB_HIDDEN_BEGIN
+
+// Splits format string into literal pieces and "{}" placeholders.
+// "{{" and "}}" are escaped braces
+struct FormatParser {
+  enum class Error {
+    None,
+    UnmatchedOpenBrace,
+    UnmatchedCloseBrace,
+    UnsupportedSpecification
+  };
+
+  struct Segment {
+    size_t begin      = 0;
+    size_t length     = 0;
+    size_t argument   = 0;
+    bool   isArgument = false;
+  };
+
+  struct Result {
+    size_t segmentsCount  = 0;
+    size_t argumentsCount = 0;
+    size_t literalLength  = 0;
+    Error  error          = Error::None;
+  };
+
+  // Only counts segments, unless segments isn't null
+  static constexpr Result parse(const char32_t* format, size_t length, Segment* segments) noexcept {
+    Result result;
+
+    size_t literal_begin = 0;
+
+    auto add_literal = [&](size_t end) {
+      if (end == literal_begin)
+        return;
+
+      if (segments)
+        segments[result.segmentsCount] = Segment{ literal_begin, end - literal_begin, 0, false };
+
+      ++result.segmentsCount;
+      result.literalLength += end - literal_begin;
+    };
+
+    for (size_t index = 0; index < length;) {
+      char32_t character = format[index];
+      char32_t next = index + 1 < length ? format[index + 1] : U'\0';
+
+      if (character == U'{' && next == U'{') {
+        add_literal(index + 1);
+        index += 2;
+        literal_begin = index;
+      }
+      else if (character == U'{' && next == U'}') {
+        add_literal(index);
+
+        if (segments)
+          segments[result.segmentsCount] = Segment{ index, 0, result.argumentsCount, true };
+
+        ++result.segmentsCount;
+        ++result.argumentsCount;
+
+        index += 2;
+        literal_begin = index;
+      }
+      else if (character == U'{') {
+        // braces before this one are already consumed, so only a later '}' closes it
+        bool is_closed = StringUtils::find(format + index, length - index, U'}') != -1;
+
+        result.error = is_closed ? Error::UnsupportedSpecification : Error::UnmatchedOpenBrace;
+        return result;
+      }
+      else if (character == U'}' && next == U'}') {
+        add_literal(index + 1);
+        index += 2;
+        literal_begin = index;
+      }
+      else if (character == U'}') {
+        result.error = Error::UnmatchedCloseBrace;
+        return result;
+      }
+      else
+        ++index;
+    }
+
+    add_literal(length);
+
+    return result;
+  }
+};
+
+// Format string is split at compile time into literal pieces and "{}" placeholders
+template <FixedString Format>
+class FormatString {
+private:
+  using Parser     = FormatParser;
+  using ParseError = Parser::Error;
+  using Segment    = Parser::Segment;
+
+  static constexpr Parser::Result PARSED = Parser::parse(Format.characters, Format.length(), nullptr);
+
+  static_assert(PARSED.error != ParseError::UnmatchedOpenBrace, "Unmatched '{' in format string, use \"{{\" for a brace");
+  static_assert(PARSED.error != ParseError::UnmatchedCloseBrace, "Unmatched '}' in format string, use \"}}\" for a brace");
+  static_assert(PARSED.error != ParseError::UnsupportedSpecification, "Only \"{}\" placeholders are supported");
+
+  struct Segments {
+    // one more, so empty format string doesn't make an empty array
+    Segment items[PARSED.segmentsCount + 1] = {};
+
+    constexpr Segments() noexcept {
+      Parser::parse(Format.characters, Format.length(), items);
+    }
+  };
+
+  static constexpr Segments SEGMENTS = {};
+
+public:
+  static constexpr size_t ARGUMENTS_COUNT = PARSED.argumentsCount;
+  static constexpr size_t LITERAL_LENGTH  = PARSED.literalLength;
+
+  template <typename... ArgsT>
+  static constexpr char32_t* write(char32_t* destination, ArgsT const&... args) {
+    return _writeSegment<0>(destination, args...);
+  }
+
+private:
+  template <size_t Index, typename FirstT, typename... RestT>
+  [[nodiscard]]
+  static constexpr auto const& _argument(FirstT const& first, RestT const&... rest) noexcept {
+    if constexpr (Index == 0)
+      return first;
+    else
+      return _argument<Index - 1>(rest...);
+  }
+
+  template <size_t Index, typename FirstT, typename... RestT>
+  struct ArgumentType {
+    using type = typename ArgumentType<Index - 1, RestT...>::type;
+  };
+
+  template <typename FirstT, typename... RestT>
+  struct ArgumentType<0, FirstT, RestT...> {
+    using type = FirstT;
+  };
+
+  template <size_t Index, typename... ArgsT>
+  static constexpr char32_t* _writeSegment(char32_t* destination, ArgsT const&... args) {
+    if constexpr (Index == PARSED.segmentsCount)
+      return destination;
+    else {
+      constexpr Segment SEGMENT = SEGMENTS.items[Index];
+
+      if constexpr (SEGMENT.isArgument) {
+        using ArgumentT = typename ArgumentType<SEGMENT.argument, ArgsT...>::type;
+        destination = Formatter<ArgumentT>::write(destination, _argument<SEGMENT.argument>(args...));
+      }
+      else {
+        for (size_t index = 0; index < SEGMENT.length; ++index)
+          *destination++ = Format.characters[SEGMENT.begin + index];
+      }
+
+      return _writeSegment<Index + 1>(destination, args...);
+    }
+  }
+};
+
+_RHLIB_HIDDEN_END
+
+// Appends formatted text to destination. Space for the whole result is reserved once,
+//  so clearing and reusing the same string avoids allocations at all
+template <FixedString Format, typename... ArgsT>
+constexpr void formatTo(String& destination, ArgsT const&... args) {
+  using FormatString = _RHLIBH FormatString<Format>;
+
+  static_assert(FormatString::ARGUMENTS_COUNT == sizeof...(ArgsT), "Count of \"{}\" in format string doesn't match count of arguments");
+  static_assert((Formattable<ArgsT> && ...), "Argument type has no Formatter specialization");
+
+  size_t prev_length = destination.length();
+  size_t max_length = FormatString::LITERAL_LENGTH + (Formatter<ArgsT>::maxLength(args) + ... + 0);
+  size_t need_allocated = prev_length + max_length + 1;
+
+  // Arguments may view destination itself (formatTo(string, string)), so neither its buffer
+  //  nor its length may change before they're written. Growing result is built in a new
+  //  string, and the old buffer is freed after
+  if (destination.capacity() < need_allocated) {
+    String result;
+    result.reserve(max(need_allocated, destination.capacity() + destination.capacity() / 2));
+    result.resizeForOverwrite(prev_length + max_length);
+
+    _RHLIBH StringUtils::copyUnits(result.data(), destination.data(), prev_length);
+
+    char32_t* end = FormatString::write(result.data() + prev_length, args...);
+    result.resizeForOverwrite(static_cast<size_t>(end - result.data()));
+
+    destination = move(result);
+    return;
+  }
+
+  // written past the end, but within capacity
+  char32_t* end = FormatString::write(destination.data() + prev_length, args...);
+  destination.resizeForOverwrite(static_cast<size_t>(end - destination.data()));
+}
+
+// format<"{} of {} done">(count, total)
+template <FixedString Format, typename... ArgsT>
+[[nodiscard]]
+constexpr String format(ArgsT const&... args) {
+  String result;
+  formatTo<Format>(result, args...);
+  return result;
+}
+
+// Anything convertible to StringView: String, FixedString, literals
+template <typename T>
+  requires ConvertibleTo<T, StringView>
+struct Formatter<T> {
+  [[nodiscard]]
+  static constexpr size_t maxLength(StringView string) noexcept {
+    return string.length();
+  }
+
+  static constexpr char32_t* write(char32_t* destination, StringView string) noexcept {
+    for (char32_t character : string)
+      *destination++ = character;
+
+    return destination;
+  }
+};
+
+template <>
+struct Formatter<char32_t> {
+  [[nodiscard]]
+  static constexpr size_t maxLength(char32_t) noexcept {
+    return 1;
+  }
+
+  static constexpr char32_t* write(char32_t* destination, char32_t character) noexcept {
+    *destination++ = character;
+    return destination;
+  }
+};
+
+template <>
+struct Formatter<bool> {
+  [[nodiscard]]
+  static constexpr size_t maxLength(bool value) noexcept {
+    return value ? 4 : 5;
+  }
+
+  static constexpr char32_t* write(char32_t* destination, bool value) noexcept {
+    return Formatter<StringView>::write(destination, value ? U"true" : U"false");
+  }
+};
+
+// Length of integers is exact, so nothing is over-reserved
+template <typename T>
+  requires Integral<T>
+struct Formatter<T> {
+  [[nodiscard]]
+  static constexpr size_t maxLength(T value) noexcept {
+    uint64_t magnitude = static_cast<uint64_t>(value);
+
+    if constexpr (_RHLIBH NumberUtils::IS_SIGNED<T>) {
+      if (value < 0)
+        return _RHLIBH NumberUtils::countDigits(0 - magnitude) + 1;
+    }
+
+    return _RHLIBH NumberUtils::countDigits(magnitude);
+  }
+
+  static constexpr char32_t* write(char32_t* destination, T value) noexcept {
+    return toChars(destination, value);
+  }
+};
+
+template <typename T>
+  requires is_any_type_of<T, float, double>
+struct Formatter<T> {
+  [[nodiscard]]
+  static constexpr size_t maxLength(T) noexcept {
+    return MAX_NUMBER_LENGTH;
+  }
+
+  static inline char32_t* write(char32_t* destination, T value) noexcept {
+    return toChars(destination, value);
+  }
+};
+
+// [first, second, third]
+template <Formattable T, typename AllocatorT>
+struct Formatter<List<T, AllocatorT>> {
+  [[nodiscard]]
+  static constexpr size_t maxLength(List<T, AllocatorT> const& list) noexcept {
+    size_t length = 2;
+
+    for (T const& item : list)
+      length += Formatter<T>::maxLength(item);
+
+    if (list.length() > 1)
+      length += (list.length() - 1) * 2;
+
+    return length;
+  }
+
+  static constexpr char32_t* write(char32_t* destination, List<T, AllocatorT> const& list) noexcept {
+    *destination++ = U'[';
+
+    for (size_t index = 0; index < list.length(); ++index) {
+      if (index != 0) {
+        *destination++ = U',';
+        *destination++ = U' ';
+      }
+
+      destination = Formatter<T>::write(destination, list[index]);
+    }
+
+    *destination++ = U']';
+
+    return destination;
+  }
+};
+
+// (first, second)
+template <Formattable T, Formattable K>
+struct Formatter<Pair<T, K>> {
+  [[nodiscard]]
+  static constexpr size_t maxLength(Pair<T, K> const& pair) noexcept {
+    return Formatter<T>::maxLength(pair.first) + Formatter<K>::maxLength(pair.second) + 4;
+  }
+
+  static constexpr char32_t* write(char32_t* destination, Pair<T, K> const& pair) noexcept {
+    *destination++ = U'(';
+    destination = Formatter<T>::write(destination, pair.first);
+    *destination++ = U',';
+    *destination++ = U' ';
+    destination = Formatter<K>::write(destination, pair.second);
+    *destination++ = U')';
+
+    return destination;
+  }
+};
+
+_RHLIB_END
+
+_RHLIB_GLOBAL_CLASS(Formatter);
+_RHLIB_GLOBAL_CLASS(Formattable);
+_RHLIB_GLOBAL_CLASS(formatTo);
+_RHLIB_GLOBAL_CLASS(format);
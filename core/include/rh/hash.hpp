@@ -0,0 +1,387 @@
+#pragma once
+#define _RHLIB_INCLUDED_HASH
+
+#include <rh.hpp>
+
+#include <rh/TypeTraits.hpp>
+#include <rh/simd.hpp>
+
+_RHLIB_BEGIN
+_RHLIB_HIDDEN_BEGIN
+
+// Reads little-endian integers from any offset of array of code units.
+// Constant evaluation can't reinterpret memory, so it assembles them from units
+template <typename UnitT>
+struct HashReader {
+  static constexpr size_t UNIT_SIZE = sizeof(UnitT);
+
+  static_assert(UNIT_SIZE == 1 || UNIT_SIZE == 2 || UNIT_SIZE == 4, "Unsupported code unit size");
+
+  const UnitT* units;
+
+  [[nodiscard]]
+  inline const uint8_t* bytes() const noexcept {
+    return reinterpret_cast<const uint8_t*>(units);
+  }
+
+  [[nodiscard]]
+  constexpr uint64_t read8(size_t offset) const noexcept {
+    uint64_t unit = static_cast<uint64_t>(units[offset / UNIT_SIZE]);
+    return (unit >> (offset % UNIT_SIZE * 8)) & 0xFF;
+  }
+
+  [[nodiscard]]
+  constexpr uint64_t read32(size_t offset) const noexcept {
+    if !consteval {
+      uint32_t result;
+      __builtin_memcpy(&result, bytes() + offset, sizeof(result));
+      return result;
+    }
+
+    return _assemble(offset, 4);
+  }
+
+  [[nodiscard]]
+  constexpr uint64_t read64(size_t offset) const noexcept {
+    if !consteval {
+      uint64_t result;
+      __builtin_memcpy(&result, bytes() + offset, sizeof(result));
+      return result;
+    }
+
+    return _assemble(offset, 8);
+  }
+
+  [[nodiscard]]
+  constexpr uint64_t _assemble(size_t offset, size_t size) const noexcept {
+    uint64_t result = 0;
+
+    for (size_t index = 0; index < size; ++index)
+      result |= read8(offset + index) << (index * 8);
+
+    return result;
+  }
+};
+
+// wyhash for short inputs, xxh3-like stripe accumulation for long ones.
+// Scalar and vector versions of the long path give the same result
+struct HashUtils {
+  static constexpr uint64_t SECRET[4] = {
+    0xA0761D6478BD642Full, 0xE7037ED1A0B428DBull, 0x8EBC6AF09C88C6E3ull, 0x589965CC75374CC3ull
+  };
+
+  // Stripe N of a block is mixed with words [N, N + 8), block is scrambled with [16, 24)
+  static constexpr uint64_t STRIPE_SECRET[24] = {
+    0xBE4BA423396CFEB8ull, 0x1CAD21F72C81017Cull, 0xDB979083E96DD4DEull, 0x1F67B3B7A4A44072ull,
+    0x78E5C0CC4EE679CBull, 0x2172FFCC7DD05A82ull, 0x8E2443F7744608B8ull, 0x4C263A81E69035E0ull,
+    0xCB00C391BB52283Cull, 0xA32E531B8B65D088ull, 0x4EF90DA297486471ull, 0xD8ACDEA946EF1938ull,
+    0x3F349CE33F76FAA8ull, 0x1D4F0BC7C7BBDCF9ull, 0x3159B4CD4BE0518Aull, 0x647378D9C97E9FC8ull,
+    0xC3EBD33483ACC5EAull, 0xEB6313FAFFA081C5ull, 0x49DAF0B751DD0D17ull, 0x9E68D429265516D3ull,
+    0xFCA1477D58BE162Bull, 0xCE31D07AD1B8F88Full, 0x280416958F3ACB45ull, 0x7E404BBBCAFBD7AFull
+  };
+
+  static constexpr uint64_t LANE_PRIMES[8] = {
+    0x00000000C2B2AE3Dull, 0x9E3779B185EBCA87ull, 0xC2B2AE3D27D4EB4Full, 0x165667B19E3779F9ull,
+    0x85EBCA77C2B2AE63ull, 0x0000000085EBCA77ull, 0x27D4EB2F165667C5ull, 0x000000009E3779B1ull
+  };
+
+  static constexpr uint32_t SCRAMBLE_PRIME = 0x9E3779B1;
+
+  static constexpr size_t LANES_COUNT       = 8;
+  static constexpr size_t STRIPE_SIZE       = LANES_COUNT * sizeof(uint64_t);
+  static constexpr size_t STRIPES_PER_BLOCK = 16;
+  static constexpr size_t LAST_STRIPE_KEY   = 11;
+
+  // Inputs of at least this many bytes go to the stripe loop
+  static constexpr size_t LONG_INPUT_SIZE = 512;
+
+  static constexpr void multiply(uint64_t& a, uint64_t& b) noexcept {
+    unsigned __int128 product = a;
+    product *= b;
+
+    a = static_cast<uint64_t>(product);
+    b = static_cast<uint64_t>(product >> 64);
+  }
+
+  [[nodiscard]]
+  static constexpr uint64_t mix(uint64_t a, uint64_t b) noexcept {
+    multiply(a, b);
+    return a ^ b;
+  }
+
+  template <typename UnitT>
+  [[nodiscard]]
+  static constexpr uint64_t hash(const UnitT* units, size_t size, uint64_t seed) noexcept {
+    HashReader<UnitT> reader{units};
+
+    if (size >= LONG_INPUT_SIZE)
+      return hashLong(reader, size, seed);
+
+    return hashShort(reader, size, seed);
+  }
+
+  template <typename UnitT>
+  [[nodiscard]]
+  static constexpr uint64_t hashShort(HashReader<UnitT> reader, size_t size, uint64_t seed) noexcept {
+    seed ^= mix(seed ^ SECRET[0], SECRET[1]);
+
+    uint64_t a = 0;
+    uint64_t b = 0;
+
+    if (size <= 16) {
+      if (size >= 4) {
+        size_t middle = (size >> 3) << 2;
+
+        a = (reader.read32(0) << 32) | reader.read32(middle);
+        b = (reader.read32(size - 4) << 32) | reader.read32(size - 4 - middle);
+      }
+      else if (size > 0)
+        a = (reader.read8(0) << 16) | (reader.read8(size >> 1) << 8) | reader.read8(size - 1);
+    }
+    else {
+      size_t offset = 0;
+      size_t remaining = size;
+
+      if (remaining > 48) {
+        uint64_t first = seed;
+        uint64_t second = seed;
+
+        do {
+          seed   = mix(reader.read64(offset) ^ SECRET[1], reader.read64(offset + 8) ^ seed);
+          first  = mix(reader.read64(offset + 16) ^ SECRET[2], reader.read64(offset + 24) ^ first);
+          second = mix(reader.read64(offset + 32) ^ SECRET[3], reader.read64(offset + 40) ^ second);
+
+          offset += 48;
+          remaining -= 48;
+        } while (remaining > 48);
+
+        seed ^= first ^ second;
+      }
+
+      while (remaining > 16) {
+        seed = mix(reader.read64(offset) ^ SECRET[1], reader.read64(offset + 8) ^ seed);
+
+        offset += 16;
+        remaining -= 16;
+      }
+
+      a = reader.read64(offset + remaining - 16);
+      b = reader.read64(offset + remaining - 8);
+    }
+
+    a ^= SECRET[1];
+    b ^= seed;
+    multiply(a, b);
+
+    return mix(a ^ SECRET[0] ^ size, b ^ SECRET[1]);
+  }
+
+  template <typename UnitT>
+  [[nodiscard]]
+  static constexpr uint64_t hashLong(HashReader<UnitT> reader, size_t size, uint64_t seed) noexcept {
+    uint64_t accumulators[LANES_COUNT];
+
+    for (size_t lane = 0; lane < LANES_COUNT; ++lane)
+      accumulators[lane] = lane % 2 ? LANE_PRIMES[lane] - seed : LANE_PRIMES[lane] + seed;
+
+#if _RHLIB_SIMD_SSE2
+    if !consteval {
+      accumulateVector(accumulators, reader.bytes(), size);
+    }
+    else {
+      accumulateScalar(accumulators, reader, size);
+    }
+#else
+    accumulateScalar(accumulators, reader, size);
+#endif
+
+    uint64_t result = size * LANE_PRIMES[1];
+
+    for (size_t lane = 0; lane < LANES_COUNT; lane += 2)
+      result += mix(accumulators[lane] ^ SECRET[lane / 2], accumulators[lane + 1] ^ STRIPE_SECRET[lane]);
+
+    return mix(result ^ SECRET[0], SECRET[2] ^ seed);
+  }
+
+  // Last stripe is always processed separately and may overlap the previous one
+  template <typename UnitT>
+  static constexpr void accumulateScalar(uint64_t (&accumulators)[LANES_COUNT], HashReader<UnitT> reader, size_t size) noexcept {
+    size_t stripes_count = (size - 1) / STRIPE_SIZE;
+
+    for (size_t stripe = 0; stripe < stripes_count; ++stripe) {
+      accumulateStripe(accumulators, reader, stripe * STRIPE_SIZE, STRIPE_SECRET + stripe % STRIPES_PER_BLOCK);
+
+      if (stripe % STRIPES_PER_BLOCK == STRIPES_PER_BLOCK - 1)
+        scramble(accumulators);
+    }
+
+    accumulateStripe(accumulators, reader, size - STRIPE_SIZE, STRIPE_SECRET + LAST_STRIPE_KEY);
+  }
+
+  template <typename UnitT>
+  static constexpr void accumulateStripe(uint64_t (&accumulators)[LANES_COUNT], HashReader<UnitT> reader, size_t offset, const uint64_t* secret) noexcept {
+    for (size_t lane = 0; lane < LANES_COUNT; ++lane) {
+      uint64_t data = reader.read64(offset + lane * sizeof(uint64_t));
+      uint64_t key = data ^ secret[lane];
+
+      accumulators[lane] += data + (key & 0xFFFFFFFF) * (key >> 32);
+    }
+  }
+
+  static constexpr void scramble(uint64_t (&accumulators)[LANES_COUNT]) noexcept {
+    for (size_t lane = 0; lane < LANES_COUNT; ++lane) {
+      uint64_t value = accumulators[lane];
+
+      value ^= value >> 47;
+      value ^= STRIPE_SECRET[STRIPES_PER_BLOCK + lane];
+
+      accumulators[lane] = value * SCRAMBLE_PRIME;
+    }
+  }
+
+#if _RHLIB_SIMD_SSE2
+#if _RHLIB_SIMD_AVX2
+  using Vector = __m256i;
+
+  static constexpr size_t VECTOR_LANES = 4;
+
+  static inline Vector load(const void* address) noexcept { return _mm256_loadu_si256(static_cast<const __m256i*>(address)); }
+  static inline void store(void* address, Vector value) noexcept { _mm256_storeu_si256(static_cast<__m256i*>(address), value); }
+
+  static inline Vector add(Vector a, Vector b) noexcept { return _mm256_add_epi64(a, b); }
+  static inline Vector xorBits(Vector a, Vector b) noexcept { return _mm256_xor_si256(a, b); }
+  static inline Vector shiftRight(Vector a, int bits) noexcept { return _mm256_srli_epi64(a, bits); }
+  static inline Vector shiftLeft(Vector a, int bits) noexcept { return _mm256_slli_epi64(a, bits); }
+  static inline Vector multiplyLow(Vector a, Vector b) noexcept { return _mm256_mul_epu32(a, b); }
+  static inline Vector broadcast(uint32_t value) noexcept { return _mm256_set1_epi64x(value); }
+#else
+  using Vector = __m128i;
+
+  static constexpr size_t VECTOR_LANES = 2;
+
+  static inline Vector load(const void* address) noexcept { return _mm_loadu_si128(static_cast<const __m128i*>(address)); }
+  static inline void store(void* address, Vector value) noexcept { _mm_storeu_si128(static_cast<__m128i*>(address), value); }
+
+  static inline Vector add(Vector a, Vector b) noexcept { return _mm_add_epi64(a, b); }
+  static inline Vector xorBits(Vector a, Vector b) noexcept { return _mm_xor_si128(a, b); }
+  static inline Vector shiftRight(Vector a, int bits) noexcept { return _mm_srli_epi64(a, bits); }
+  static inline Vector shiftLeft(Vector a, int bits) noexcept { return _mm_slli_epi64(a, bits); }
+  static inline Vector multiplyLow(Vector a, Vector b) noexcept { return _mm_mul_epu32(a, b); }
+  static inline Vector broadcast(uint32_t value) noexcept { return _mm_set1_epi64x(value); }
+#endif
+
+  static constexpr size_t VECTORS_COUNT = LANES_COUNT / VECTOR_LANES;
+
+  // Same as accumulateScalar, but keeps accumulators in registers
+  static inline void accumulateVector(uint64_t (&accumulators)[LANES_COUNT], const uint8_t* data, size_t size) noexcept {
+    Vector vectors[VECTORS_COUNT];
+
+    for (size_t index = 0; index < VECTORS_COUNT; ++index)
+      vectors[index] = load(accumulators + index * VECTOR_LANES);
+
+    size_t stripes_count = (size - 1) / STRIPE_SIZE;
+
+    for (size_t stripe = 0; stripe < stripes_count; ++stripe) {
+      accumulateStripeVector(vectors, data + stripe * STRIPE_SIZE, STRIPE_SECRET + stripe % STRIPES_PER_BLOCK);
+
+      if (stripe % STRIPES_PER_BLOCK == STRIPES_PER_BLOCK - 1)
+        scrambleVector(vectors);
+    }
+
+    accumulateStripeVector(vectors, data + size - STRIPE_SIZE, STRIPE_SECRET + LAST_STRIPE_KEY);
+
+    for (size_t index = 0; index < VECTORS_COUNT; ++index)
+      store(accumulators + index * VECTOR_LANES, vectors[index]);
+  }
+
+  static inline void accumulateStripeVector(Vector (&vectors)[VECTORS_COUNT], const uint8_t* stripe, const uint64_t* secret) noexcept {
+    for (size_t index = 0; index < VECTORS_COUNT; ++index) {
+      Vector data = load(stripe + index * sizeof(Vector));
+      Vector key = xorBits(data, load(secret + index * VECTOR_LANES));
+      Vector product = multiplyLow(key, shiftRight(key, 32));
+
+      vectors[index] = add(vectors[index], add(data, product));
+    }
+  }
+
+  // 64-bit multiplication by 32-bit prime is done as two 32x32 multiplications
+  static inline void scrambleVector(Vector (&vectors)[VECTORS_COUNT]) noexcept {
+    const Vector prime = broadcast(SCRAMBLE_PRIME);
+
+    for (size_t index = 0; index < VECTORS_COUNT; ++index) {
+      Vector value = vectors[index];
+
+      value = xorBits(value, shiftRight(value, 47));
+      value = xorBits(value, load(STRIPE_SECRET + STRIPES_PER_BLOCK + index * VECTOR_LANES));
+
+      Vector low = multiplyLow(value, prime);
+      Vector high = multiplyLow(shiftRight(value, 32), prime);
+
+      vectors[index] = add(low, shiftLeft(high, 32));
+    }
+  }
+#endif
+};
+
+_RHLIB_HIDDEN_END
+
+namespace hash {
+
+// Hash of code units is the same as hash of their bytes (on little-endian platforms),
+//  both in constant evaluation and at runtime
+template <typename UnitT>
+[[nodiscard]]
+constexpr uint64_t units(const UnitT* data, size_t count, uint64_t seed = 0) noexcept {
+  return _RHLIBH HashUtils::hash(data, count * sizeof(UnitT), seed);
+}
+
+[[nodiscard]]
+inline uint64_t bytes(const void* data, size_t size, uint64_t seed = 0) noexcept {
+  return _RHLIBH HashUtils::hash(static_cast<const uint8_t*>(data), size, seed);
+}
+
+[[nodiscard]]
+constexpr uint64_t integer(uint64_t value) noexcept {
+  return _RHLIBH HashUtils::mix(value ^ _RHLIBH HashUtils::SECRET[0], _RHLIBH HashUtils::SECRET[1]);
+}
+
+// Order-dependent
+[[nodiscard]]
+constexpr uint64_t combine(uint64_t seed, uint64_t value) noexcept {
+  return _RHLIBH HashUtils::mix(seed ^ _RHLIBH HashUtils::SECRET[2], value ^ _RHLIBH HashUtils::SECRET[3]);
+}
+
+} // namespace hash
+
+// Default hash function for containers. Uses "hash()" member if there's one
+template <typename T>
+struct Hasher {
+  [[nodiscard]]
+  constexpr uint64_t operator()(T const& value) const noexcept
+    requires requires { { value.hash() } -> ConvertibleTo<uint64_t>; }
+  {
+    return value.hash();
+  }
+};
+
+template <typename T>
+  requires is_integral_type<T> || is_char_type<T>
+struct Hasher<T> {
+  [[nodiscard]]
+  constexpr uint64_t operator()(T value) const noexcept {
+    return hash::integer(static_cast<uint64_t>(value));
+  }
+};
+
+template <typename T>
+struct Hasher<T*> {
+  [[nodiscard]]
+  inline uint64_t operator()(T* value) const noexcept {
+    return hash::integer(reinterpret_cast<uintptr_t>(value));
+  }
+};
+
+_RHLIB_END
+
+_RHLIB_GLOBAL_NS(hash);
+_RHLIB_GLOBAL_CLASS(Hasher);
@@ -0,0 +1,189 @@
+#pragma once
+#define _RHLIB_INCLUDED_NUMBERS
+
+#include <rh.hpp>
+
+#include <rh/String.hpp>
+#include <rh/TypeTraits.hpp>
+#include <rh/exceptions.hpp>
+
+_RHLIB_BEGIN
+
+// Enough for any integer and for the shortest representation of any floating-point number
+static constexpr size_t MAX_NUMBER_LENGTH = 32;
+
+// long double isn't supported
+template <typename T>
+concept Number = Integral<T> || is_any_type_of<T, float, double>;
+
+_RHLIB_HIDDEN_BEGIN
+
+struct NumberUtils {
+  static constexpr char DIGIT_PAIRS[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+  static constexpr uint64_t POWERS_OF_TEN[20] = {
+    1ull, 10ull, 100ull, 1000ull, 10000ull,
+    100000ull, 1000000ull, 10000000ull, 100000000ull, 1000000000ull,
+    10000000000ull, 100000000000ull, 1000000000000ull, 10000000000000ull, 100000000000000ull,
+    1000000000000000ull, 10000000000000000ull, 100000000000000000ull, 1000000000000000000ull, 10000000000000000000ull
+  };
+
+  template <typename T>
+  static constexpr bool IS_SIGNED = static_cast<T>(-1) < static_cast<T>(0);
+
+  template <typename T>
+  static constexpr uint64_t MAX_VALUE = IS_SIGNED<T> ? (1ull << (sizeof(T) * 8 - 1)) - 1 : static_cast<T>(~static_cast<T>(0));
+
+  // log10 is estimated from the bit length (1233 / 4096 ~ log10(2)) and corrected by one comparison
+  [[nodiscard]]
+  static constexpr size_t countDigits(uint64_t value) noexcept {
+    value |= 1;
+
+    size_t estimate = ((64 - __builtin_clzll(value)) * 1233) >> 12;
+    return estimate - (value < POWERS_OF_TEN[estimate]) + 1;
+  }
+
+  // Writes exactly countDigits(value) characters
+  static constexpr char32_t* writeUnsigned(char32_t* destination, uint64_t value) noexcept {
+    char32_t* end = destination + countDigits(value);
+    char32_t* it = end;
+
+    while (value >= 100) {
+      size_t pair = (value % 100) * 2;
+      value /= 100;
+
+      *--it = static_cast<char32_t>(DIGIT_PAIRS[pair + 1]);
+      *--it = static_cast<char32_t>(DIGIT_PAIRS[pair]);
+    }
+
+    if (value >= 10) {
+      *--it = static_cast<char32_t>(DIGIT_PAIRS[value * 2 + 1]);
+      *--it = static_cast<char32_t>(DIGIT_PAIRS[value * 2]);
+    }
+    else
+      *--it = static_cast<char32_t>(U'0' + value);
+
+    return end;
+  }
+
+  template <typename T>
+  static constexpr char32_t* writeInteger(char32_t* destination, T value) noexcept {
+    uint64_t magnitude = static_cast<uint64_t>(value);
+
+    if constexpr (IS_SIGNED<T>) {
+      if (value < 0) {
+        *destination++ = U'-';
+        magnitude = 0 - magnitude;
+      }
+    }
+
+    return writeUnsigned(destination, magnitude);
+  }
+
+  template <typename T>
+  static constexpr ssize_t parseInteger(const char32_t* string, size_t length, T& out_value) noexcept {
+    size_t index = 0;
+    bool is_negative = false;
+
+    if constexpr (IS_SIGNED<T>) {
+      if (length > 0 && string[0] == U'-') {
+        is_negative = true;
+        index = 1;
+      }
+    }
+
+    size_t digits_begin = index;
+    uint64_t value = 0;
+
+    for (; index < length; ++index) {
+      uint32_t digit = static_cast<uint32_t>(string[index]) - U'0';
+
+      if (digit > 9)
+        break;
+
+      if (__builtin_mul_overflow(value, 10ull, &value) || __builtin_add_overflow(value, digit, &value))
+        return -1;
+    }
+
+    if (index == digits_begin)
+      return -1;
+
+    // magnitude of the minimal signed value is greater than the maximal by one
+    if (value > MAX_VALUE<T> + is_negative)
+      return -1;
+
+    out_value = static_cast<T>(is_negative ? 0 - value : value);
+    return static_cast<ssize_t>(index);
+  }
+};
+
+_RHLIB_HIDDEN_END
+
+// Writes decimal representation and returns its end.
+// destination must have space for MAX_NUMBER_LENGTH characters, null-terminator isn't written
+template <Integral T>
+constexpr char32_t* toChars(char32_t* destination, T value) noexcept {
+  return _RHLIBH NumberUtils::writeInteger(destination, value);
+}
+
+// Shortest representation, which is parsed back to the same value.
+// Fixed or scientific notation is chosen just like in std::to_chars: whichever is shorter
+_RHLIB_API
+char32_t* toChars(char32_t* destination, double value) noexcept;
+
+_RHLIB_API
+char32_t* toChars(char32_t* destination, float value) noexcept;
+
+// Appends number to string, writing directly into its buffer
+template <Number T>
+constexpr void toChars(String& destination, T value) {
+  size_t prev_length = destination.length();
+
+  destination.resizeForOverwrite(prev_length + MAX_NUMBER_LENGTH);
+
+  char32_t* end = toChars(destination.data() + prev_length, value);
+  destination.resizeForOverwrite(static_cast<size_t>(end - destination.data()));
+}
+
+// Parses number from the beginning of string.
+// Returns count of used characters, or -1 if string doesn't start with a number or it's out of range
+template <Integral T>
+constexpr ssize_t parseNumber(StringView string, T& out_value) noexcept {
+  return _RHLIBH NumberUtils::parseInteger(string.data(), string.length(), out_value);
+}
+
+// Accepts the same syntax as std::from_chars: [-]digits[.digits][e[+-]digits], inf, infinity and nan.
+// Values are rounded to the nearest, too big ones become infinity
+_RHLIB_API
+ssize_t parseNumber(StringView string, double& out_value) noexcept;
+
+_RHLIB_API
+ssize_t parseNumber(StringView string, float& out_value) noexcept;
+
+// The whole string must be a number, throws ParseError otherwise
+template <Number T>
+[[nodiscard]]
+constexpr T parseNumber(StringView string) {
+  T value = {};
+
+  if (parseNumber(string, value) != static_cast<ssize_t>(string.length()))
+    throw ParseError(U"string isn't a number or it's out of range");
+
+  return value;
+}
+
+_RHLIB_END
+
+_RHLIB_GLOBAL_CLASS(MAX_NUMBER_LENGTH);
+_RHLIB_GLOBAL_CLASS(toChars);
+_RHLIB_GLOBAL_CLASS(parseNumber);
@@ -0,0 +1,157 @@
+#pragma once
+#define _RHLIB_INCLUDED_SIMD
+
+#include <rh.hpp>
+
+#if _RHLIB_SIMD_SSE2
+# include <immintrin.h>
+#endif
+
+_RHLIB_BEGIN
+_RHLIB_HIDDEN_BEGIN
+
+// Index of the lowest set bit. Value must be non-zero
+[[nodiscard]]
+constexpr uint32_t countTrailingZeros(uint32_t value) noexcept {
+  return static_cast<uint32_t>(__builtin_ctz(value));
+}
+
+[[nodiscard]]
+constexpr uint32_t countTrailingZeros(uint64_t value) noexcept {
+  return static_cast<uint32_t>(__builtin_ctzll(value));
+}
+
+// Smallest power of two, which isn't less than value
+[[nodiscard]]
+constexpr size_t roundUpToPowerOfTwo(size_t value) noexcept {
+  size_t result = 1;
+
+  while (result < value)
+    result <<= 1;
+
+  return result;
+}
+
+#if _RHLIB_SIMD_SSE2
+
+// Widest available vector register, viewed as lanes of 32-bit integers.
+// Masks have one bit per byte, so lane N occupies bits [N * 4, N * 4 + 4)
+struct Vector32 {
+#if _RHLIB_SIMD_AVX2
+  using type = __m256i;
+
+  static constexpr size_t   SIZE      = 32;
+  static constexpr uint32_t FULL_MASK = 0xFFFFFFFF;
+
+  [[nodiscard]]
+  static inline type load(const void* address) noexcept {
+    return _mm256_loadu_si256(static_cast<const __m256i*>(address));
+  }
+
+  // Aligned block never crosses a page, so it's safe to read past the end of buffer with it
+  [[nodiscard]]
+  _RHLIB_NO_SANITIZE_ADDRESS
+  static inline type loadAligned(const void* address) noexcept {
+    return _mm256_load_si256(static_cast<const __m256i*>(address));
+  }
+
+  [[nodiscard]]
+  static inline type broadcast(uint32_t value) noexcept {
+    return _mm256_set1_epi32(static_cast<int>(value));
+  }
+
+  [[nodiscard]]
+  static inline uint32_t equalMask(type left, type right) noexcept {
+    return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi32(left, right)));
+  }
+
+  static inline void store(void* address, type value) noexcept {
+    _mm256_storeu_si256(static_cast<__m256i*>(address), value);
+  }
+
+  [[nodiscard]]
+  static inline type bitAnd(type left, type right) noexcept {
+    return _mm256_and_si256(left, right);
+  }
+
+  [[nodiscard]]
+  static inline type bitOr(type left, type right) noexcept {
+    return _mm256_or_si256(left, right);
+  }
+
+  [[nodiscard]]
+  static inline type bitXor(type left, type right) noexcept {
+    return _mm256_xor_si256(left, right);
+  }
+
+  // left & ~right
+  [[nodiscard]]
+  static inline type bitAndNot(type left, type right) noexcept {
+    return _mm256_andnot_si256(right, left);
+  }
+#else
+  using type = __m128i;
+
+  static constexpr size_t   SIZE      = 16;
+  static constexpr uint32_t FULL_MASK = 0xFFFF;
+
+  [[nodiscard]]
+  static inline type load(const void* address) noexcept {
+    return _mm_loadu_si128(static_cast<const __m128i*>(address));
+  }
+
+  // Aligned block never crosses a page, so it's safe to read past the end of buffer with it
+  [[nodiscard]]
+  _RHLIB_NO_SANITIZE_ADDRESS
+  static inline type loadAligned(const void* address) noexcept {
+    return _mm_load_si128(static_cast<const __m128i*>(address));
+  }
+
+  [[nodiscard]]
+  static inline type broadcast(uint32_t value) noexcept {
+    return _mm_set1_epi32(static_cast<int>(value));
+  }
+
+  [[nodiscard]]
+  static inline uint32_t equalMask(type left, type right) noexcept {
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi32(left, right)));
+  }
+
+  static inline void store(void* address, type value) noexcept {
+    _mm_storeu_si128(static_cast<__m128i*>(address), value);
+  }
+
+  [[nodiscard]]
+  static inline type bitAnd(type left, type right) noexcept {
+    return _mm_and_si128(left, right);
+  }
+
+  [[nodiscard]]
+  static inline type bitOr(type left, type right) noexcept {
+    return _mm_or_si128(left, right);
+  }
+
+  [[nodiscard]]
+  static inline type bitXor(type left, type right) noexcept {
+    return _mm_xor_si128(left, right);
+  }
+
+  // left & ~right
+  [[nodiscard]]
+  static inline type bitAndNot(type left, type right) noexcept {
+    return _mm_andnot_si128(right, left);
+  }
+#endif
+
+  static constexpr size_t LANES = SIZE / sizeof(uint32_t);
+
+  [[nodiscard]]
+  static constexpr size_t lane(uint32_t mask) noexcept {
+    return countTrailingZeros(mask) / sizeof(uint32_t);
+  }
+};
+
+#endif
+
+_RHLIB_HIDDEN_END
+_RHLIB_END
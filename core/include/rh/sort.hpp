@@ -0,0 +1,787 @@
+#pragma once
+#define _RHLIB_INCLUDED_SORT
+
+#include <rh.hpp>
+
+#include <rh/Allocator.hpp>
+#include <rh/Container.hpp>
+#include <rh/Pair.hpp>
+#include <rh/String.hpp>
+#include <rh/TypeTraits.hpp>
+
+_RHLIB_BEGIN
+
+_RHLIB_HIDDEN_BEGIN
+
+template <typename ContainerT>
+using container_item = remove_reference<decltype(*declval<ContainerT&>().data())>;
+
+// Numbers and strings are sorted by their bits and code units, when they are
+//  compared by Less. Long double has padding bits, so it goes through comparisons
+template <typename T>
+static constexpr bool is_radix_sortable = Integral<T> || is_any_type_of<T, float, double>;
+
+template <typename T>
+static constexpr bool is_radix_string = false;
+
+template <typename CharT, typename AllocatorT>
+static constexpr bool is_radix_string<BasicString<CharT, AllocatorT>> = true;
+
+template <typename CharT>
+static constexpr bool is_radix_string<BasicStringView<CharT>> = true;
+
+// Raw memory for count items, which are constructed and destroyed by its user
+template <typename T>
+struct SortBuffer {
+  T*     items;
+  size_t count;
+
+  explicit SortBuffer(size_t count)
+    : items(static_cast<T*>(DefaultAllocator::allocate(count * sizeof(T), alignof(T)))), count(count) {}
+
+  SortBuffer(SortBuffer const&) = delete;
+  SortBuffer& operator=(SortBuffer const&) = delete;
+
+  ~SortBuffer() {
+    DefaultAllocator::deallocate(items, count * sizeof(T), alignof(T));
+  }
+};
+
+// Item taken out of the range goes back into the hole, even if less() throws,
+//  so a throwing comparator leaves all items in place in some order
+template <typename T>
+struct SortHole {
+  T  item;
+  T* position;
+
+  constexpr ~SortHole() {
+    *position = move(item);
+  }
+};
+
+// Pattern-defeating quicksort (Orson Peters): median-of-3 or ninther pivots, already
+//  partitioned ranges are finished with a bounded insertion sort, runs of equal items
+//  are split off in one pass, and unbalanced partitions shuffle items around the pivot
+//  and at last fall back to heapsort, so the worst case is O(n log n)
+struct SortUtils {
+  static constexpr size_t INSERTION_SORT_THRESHOLD     = 24;
+  static constexpr size_t NINTHER_THRESHOLD            = 128;
+  static constexpr size_t PARTIAL_INSERTION_SORT_LIMIT = 8;
+  static constexpr size_t STABLE_RUN_LENGTH            = 32;
+  static constexpr size_t RADIX_SORT_THRESHOLD         = 512;
+  static constexpr size_t STRING_SORT_THRESHOLD        = 16;
+
+  template <typename T>
+  static constexpr void swapItems(T* left, T* right) {
+    T item = move(*left);
+    *left = move(*right);
+    *right = move(item);
+  }
+
+  template <typename T, typename LessT>
+  static constexpr void sort2(T* left, T* right, LessT const& less) {
+    if (less(*right, *left))
+      swapItems(left, right);
+  }
+
+  template <typename T, typename LessT>
+  static constexpr void sort3(T* first, T* second, T* third, LessT const& less) {
+    sort2(first, second, less);
+    sort2(second, third, less);
+    sort2(first, second, less);
+  }
+
+  // Unguarded one relies on an item before first, which isn't greater than any of the range
+  template <bool IsGuarded = true, typename T, typename LessT>
+  static constexpr void insertionSort(T* first, T* last, LessT const& less) {
+    if (first == last)
+      return;
+
+    for (T* current = first + 1; current != last; ++current) {
+      T* sift = current;
+
+      if (!less(*sift, sift[-1]))
+        continue;
+
+      SortHole<T> hole{ move(*sift), sift };
+
+      do {
+        *hole.position = move(hole.position[-1]);
+        --hole.position;
+      } while ((!IsGuarded || hole.position != first) && less(hole.item, hole.position[-1]));
+    }
+  }
+
+  // Gives up after PARTIAL_INSERTION_SORT_LIMIT moves, tells if range got sorted
+  template <typename T, typename LessT>
+  static constexpr bool partialInsertionSort(T* first, T* last, LessT const& less) {
+    if (first == last)
+      return true;
+
+    size_t moves = 0;
+
+    for (T* current = first + 1; current != last; ++current) {
+      T* sift = current;
+
+      if (!less(*sift, sift[-1]))
+        continue;
+
+      {
+        SortHole<T> hole{ move(*sift), sift };
+
+        do {
+          *hole.position = move(hole.position[-1]);
+          --hole.position;
+        } while (hole.position != first && less(hole.item, hole.position[-1]));
+
+        moves += static_cast<size_t>(current - hole.position);
+      }
+
+      if (moves > PARTIAL_INSERTION_SORT_LIMIT)
+        return false;
+    }
+
+    return true;
+  }
+
+  // Pivot is *first. Items equal to it go to the right. Returns position of the pivot
+  //  and whether no items were swapped
+  template <typename T, typename LessT>
+  static constexpr Pair<T*, bool> partitionRight(T* first, T* last, LessT const& less) {
+    SortHole<T> pivot{ move(*first), first };
+    T* left = first;
+    T* right = last;
+
+    // median selection put an item not less than pivot to the end, so the first loop stops
+    while (less(*++left, pivot.item));
+
+    if (left - 1 == first)
+      while (left < right && !less(*--right, pivot.item));
+    else
+      while (!less(*--right, pivot.item));
+
+    bool is_partitioned = left >= right;
+
+    while (left < right) {
+      swapItems(left, right);
+      while (less(*++left, pivot.item));
+      while (!less(*--right, pivot.item));
+    }
+
+    T* position = left - 1;
+    *first = move(*position);
+    pivot.position = position;
+
+    return { position, is_partitioned };
+  }
+
+  // Items equal to the pivot go to the left. Used when pivot equals the item before
+  //  the range, so they are all in place and only greater ones are sorted further
+  template <typename T, typename LessT>
+  static constexpr T* partitionLeft(T* first, T* last, LessT const& less) {
+    SortHole<T> pivot{ move(*first), first };
+    T* left = first;
+    T* right = last;
+
+    while (less(pivot.item, *--right));
+
+    if (right + 1 == last)
+      while (left < right && !less(pivot.item, *++left));
+    else
+      while (!less(pivot.item, *++left));
+
+    while (left < right) {
+      swapItems(left, right);
+      while (less(pivot.item, *--right));
+      while (!less(pivot.item, *++left));
+    }
+
+    *first = move(*right);
+    pivot.position = right;
+
+    return right;
+  }
+
+  template <typename T, typename LessT>
+  static constexpr void siftDown(T* items, size_t index, size_t count, LessT const& less) {
+    SortHole<T> hole{ move(items[index]), items + index };
+
+    for (size_t child = index * 2 + 1; child < count; child = index * 2 + 1) {
+      if (child + 1 < count && less(items[child], items[child + 1]))
+        ++child;
+
+      if (!less(hole.item, items[child]))
+        break;
+
+      *hole.position = move(items[child]);
+      hole.position = items + child;
+      index = child;
+    }
+  }
+
+  template <typename T, typename LessT>
+  static constexpr void heapSort(T* first, T* last, LessT const& less) {
+    size_t count = static_cast<size_t>(last - first);
+
+    for (size_t index = count / 2; index > 0; --index)
+      siftDown(first, index - 1, count, less);
+
+    for (size_t end = count - 1; end > 0; --end) {
+      swapItems(first, first + end);
+      siftDown(first, 0, end, less);
+    }
+  }
+
+  template <typename T, typename LessT>
+  static constexpr void pdqSort(T* first, T* last, LessT const& less, uint32_t bad_allowed, bool is_leftmost) {
+    while (true) {
+      size_t count = static_cast<size_t>(last - first);
+
+      if (count < INSERTION_SORT_THRESHOLD) {
+        if (is_leftmost)
+          insertionSort(first, last, less);
+        else
+          insertionSort<false>(first, last, less);
+
+        return;
+      }
+
+      size_t half = count / 2;
+
+      if (count > NINTHER_THRESHOLD) {
+        sort3(first, first + half, last - 1, less);
+        sort3(first + 1, first + (half - 1), last - 2, less);
+        sort3(first + 2, first + (half + 1), last - 3, less);
+        sort3(first + (half - 1), first + half, first + (half + 1), less);
+        swapItems(first, first + half);
+      }
+      else {
+        sort3(first + half, first, last - 1, less);
+      }
+
+      if (!is_leftmost && !less(first[-1], *first)) {
+        first = partitionLeft(first, last, less) + 1;
+        continue;
+      }
+
+      auto [pivot, is_partitioned] = partitionRight(first, last, less);
+
+      size_t left_count = static_cast<size_t>(pivot - first);
+      size_t right_count = static_cast<size_t>(last - (pivot + 1));
+
+      if (left_count < count / 8 || right_count < count / 8) {
+        if (--bad_allowed == 0) {
+          heapSort(first, last, less);
+          return;
+        }
+
+        // break patterns, which made the pivot bad
+        if (left_count >= INSERTION_SORT_THRESHOLD) {
+          swapItems(first, first + left_count / 4);
+          swapItems(pivot - 1, pivot - left_count / 4);
+
+          if (left_count > NINTHER_THRESHOLD) {
+            swapItems(first + 1, first + (left_count / 4 + 1));
+            swapItems(first + 2, first + (left_count / 4 + 2));
+            swapItems(pivot - 2, pivot - (left_count / 4 + 1));
+            swapItems(pivot - 3, pivot - (left_count / 4 + 2));
+          }
+        }
+
+        if (right_count >= INSERTION_SORT_THRESHOLD) {
+          swapItems(pivot + 1, pivot + (1 + right_count / 4));
+          swapItems(last - 1, last - right_count / 4);
+
+          if (right_count > NINTHER_THRESHOLD) {
+            swapItems(pivot + 2, pivot + (2 + right_count / 4));
+            swapItems(pivot + 3, pivot + (3 + right_count / 4));
+            swapItems(last - 2, last - (1 + right_count / 4));
+            swapItems(last - 3, last - (2 + right_count / 4));
+          }
+        }
+      }
+      else if (is_partitioned && partialInsertionSort(first, pivot, less) && partialInsertionSort(pivot + 1, last, less)) {
+        return;
+      }
+
+      pdqSort(first, pivot, less, bad_allowed, is_leftmost);
+
+      first = pivot + 1;
+      is_leftmost = false;
+    }
+  }
+
+  template <typename T, typename LessT>
+  static constexpr void unstableSort(T* first, T* last, LessT const& less) {
+    size_t count = static_cast<size_t>(last - first);
+
+    if (count > 1)
+      pdqSort(first, last, less, static_cast<uint32_t>(64 - __builtin_clzll(count)), true);
+  }
+
+  // Merges sorted [first, middle) and [middle, last). Left run is moved out into buffer
+  //  and merged back, so buffer needs space for middle - first items
+  template <typename T, typename LessT>
+  static constexpr void merge(T* first, T* middle, T* last, T* buffer, LessT const& less) {
+    if (!less(*middle, middle[-1]))
+      return;
+
+    // items of the left run, which don't go after *middle, are in place already
+    while (!less(*middle, *first))
+      ++first;
+
+    size_t count = static_cast<size_t>(middle - first);
+
+    for (size_t index = 0; index < count; ++index)
+      constructAt(buffer + index, move(first[index]));
+
+    // Whatever is left in buffer fills the gap before right, even if less() throws
+    struct Tail {
+      T* output;
+      T* buffer;
+      T* bufferEnd;
+      T* bufferBegin;
+
+      constexpr ~Tail() {
+        while (buffer != bufferEnd)
+          *output++ = move(*buffer++);
+
+        for (T* item = bufferBegin; item != bufferEnd; ++item)
+          destructAt(item);
+      }
+    } tail{ first, buffer, buffer + count, buffer };
+
+    T* right = middle;
+
+    while (tail.buffer != tail.bufferEnd && right != last)
+      *tail.output++ = less(*right, *tail.buffer) ? move(*right++) : move(*tail.buffer++);
+  }
+
+  template <typename T, typename LessT>
+  static constexpr void mergeSort(T* first, T* last, T* buffer, LessT const& less) {
+    size_t count = static_cast<size_t>(last - first);
+
+    if (count <= STABLE_RUN_LENGTH) {
+      insertionSort(first, last, less);
+      return;
+    }
+
+    T* middle = first + count / 2;
+
+    mergeSort(first, middle, buffer, less);
+    mergeSort(middle, last, buffer, less);
+    merge(first, middle, last, buffer, less);
+  }
+
+  // Items of left, which are among the first outputs items of merging left and right.
+  //  Equal items are taken from left first, the same as merge() does (Siebert, Traff)
+  template <typename T, typename LessT>
+  [[nodiscard]]
+  static constexpr size_t coRank(T const* left, size_t leftCount, T const* right, size_t rightCount, size_t outputs, LessT const& less) {
+    size_t low = outputs > rightCount ? outputs - rightCount : 0;
+    size_t high = outputs < leftCount ? outputs : leftCount;
+
+    while (low < high) {
+      size_t taken = low + (high - low) / 2;
+
+      // left[taken] goes before right[outputs - taken - 1], so more of left is needed
+      if (!less(right[outputs - taken - 1], left[taken]))
+        low = taken + 1;
+      else
+        high = taken;
+    }
+
+    return low;
+  }
+
+  // Moves merged items from output back into the runs, they came from, in some order
+  template <typename T>
+  static constexpr void restoreRuns(T* left, T* leftEnd, T* right, T* rightEnd, T* output) noexcept {
+    for (; left != leftEnd; ++left, ++output) {
+      *left = move(*output);
+      destructAt(output);
+    }
+
+    for (; right != rightEnd; ++right, ++output) {
+      *right = move(*output);
+      destructAt(output);
+    }
+  }
+
+  // Merges sorted runs into raw memory at output. If less() throws, merged items go back
+  //  into the runs, so they still hold all items
+  template <typename T, typename LessT>
+  static constexpr void mergeInto(T* left, T* leftEnd, T* right, T* rightEnd, T* output, LessT const& less) {
+    struct Output {
+      T* leftBegin;
+      T* left;
+      T* leftEnd;
+      T* rightBegin;
+      T* right;
+      T* rightEnd;
+      T* begin;
+      T* end;
+
+      constexpr ~Output() {
+        if (left != leftEnd && right != rightEnd) {
+          restoreRuns(leftBegin, left, rightBegin, right, begin);
+          return;
+        }
+
+        // one run is over, the rest of the other one follows
+        for (; left != leftEnd; ++left)
+          constructAt(end++, move(*left));
+
+        for (; right != rightEnd; ++right)
+          constructAt(end++, move(*right));
+      }
+    } merged{ left, left, leftEnd, right, right, rightEnd, output, output };
+
+    while (merged.left != merged.leftEnd && merged.right != merged.rightEnd) {
+      T* source = less(*merged.right, *merged.left) ? merged.right++ : merged.left++;
+      constructAt(merged.end++, move(*source));
+    }
+  }
+
+  // Unsigned integer, which orders the same way as value: sign bit of integers is
+  //  flipped, negative floats are inverted, and -0 is the same as +0
+  template <typename T>
+  [[nodiscard]]
+  static constexpr auto radixKey(T value) noexcept {
+    using KeyT = conditional<sizeof(T) == 1, uint8_t,
+                 conditional<sizeof(T) == 2, uint16_t,
+                 conditional<sizeof(T) == 4, uint32_t, uint64_t>>>;
+
+    constexpr KeyT SIGN_BIT = static_cast<KeyT>(KeyT{1} << (sizeof(T) * 8 - 1));
+
+    if constexpr (FloatingPoint<T>) {
+      KeyT bits = value == 0 ? KeyT{0} : __builtin_bit_cast(KeyT, value);
+      return static_cast<KeyT>(bits & SIGN_BIT ? ~bits : bits | SIGN_BIT);
+    }
+    else if constexpr (static_cast<T>(-1) < 0) {
+      return static_cast<KeyT>(static_cast<KeyT>(value) ^ SIGN_BIT);
+    }
+    else {
+      return static_cast<KeyT>(value);
+    }
+  }
+
+  // LSD radix sort by bytes of keys: one pass counts all digits, then each byte is
+  //  scattered between items and buffer, bytes where all items agree are skipped.
+  // Stable, items are copied as bytes
+  template <typename T>
+  static void radixSort(T* items, size_t count) {
+    constexpr size_t PASSES = sizeof(T);
+
+    size_t counts[PASSES][256] = {};
+
+    for (size_t index = 0; index < count; ++index) {
+      auto key = radixKey(items[index]);
+
+      for (size_t pass = 0; pass < PASSES; ++pass)
+        ++counts[pass][(key >> (pass * 8)) & 0xFF];
+    }
+
+    SortBuffer<T> buffer(count);
+
+    T* from = items;
+    T* to = buffer.items;
+
+    for (size_t pass = 0; pass < PASSES; ++pass) {
+      size_t* digits = counts[pass];
+
+      if (digits[(radixKey(from[0]) >> (pass * 8)) & 0xFF] == count)
+        continue;
+
+      size_t offset = 0;
+
+      for (size_t digit = 0; digit < 256; ++digit) {
+        size_t digit_count = digits[digit];
+        digits[digit] = offset;
+        offset += digit_count;
+      }
+
+      for (size_t index = 0; index < count; ++index)
+        to[digits[(radixKey(from[index]) >> (pass * 8)) & 0xFF]++] = from[index];
+
+      T* swapped = from;
+      from = to;
+      to = swapped;
+    }
+
+    if (from != items)
+      __builtin_memcpy(items, from, count * sizeof(T));
+  }
+
+  // Code unit at depth, or -1 past the end of string
+  template <typename T>
+  [[nodiscard]]
+  static constexpr int64_t unitAt(T const& string, size_t depth) noexcept {
+    using CharT = remove_reference<decltype(*string.data())>;
+    using UnitT = conditional<sizeof(CharT) == 1, uint8_t, conditional<sizeof(CharT) == 2, uint16_t, uint32_t>>;
+
+    return depth < string.length() ? static_cast<int64_t>(static_cast<UnitT>(string.data()[depth])) : -1;
+  }
+
+  // Multikey quicksort (Bentley, Sedgewick): three-way partition by the code unit at depth,
+  //  then only equal ones go one unit deeper, so common prefixes are never compared again.
+  // Deep recursion on bad pivots falls back to comparisons
+  template <typename T>
+  static constexpr void stringSort(T* first, T* last, size_t depth, uint32_t levels_allowed) {
+    while (static_cast<size_t>(last - first) > STRING_SORT_THRESHOLD) {
+      if (levels_allowed == 0) {
+        unstableSort(first, last, Less{});
+        return;
+      }
+
+      int64_t a = unitAt(*first, depth);
+      int64_t b = unitAt(first[(last - first) / 2], depth);
+      int64_t c = unitAt(last[-1], depth);
+      int64_t pivot = a < b ? (b < c ? b : (a < c ? c : a)) : (a < c ? a : (b < c ? c : b));
+
+      T* less_end = first;
+      T* greater_begin = last;
+
+      for (T* current = first; current < greater_begin;) {
+        int64_t unit = unitAt(*current, depth);
+
+        if (unit < pivot)
+          swapItems(less_end++, current++);
+        else if (unit > pivot)
+          swapItems(current, --greater_begin);
+        else
+          ++current;
+      }
+
+      stringSort(first, less_end, depth, levels_allowed - 1);
+      stringSort(greater_begin, last, depth, levels_allowed - 1);
+
+      // equal strings have all ended
+      if (pivot < 0)
+        return;
+
+      first = less_end;
+      last = greater_begin;
+      ++depth;
+    }
+
+    insertionSort(first, last, Less{});
+  }
+};
+
+// Threads for parallelSort(): hardware threads, at least 1
+[[nodiscard]]
+_RHLIB_API
+size_t sortThreadCount() noexcept;
+
+// Runs task(context, index) for indices [0, count) on separate threads, index 0 on the calling
+//  one, and waits for all of them. The first exception of tasks is rethrown after that
+_RHLIB_API
+void runSortTasks(size_t count, void (*task)(void* context, size_t index), void* context);
+
+_RHLIB_HIDDEN_END
+
+// Contiguous containers with assignable items: List, SmallList, Array and others
+template <typename ContainerT>
+concept SortableContainer =
+  ConstContainer<ContainerT, _RHLIBH container_item<ContainerT>> &&
+  requires(_RHLIBH container_item<ContainerT>& item) {
+    item = move(item);
+  };
+
+// Not stable. Pattern-defeating quicksort, or radix sort for numbers and strings compared by Less
+template <typename T, Comparator<T> CompareT = Less>
+constexpr void sort(T* first, T* last, CompareT const& compare = CompareT{}) {
+  using Utils = _RHLIBH SortUtils;
+
+  if constexpr (is_same_type<CompareT, Less> && _RHLIBH is_radix_sortable<T>) {
+    if !consteval {
+      if (static_cast<size_t>(last - first) >= Utils::RADIX_SORT_THRESHOLD) {
+        Utils::radixSort(first, static_cast<size_t>(last - first));
+        return;
+      }
+    }
+  }
+  else if constexpr (is_same_type<CompareT, Less> && _RHLIBH is_radix_string<T>) {
+    size_t count = static_cast<size_t>(last - first);
+
+    if (count > Utils::STRING_SORT_THRESHOLD) {
+      Utils::stringSort(first, last, 0, 2 * static_cast<uint32_t>(64 - __builtin_clzll(count)) + 16);
+      return;
+    }
+  }
+
+  Utils::unstableSort(first, last, compare);
+}
+
+template <SortableContainer ContainerT, typename CompareT = Less>
+constexpr void sort(ContainerT& items, CompareT const& compare = CompareT{}) {
+  sort(items.data(), items.data() + items.length(), compare);
+}
+
+// Equal items keep their order. Merge sort with a buffer for half of the items. Integers
+//  compared by Less go through sort(), because equal ones are the same, and many floats
+//  through radix sort, which is stable: -0 and +0 are equal, but not the same
+template <typename T, Comparator<T> CompareT = Less>
+constexpr void stableSort(T* first, T* last, CompareT const& compare = CompareT{}) {
+  using Utils = _RHLIBH SortUtils;
+
+  size_t count = static_cast<size_t>(last - first);
+
+  if constexpr (is_same_type<CompareT, Less> && Integral<T>) {
+    sort(first, last, compare);
+    return;
+  }
+  else if constexpr (is_same_type<CompareT, Less> && _RHLIBH is_radix_sortable<T>) {
+    if !consteval {
+      if (count >= Utils::RADIX_SORT_THRESHOLD) {
+        Utils::radixSort(first, count);
+        return;
+      }
+    }
+  }
+
+  if (count <= Utils::STABLE_RUN_LENGTH) {
+    Utils::insertionSort(first, last, compare);
+  }
+  else {
+    _RHLIBH SortBuffer<T> buffer(count / 2);
+    Utils::mergeSort(first, last, buffer.items, compare);
+  }
+}
+
+template <SortableContainer ContainerT, typename CompareT = Less>
+constexpr void stableSort(ContainerT& items, CompareT const& compare = CompareT{}) {
+  stableSort(items.data(), items.data() + items.length(), compare);
+}
+
+// Ranges of at least this many items per thread are sorted in parallel
+static constexpr size_t PARALLEL_SORT_THRESHOLD = 1 << 16;
+
+// Not stable. Splits items between threads, sorts every part with sort(), then merges
+//  neighbouring parts in rounds. Every merge is split between threads by co-ranking, so
+//  all threads work in every round, the last one too. compare is called from several
+//  threads at once. Takes a buffer for all items. threads = 0 uses all hardware threads
+template <typename T, Comparator<T> CompareT = Less>
+void parallelSort(T* first, T* last, CompareT const& compare = CompareT{}, size_t threads = 0) {
+  using Utils = _RHLIBH SortUtils;
+
+  size_t count = static_cast<size_t>(last - first);
+  size_t parts = 1;
+
+  if (threads == 0)
+    threads = _RHLIBH sortThreadCount();
+
+  while (parts * 2 <= threads && count / (parts * 2) >= PARALLEL_SORT_THRESHOLD)
+    parts *= 2;
+
+  if (parts == 1) {
+    sort(first, last, compare);
+    return;
+  }
+
+  // Runs of one thread's share of a merge, and where it goes in buffer
+  struct Piece {
+    T*   left;
+    T*   leftEnd;
+    T*   right;
+    T*   rightEnd;
+    T*   output;
+    bool isMerged;
+  };
+
+  struct Job {
+    T*              items;
+    T*              buffer;
+    Piece*          pieces;
+    size_t          count;
+    size_t          parts;
+    size_t          width; // parts in each run being merged
+    CompareT const* compare;
+
+    constexpr T* boundary(size_t part) const noexcept {
+      return items + count * part / parts;
+    }
+  };
+
+  _RHLIBH SortBuffer<T> buffer(count);
+  _RHLIBH SortBuffer<Piece> pieces(parts);
+  Job job{ first, buffer.items, pieces.items, count, parts, 1, &compare };
+
+  _RHLIBH runSortTasks(parts, [](void* context, size_t index) {
+    Job& job = *static_cast<Job*>(context);
+    sort(job.boundary(index), job.boundary(index + 1), *job.compare);
+  }, &job);
+
+  for (; job.width < parts; job.width *= 2) {
+    for (size_t index = 0; index < parts; ++index)
+      pieces.items[index].isMerged = false;
+
+    // task index takes piece index % (width * 2) of merged output, and finds its runs by co-ranking
+    try {
+      _RHLIBH runSortTasks(parts, [](void* context, size_t index) {
+        Job& job = *static_cast<Job*>(context);
+
+        size_t share = job.width * 2;
+        size_t run = index - index % share;
+
+        T* begin = job.boundary(run);
+        T* middle = job.boundary(run + job.width);
+        T* end = job.boundary(run + share);
+
+        size_t left_count = static_cast<size_t>(middle - begin);
+        size_t right_count = static_cast<size_t>(end - middle);
+        size_t first_output = (left_count + right_count) * (index % share) / share;
+        size_t last_output = (left_count + right_count) * (index % share + 1) / share;
+
+        size_t first_left = Utils::coRank(begin, left_count, middle, right_count, first_output, *job.compare);
+        size_t last_left = Utils::coRank(begin, left_count, middle, right_count, last_output, *job.compare);
+
+        Piece& piece = job.pieces[index];
+        piece.left = begin + first_left;
+        piece.leftEnd = begin + last_left;
+        piece.right = middle + (first_output - first_left);
+        piece.rightEnd = middle + (last_output - last_left);
+        piece.output = job.buffer + (begin - job.items) + first_output;
+
+        Utils::mergeInto(piece.left, piece.leftEnd, piece.right, piece.rightEnd, piece.output, *job.compare);
+        piece.isMerged = true;
+      }, &job);
+    }
+    catch (...) {
+      // failed pieces restored themselves, the others take their items back
+      for (size_t index = 0; index < parts; ++index) {
+        Piece& piece = pieces.items[index];
+
+        if (piece.isMerged)
+          Utils::restoreRuns(piece.left, piece.leftEnd, piece.right, piece.rightEnd, piece.output);
+      }
+
+      throw;
+    }
+
+    _RHLIBH runSortTasks(parts, [](void* context, size_t index) {
+      Job& job = *static_cast<Job*>(context);
+
+      T* end = job.boundary(index + 1);
+
+      for (T* item = job.boundary(index); item != end; ++item) {
+        T* merged = job.buffer + (item - job.items);
+        *item = move(*merged);
+        destructAt(merged);
+      }
+    }, &job);
+  }
+}
+
+template <SortableContainer ContainerT, typename CompareT = Less>
+void parallelSort(ContainerT& items, CompareT const& compare = CompareT{}, size_t threads = 0) {
+  parallelSort(items.data(), items.data() + items.length(), compare, threads);
+}
+
+_RHLIB_END
+
+_RHLIB_GLOBAL_CLASS(sort);
+_RHLIB_GLOBAL_CLASS(stableSort);
+_RHLIB_GLOBAL_CLASS(parallelSort);
+_RHLIB_GLOBAL_CLASS(PARALLEL_SORT_THRESHOLD);
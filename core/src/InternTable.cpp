@@ -0,0 +1,187 @@
+#include <rh/InternTable.hpp>
+
+#include <rh/ScopedLock.hpp>
+
+using rh::Atom;
+using rh::InternTable;
+using rh::StringView;
+using AtomEntry = rh::_Hidden::AtomEntry;
+
+InternTable::~InternTable() noexcept {
+  for (Shard& shard : m_shards) {
+    for (Slots* slots = shard.slots; slots;) {
+      Slots* previous = slots->previous;
+      delete[] slots->entries;
+      delete slots;
+      slots = previous;
+    }
+
+    for (ArenaBlock* block = shard.blocks; block;) {
+      ArenaBlock* next = block->next;
+      delete[] reinterpret_cast<rh::byte*>(block);
+      block = next;
+    }
+  }
+}
+
+InternTable& InternTable::global() noexcept {
+  static InternTable table;
+  return table;
+}
+
+Atom InternTable::intern(StringView string) {
+  if (string.isEmpty())
+    return Atom{};
+
+  rh::uint64_t hash = _hash(string);
+  Shard& shard = _shardFor(hash);
+
+  if (const AtomEntry* entry = _lookup(shard, string, hash)) {
+    _countHit();
+    return Atom{entry};
+  }
+
+  rh::ScopedLock lock{shard.lock};
+
+  // could be inserted while we were waiting for the lock
+  if (const AtomEntry* entry = _lookup(shard, string, hash)) {
+    _countHit();
+    return Atom{entry};
+  }
+
+  // keep load factor under 3/4, so probing always ends on an empty slot
+  if (!shard.slots || (shard.count + 1) * 4 > (shard.slots->mask + 1) * 3)
+    _grow(shard);
+
+  size_t length = string.length();
+
+  auto entry = reinterpret_cast<AtomEntry*>(_allocateInArena(shard, sizeof(AtomEntry) + (length + 1) * sizeof(char32_t)));
+  rh::constructAt(entry, AtomEntry{ hash, length });
+
+  auto characters = const_cast<char32_t*>(entry->characters());
+  for (size_t i = 0; i < length; ++i)
+    characters[i] = string[i];
+  characters[length] = 0;
+
+  Slots* slots = shard.slots;
+  size_t index = hash & slots->mask;
+
+  while (slots->entries[index])
+    index = (index + 1) & slots->mask;
+
+  // publish only fully initialized entry
+  __atomic_store_n(&slots->entries[index], entry, __ATOMIC_RELEASE);
+
+  __atomic_fetch_add(&shard.count, 1, __ATOMIC_RELAXED);
+  __atomic_fetch_add(&shard.misses, 1, __ATOMIC_RELAXED);
+
+  return Atom{entry};
+}
+
+Atom InternTable::find(StringView string) const noexcept {
+  if (string.isEmpty())
+    return Atom{};
+
+  rh::uint64_t hash = _hash(string);
+  return Atom{_lookup(_shardFor(hash), string, hash)};
+}
+
+InternTable::Statistics InternTable::statistics() const noexcept {
+  Statistics result = {};
+
+  for (HitCounter const& counter : m_hitCounters)
+    result.hits += __atomic_load_n(&counter.hits, __ATOMIC_RELAXED);
+
+  for (Shard const& shard : m_shards) {
+    result.misses     += __atomic_load_n(&shard.misses, __ATOMIC_RELAXED);
+    result.atoms      += __atomic_load_n(&shard.count, __ATOMIC_RELAXED);
+    result.arenaBytes += __atomic_load_n(&shard.arenaBytes, __ATOMIC_RELAXED);
+    result.tableBytes += __atomic_load_n(&shard.tableBytes, __ATOMIC_RELAXED);
+  }
+
+  return result;
+}
+
+void InternTable::_countHit() noexcept {
+  // threads take counters in turn
+  static size_t next_index = 0;
+  thread_local size_t index = __atomic_fetch_add(&next_index, 1, __ATOMIC_RELAXED) % HIT_COUNTERS_COUNT;
+
+  __atomic_fetch_add(&m_hitCounters[index].hits, 1, __ATOMIC_RELAXED);
+}
+
+rh::uint64_t InternTable::_hash(StringView string) noexcept {
+  // top bits pick the shard, so they have to depend on every character
+  return string.hash();
+}
+
+const AtomEntry* InternTable::_lookup(Shard const& shard, StringView string, rh::uint64_t hash) noexcept {
+  Slots* slots = __atomic_load_n(&shard.slots, __ATOMIC_ACQUIRE);
+
+  if (!slots)
+    return nullptr;
+
+  for (size_t index = hash & slots->mask;; index = (index + 1) & slots->mask) {
+    const AtomEntry* entry = __atomic_load_n(&slots->entries[index], __ATOMIC_ACQUIRE);
+
+    if (!entry)
+      return nullptr;
+
+    if (entry->hash == hash && StringView{entry->characters(), entry->length} == string)
+      return entry;
+  }
+}
+
+void InternTable::_grow(Shard& shard) {
+  Slots* previous = shard.slots;
+  size_t capacity = previous ? (previous->mask + 1) * 2 : INITIAL_SLOTS_COUNT;
+
+  auto slots = new Slots{ new AtomEntry*[capacity](), capacity - 1, previous };
+
+  if (previous) {
+    for (size_t i = 0; i <= previous->mask; ++i) {
+      AtomEntry* entry = previous->entries[i];
+
+      if (!entry)
+        continue;
+
+      size_t index = entry->hash & slots->mask;
+
+      while (slots->entries[index])
+        index = (index + 1) & slots->mask;
+
+      slots->entries[index] = entry;
+    }
+  }
+
+  __atomic_fetch_add(&shard.tableBytes, sizeof(Slots) + capacity * sizeof(AtomEntry*), __ATOMIC_RELAXED);
+
+  // readers, which got previous table, still can use it
+  __atomic_store_n(&shard.slots, slots, __ATOMIC_RELEASE);
+}
+
+rh::byte* InternTable::_allocateInArena(Shard& shard, size_t size) {
+  size = (size + alignof(AtomEntry) - 1) & ~(alignof(AtomEntry) - 1);
+
+  if (size > shard.remaining) {
+    size_t block_size = rh::max(ARENA_BLOCK_SIZE, size + sizeof(ArenaBlock));
+
+    rh::byte* memory = new rh::byte[block_size];
+
+    auto block = reinterpret_cast<ArenaBlock*>(memory);
+    block->next = shard.blocks;
+    shard.blocks = block;
+
+    shard.current = memory + sizeof(ArenaBlock);
+    shard.remaining = block_size - sizeof(ArenaBlock);
+
+    __atomic_fetch_add(&shard.arenaBytes, block_size, __ATOMIC_RELAXED);
+  }
+
+  rh::byte* result = shard.current;
+
+  shard.current += size;
+  shard.remaining -= size;
+
+  return result;
+}
@@ -0,0 +1,50 @@
+#include <rh/sort.hpp>
+
+#include <exception>
+#include <thread>
+#include <vector>
+
+rh::size_t rh::_Hidden::sortThreadCount() noexcept {
+  unsigned count = std::thread::hardware_concurrency();
+  return count > 0 ? count : 1;
+}
+
+void rh::_Hidden::runSortTasks(size_t count, void (*task)(void* context, size_t index), void* context) {
+  if (count == 1) {
+    task(context, 0);
+    return;
+  }
+
+  std::vector<std::exception_ptr> errors(count);
+  std::vector<std::thread> threads;
+  threads.reserve(count - 1);
+
+  auto run = [&](size_t index) noexcept {
+    try {
+      task(context, index);
+    }
+    catch (...) {
+      errors[index] = std::current_exception();
+    }
+  };
+
+  for (size_t index = 1; index < count; ++index) {
+    try {
+      threads.emplace_back(run, index);
+    }
+    catch (...) {
+      // out of threads: this one does the task
+      run(index);
+    }
+  }
+
+  run(0);
+
+  for (std::thread& thread : threads)
+    thread.join();
+
+  for (std::exception_ptr& error : errors) {
+    if (error)
+      std::rethrow_exception(error);
+  }
+}
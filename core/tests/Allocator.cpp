@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+
+#include <rh/Allocator.hpp>
+#include <rh/List.hpp>
+#include <rh/SharedString.hpp>
+#include <rh/String.hpp>
+
+namespace {
+
+// Stateful, without reallocate(): counts blocks, which are still alive
+struct CountingAllocator {
+  size_t* alive;
+
+  void* allocate(size_t size, size_t alignment) {
+    ++*alive;
+    return DefaultAllocator::allocate(size, alignment);
+  }
+
+  void deallocate(void* pointer, size_t size, size_t alignment) noexcept {
+    --*alive;
+    DefaultAllocator::deallocate(pointer, size, alignment);
+  }
+};
+
+}
+
+static_assert(rh::Allocator<CountingAllocator> && !rh::ReallocatingAllocator<CountingAllocator>);
+
+// stateless allocator takes no space
+static_assert(sizeof(rh::List<int>) == 3 * sizeof(void*));
+static_assert(sizeof(rh::List<int, ArenaAllocator>) == 4 * sizeof(void*));
+static_assert(sizeof(String) == sizeof(rh::BasicString<char32_t, ArenaAllocator>) - sizeof(void*));
+
+TEST(AllocatorTests, Arena) {
+  Arena arena(256);
+
+  void* first = arena.allocate(10, 1);
+  void* aligned = arena.allocate(32, 32);
+
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(aligned) % 32, 0);
+  EXPECT_TRUE(arena.owns(first));
+  EXPECT_TRUE(arena.owns(aligned));
+
+  // the latest block grows in place
+  EXPECT_EQ(arena.reallocate(aligned, 32, 64, 32), aligned);
+
+  // bigger than chunk
+  void* big = arena.allocate(1000, 8);
+  EXPECT_TRUE(arena.owns(big));
+
+  int local = 0;
+  EXPECT_FALSE(arena.owns(&local));
+
+  arena.reset();
+  EXPECT_FALSE(arena.owns(first));
+}
+
+TEST(AllocatorTests, ArenaAlignmentPastEnd) {
+  Arena arena(100);
+
+  (void)arena.allocate(98, 1);
+
+  // aligned block would start past the end of the chunk
+  auto* block = static_cast<char*>(arena.allocate(1, 64));
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(block) % 64, 0);
+  EXPECT_TRUE(arena.owns(block));
+  *block = 1;
+}
+
+TEST(AllocatorTests, ListInArena) {
+  Arena arena;
+
+  {
+    rh::List<int, ArenaAllocator> numbers{ArenaAllocator{arena}};
+
+    for (int i = 0; i < 1000; ++i)
+      numbers.append(i);
+
+    EXPECT_TRUE(arena.owns(numbers.data()));
+    EXPECT_EQ(numbers[999], 999);
+
+    rh::List<String, ArenaAllocator> strings{ArenaAllocator{arena}};
+
+    for (int i = 0; i < 100; ++i)
+      strings.append(String(40, U'a' + i % 26));
+
+    rh::List<String, ArenaAllocator> copy = strings;
+    EXPECT_TRUE(arena.owns(copy.data()));
+    EXPECT_EQ(copy[27], String(40, U'b'));
+
+    rh::List<String, ArenaAllocator> moved = move(copy);
+    EXPECT_TRUE(copy.isEmpty());
+    EXPECT_EQ(&moved.allocator().arena(), &arena);
+  }
+
+  arena.reset();
+}
+
+TEST(AllocatorTests, StringInArena) {
+  Arena arena;
+
+  using ArenaString = rh::BasicString<char32_t, ArenaAllocator>;
+
+  ArenaString string{U"short", ArenaAllocator{arena}};
+  EXPECT_FALSE(arena.owns(string.data()));
+
+  for (int i = 0; i < 100; ++i)
+    string.append(U" and longer");
+
+  EXPECT_TRUE(arena.owns(string.data()));
+  EXPECT_TRUE(string.startsWith(U"short and longer and"));
+  EXPECT_EQ(string.length(), 5 + 100 * 11);
+
+  ArenaString copy = string;
+  EXPECT_EQ(copy, StringView{string});
+  EXPECT_NE(copy.data(), string.data());
+
+  // buffer can't be handed over to SharedString
+  SharedString shared = move(copy).share();
+  EXPECT_EQ(shared, StringView{string});
+}
+
+TEST(AllocatorTests, EveryBlockIsFreed) {
+  size_t alive = 0;
+
+  {
+    CountingAllocator allocator{&alive};
+
+    rh::List<int, CountingAllocator> numbers{allocator};
+    rh::BasicString<char32_t, CountingAllocator> string{allocator};
+
+    for (int i = 0; i < 1000; ++i) {
+      numbers.append(i);
+      string.append(U'x');
+    }
+
+    EXPECT_EQ(alive, 2);
+
+    numbers.shrinkToFit();
+    string.erase(1, 999);
+    string.shrinkToFit();
+
+    EXPECT_EQ(alive, 1);
+
+    auto copy = numbers;
+    EXPECT_EQ(alive, 2);
+  }
+
+  EXPECT_EQ(alive, 0);
+}
@@ -0,0 +1,281 @@
+#include <gtest/gtest.h>
+
+#include <rh/BTreeMap.hpp>
+#include <rh/String.hpp>
+
+#include <map>
+#include <random>
+#include <vector>
+
+namespace {
+
+// Counts live objects, and isn't relocatable, because it remembers its own address
+struct Tracked {
+  static inline int alive = 0;
+
+  int value = 0;
+  const Tracked* self = this;
+
+  Tracked() noexcept { ++alive; }
+  Tracked(int value) noexcept : value(value) { ++alive; }
+  Tracked(Tracked const& other) noexcept : value(other.value) { ++alive; }
+  Tracked(Tracked&& other) noexcept : value(other.value) { other.value = -1; ++alive; }
+
+  Tracked& operator=(Tracked const& other) noexcept {
+    value = other.value;
+    return *this;
+  }
+
+  Tracked& operator=(Tracked&& other) noexcept {
+    value = other.value;
+    other.value = -1;
+    return *this;
+  }
+
+  ~Tracked() {
+    EXPECT_EQ(self, this);
+    --alive;
+  }
+
+  bool operator<(Tracked const& other) const noexcept {
+    return value < other.value;
+  }
+};
+
+struct Greater {
+  bool operator()(int left, int right) const noexcept {
+    return left > right;
+  }
+};
+
+template <typename MapT>
+std::vector<int> keys(MapT const& map) {
+  std::vector<int> result;
+
+  for (auto const& entry : map) {
+    if constexpr (requires { entry.first; })
+      result.push_back(entry.first);
+    else
+      result.push_back(entry);
+  }
+
+  return result;
+}
+
+rh::List<int> listOf(std::vector<int> const& values) {
+  rh::List<int> result;
+
+  for (int value : values)
+    result.append(value);
+
+  return result;
+}
+
+}
+
+static_assert(rh::Comparator<rh::Less, String> && rh::Comparator<Greater, int>);
+static_assert(rh::is_trivially_relocatable<rh::BTreeMap<String, Tracked>>);
+
+TEST(BTreeMapTests, Basics) {
+  rh::BTreeMap<int, int> map;
+
+  EXPECT_TRUE(map.isEmpty());
+  EXPECT_EQ(map.find(1), nullptr);
+  EXPECT_FALSE(map.erase(1));
+  EXPECT_TRUE(map.begin() == map.end());
+
+  for (int i = 10; i > 0; --i)
+    EXPECT_TRUE(map.insert(i, i * 10));
+
+  EXPECT_FALSE(map.insert(5, 0));
+  EXPECT_TRUE(map.insert(rh::Pair<int, int>(20, 200)));
+
+  map.set(5, 55);
+  map[30] += 3;
+
+  EXPECT_EQ(map.length(), 12);
+  EXPECT_EQ(map.at(5), 55);
+  EXPECT_EQ(*map.find(30), 3);
+  EXPECT_THROW(static_cast<void>(map.at(11)), rh::KeyError);
+  EXPECT_EQ(keys(map), (std::vector<int>{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 20, 30}));
+
+  for (auto [key, value] : map)
+    value = key;
+
+  EXPECT_EQ(map.at(20), 20);
+
+  EXPECT_TRUE(map.erase(5));
+  EXPECT_FALSE(map.contains(5));
+
+  map.clear();
+  EXPECT_TRUE(map.isEmpty());
+}
+
+TEST(BTreeMapTests, Bounds) {
+  rh::BTreeMap<int, int> map;
+
+  for (int i = 0; i < 1000; i += 2)
+    map.insert(i, i);
+
+  EXPECT_EQ(map.lowerBound(10).key(), 10);
+  EXPECT_EQ(map.lowerBound(11).key(), 12);
+  EXPECT_EQ(map.upperBound(10).key(), 12);
+  EXPECT_EQ(map.lowerBound(-5).key(), 0);
+  EXPECT_TRUE(map.lowerBound(999) == map.end());
+  EXPECT_TRUE(map.upperBound(998) == map.end());
+
+  std::vector<int> found;
+
+  for (auto const& [key, value] : map.range(101, 121))
+    found.push_back(value);
+
+  EXPECT_EQ(found, (std::vector<int>{102, 104, 106, 108, 110, 112, 114, 116, 118, 120}));
+
+  rh::BTreeMap<int, int> const& constant = map;
+  EXPECT_EQ(constant.upperBound(0).value(), 2);
+  EXPECT_TRUE(constant.range(7, 7).begin() == constant.range(7, 7).end());
+}
+
+TEST(BTreeMapTests, MatchesStd) {
+  std::mt19937 random(7);
+  std::uniform_int_distribution<int> key_of(0, 20000);
+
+  rh::BTreeMap<int, int> map;
+  std::map<int, int> expected;
+
+  for (int step = 0; step < 200000; ++step) {
+    int key = key_of(random);
+
+    switch (random() % 4) {
+    case 0:
+    case 1:
+      map.set(key, step);
+      expected[key] = step;
+      break;
+    case 2:
+      EXPECT_EQ(map.erase(key), expected.erase(key) != 0);
+      break;
+    default: {
+      auto found = expected.lower_bound(key);
+      auto bound = map.lowerBound(key);
+
+      ASSERT_EQ(bound == map.end(), found == expected.end());
+
+      if (found != expected.end()) {
+        EXPECT_EQ(bound.key(), found->first);
+        EXPECT_EQ(bound.value(), found->second);
+      }
+    }
+    }
+  }
+
+  ASSERT_EQ(map.length(), expected.size());
+
+  auto expected_entry = expected.begin();
+
+  for (auto const& [key, value] : map) {
+    EXPECT_EQ(key, expected_entry->first);
+    EXPECT_EQ(value, expected_entry->second);
+    ++expected_entry;
+  }
+
+  // erase down to nothing
+  for (auto const& [key, value] : expected)
+    EXPECT_TRUE(map.erase(key));
+
+  EXPECT_TRUE(map.isEmpty());
+  EXPECT_TRUE(map.begin() == map.end());
+}
+
+TEST(BTreeMapTests, StringKeys) {
+  rh::BTreeMap<String, int> map;
+
+  map.set(U"pear", 1);
+  map.set(String(U"apple"), 2);
+  map.emplace(StringView{U"fig"}, 3);
+
+  // looked up through views, without temporary strings
+  EXPECT_EQ(map.at(U"apple"), 2);
+  EXPECT_EQ(map.at(StringView{U"fig"}), 3);
+  EXPECT_FALSE(map.contains(U"plum"));
+
+  std::vector<String> ordered;
+
+  for (auto const& [key, value] : map)
+    ordered.push_back(key);
+
+  EXPECT_EQ(ordered, (std::vector<String>{String(U"apple"), String(U"fig"), String(U"pear")}));
+  EXPECT_EQ(map.lowerBound(U"b").key(), U"fig");
+}
+
+TEST(BTreeMapTests, FromSortedCopyAndMove) {
+  {
+    rh::List<rh::Pair<Tracked, Tracked>> entries;
+
+    for (int i = 0; i < 5000; ++i)
+      entries.append(rh::Pair<Tracked, Tracked>(Tracked(i * 3), Tracked(i)));
+
+    auto map = rh::BTreeMap<Tracked, Tracked>::fromSorted(entries);
+    auto moved_in = rh::BTreeMap<Tracked, Tracked>::fromSorted(rh::move(entries));
+
+    ASSERT_EQ(map.length(), 5000);
+    EXPECT_EQ(moved_in.length(), 5000);
+    EXPECT_EQ(map.at(Tracked(300)).value, 100);
+    EXPECT_FALSE(map.contains(Tracked(301)));
+
+    int expected = 0;
+
+    for (auto const& [key, value] : map)
+      EXPECT_EQ(value.value, expected++);
+
+    // tree stays valid for further edits
+    for (int i = 0; i < 15000; i += 2) {
+      map.erase(Tracked(i));
+      map.insert(Tracked(i + 1), Tracked(-i));
+    }
+
+    EXPECT_EQ(map.at(Tracked(3)).value, 1);
+    EXPECT_EQ(map.at(Tracked(5)).value, -4);
+
+    rh::BTreeMap<Tracked, Tracked> copy = map;
+    EXPECT_EQ(copy.length(), map.length());
+
+    rh::BTreeMap<Tracked, Tracked> moved = rh::move(copy);
+    EXPECT_TRUE(copy.isEmpty());
+
+    copy = moved;
+    moved = rh::move(map);
+    EXPECT_EQ(copy.length(), moved.length());
+  }
+
+  EXPECT_EQ(Tracked::alive, 0);
+
+  // duplicates and wrong order are rejected
+  EXPECT_THROW(static_cast<void>(rh::BTreeSet<int>::fromSorted(listOf({1, 2, 2}))), rh::KeyError);
+  EXPECT_THROW(static_cast<void>(rh::BTreeSet<int>::fromSorted(listOf({3, 1}))), rh::KeyError);
+
+  rh::List<int> sorted;
+
+  for (int i = 0; i < 100000; ++i)
+    sorted.append(i);
+
+  auto set = rh::BTreeSet<int>::fromSorted(sorted);
+  EXPECT_EQ(set.length(), 100000);
+  EXPECT_EQ(*set.find(77777), 77777);
+  EXPECT_EQ(keys(set).back(), 99999);
+}
+
+TEST(BTreeSetTests, Basics) {
+  rh::BTreeSet<int, Greater> set;
+
+  for (int i = 0; i < 100; ++i)
+    set.insert(i % 10);
+
+  EXPECT_EQ(keys(set), (std::vector<int>{9, 8, 7, 6, 5, 4, 3, 2, 1, 0}));
+  EXPECT_FALSE(set.insert(3));
+  EXPECT_TRUE(set.erase(3));
+  EXPECT_EQ(set.find(3), nullptr);
+
+  // descending order, so [from, to) goes down
+  EXPECT_EQ(keys(set.range(7, 2)), (std::vector<int>{7, 6, 5, 4}));
+}
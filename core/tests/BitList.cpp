@@ -0,0 +1,204 @@
+#include <gtest/gtest.h>
+
+#include <rh/BitList.hpp>
+
+#include <random>
+#include <vector>
+
+namespace {
+
+template <typename BitsT>
+std::vector<size_t> setIndices(BitsT const& bits) {
+  std::vector<size_t> result;
+
+  for (size_t index : bits.setBits())
+    result.push_back(index);
+
+  return result;
+}
+
+rh::BitList randomBits(std::mt19937& random, size_t length, unsigned density) {
+  rh::BitList bits(length);
+
+  for (size_t i = 0; i < length; ++i) {
+    if (random() % 100 < density)
+      bits.set(i);
+  }
+
+  return bits;
+}
+
+}
+
+static_assert(rh::is_trivially_relocatable<rh::BitList>);
+static_assert(sizeof(rh::BitArray<65>) == 16);
+
+TEST(BitListTests, Basics) {
+  rh::BitList bits;
+
+  EXPECT_TRUE(bits.isEmpty());
+  EXPECT_EQ(bits.findFirstSet(), -1);
+  EXPECT_TRUE(bits.setBits().begin() == bits.setBits().end());
+
+  for (int i = 0; i < 130; ++i)
+    bits.append(i % 3 == 0);
+
+  EXPECT_EQ(bits.length(), 130);
+  EXPECT_EQ(bits.count(), 44);
+  EXPECT_TRUE(bits[129]);
+  EXPECT_FALSE(bits.test(128));
+
+  bits.flip(128);
+  bits.reset(0);
+  bits.set(1, true);
+
+  EXPECT_EQ(bits.findFirstSet(), 1);
+  EXPECT_EQ(bits.findNextSet(2), 3);
+  EXPECT_EQ(bits.findNextSet(127), 128);
+  EXPECT_EQ(bits.findNextSet(130), -1);
+
+  // bits past the length stay clear
+  bits.flipAll();
+  EXPECT_EQ(bits.count(), 130 - 45);
+  EXPECT_EQ(bits.words()[2] >> 2, 0);
+
+  bits.setAll();
+  EXPECT_EQ(bits.count(), 130);
+
+  bits.resize(200);
+  EXPECT_EQ(bits.count(), 130);
+
+  bits.resize(300, true);
+  EXPECT_EQ(bits.count(), 230);
+  EXPECT_EQ(bits.findNextSet(130), 200);
+
+  bits.resize(10);
+  EXPECT_EQ(bits.count(), 10);
+
+  bits.resize(64, true);
+  EXPECT_EQ(bits.words()[0], ~uint64_t{0});
+
+  bits.resetAll();
+  EXPECT_FALSE(bits.any());
+
+  bits.clear();
+  EXPECT_TRUE(bits.isEmpty());
+}
+
+TEST(BitListTests, BulkOperations) {
+  std::mt19937 random(23);
+
+  for (size_t length : {1, 63, 64, 65, 255, 256, 1000, 100003}) {
+    rh::BitList left = randomBits(random, length, 50);
+    rh::BitList right = randomBits(random, length, 30);
+
+    rh::BitList both = left;
+    rh::BitList either = left;
+    rh::BitList one = left;
+    rh::BitList only_left = left;
+
+    both &= right;
+    either |= right;
+    one ^= right;
+    only_left.andNot(right);
+
+    size_t left_count = 0;
+
+    for (size_t i = 0; i < length; ++i) {
+      ASSERT_EQ(both[i], left[i] && right[i]);
+      ASSERT_EQ(either[i], left[i] || right[i]);
+      ASSERT_EQ(one[i], left[i] != right[i]);
+      ASSERT_EQ(only_left[i], left[i] && !right[i]);
+
+      left_count += left[i];
+    }
+
+    EXPECT_EQ(left.count(), left_count);
+    EXPECT_EQ(both.count() + one.count(), either.count());
+    EXPECT_EQ(setIndices(left).size(), left_count);
+
+    // every set bit is found in order
+    std::vector<size_t> found;
+
+    for (ssize_t index = left.findFirstSet(); index >= 0; index = left.findNextSet(static_cast<size_t>(index) + 1))
+      found.push_back(static_cast<size_t>(index));
+
+    EXPECT_EQ(found, setIndices(left));
+
+    rh::BitList copy = left;
+    EXPECT_TRUE(copy == left);
+    copy.flip(length - 1);
+    EXPECT_FALSE(copy == left);
+  }
+
+  rh::BitList shorter(10);
+  rh::BitList longer(11);
+  EXPECT_THROW(shorter |= longer, rh::IndexError);
+}
+
+TEST(BitListTests, RankSelect) {
+  std::mt19937 random(29);
+
+  for (unsigned density : {0u, 1u, 50u, 100u}) {
+    rh::BitList bits = randomBits(random, 5000, density);
+    rh::BitRank index(bits);
+
+    EXPECT_EQ(index.count(), bits.count());
+
+    size_t rank = 0;
+    size_t selected = 0;
+
+    for (size_t i = 0; i < bits.length(); ++i) {
+      ASSERT_EQ(index.rank(i), rank);
+
+      if (bits[i]) {
+        ASSERT_EQ(index.select(rank), static_cast<ssize_t>(i));
+        ++rank;
+        ++selected;
+      }
+    }
+
+    EXPECT_EQ(index.rank(bits.length()), rank);
+    EXPECT_EQ(index.select(selected), -1);
+  }
+}
+
+TEST(BitArrayTests, Basics) {
+  rh::BitArray<100> bits;
+
+  EXPECT_FALSE(bits.any());
+  EXPECT_EQ(bits.length(), 100);
+
+  bits.set(3);
+  bits.set(64);
+  bits.set(99);
+
+  EXPECT_EQ(bits.count(), 3);
+  EXPECT_EQ(setIndices(bits), (std::vector<size_t>{3, 64, 99}));
+  EXPECT_EQ(bits.findNextSet(4), 64);
+
+  rh::BitArray<100> other;
+  other.setAll();
+  EXPECT_EQ(other.count(), 100);
+
+  other.andNot(bits);
+  EXPECT_EQ(other.count(), 97);
+
+  other ^= bits;
+  EXPECT_EQ(other.count(), 100);
+
+  other &= bits;
+  EXPECT_TRUE(other == bits);
+
+  other.flipAll();
+  other |= bits;
+  EXPECT_EQ(other.count(), 100);
+
+  rh::BitRank index(bits);
+  EXPECT_EQ(index.rank(64), 1);
+  EXPECT_EQ(index.select(2), 99);
+
+  rh::BitArray<256> wide;
+  wide.setAll();
+  EXPECT_EQ(wide.count(), 256);
+}
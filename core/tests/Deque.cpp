@@ -0,0 +1,210 @@
+#include <gtest/gtest.h>
+
+#include <rh/Container.hpp>
+#include <rh/Deque.hpp>
+#include <rh/String.hpp>
+
+#include <deque>
+#include <random>
+#include <vector>
+
+namespace {
+
+// Counts live objects, and isn't relocatable, because it remembers its own address
+struct Tracked {
+  static inline int alive = 0;
+
+  int value = 0;
+  const Tracked* self = this;
+
+  Tracked() noexcept { ++alive; }
+  Tracked(int value) noexcept : value(value) { ++alive; }
+  Tracked(Tracked const& other) noexcept : value(other.value) { ++alive; }
+  Tracked(Tracked&& other) noexcept : value(other.value) { other.value = -1; ++alive; }
+
+  Tracked& operator=(Tracked const& other) noexcept {
+    value = other.value;
+    return *this;
+  }
+
+  ~Tracked() {
+    EXPECT_EQ(self, this);
+    --alive;
+  }
+};
+
+template <typename DequeT>
+std::vector<int> values(DequeT const& deque) {
+  std::vector<int> result;
+
+  for (auto const& item : deque) {
+    if constexpr (requires { item.value; })
+      result.push_back(item.value);
+    else
+      result.push_back(item);
+  }
+
+  return result;
+}
+
+}
+
+static_assert(rh::Iterable<rh::Deque<int>> && rh::Iterable<rh::Deque<int> const>);
+static_assert(rh::is_trivially_relocatable<rh::Deque<String>>);
+static_assert(rh::Deque<int>::CHUNK_LENGTH == 1024 && rh::Deque<char[5000]>::CHUNK_LENGTH == 16);
+
+TEST(DequeTests, Basics) {
+  rh::Deque<int> deque;
+
+  EXPECT_TRUE(deque.isEmpty());
+  EXPECT_TRUE(deque.begin() == deque.end());
+
+  for (int i = 0; i < 5; ++i) {
+    deque.append(i);
+    deque.prepend(-i - 1);
+  }
+
+  EXPECT_EQ(deque.length(), 10);
+  EXPECT_EQ(values(deque), (std::vector<int>{-5, -4, -3, -2, -1, 0, 1, 2, 3, 4}));
+  EXPECT_EQ(deque.front(), -5);
+  EXPECT_EQ(deque.back(), 4);
+  EXPECT_EQ(deque[5], 0);
+
+  deque.emplaceBack(100) += 1;
+  deque.popFront();
+  deque.popFront();
+
+  EXPECT_EQ(deque.front(), -3);
+  EXPECT_EQ(deque.back(), 101);
+
+  auto last = deque.end();
+  EXPECT_EQ(*--last, 101);
+
+  deque.clear();
+  EXPECT_TRUE(deque.isEmpty());
+
+  deque.prepend(7);
+  EXPECT_EQ(deque.back(), 7);
+}
+
+TEST(DequeTests, StableReferences) {
+  rh::Deque<int> deque;
+  std::vector<int*> addresses;
+
+  for (int i = 0; i < 5000; ++i) {
+    addresses.push_back(&deque.emplaceBack(i));
+    addresses.insert(addresses.begin(), &deque.emplaceFront(-i));
+  }
+
+  for (size_t i = 0; i < addresses.size(); ++i)
+    ASSERT_EQ(addresses[i], &deque[i]);
+
+  // popping one end leaves the rest in place
+  for (int i = 0; i < 3500; ++i) {
+    deque.popFront();
+    deque.popBack();
+  }
+
+  for (size_t i = 0; i < deque.length(); ++i)
+    ASSERT_EQ(addresses[i + 3500], &deque[i]);
+}
+
+TEST(DequeTests, MatchesStd) {
+  std::mt19937 random(11);
+
+  rh::Deque<int> deque;
+  std::deque<int> expected;
+
+  for (int step = 0; step < 300000; ++step) {
+    // drifts in both directions, so the chunk index gets recentered
+    bool grow = (step / 50000) % 2 == 0;
+
+    switch (random() % 4) {
+    case 0:
+      deque.append(step);
+      expected.push_back(step);
+      break;
+    case 1:
+      if (grow) {
+        deque.prepend(step);
+        expected.push_front(step);
+      }
+      else if (!expected.empty()) {
+        deque.popBack();
+        expected.pop_back();
+      }
+      break;
+    case 2:
+      if (!expected.empty()) {
+        deque.popFront();
+        expected.pop_front();
+      }
+      break;
+    default:
+      if (!expected.empty()) {
+        size_t index = random() % expected.size();
+        ASSERT_EQ(deque[index], expected[index]);
+      }
+    }
+  }
+
+  ASSERT_EQ(deque.length(), expected.size());
+  EXPECT_EQ(values(deque), std::vector<int>(expected.begin(), expected.end()));
+
+  // plain queue walks forward through chunks
+  rh::Deque<int> queue;
+
+  for (int i = 0; i < 1000000; ++i) {
+    queue.append(i);
+
+    if (i % 3 != 0) {
+      ASSERT_EQ(queue.front(), i - static_cast<int>(queue.length()) + 1);
+      queue.popFront();
+    }
+  }
+
+  EXPECT_EQ(queue.length(), 333334);
+
+  queue.shrinkToFit();
+  EXPECT_EQ(queue.back(), 999999);
+}
+
+TEST(DequeTests, CopyAndMove) {
+  {
+    rh::Deque<Tracked> deque;
+
+    for (int i = 0; i < 3000; ++i) {
+      deque.emplaceBack(i);
+      deque.emplaceFront(-i);
+    }
+
+    rh::Deque<Tracked> copy = deque;
+    EXPECT_EQ(values(copy), values(deque));
+
+    rh::Deque<Tracked> moved = rh::move(copy);
+    EXPECT_TRUE(copy.isEmpty());
+    EXPECT_EQ(moved.length(), 6000);
+
+    copy = moved;
+    moved = rh::move(deque);
+    EXPECT_EQ(values(copy), values(moved));
+
+    for (int i = 0; i < 2000; ++i)
+      moved.popBack();
+
+    moved.shrinkToFit();
+    copy.clear();
+    copy.shrinkToFit();
+    EXPECT_TRUE(copy.isEmpty());
+
+    rh::Deque<String> strings;
+    strings.append(String(100, U'x'));
+    strings.prepend(String(U"short"));
+
+    rh::Deque<String> const& constant = strings;
+    EXPECT_EQ(constant.front(), U"short");
+    EXPECT_EQ(constant.begin()->length(), 5);
+  }
+
+  EXPECT_EQ(Tracked::alive, 0);
+}
@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+
+#include <rh/FixedString.hpp>
+#include <rh/String.hpp>
+
+#include <string>
+
+namespace {
+
+template <FixedString Name>
+struct Command {
+  static constexpr StringView name() {
+    return Name;
+  }
+};
+
+constexpr ssize_t dispatch(StringView command) {
+  return stringSwitch<
+    U"add", U"remove", U"list", U"get", U"set", U"move", U"copy", U"rename", U"open", U"close",
+    U"read", U"write", U"seek", U"flush", U"sync", U"stat", U"chmod", U"chown", U"link", U"unlink",
+    U"mkdir", U"rmdir", U"mount", U"umount", U"ping", U"echo", U"exit", U"help", U"version", U"status",
+    U"start", U"stop", U"restart", U"reload", U"enable", U"disable", U"mask", U"unmask", U"show", U"cat",
+    U"edit", U"kill", U"reset", U"isolate", U"suspend", U"hibernate", U"poweroff", U"reboot", U"halt", U""
+  >(command);
+}
+
+}
+
+TEST(FixedStringTests, Basic) {
+  constexpr FixedString string{U"hello world"};
+
+  static_assert(string.length() == 11);
+  static_assert(string.find(U"world") == 6);
+  static_assert(string.find(U'o') == 4);
+  static_assert(string.startsWith(U"hello"));
+  static_assert(string.endsWith(U"world"));
+  static_assert(!string.contains(U"bye"));
+  static_assert(string.hash() == StringView{U"hello world"}.hash());
+  static_assert(string == FixedString{U"hello world"});
+  static_assert(FixedString{U""}.isEmpty());
+
+  EXPECT_EQ(string.hash(), String{U"hello world"}.hash());
+  EXPECT_TRUE(Command<U"list">::name() == U"list");
+}
+
+TEST(FixedStringTests, StringSwitch) {
+  static_assert(stringSwitch<U"one", U"two">(U"two") == 1);
+  static_assert(stringSwitch<U"one", U"two">(U"three") == -1);
+  static_assert(dispatch(U"halt") == 48);
+
+  EXPECT_EQ(dispatch(U"add"), 0);
+  EXPECT_EQ(dispatch(U"remove"), 1);
+  EXPECT_EQ(dispatch(U"status"), 29);
+  EXPECT_EQ(dispatch(U"halt"), 48);
+  EXPECT_EQ(dispatch(U""), 49);
+  EXPECT_EQ(dispatch(U"unknown"), -1);
+  EXPECT_EQ(dispatch(U"ad"), -1);
+  EXPECT_EQ(dispatch(U"adds"), -1);
+
+  // every case must be found at runtime, everything else must not
+  const char32_t* names[] = { U"add", U"remove", U"list", U"get", U"set", U"move", U"copy", U"rename", U"open", U"close" };
+
+  for (size_t index = 0; index < 10; ++index) {
+    EXPECT_EQ(dispatch(names[index]), index);
+
+    std::u32string changed = names[index];
+    changed[0] = U'X';
+    EXPECT_EQ(dispatch(StringView{changed}), -1);
+  }
+}
@@ -0,0 +1,198 @@
+#include <gtest/gtest.h>
+
+#include <rh/FlatMap.hpp>
+#include <rh/String.hpp>
+
+#include <map>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace {
+
+// Counts live objects, and isn't relocatable, because it remembers its own address
+struct Tracked {
+  static inline int alive = 0;
+
+  int value = 0;
+  const Tracked* self = this;
+
+  Tracked() noexcept { ++alive; }
+  Tracked(int value) noexcept : value(value) { ++alive; }
+  Tracked(Tracked const& other) noexcept : value(other.value) { ++alive; }
+  Tracked(Tracked&& other) noexcept : value(other.value) { other.value = -1; ++alive; }
+
+  Tracked& operator=(Tracked const& other) noexcept {
+    value = other.value;
+    return *this;
+  }
+
+  Tracked& operator=(Tracked&& other) noexcept {
+    value = other.value;
+    other.value = -1;
+    return *this;
+  }
+
+  ~Tracked() {
+    EXPECT_EQ(self, this);
+    --alive;
+  }
+};
+
+struct Greater {
+  bool operator()(int left, int right) const noexcept {
+    return left > right;
+  }
+};
+
+}
+
+static_assert(rh::is_trivially_relocatable<rh::FlatMap<String, Tracked>>);
+static_assert(sizeof(rh::FlatSet<int>) == sizeof(rh::List<int>));
+
+TEST(FlatMapTests, Basics) {
+  rh::FlatMap<int, int> map;
+
+  EXPECT_TRUE(map.isEmpty());
+  EXPECT_EQ(map.find(1), nullptr);
+  EXPECT_FALSE(map.erase(1));
+
+  for (int i = 10; i > 0; --i)
+    EXPECT_TRUE(map.insert(i, i * 10));
+
+  EXPECT_FALSE(map.insert(5, 0));
+  EXPECT_TRUE(map.insert(rh::Pair<int, int>(20, 200)));
+
+  map.set(5, 55);
+  map[30] += 3;
+
+  EXPECT_EQ(map.length(), 12);
+  EXPECT_EQ(map.at(5), 55);
+  EXPECT_EQ(*map.find(30), 3);
+  EXPECT_THROW(static_cast<void>(map.at(11)), rh::KeyError);
+  EXPECT_EQ(map.keys()[0], 1);
+  EXPECT_EQ(map.values()[11], 3);
+
+  int previous = 0;
+
+  for (auto [key, value] : map) {
+    EXPECT_LT(previous, key);
+    previous = key;
+    value = -key;
+  }
+
+  EXPECT_EQ(map.at(20), -20);
+
+  EXPECT_EQ(map.lowerBound(15).key(), 20);
+  EXPECT_EQ(map.upperBound(20).key(), 30);
+  EXPECT_TRUE(map.lowerBound(31) == map.end());
+
+  EXPECT_TRUE(map.erase(5));
+  EXPECT_FALSE(map.contains(5));
+
+  map.shrinkToFit();
+  EXPECT_EQ(map.capacity(), 11);
+
+  map.clear();
+  EXPECT_TRUE(map.isEmpty());
+}
+
+TEST(FlatMapTests, Batch) {
+  std::mt19937 random(3);
+
+  rh::FlatMap<int, int> map;
+  std::map<int, int> expected;
+
+  for (int round = 0; round < 20; ++round) {
+    rh::List<rh::Pair<int, int>> entries;
+
+    for (int i = 0; i < 1000; ++i) {
+      int key = static_cast<int>(random() % 5000);
+
+      entries.append(rh::Pair<int, int>(key, round * 1000 + i));
+      expected.emplace(key, round * 1000 + i);
+    }
+
+    map.insertBatch(rh::move(entries));
+  }
+
+  ASSERT_EQ(map.length(), expected.size());
+
+  auto expected_entry = expected.begin();
+
+  for (auto const& [key, value] : map) {
+    EXPECT_EQ(key, expected_entry->first);
+    EXPECT_EQ(value, expected_entry->second);
+    ++expected_entry;
+  }
+
+  for (int key = -1; key <= 5000; ++key)
+    EXPECT_EQ(map.contains(key), expected.contains(key));
+}
+
+TEST(FlatMapTests, StringKeysAndBalance) {
+  {
+    rh::List<rh::Pair<String, Tracked>> entries;
+
+    entries.append(rh::Pair<String, Tracked>(String(U"pear"), Tracked(1)));
+    entries.append(rh::Pair<String, Tracked>(String(U"apple"), Tracked(2)));
+    entries.append(rh::Pair<String, Tracked>(String(U"fig"), Tracked(3)));
+    entries.append(rh::Pair<String, Tracked>(String(U"apple"), Tracked(4)));
+
+    rh::FlatMap<String, Tracked> map(rh::move(entries));
+
+    EXPECT_EQ(map.length(), 3);
+    EXPECT_EQ(map.at(U"apple").value, 2);
+    EXPECT_EQ(map.at(StringView{U"fig"}).value, 3);
+    EXPECT_FALSE(map.contains(U"plum"));
+    EXPECT_EQ(map.keys()[2], U"pear");
+
+    for (int i = 0; i < 100; ++i)
+      map.emplace(String(static_cast<size_t>(i % 30 + 1), U'a' + i % 26), i);
+
+    rh::FlatMap<String, Tracked> copy = map;
+    EXPECT_EQ(copy.length(), map.length());
+
+    for (int i = 0; i < 100; i += 3)
+      copy.erase(String(static_cast<size_t>(i % 30 + 1), U'a' + i % 26));
+
+    EXPECT_LT(copy.length(), map.length());
+  }
+
+  EXPECT_EQ(Tracked::alive, 0);
+}
+
+TEST(FlatSetTests, Basics) {
+  rh::List<int> keys;
+
+  for (int i = 0; i < 100; ++i)
+    keys.append(i % 10);
+
+  rh::FlatSet<int, Greater> set(keys);
+
+  EXPECT_EQ(set.length(), 10);
+  EXPECT_EQ(set.keys()[0], 9);
+  EXPECT_EQ(*set.lowerBound(20), 9);
+  EXPECT_EQ(*set.upperBound(9), 8);
+  EXPECT_FALSE(set.insert(3));
+  EXPECT_TRUE(set.erase(3));
+  EXPECT_EQ(set.find(3), nullptr);
+  EXPECT_TRUE(set.insert(42));
+  EXPECT_EQ(*set.begin(), 42);
+
+  std::mt19937 random(5);
+  rh::FlatSet<int> numbers;
+  std::set<int> expected;
+
+  for (int i = 0; i < 3000; ++i) {
+    int key = static_cast<int>(random() % 1000);
+
+    EXPECT_EQ(numbers.insert(key), expected.insert(key).second);
+
+    if (i % 3 == 0) {
+      EXPECT_EQ(numbers.erase(key / 2), expected.erase(key / 2) != 0);
+    }
+  }
+
+  EXPECT_EQ(std::vector<int>(numbers.begin(), numbers.end()), std::vector<int>(expected.begin(), expected.end()));
+}
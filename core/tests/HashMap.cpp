@@ -0,0 +1,264 @@
+#include <gtest/gtest.h>
+
+#include <rh/HashMap.hpp>
+#include <rh/String.hpp>
+
+#include <random>
+#include <unordered_map>
+
+namespace {
+
+// Counts live objects, and isn't relocatable, because it remembers its own address
+struct Tracked {
+  static inline int alive = 0;
+
+  int value = 0;
+  const Tracked* self = this;
+
+  Tracked() noexcept { ++alive; }
+  Tracked(int value) noexcept : value(value) { ++alive; }
+  Tracked(Tracked const& other) noexcept : value(other.value) { ++alive; }
+  Tracked(Tracked&& other) noexcept : value(other.value) { other.value = -1; ++alive; }
+
+  Tracked& operator=(Tracked const& other) noexcept {
+    value = other.value;
+    return *this;
+  }
+
+  ~Tracked() {
+    EXPECT_EQ(self, this);
+    --alive;
+  }
+};
+
+// All keys collide into the same group
+struct BadKey {
+  int value;
+
+  bool operator==(BadKey const&) const noexcept = default;
+
+  uint64_t hash() const noexcept {
+    return static_cast<uint64_t>(value % 3);
+  }
+};
+
+}
+
+static_assert(rh::is_trivially_relocatable<rh::HashMap<String, Tracked>>);
+static_assert(rh::is_trivially_relocatable<rh::HashSet<int>>);
+
+TEST(HashMapTests, Basics) {
+  rh::HashMap<int, int> map;
+
+  EXPECT_TRUE(map.isEmpty());
+  EXPECT_EQ(map.find(1), nullptr);
+  EXPECT_FALSE(map.erase(1));
+
+  EXPECT_TRUE(map.insert(1, 10));
+  EXPECT_FALSE(map.insert(1, 20));
+  EXPECT_EQ(map.at(1), 10);
+
+  map.set(1, 30);
+  map.set(2, 40);
+  map[3] += 5;
+
+  EXPECT_EQ(map.length(), 3);
+  EXPECT_EQ(*map.find(1), 30);
+  EXPECT_EQ(map[2], 40);
+  EXPECT_EQ(map.at(3), 5);
+  EXPECT_THROW(static_cast<void>(map.at(4)), rh::KeyError);
+
+  int sum = 0;
+
+  for (auto const& [key, value] : map)
+    sum += key * 100 + value;
+
+  EXPECT_EQ(sum, 600 + 75);
+
+  EXPECT_TRUE(map.erase(2));
+  EXPECT_FALSE(map.contains(2));
+  EXPECT_EQ(map.length(), 2);
+
+  map.clear();
+  EXPECT_TRUE(map.isEmpty());
+  EXPECT_FALSE(map.contains(1));
+}
+
+TEST(HashMapTests, StringKeys) {
+  rh::HashMap<String, int> map;
+
+  map.set(String(U"first"), 1);
+  map.set(U"second", 2);
+  map.emplace(StringView{U"third"}, 3);
+
+  // looked up through views, without temporary strings
+  EXPECT_EQ(map.at(U"first"), 1);
+  EXPECT_EQ(map.at(StringView{U"second"}), 2);
+  EXPECT_EQ(map.at(String(U"third")), 3);
+  EXPECT_FALSE(map.contains(U"fourth"));
+
+  EXPECT_TRUE(map.erase(U"second"));
+  EXPECT_EQ(map.length(), 2);
+
+  // long keys live on the heap
+  String long_key(100, U'x');
+  map[long_key] = 100;
+  EXPECT_EQ(map[StringView{long_key}], 100);
+}
+
+TEST(HashMapTests, TombstonesAndCollisions) {
+  rh::HashMap<BadKey, int> map;
+
+  for (int round = 0; round < 10; ++round) {
+    for (int i = 0; i < 100; ++i)
+      EXPECT_TRUE(map.insert(BadKey{i}, i));
+
+    for (int i = 0; i < 100; i += 2)
+      EXPECT_TRUE(map.erase(BadKey{i}));
+
+    for (int i = 0; i < 100; ++i) {
+      int const* value = map.find(BadKey{i});
+
+      if (i % 2 == 0) {
+        EXPECT_EQ(value, nullptr);
+      }
+      else {
+        EXPECT_EQ(*value, i);
+      }
+    }
+
+    map.clear();
+  }
+
+  // erase and reinsert keep capacity, reusing deleted slots
+  rh::HashMap<int, int> numbers;
+
+  for (int i = 0; i < 80; ++i)
+    numbers.insert(i, i);
+
+  size_t capacity = numbers.capacity();
+
+  for (int i = 0; i < 100000; ++i) {
+    EXPECT_TRUE(numbers.erase(i));
+    EXPECT_TRUE(numbers.insert(i + 80, i));
+  }
+
+  EXPECT_EQ(numbers.length(), 80);
+  EXPECT_EQ(numbers.capacity(), capacity);
+}
+
+TEST(HashMapTests, MatchesStd) {
+  std::mt19937 random(42);
+  std::uniform_int_distribution<int> keys(0, 5000);
+
+  rh::HashMap<int, int> map;
+  std::unordered_map<int, int> expected;
+
+  for (int step = 0; step < 100000; ++step) {
+    int key = keys(random);
+
+    switch (random() % 3) {
+    case 0:
+      map.set(key, step);
+      expected[key] = step;
+      break;
+    case 1:
+      EXPECT_EQ(map.erase(key), expected.erase(key) != 0);
+      break;
+    default: {
+      auto found = expected.find(key);
+      int const* value = map.find(key);
+
+      ASSERT_EQ(value != nullptr, found != expected.end());
+
+      if (value) {
+        EXPECT_EQ(*value, found->second);
+      }
+    }
+    }
+  }
+
+  EXPECT_EQ(map.length(), expected.size());
+
+  size_t visited = 0;
+
+  for (auto const& [key, value] : map) {
+    EXPECT_EQ(expected.at(key), value);
+    ++visited;
+  }
+
+  EXPECT_EQ(visited, expected.size());
+}
+
+TEST(HashMapTests, CopyMoveAndRehash) {
+  {
+    rh::HashMap<String, Tracked> map;
+
+    for (int i = 0; i < 1000; ++i)
+      map.emplace(String(static_cast<size_t>(i % 50 + 1), U'a' + i % 26), i);
+
+    rh::HashMap<String, Tracked> copy = map;
+    EXPECT_EQ(copy.length(), map.length());
+
+    for (auto const& [key, value] : map)
+      EXPECT_EQ(copy.at(key).value, value.value);
+
+    rh::HashMap<String, Tracked> moved = rh::move(copy);
+    EXPECT_TRUE(copy.isEmpty());
+    EXPECT_EQ(moved.length(), map.length());
+
+    copy = moved;
+    moved = rh::move(map);
+    EXPECT_EQ(copy.length(), moved.length());
+
+    // shrinks to fit, growth is up front
+    size_t length = moved.length();
+
+    moved.rehash(0);
+    EXPECT_LT(moved.capacity(), 2 * length + 32);
+    EXPECT_EQ(moved.length(), length);
+
+    moved.reserve(10000);
+    size_t capacity = moved.capacity();
+
+    for (int i = 0; i < 9000; ++i)
+      moved.emplace(String(60, U'a') + String(static_cast<size_t>(i % 7 + 1), U'b' + i % 20), i);
+
+    EXPECT_EQ(moved.capacity(), capacity);
+
+    moved.rehash(0);
+    moved.clear();
+    moved.rehash(0);
+    EXPECT_EQ(moved.capacity(), 0);
+  }
+
+  EXPECT_EQ(Tracked::alive, 0);
+}
+
+TEST(HashSetTests, Basics) {
+  rh::HashSet<String> set;
+
+  EXPECT_TRUE(set.insert(U"one"));
+  EXPECT_TRUE(set.insert(String(U"two")));
+  EXPECT_FALSE(set.insert(U"one"));
+
+  EXPECT_TRUE(set.contains(U"two"));
+  EXPECT_EQ(*set.find(StringView{U"one"}), U"one");
+  EXPECT_EQ(set.find(U"three"), nullptr);
+
+  EXPECT_TRUE(set.erase(U"one"));
+  EXPECT_FALSE(set.erase(U"one"));
+
+  rh::HashSet<int> numbers;
+
+  for (int i = 0; i < 1000; ++i)
+    numbers.insert(i % 100);
+
+  int sum = 0;
+
+  for (int number : numbers)
+    sum += number;
+
+  EXPECT_EQ(numbers.length(), 100);
+  EXPECT_EQ(sum, 4950);
+}
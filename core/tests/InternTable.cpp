@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+
+#include <rh/InternTable.hpp>
+#include <rh/String.hpp>
+
+#include <thread>
+#include <vector>
+
+TEST(InternTableTests, Atoms) {
+  InternTable table;
+
+  Atom empty = table.intern(U"");
+  EXPECT_EQ(empty, Atom{});
+  EXPECT_TRUE(empty.isEmpty());
+  EXPECT_TRUE(empty.view().isEmpty());
+
+  Atom hello = table.intern(U"hello");
+  Atom helloAgain = table.intern(String{U"hello"});
+  Atom world = table.intern(U"world");
+
+  EXPECT_EQ(hello, helloAgain);
+  EXPECT_EQ(hello.hash(), helloAgain.hash());
+  EXPECT_NE(hello, world);
+  EXPECT_EQ(hello.data(), helloAgain.data());
+  EXPECT_TRUE(hello.view() == U"hello");
+  EXPECT_EQ(hello.length(), 5);
+  EXPECT_EQ(hello.data()[5], 0);
+
+  EXPECT_EQ(table.find(U"world"), world);
+  EXPECT_TRUE(table.find(U"missing").isEmpty());
+
+  InternTable::Statistics statistics = table.statistics();
+  EXPECT_EQ(statistics.atoms, 2);
+  EXPECT_EQ(statistics.misses, 2);
+  EXPECT_EQ(statistics.hits, 1);
+  EXPECT_GT(statistics.arenaBytes, 0);
+  EXPECT_GT(statistics.tableBytes, 0);
+
+  EXPECT_EQ(Atom{U"global"}, InternTable::global().intern(U"global"));
+}
+
+TEST(InternTableTests, Concurrent) {
+  constexpr size_t threadsCount = 8;
+  constexpr size_t stringsCount = 20000;
+
+  InternTable table;
+
+  std::vector<String> strings;
+  for (size_t i = 0; i < stringsCount; ++i) {
+    String string{U"identifier_"};
+    for (size_t value = i; value; value /= 10)
+      string.push(U'0' + value % 10);
+    strings.push_back(string);
+  }
+
+  std::vector<std::vector<Atom>> results(threadsCount);
+  std::vector<std::thread> threads;
+
+  for (size_t thread = 0; thread < threadsCount; ++thread) {
+    threads.emplace_back([&, thread] {
+      auto& atoms = results[thread];
+      atoms.resize(stringsCount);
+
+      // every thread starts from its own place, so insertions race with lookups
+      for (size_t i = 0; i < stringsCount; ++i) {
+        size_t index = (i + thread * (stringsCount / threadsCount)) % stringsCount;
+        atoms[index] = table.intern(strings[index]);
+      }
+    });
+  }
+
+  for (auto& thread : threads)
+    thread.join();
+
+  for (size_t i = 0; i < stringsCount; ++i) {
+    EXPECT_TRUE(results[0][i].view() == strings[i]);
+
+    for (size_t thread = 1; thread < threadsCount; ++thread)
+      EXPECT_EQ(results[thread][i], results[0][i]);
+  }
+
+  InternTable::Statistics statistics = table.statistics();
+  EXPECT_EQ(statistics.atoms, stringsCount);
+  EXPECT_EQ(statistics.misses, stringsCount);
+  EXPECT_EQ(statistics.hits, stringsCount * (threadsCount - 1));
+}
@@ -0,0 +1,229 @@
+#include <gtest/gtest.h>
+
+#include <rh/IntrusiveHashTable.hpp>
+#include <rh/IntrusiveList.hpp>
+#include <rh/List.hpp>
+#include <rh/String.hpp>
+
+#include <random>
+#include <unordered_set>
+
+namespace {
+
+// Timer, which is found by its id and ordered in a list at the same time
+struct Timer {
+  uint64_t id = 0;
+  int deadline = 0;
+
+  rh::IntrusiveHashHook byId;
+  rh::IntrusiveListHook byDeadline;
+
+  Timer() noexcept = default;
+  Timer(uint64_t id, int deadline = 0) noexcept : id(id), deadline(deadline) {}
+};
+
+using TimerTable = rh::IntrusiveHashTable<Timer, &Timer::byId, &Timer::id>;
+
+struct Named {
+  String name;
+  rh::IntrusiveHashHook hook;
+};
+
+using NamedTable = rh::IntrusiveHashTable<Named, &Named::hook, &Named::name>;
+
+}
+
+static_assert(std::is_same_v<TimerTable::key_type, uint64_t>);
+static_assert(rh::is_trivially_relocatable<TimerTable>);
+
+TEST(IntrusiveHashTableTests, Basics) {
+  Timer timers[] = { 10, 20, 30 };
+  TimerTable table;
+
+  EXPECT_TRUE(table.isEmpty());
+  EXPECT_EQ(table.find(10u), nullptr);
+  EXPECT_EQ(table.extract(10u), nullptr);
+  EXPECT_EQ(table.begin(), table.end());
+
+  for (Timer& timer : timers)
+    EXPECT_TRUE(table.insert(timer));
+
+  // same key is refused, object stays unlinked
+  Timer duplicate(20);
+  EXPECT_FALSE(table.insert(duplicate));
+  EXPECT_FALSE(duplicate.byId.isLinked());
+
+  EXPECT_EQ(table.length(), 3);
+  EXPECT_EQ(table.find(20u), &timers[1]);
+  EXPECT_TRUE(table.contains(30u));
+  EXPECT_FALSE(table.contains(40u));
+  EXPECT_TRUE(timers[0].byId.isLinked());
+
+  table.erase(timers[0]);
+  EXPECT_FALSE(timers[0].byId.isLinked());
+  EXPECT_FALSE(table.contains(10u));
+  EXPECT_EQ(table.length(), 2);
+
+  EXPECT_EQ(table.extract(30u), &timers[2]);
+  EXPECT_FALSE(timers[2].byId.isLinked());
+  EXPECT_EQ(table.length(), 1);
+
+  // erased object can go back
+  EXPECT_TRUE(table.insert(timers[0]));
+  EXPECT_EQ(table.find(10u), &timers[0]);
+
+  int count = 0;
+  for (Timer const& timer : table) {
+    EXPECT_TRUE(timer.id == 10 || timer.id == 20);
+    ++count;
+  }
+  EXPECT_EQ(count, 2);
+
+  table.clear();
+  EXPECT_TRUE(table.isEmpty());
+  EXPECT_FALSE(timers[0].byId.isLinked());
+  EXPECT_FALSE(timers[1].byId.isLinked());
+  EXPECT_EQ(table.begin(), table.end());
+}
+
+TEST(IntrusiveHashTableTests, StringKeys) {
+  Named names[] = { { String(U"one"), {} }, { String(U"two"), {} } };
+  NamedTable table;
+
+  table.insert(names[0]);
+  table.insert(names[1]);
+
+  // views and literals are looked up without a String
+  EXPECT_EQ(table.find(U"one"), &names[0]);
+  EXPECT_EQ(table.find(StringView(U"two")), &names[1]);
+  EXPECT_EQ(table.find(String(U"two")), &names[1]);
+  EXPECT_FALSE(table.contains(U"three"));
+
+  table.clear();
+}
+
+TEST(IntrusiveHashTableTests, Reserve) {
+  rh::List<Timer> timers;
+  TimerTable table;
+
+  for (uint64_t i = 0; i < 100; ++i)
+    timers.append(Timer(i));
+
+  table.reserve(100);
+  size_t buckets = table.bucketCount();
+  EXPECT_GE(buckets, 100);
+
+  for (Timer& timer : timers)
+    table.insert(timer);
+
+  EXPECT_EQ(table.bucketCount(), buckets);
+
+  // clear keeps buckets
+  table.clear();
+  EXPECT_EQ(table.bucketCount(), buckets);
+}
+
+TEST(IntrusiveHashTableTests, Move) {
+  Timer timers[] = { 1, 2, 3 };
+  TimerTable table;
+
+  for (Timer& timer : timers)
+    table.insert(timer);
+
+  TimerTable moved(std::move(table));
+  EXPECT_TRUE(table.isEmpty());
+  EXPECT_EQ(moved.length(), 3);
+
+  // links into buckets survive the move
+  moved.erase(timers[1]);
+  EXPECT_EQ(moved.find(1u), &timers[0]);
+  EXPECT_FALSE(moved.contains(2u));
+
+  table = std::move(moved);
+  EXPECT_TRUE(moved.isEmpty());
+  EXPECT_EQ(table.find(3u), &timers[2]);
+
+  table = TimerTable();
+  EXPECT_FALSE(timers[0].byId.isLinked());
+  EXPECT_FALSE(timers[2].byId.isLinked());
+}
+
+TEST(IntrusiveHashTableTests, TimerSet) {
+  rh::List<Timer> timers;
+  TimerTable byId;
+  rh::IntrusiveList<Timer, &Timer::byDeadline> byDeadline;
+
+  for (uint64_t i = 0; i < 8; ++i)
+    timers.append(Timer(i * 7, static_cast<int>(i)));
+
+  byId.reserve(timers.length());
+
+  for (Timer& timer : timers) {
+    byId.insert(timer);
+    byDeadline.append(timer);
+  }
+
+  // cancel by id: both memberships are dropped without allocation or search
+  Timer* cancelled = byId.extract(21u);
+  ASSERT_NE(cancelled, nullptr);
+  byDeadline.erase(*cancelled);
+
+  // fire the earliest ones
+  for (int i = 0; i < 2; ++i) {
+    Timer& fired = byDeadline.popFront();
+    byId.erase(fired);
+    EXPECT_FALSE(fired.byId.isLinked());
+  }
+
+  EXPECT_EQ(byId.length(), 5);
+  EXPECT_EQ(byDeadline.length(), 5);
+  EXPECT_EQ(byDeadline.front().id, 14);
+  EXPECT_FALSE(byId.contains(0u));
+  EXPECT_FALSE(byId.contains(7u));
+  EXPECT_TRUE(byId.contains(14u));
+
+  byId.clear();
+  byDeadline.clear();
+}
+
+TEST(IntrusiveHashTableTests, Random) {
+  std::mt19937_64 random(42);
+  rh::List<Timer> timers;
+  std::unordered_set<uint64_t> expected;
+  TimerTable table;
+
+  for (uint64_t i = 0; i < 2000; ++i)
+    timers.append(Timer(random() % 1000));
+
+  for (int round = 0; round < 10000; ++round) {
+    Timer& timer = timers[random() % timers.length()];
+
+    if (timer.byId.isLinked()) {
+      table.erase(timer);
+      expected.erase(timer.id);
+    }
+    else {
+      EXPECT_EQ(table.insert(timer), expected.insert(timer.id).second);
+    }
+
+    ASSERT_EQ(table.length(), expected.size());
+  }
+
+  for (uint64_t key = 0; key < 1000; ++key) {
+    Timer* found = table.find(key);
+
+    EXPECT_EQ(found != nullptr, expected.contains(key));
+
+    if (found) {
+      EXPECT_EQ(found->id, key);
+    }
+  }
+
+  size_t count = 0;
+  for ([[maybe_unused]] Timer& timer : table)
+    ++count;
+
+  EXPECT_EQ(count, expected.size());
+
+  table.clear();
+}
@@ -0,0 +1,181 @@
+#include <gtest/gtest.h>
+
+#include <rh/IntrusiveList.hpp>
+#include <rh/List.hpp>
+
+#include <vector>
+
+namespace {
+
+// Entry of a cache: in LRU order and in a list of dirty entries at the same time
+struct Entry {
+  int value = 0;
+
+  rh::IntrusiveListHook lruHook;
+  rh::IntrusiveListHook dirtyHook;
+
+  Entry() noexcept = default;
+  Entry(int value) noexcept : value(value) {}
+};
+
+using LruList   = rh::IntrusiveList<Entry, &Entry::lruHook>;
+using DirtyList = rh::IntrusiveList<Entry, &Entry::dirtyHook>;
+
+template <typename ListT>
+std::vector<int> valuesOf(ListT const& list) {
+  std::vector<int> values;
+
+  for (Entry const& entry : list)
+    values.push_back(entry.value);
+
+  return values;
+}
+
+}
+
+TEST(IntrusiveListTests, Basics) {
+  Entry entries[] = { 0, 1, 2, 3, 4 };
+  LruList list;
+
+  EXPECT_TRUE(list.isEmpty());
+  EXPECT_EQ(list.begin(), list.end());
+
+  list.append(entries[1]);
+  list.append(entries[2]);
+  list.prepend(entries[0]);
+  list.insertBefore(entries[2], entries[3]);
+
+  EXPECT_EQ(list.length(), 4);
+  EXPECT_EQ(valuesOf(list), (std::vector<int>{ 0, 1, 3, 2 }));
+  EXPECT_EQ(list.front().value, 0);
+  EXPECT_EQ(list.back().value, 2);
+  EXPECT_TRUE(entries[3].lruHook.isLinked());
+  EXPECT_FALSE(entries[4].lruHook.isLinked());
+
+  list.erase(entries[1]);
+  EXPECT_FALSE(entries[1].lruHook.isLinked());
+  EXPECT_EQ(valuesOf(list), (std::vector<int>{ 0, 3, 2 }));
+
+  EXPECT_EQ(&list.popFront(), &entries[0]);
+  EXPECT_EQ(&list.popBack(), &entries[2]);
+  EXPECT_EQ(list.length(), 1);
+  EXPECT_FALSE(entries[0].lruHook.isLinked());
+
+  // backwards
+  list.append(entries[4]);
+  auto it = list.end();
+  --it;
+  EXPECT_EQ(it->value, 4);
+  --it;
+  EXPECT_EQ(it->value, 3);
+  EXPECT_EQ(it, list.begin());
+
+  list.clear();
+  EXPECT_TRUE(list.isEmpty());
+  EXPECT_FALSE(entries[3].lruHook.isLinked());
+  EXPECT_FALSE(entries[4].lruHook.isLinked());
+}
+
+TEST(IntrusiveListTests, Lru) {
+  Entry entries[] = { 0, 1, 2, 3 };
+  LruList lru;
+
+  for (Entry& entry : entries)
+    lru.moveToBack(entry);
+
+  // touching makes an entry the most recent one
+  lru.moveToBack(entries[0]);
+  lru.moveToBack(entries[2]);
+  EXPECT_EQ(valuesOf(lru), (std::vector<int>{ 1, 3, 0, 2 }));
+
+  // evict the least recent ones
+  EXPECT_EQ(lru.popFront().value, 1);
+  EXPECT_EQ(lru.popFront().value, 3);
+  EXPECT_EQ(valuesOf(lru), (std::vector<int>{ 0, 2 }));
+}
+
+TEST(IntrusiveListTests, SeveralHooks) {
+  Entry entries[] = { 0, 1, 2, 3 };
+  LruList lru;
+  DirtyList dirty;
+
+  for (Entry& entry : entries)
+    lru.append(entry);
+
+  dirty.append(entries[3]);
+  dirty.append(entries[1]);
+
+  EXPECT_EQ(valuesOf(lru), (std::vector<int>{ 0, 1, 2, 3 }));
+  EXPECT_EQ(valuesOf(dirty), (std::vector<int>{ 3, 1 }));
+
+  // lists don't affect each other
+  lru.erase(entries[1]);
+  EXPECT_FALSE(entries[1].lruHook.isLinked());
+  EXPECT_TRUE(entries[1].dirtyHook.isLinked());
+  EXPECT_EQ(valuesOf(dirty), (std::vector<int>{ 3, 1 }));
+
+  dirty.clear();
+  EXPECT_EQ(valuesOf(lru), (std::vector<int>{ 0, 2, 3 }));
+
+  lru.clear();
+}
+
+TEST(IntrusiveListTests, MoveAndCopy) {
+  Entry entries[] = { 0, 1, 2 };
+  LruList list;
+
+  for (Entry& entry : entries)
+    list.append(entry);
+
+  LruList moved(std::move(list));
+  EXPECT_TRUE(list.isEmpty());
+  EXPECT_EQ(moved.length(), 3);
+  EXPECT_EQ(valuesOf(moved), (std::vector<int>{ 0, 1, 2 }));
+
+  moved.erase(entries[0]);
+  moved.erase(entries[2]);
+  EXPECT_EQ(valuesOf(moved), (std::vector<int>{ 1 }));
+
+  list = std::move(moved);
+  EXPECT_TRUE(moved.isEmpty());
+  EXPECT_EQ(valuesOf(list), (std::vector<int>{ 1 }));
+
+  // empty one unlinks its own items
+  list = LruList();
+  EXPECT_TRUE(list.isEmpty());
+  EXPECT_FALSE(entries[1].lruHook.isLinked());
+
+  // copy of an object isn't linked anywhere
+  list.append(entries[0]);
+  Entry copy = entries[0];
+  EXPECT_TRUE(entries[0].lruHook.isLinked());
+  EXPECT_FALSE(copy.lruHook.isLinked());
+
+  copy = entries[0];
+  EXPECT_FALSE(copy.lruHook.isLinked());
+}
+
+TEST(IntrusiveListTests, Many) {
+  rh::List<Entry> entries;
+  LruList list;
+
+  for (int i = 0; i < 1000; ++i)
+    entries.append(Entry(i));
+
+  for (Entry& entry : entries)
+    list.append(entry);
+
+  // erase every odd one
+  for (size_t i = 1; i < entries.length(); i += 2)
+    list.erase(entries[i]);
+
+  EXPECT_EQ(list.length(), 500);
+
+  int expected = 0;
+  for (Entry const& entry : list) {
+    EXPECT_EQ(entry.value, expected);
+    expected += 2;
+  }
+
+  list.clear();
+}
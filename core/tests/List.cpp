@@ -0,0 +1,198 @@
+#include <gtest/gtest.h>
+
+#include <rh/List.hpp>
+#include <rh/String.hpp>
+
+#include <vector>
+
+namespace {
+
+// Counts live objects, and isn't relocatable, because it registers its own address
+struct Tracked {
+  static inline int alive = 0;
+
+  int value = 0;
+  const Tracked* self = this;
+
+  Tracked() noexcept { ++alive; }
+  Tracked(int value) noexcept : value(value) { ++alive; }
+  Tracked(Tracked const& other) noexcept : value(other.value) { ++alive; }
+  Tracked(Tracked&& other) noexcept : value(other.value) { other.value = -1; ++alive; }
+
+  Tracked& operator=(Tracked const& other) noexcept {
+    value = other.value;
+    return *this;
+  }
+
+  Tracked& operator=(Tracked&& other) noexcept {
+    value = other.value;
+    other.value = -1;
+    return *this;
+  }
+
+  ~Tracked() {
+    EXPECT_EQ(self, this);
+    --alive;
+  }
+};
+
+// Has a destructor, but may be moved by memcpy
+struct Handle {
+  static inline int alive = 0;
+
+  int* value;
+
+  Handle(int value = 0) : value(new int(value)) { ++alive; }
+  Handle(Handle const& other) : value(new int(*other.value)) { ++alive; }
+  Handle(Handle&& other) noexcept : value(other.value) { other.value = nullptr; ++alive; }
+
+  Handle& operator=(Handle const& other) {
+    *value = *other.value;
+    return *this;
+  }
+
+  Handle& operator=(Handle&& other) noexcept {
+    delete value;
+    value = other.value;
+    other.value = nullptr;
+    return *this;
+  }
+
+  ~Handle() {
+    delete value;
+    --alive;
+  }
+};
+
+template <typename T>
+std::vector<int> values(rh::List<T> const& list) {
+  std::vector<int> result;
+
+  for (T const& item : list) {
+    if constexpr (requires { *item.value; })
+      result.push_back(*item.value);
+    else if constexpr (requires { item.value; })
+      result.push_back(item.value);
+    else
+      result.push_back(item);
+  }
+
+  return result;
+}
+
+template <typename T>
+void checkEditing() {
+  {
+    rh::List<T> list;
+
+    for (int i = 0; i < 5; ++i)
+      list.append(T(i));
+
+    list.insert(0, T(10));
+    list.insert(3, T(11));
+    list.insert(-1, T(12));
+    list.emplace(1, 13);
+    list.emplaceBack(14);
+
+    EXPECT_EQ(values(list), (std::vector<int>{10, 13, 0, 1, 11, 2, 3, 12, 4, 14}));
+
+    list.erase(0);
+    list.erase(2, 3);
+    list.erase(-1);
+
+    EXPECT_EQ(values(list), (std::vector<int>{13, 0, 3, 12, 4}));
+
+    EXPECT_THROW(list.erase(5), rh::IndexError);
+    EXPECT_THROW(list.erase(3, 3), rh::IndexError);
+    EXPECT_THROW(list.insert(6, T(0)), rh::IndexError);
+
+    // items of the list itself
+    list.append(list[0]);
+    list.insert(0, list[4]);
+
+    EXPECT_EQ(values(list), (std::vector<int>{4, 13, 0, 3, 12, 4, 13}));
+
+    rh::List<T> copy = list;
+    list.shrinkToFit();
+    list.resize(2);
+    list = copy;
+    copy = rh::move(list);
+
+    EXPECT_EQ(values(copy), (std::vector<int>{4, 13, 0, 3, 12, 4, 13}));
+    EXPECT_TRUE(list.isEmpty());
+  }
+}
+
+}
+
+_RHLIB_MAKE_TRIVIALLY_RELOCATABLE(Handle)
+
+static_assert(rh::is_trivially_relocatable<int>);
+static_assert(rh::is_trivially_relocatable<Handle>);
+static_assert(rh::is_trivially_relocatable<rh::String>);
+static_assert(rh::is_trivially_relocatable<rh::List<Tracked>>);
+static_assert(!rh::is_trivially_relocatable<Tracked>);
+
+// relocation and allocation fall back to element-wise code in constant evaluation
+template <typename T>
+constexpr bool editInConstantEvaluation(T (*make)(int)) {
+  rh::List<T> list;
+
+  for (int i = 0; i < 20; ++i)
+    list.append(make(i));
+
+  list.insert(0, make(100));
+  list.insert(5, make(101));
+  list.erase(1, 3);
+  list.erase(-1);
+
+  rh::List<T> copy = list;
+  copy.reserve(100);
+  copy.shrinkToFit();
+
+  return copy.length() == 18 && copy[0] == make(100) && copy[1] == make(3)
+    && copy[2] == make(101) && copy[17] == make(18) && list.length() == 18;
+}
+
+static_assert(editInConstantEvaluation<int>([](int value) { return value; }));
+static_assert(editInConstantEvaluation<String>([](int value) { return String(static_cast<size_t>(value % 12 + 1), U'a' + value); }));
+
+TEST(ListTests, Editing) {
+  checkEditing<int>();
+  checkEditing<Tracked>();
+  checkEditing<Handle>();
+
+  EXPECT_EQ(Tracked::alive, 0);
+  EXPECT_EQ(Handle::alive, 0);
+}
+
+TEST(ListTests, Growth) {
+  rh::List<int> numbers;
+
+  for (int i = 0; i < 1000000; ++i)
+    numbers.append(i);
+
+  EXPECT_EQ(numbers.length(), 1000000);
+  EXPECT_EQ(numbers[999999], 999999);
+
+  numbers.reserve(2000000);
+  EXPECT_EQ(numbers.capacity(), 2000000);
+  EXPECT_EQ(numbers[123456], 123456);
+
+  // strings with heap buffers are relocated without copying characters
+  rh::List<String> strings;
+  String long_string(100, U'x');
+
+  for (int i = 0; i < 100; ++i)
+    strings.append(long_string);
+
+  const char32_t* first = strings[0].data();
+
+  strings.reserve(1000);
+  EXPECT_EQ(strings[0].data(), first);
+  EXPECT_EQ(strings[99], long_string);
+
+  strings.erase(0, 50);
+  EXPECT_EQ(strings.length(), 50);
+  EXPECT_EQ(strings[49], long_string);
+}
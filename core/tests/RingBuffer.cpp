@@ -0,0 +1,169 @@
+#include <gtest/gtest.h>
+
+#include <rh/Container.hpp>
+#include <rh/RingBuffer.hpp>
+#include <rh/String.hpp>
+
+#include <deque>
+#include <random>
+#include <vector>
+
+namespace {
+
+// Counts live objects, and isn't relocatable, because it remembers its own address
+struct Tracked {
+  static inline int alive = 0;
+
+  int value = 0;
+  const Tracked* self = this;
+
+  Tracked() noexcept { ++alive; }
+  Tracked(int value) noexcept : value(value) { ++alive; }
+  Tracked(Tracked const& other) noexcept : value(other.value) { ++alive; }
+  Tracked(Tracked&& other) noexcept : value(other.value) { other.value = -1; ++alive; }
+
+  Tracked& operator=(Tracked const& other) noexcept {
+    value = other.value;
+    return *this;
+  }
+
+  ~Tracked() {
+    EXPECT_EQ(self, this);
+    --alive;
+  }
+};
+
+template <typename BufferT>
+std::vector<int> values(BufferT const& buffer) {
+  std::vector<int> result;
+
+  for (auto const& item : buffer) {
+    if constexpr (requires { item.value; })
+      result.push_back(item.value);
+    else
+      result.push_back(item);
+  }
+
+  return result;
+}
+
+}
+
+static_assert(rh::Iterable<rh::RingBuffer<int>> && rh::Iterable<rh::RingBuffer<int> const>);
+static_assert(rh::is_trivially_relocatable<rh::RingBuffer<String>>);
+
+TEST(RingBufferTests, Basics) {
+  rh::RingBuffer<int> empty;
+
+  EXPECT_TRUE(empty.isEmpty());
+  EXPECT_TRUE(empty.isFull());
+  EXPECT_THROW(empty.append(1), rh::RuntimeError);
+
+  rh::RingBuffer<int> buffer(5);
+
+  EXPECT_EQ(buffer.capacity(), 8);
+
+  for (int i = 0; i < 4; ++i) {
+    buffer.append(i);
+    buffer.prepend(-i - 1);
+  }
+
+  EXPECT_TRUE(buffer.isFull());
+  EXPECT_THROW(buffer.append(100), rh::RuntimeError);
+  EXPECT_THROW(buffer.prepend(100), rh::RuntimeError);
+  EXPECT_EQ(values(buffer), (std::vector<int>{-4, -3, -2, -1, 0, 1, 2, 3}));
+  EXPECT_EQ(buffer.front(), -4);
+  EXPECT_EQ(buffer.back(), 3);
+  EXPECT_EQ(buffer[4], 0);
+
+  auto last = buffer.end();
+  EXPECT_EQ(*--last, 3);
+
+  buffer.popFront();
+  buffer.popBack();
+  buffer.emplaceBack(10) += 1;
+
+  EXPECT_EQ(values(buffer), (std::vector<int>{-3, -2, -1, 0, 1, 2, 11}));
+
+  buffer.clear();
+  EXPECT_TRUE(buffer.isEmpty());
+  EXPECT_EQ(buffer.capacity(), 8);
+}
+
+TEST(RingBufferTests, MatchesStd) {
+  std::mt19937 random(13);
+
+  rh::RingBuffer<int> buffer(1000);
+  std::deque<int> expected;
+
+  for (int step = 0; step < 300000; ++step) {
+    switch (random() % 5) {
+    case 0:
+    case 1:
+      if (!buffer.isFull()) {
+        buffer.append(step);
+        expected.push_back(step);
+      }
+      break;
+    case 2:
+      if (!buffer.isFull()) {
+        buffer.prepend(step);
+        expected.push_front(step);
+      }
+      break;
+    case 3:
+      if (!expected.empty()) {
+        buffer.popFront();
+        expected.pop_front();
+      }
+      break;
+    default:
+      if (!expected.empty()) {
+        size_t index = random() % expected.size();
+        ASSERT_EQ(buffer[index], expected[index]);
+      }
+    }
+
+    ASSERT_EQ(buffer.length(), expected.size());
+  }
+
+  EXPECT_EQ(values(buffer), std::vector<int>(expected.begin(), expected.end()));
+}
+
+TEST(RingBufferTests, CopyAndMove) {
+  {
+    rh::RingBuffer<Tracked> buffer(64);
+
+    for (int i = 0; i < 200; ++i) {
+      if (buffer.isFull())
+        buffer.popFront();
+
+      buffer.emplaceBack(i);
+    }
+
+    EXPECT_EQ(buffer.front().value, 136);
+
+    rh::RingBuffer<Tracked> copy = buffer;
+    EXPECT_EQ(values(copy), values(buffer));
+
+    rh::RingBuffer<Tracked> moved = rh::move(copy);
+    EXPECT_TRUE(copy.isEmpty());
+    EXPECT_EQ(copy.capacity(), 0);
+
+    rh::RingBuffer<Tracked> small(4);
+    small.emplaceBack(1);
+
+    small = moved;
+    EXPECT_EQ(small.capacity(), 64);
+    EXPECT_EQ(values(small), values(moved));
+
+    moved = rh::move(buffer);
+    EXPECT_EQ(moved.length(), 64);
+
+    rh::RingBuffer<Tracked> const& constant = moved;
+    EXPECT_EQ(constant.back().value, 199);
+    EXPECT_EQ(constant.begin()->value, 136);
+  }
+
+  EXPECT_EQ(Tracked::alive, 0);
+}
@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+
+#include <rh/SharedString.hpp>
+#include <rh/String.hpp>
+
+#include <thread>
+#include <vector>
+
+TEST(SharedStringTests, Copies) {
+  SharedString empty;
+  EXPECT_TRUE(empty.isEmpty());
+  EXPECT_EQ(empty.references(), 0);
+  EXPECT_TRUE(empty.view() == U"");
+  EXPECT_TRUE(SharedString{U""}.isEmpty());
+
+  SharedString string{U"hello"};
+  EXPECT_EQ(string.references(), 1);
+  EXPECT_EQ(string.length(), 5);
+  EXPECT_EQ(string.data()[5], 0);
+
+  {
+    SharedString copy = string;
+    EXPECT_EQ(copy.data(), string.data());
+    EXPECT_EQ(string.references(), 2);
+
+    SharedString other{U"world"};
+    other = copy;
+    EXPECT_EQ(string.references(), 3);
+    EXPECT_TRUE(other == string);
+
+    SharedString moved = move(other);
+    EXPECT_TRUE(other.isEmpty());
+    EXPECT_EQ(string.references(), 3);
+  }
+
+  EXPECT_EQ(string.references(), 1);
+
+  StringView view = string;
+  EXPECT_TRUE(view == U"hello");
+  EXPECT_TRUE(string == SharedString{U"hello"});
+  EXPECT_TRUE(string != SharedString{U"world"});
+}
+
+TEST(SharedStringTests, RoundTrip) {
+  String string{U"long enough to be stored on the heap"};
+  const char32_t* characters = string.data();
+
+  SharedString shared = move(string).share();
+  EXPECT_TRUE(string.isEmpty());
+  EXPECT_EQ(shared.data(), characters);
+  EXPECT_TRUE(shared == U"long enough to be stored on the heap");
+
+  SharedString copy = shared;
+
+  // two references, so it must be copied
+  String copied = move(copy).toString();
+  EXPECT_TRUE(copy.isEmpty());
+  EXPECT_NE(copied.data(), characters);
+  EXPECT_EQ(shared.references(), 1);
+
+  String adopted = move(shared).toString();
+  EXPECT_TRUE(shared.isEmpty());
+  EXPECT_EQ(adopted.data(), characters);
+  EXPECT_TRUE(adopted == copied);
+
+  adopted.append(U", and it's still a regular string");
+  EXPECT_TRUE(StringView{adopted}.endsWith(U"regular string"));
+
+  // characters share the allocation with the header, so they're copied
+  SharedString fromView{U"long enough to be stored on the heap"};
+  String fromViewCopy = move(fromView).toString();
+  EXPECT_TRUE(fromView.isEmpty());
+  EXPECT_TRUE(fromViewCopy == copied);
+
+  // adopted buffer is freed by the last reference
+  {
+    String heap{U"another one, which is long enough for the heap"};
+    SharedString first = move(heap).share();
+    SharedString second = first;
+    EXPECT_EQ(second.references(), 2);
+  }
+
+  String small{U"tiny"};
+  SharedString sharedSmall = small.share();
+  EXPECT_TRUE(sharedSmall == U"tiny");
+  EXPECT_TRUE(small == U"tiny");
+  EXPECT_TRUE(move(sharedSmall).toString() == U"tiny");
+}
+
+TEST(SharedStringTests, Concurrent) {
+  constexpr size_t THREADS_COUNT = 8;
+  constexpr size_t COPIES_COUNT = 10000;
+
+  SharedString string{U"shared between threads"};
+  std::vector<std::thread> threads;
+
+  for (size_t thread = 0; thread < THREADS_COUNT; ++thread) {
+    threads.emplace_back([string]() {
+      for (size_t i = 0; i < COPIES_COUNT; ++i) {
+        SharedString copy = string;
+        EXPECT_EQ(copy.length(), 22);
+      }
+    });
+  }
+
+  for (std::thread& thread : threads)
+    thread.join();
+
+  EXPECT_EQ(string.references(), 1);
+}
@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+
+#include <rh/Container.hpp>
+#include <rh/HashMap.hpp>
+#include <rh/SlotMap.hpp>
+#include <rh/String.hpp>
+
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+// Counts live objects, and isn't relocatable, because it remembers its own address
+struct Tracked {
+  static inline int alive = 0;
+
+  int value = 0;
+  const Tracked* self = this;
+
+  Tracked() noexcept { ++alive; }
+  Tracked(int value) noexcept : value(value) { ++alive; }
+  Tracked(Tracked const& other) noexcept : value(other.value) { ++alive; }
+  Tracked(Tracked&& other) noexcept : value(other.value) { other.value = -1; ++alive; }
+
+  Tracked& operator=(Tracked const& other) noexcept {
+    value = other.value;
+    return *this;
+  }
+
+  Tracked& operator=(Tracked&& other) noexcept {
+    value = other.value;
+    other.value = -1;
+    return *this;
+  }
+
+  ~Tracked() {
+    EXPECT_EQ(self, this);
+    --alive;
+  }
+};
+
+}
+
+static_assert(rh::ConstContainer<rh::SlotMap<int>, int>);
+static_assert(sizeof(rh::SlotHandle) == 8);
+static_assert(rh::is_trivially_relocatable<rh::SlotMap<Tracked>>);
+
+TEST(SlotMapTests, Basics) {
+  rh::SlotMap<String> map;
+
+  EXPECT_TRUE(map.isEmpty());
+  EXPECT_FALSE(map.contains(rh::SlotHandle{}));
+  EXPECT_FALSE(map.erase(rh::SlotHandle{}));
+
+  rh::SlotHandle first  = map.insert(String(U"first"));
+  rh::SlotHandle second = map.emplace(U"second");
+  rh::SlotHandle third  = map.emplace(100, U'x');
+
+  EXPECT_EQ(map.length(), 3);
+  EXPECT_EQ(map.at(first), U"first");
+  EXPECT_EQ(*map.find(second), U"second");
+  EXPECT_EQ(map.at(third).length(), 100);
+
+  // last item moves into the hole, handles stay valid
+  EXPECT_TRUE(map.erase(first));
+  EXPECT_FALSE(map.erase(first));
+  EXPECT_EQ(map.find(first), nullptr);
+  EXPECT_THROW(static_cast<void>(map.at(first)), rh::KeyError);
+  EXPECT_EQ(map[0].length(), 100);
+  EXPECT_EQ(map.at(second), U"second");
+  EXPECT_EQ(map.handleAt(0), third);
+
+  // slot is reused, old handle is still stale
+  rh::SlotHandle fourth = map.emplace(U"fourth");
+  EXPECT_EQ(fourth.index, first.index);
+  EXPECT_NE(fourth, first);
+  EXPECT_FALSE(map.contains(first));
+
+  rh::SlotMap<String> const& constant = map;
+  EXPECT_EQ(constant.at(fourth), U"fourth");
+
+  size_t total = 0;
+
+  for (String const& string : constant)
+    total += string.length();
+
+  EXPECT_EQ(total, 100 + 6 + 6);
+
+  map.clear();
+  EXPECT_TRUE(map.isEmpty());
+  EXPECT_FALSE(map.contains(second));
+  EXPECT_FALSE(map.contains(fourth));
+
+  // handles work as hash keys
+  rh::HashMap<rh::SlotHandle, int> names;
+  names.set(map.emplace(U"a"), 1);
+  names.set(map.emplace(U"b"), 2);
+  EXPECT_EQ(names.at(map.handleAt(1)), 2);
+}
+
+TEST(SlotMapTests, Churn) {
+  {
+    std::mt19937 random(17);
+
+    rh::SlotMap<Tracked> map;
+    std::unordered_map<uint64_t, int> expected;
+    std::vector<rh::SlotHandle> handles;
+    std::vector<rh::SlotHandle> stale;
+
+    for (int step = 0; step < 200000; ++step) {
+      if (handles.empty() || random() % 5 < 3) {
+        rh::SlotHandle handle = map.emplace(step);
+
+        handles.push_back(handle);
+        expected[static_cast<uint64_t>(handle.generation) << 32 | handle.index] = step;
+      }
+      else {
+        size_t index = random() % handles.size();
+        rh::SlotHandle handle = handles[index];
+
+        ASSERT_TRUE(map.erase(handle));
+
+        handles[index] = handles.back();
+        handles.pop_back();
+        stale.push_back(handle);
+        expected.erase(static_cast<uint64_t>(handle.generation) << 32 | handle.index);
+      }
+    }
+
+    ASSERT_EQ(map.length(), expected.size());
+
+    for (rh::SlotHandle handle : handles)
+      ASSERT_EQ(map.at(handle).value, expected.at(static_cast<uint64_t>(handle.generation) << 32 | handle.index));
+
+    for (rh::SlotHandle handle : stale)
+      ASSERT_FALSE(map.contains(handle));
+
+    // dense items and their handles agree
+    for (size_t i = 0; i < map.length(); ++i)
+      ASSERT_EQ(map.find(map.handleAt(i)), &map[i]);
+
+    rh::SlotMap<Tracked> copy = map;
+    EXPECT_EQ(copy.at(handles[0]).value, map.at(handles[0]).value);
+
+    rh::SlotMap<Tracked> moved = rh::move(copy);
+    EXPECT_EQ(moved.length(), map.length());
+  }
+
+  EXPECT_EQ(Tracked::alive, 0);
+}
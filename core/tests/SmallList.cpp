@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+
+#include <rh/SmallList.hpp>
+#include <rh/String.hpp>
+
+#include <vector>
+
+namespace {
+
+// Counts live objects, and isn't relocatable, because it remembers its own address
+struct Tracked {
+  static inline int alive = 0;
+
+  int value = 0;
+  const Tracked* self = this;
+
+  Tracked() noexcept { ++alive; }
+  Tracked(int value) noexcept : value(value) { ++alive; }
+  Tracked(Tracked const& other) noexcept : value(other.value) { ++alive; }
+  Tracked(Tracked&& other) noexcept : value(other.value) { other.value = -1; ++alive; }
+
+  Tracked& operator=(Tracked const& other) noexcept {
+    value = other.value;
+    return *this;
+  }
+
+  Tracked& operator=(Tracked&& other) noexcept {
+    value = other.value;
+    other.value = -1;
+    return *this;
+  }
+
+  ~Tracked() {
+    EXPECT_EQ(self, this);
+    --alive;
+  }
+};
+
+struct CountingAllocator {
+  static inline size_t allocations = 0;
+
+  static void* allocate(size_t size, size_t alignment) {
+    ++allocations;
+    return DefaultAllocator::allocate(size, alignment);
+  }
+
+  static void deallocate(void* pointer, size_t size, size_t alignment) noexcept {
+    DefaultAllocator::deallocate(pointer, size, alignment);
+  }
+};
+
+template <typename ListT>
+std::vector<int> values(ListT const& list) {
+  std::vector<int> result;
+
+  for (auto const& item : list) {
+    if constexpr (requires { item.value; })
+      result.push_back(item.value);
+    else if constexpr (requires { item.length(); })
+      result.push_back(static_cast<int>(item.length())); // String(n) has length n
+    else
+      result.push_back(item);
+  }
+
+  return result;
+}
+
+template <typename T>
+void checkEditing() {
+  rh::SmallList<T, 4> list;
+
+  list.append(T(1));
+  list.append(T(2));
+  list.insert(0, T(0));
+  list.emplace(-1, 3);
+
+  EXPECT_EQ(values(list), (std::vector<int>{0, 1, 3, 2}));
+  EXPECT_EQ(list.capacity(), 4);
+
+  // spills to the heap, items of the list itself are safe to add
+  list.append(list[0]);
+  list.insert(2, list[1]);
+
+  EXPECT_EQ(values(list), (std::vector<int>{0, 1, 1, 3, 2, 0}));
+  EXPECT_GT(list.capacity(), 4);
+
+  rh::SmallList<T, 4> heap_copy = list;
+
+  list.erase(1, 3);
+  list.erase(-1);
+
+  EXPECT_EQ(values(list), (std::vector<int>{0, 2}));
+  EXPECT_THROW(list.erase(2), rh::IndexError);
+  EXPECT_THROW(list.erase(1, 2), rh::IndexError);
+  EXPECT_THROW(list.insert(3, T(0)), rh::IndexError);
+
+  // comes back inline
+  list.shrinkToFit();
+  EXPECT_EQ(list.capacity(), 4);
+  EXPECT_EQ(values(list), (std::vector<int>{0, 2}));
+
+  // inline and heap moves
+  rh::SmallList<T, 4> inline_moved = rh::move(list);
+  rh::SmallList<T, 4> heap_moved = rh::move(heap_copy);
+
+  EXPECT_TRUE(list.isEmpty());
+  EXPECT_TRUE(heap_copy.isEmpty());
+  EXPECT_EQ(values(inline_moved), (std::vector<int>{0, 2}));
+  EXPECT_EQ(values(heap_moved), (std::vector<int>{0, 1, 1, 3, 2, 0}));
+
+  heap_moved = rh::move(inline_moved);
+  EXPECT_EQ(values(heap_moved), (std::vector<int>{0, 2}));
+
+  heap_moved.resize(10);
+  EXPECT_EQ(heap_moved.length(), 10);
+  heap_moved.resize(1);
+  EXPECT_EQ(values(heap_moved), (std::vector<int>{0}));
+}
+
+}
+
+static_assert(rh::is_trivially_relocatable<rh::SmallList<int, 4>>);
+static_assert(rh::is_trivially_relocatable<rh::SmallList<String, 2>>);
+static_assert(!rh::is_trivially_relocatable<rh::SmallList<Tracked, 4>>);
+
+TEST(SmallListTests, Editing) {
+  checkEditing<int>();
+  checkEditing<Tracked>();
+  checkEditing<String>();
+
+  EXPECT_EQ(Tracked::alive, 0);
+}
+
+TEST(SmallListTests, NoAllocationsWhileInline) {
+  CountingAllocator::allocations = 0;
+
+  for (int round = 0; round < 1000; ++round) {
+    rh::SmallList<int, 8, CountingAllocator> list;
+
+    for (int i = 0; i < 8; ++i)
+      list.append(i);
+
+    EXPECT_EQ(list[7], 7);
+  }
+
+  EXPECT_EQ(CountingAllocator::allocations, 0);
+
+  rh::SmallList<int, 8, CountingAllocator> list;
+
+  for (int i = 0; i < 100; ++i)
+    list.append(i);
+
+  EXPECT_GT(CountingAllocator::allocations, 0);
+  EXPECT_EQ(values(list)[99], 99);
+}
@@ -0,0 +1,195 @@
+#include <gtest/gtest.h>
+
+#include <rh/Container.hpp>
+#include <rh/SoaList.hpp>
+#include <rh/String.hpp>
+#include <rh/exceptions.hpp>
+
+#include <vector>
+
+namespace {
+
+// Counts live objects, and isn't relocatable, because it remembers its own address
+struct Tracked {
+  static inline int alive = 0;
+
+  int value = 0;
+  const Tracked* self = this;
+
+  Tracked() noexcept { ++alive; }
+  Tracked(int value) noexcept : value(value) { ++alive; }
+  Tracked(Tracked const& other) noexcept : value(other.value) { ++alive; }
+  Tracked(Tracked&& other) noexcept : value(other.value) { other.value = -1; ++alive; }
+
+  Tracked& operator=(Tracked const& other) noexcept {
+    value = other.value;
+    return *this;
+  }
+
+  Tracked& operator=(Tracked&& other) noexcept {
+    value = other.value;
+    other.value = -1;
+    return *this;
+  }
+
+  ~Tracked() {
+    EXPECT_EQ(self, this);
+    --alive;
+  }
+};
+
+template <typename ColumnT>
+std::vector<int> values(ColumnT const& column) {
+  std::vector<int> result;
+
+  for (auto const& item : column) {
+    if constexpr (requires { item.value; })
+      result.push_back(item.value);
+    else
+      result.push_back(static_cast<int>(item));
+  }
+
+  return result;
+}
+
+bool isAligned(const void* pointer) {
+  return reinterpret_cast<uintptr_t>(pointer) % 64 == 0;
+}
+
+template <typename ListT>
+concept AssignableThroughRow = requires(ListT& list) { list[0].template get<1>() = 1.0; };
+
+}
+
+static_assert(rh::ConstContainer<rh::Span<int>, int> && rh::Container<rh::List<int>, int>);
+static_assert(rh::is_same_type<rh::SoaList<int, double>::field_type<1>, double>);
+static_assert(rh::is_trivially_relocatable<rh::SoaList<String, Tracked>>);
+
+// rows of a const list can be read but not assigned through
+static_assert(AssignableThroughRow<rh::SoaList<int, double>>);
+static_assert(!AssignableThroughRow<rh::SoaList<int, double> const>);
+static_assert(rh::is_same_type<decltype(std::declval<rh::SoaList<int, double> const&>()[0].get<0>()), int const&>);
+
+TEST(SoaListTests, Basics) {
+  rh::SoaList<float, double, int> list;
+
+  EXPECT_TRUE(list.isEmpty());
+  EXPECT_TRUE(list.column<0>().isEmpty());
+
+  for (int i = 0; i < 100; ++i)
+    list.append(i * 0.5f, i * 2.0, i);
+
+  ASSERT_EQ(list.length(), 100);
+  EXPECT_EQ(list.column<2>().length(), 100);
+  EXPECT_EQ(list.column<1>()[10], 20.0);
+
+  // every column starts on its own cache line
+  EXPECT_TRUE(isAligned(list.column<0>().data()));
+  EXPECT_TRUE(isAligned(list.column<1>().data()));
+  EXPECT_TRUE(isAligned(list.column<2>().data()));
+
+  // column-wise sweep
+  for (auto& value : list.column<0>())
+    value += 1.0f;
+
+  auto row = list[3];
+  EXPECT_EQ(row.get<0>(), 2.5f);
+  EXPECT_EQ(row.index(), 3);
+
+  row.get<2>() = -3;
+  EXPECT_EQ(list.column<2>()[3], -3);
+
+  int sum = 0;
+
+  for (auto current : list)
+    sum += current.get<2>();
+
+  EXPECT_EQ(sum, 4950 - 6);
+
+  rh::SoaList<float, double, int> const& constant = list;
+  EXPECT_EQ(constant[99].get<1>(), 198.0);
+  EXPECT_EQ((*constant.begin()).get<2>(), 0);
+
+  size_t capacity = list.capacity();
+
+  list.clear();
+  EXPECT_TRUE(list.isEmpty());
+  EXPECT_EQ(list.capacity(), capacity); // keeps storage, like List
+
+  list.shrinkToFit();
+  EXPECT_EQ(list.capacity(), 0);
+}
+
+TEST(SoaListTests, ListSemantics) {
+  rh::SoaList<int, Tracked> list;
+
+  for (int i = 0; i < 5; ++i)
+    list.append(i, i * 10);
+
+  list.insert(0, -1, -10);
+  list.insert(-1, 100, 1000);
+  list.insert(7, 200, 2000);
+
+  EXPECT_EQ(values(list.column<0>()), (std::vector<int>{-1, 0, 1, 2, 3, 100, 4, 200}));
+  EXPECT_EQ(values(list.column<1>()), (std::vector<int>{-10, 0, 10, 20, 30, 1000, 40, 2000}));
+
+  list.erase(1, 2);
+  list.erase(-1);
+
+  EXPECT_EQ(values(list.column<0>()), (std::vector<int>{-1, 2, 3, 100, 4}));
+  EXPECT_EQ(values(list.column<1>()), (std::vector<int>{-10, 20, 30, 1000, 40}));
+
+  EXPECT_THROW(list.insert(6, 0, 0), rh::IndexError);
+  EXPECT_THROW(list.erase(5), rh::IndexError);
+  EXPECT_THROW(list.erase(0, 6), rh::IndexError);
+
+  list.resize(8);
+  EXPECT_EQ(values(list.column<0>()), (std::vector<int>{-1, 2, 3, 100, 4, 0, 0, 0}));
+  EXPECT_EQ(values(list.column<1>()), (std::vector<int>{-10, 20, 30, 1000, 40, 0, 0, 0}));
+
+  list.resize(2);
+  EXPECT_EQ(values(list.column<1>()), (std::vector<int>{-10, 20}));
+
+  // values from this list survive growing it
+  list.shrinkToFit();
+  list.append(list.column<0>()[1], list.column<1>()[1]);
+  EXPECT_EQ(values(list.column<1>()), (std::vector<int>{-10, 20, 20}));
+
+  list.clear();
+  EXPECT_EQ(Tracked::alive, 0);
+}
+
+TEST(SoaListTests, CopyAndMove) {
+  {
+    rh::SoaList<String, Tracked, char> list;
+
+    list.reserve(10);
+    size_t capacity = list.capacity();
+
+    for (int i = 0; i < 10; ++i)
+      list.append(String(static_cast<size_t>(i * 10), U'a'), i, static_cast<char>('a' + i));
+
+    EXPECT_EQ(list.capacity(), capacity);
+
+    for (int i = 10; i < 1000; ++i)
+      list.append(String(U"short"), i, 'z');
+
+    rh::SoaList<String, Tracked, char> copy = list;
+    EXPECT_EQ(values(copy.column<1>()), values(list.column<1>()));
+    EXPECT_EQ(copy[5].get<0>().length(), 50);
+
+    rh::SoaList<String, Tracked, char> moved = rh::move(copy);
+    EXPECT_TRUE(copy.isEmpty());
+    EXPECT_EQ(moved.length(), 1000);
+
+    copy = moved;
+    moved = rh::move(list);
+    EXPECT_EQ(copy[999].get<2>(), 'z');
+    EXPECT_EQ(moved[9].get<2>(), 'j');
+
+    moved.erase(0, 500);
+    EXPECT_EQ(moved[0].get<1>().value, 500);
+  }
+
+  EXPECT_EQ(Tracked::alive, 0);
+}
@@ -1,6 +1,10 @@
 #include <gtest/gtest.h>
 
+#include <rh/Container.hpp>
 #include <rh/String.hpp>
+#include <rh/StringBuilder.hpp>
+
+#include <vector>
 
 TEST(CoreTests, StringView) {
   // Constructors
@@ -38,3 +42,450 @@ TEST(CoreTests, StringView) {
   EXPECT_TRUE(fromPtr.startsWith(String{U"Hello"}));
   EXPECT_TRUE(fromPtr.startsWith(StringView{U"Hello"}));
 }
+
+TEST(CoreTests, StringViewSlices) {
+  std::u32string_view stlView = U"Hello, World!";
+  StringView fromStlView = stlView.substr(0, 5);
+  EXPECT_EQ(fromStlView.length(), 5);
+  EXPECT_TRUE(fromStlView == U"Hello");
+
+  StringView view = U"Hello, World!";
+  StringView world = view.subView(7, 5);
+  EXPECT_EQ(world.length(), 5);
+  EXPECT_EQ(world.data(), view.data() + 7);
+  EXPECT_TRUE(world == U"World");
+  EXPECT_FALSE(world == U"World!");
+  EXPECT_TRUE(view.subView(7) == U"World!");
+  EXPECT_TRUE(view.subView(100).isEmpty());
+  EXPECT_EQ(view.find(U'W'), 7);
+  EXPECT_TRUE(view.endsWith(U"!"));
+  EXPECT_FALSE(world.endsWith(U"!"));
+
+  std::u32string_view worldStl = world;
+  EXPECT_EQ(worldStl, U"World");
+}
+
+TEST(CoreTests, StringLength) {
+  String string;
+  EXPECT_TRUE(string.isEmpty());
+  EXPECT_EQ(string.length(), 0);
+
+  for (size_t i = 0; i < 1000; ++i)
+    string.push(U'a' + (i % 26));
+
+  EXPECT_EQ(string.length(), 1000);
+  EXPECT_EQ(string.end() - string.begin(), 1000);
+  EXPECT_EQ(string[1000], 0);
+
+  string.append(U"xyz");
+  EXPECT_EQ(string.length(), 1003);
+  EXPECT_TRUE(string.endsWith(U"xyz"));
+  EXPECT_EQ(string.pop(), U'z');
+  EXPECT_EQ(string.length(), 1002);
+
+  string.erase(string.begin(), 2);
+  EXPECT_EQ(string.length(), 1000);
+  EXPECT_TRUE(string.startsWith(U"cd"));
+
+  string.insert(0, U"ab");
+  EXPECT_EQ(string.length(), 1002);
+  EXPECT_TRUE(string.startsWith(U"abcd"));
+
+  String filled(3, U'x');
+  EXPECT_EQ(filled.length(), 3);
+  EXPECT_TRUE(filled == U"xxx");
+
+  String copied = StringView{U"Hello, World!"}.subView(0, 5);
+  EXPECT_EQ(copied.length(), 5);
+  EXPECT_TRUE(copied == U"Hello");
+  EXPECT_FALSE(copied == U"Hello, World!");
+
+  string.clear();
+  EXPECT_TRUE(string.isEmpty());
+  string.shrinkToFit();
+  EXPECT_EQ(string.capacity(), String::INLINE_CAPACITY);
+}
+
+static constexpr bool isStoredInside(String const& string) {
+  return string.capacity() == String::INLINE_CAPACITY;
+}
+
+static_assert([] {
+  String string{U"key"};
+  string.append(U" that definitely doesn't fit inline");
+  string.erase(3, string.length() - 3);
+  string.shrinkToFit();
+  return string == U"key" && isStoredInside(string);
+}());
+
+TEST(CoreTests, StringInlineStorage) {
+  constexpr size_t maxInline = String::INLINE_CAPACITY - 1;
+
+  String empty;
+  EXPECT_TRUE(isStoredInside(empty));
+  EXPECT_NE(empty.data(), nullptr);
+  EXPECT_EQ(empty.data()[0], 0);
+
+  String small{U"id"};
+  EXPECT_TRUE(isStoredInside(small));
+
+  String full(maxInline, U'a');
+  EXPECT_TRUE(isStoredInside(full));
+  EXPECT_EQ(full.length(), maxInline);
+
+  // inline -> heap
+  full.push(U'b');
+  EXPECT_FALSE(isStoredInside(full));
+  EXPECT_EQ(full.length(), maxInline + 1);
+  EXPECT_EQ(full[maxInline], U'b');
+  EXPECT_EQ(full[maxInline + 1], 0);
+
+  // heap -> inline
+  full.pop();
+  full.shrinkToFit();
+  EXPECT_TRUE(isStoredInside(full));
+  EXPECT_TRUE(full == String(maxInline, U'a'));
+
+  // reserve spills only past inline capacity
+  String reserved;
+  reserved.reserve(String::INLINE_CAPACITY);
+  EXPECT_TRUE(isStoredInside(reserved));
+  reserved.reserve(String::INLINE_CAPACITY + 1);
+  EXPECT_FALSE(isStoredInside(reserved));
+  EXPECT_TRUE(reserved.isEmpty());
+
+  // moving inline string copies characters
+  String movedSmall = rh::move(small);
+  EXPECT_TRUE(movedSmall == U"id");
+  EXPECT_TRUE(small.isEmpty());
+  EXPECT_TRUE(isStoredInside(small));
+
+  // moving heap string steals the buffer
+  String big(100, U'z');
+  const char32_t* bigData = big.data();
+  String movedBig = rh::move(big);
+  EXPECT_EQ(movedBig.data(), bigData);
+  EXPECT_EQ(movedBig.length(), 100);
+  EXPECT_TRUE(big.isEmpty());
+  EXPECT_TRUE(isStoredInside(big));
+
+  // move-assign over heap and inline strings
+  movedSmall = rh::move(movedBig);
+  EXPECT_EQ(movedSmall.length(), 100);
+  movedSmall = String{U"x"};
+  EXPECT_TRUE(movedSmall == U"x");
+  EXPECT_TRUE(isStoredInside(movedSmall));
+}
+
+TEST(CoreTests, StringUtilsVectorMatchesScalar) {
+  using Utils = rh::_Hidden::StringUtils;
+
+  constexpr size_t maxLength = 80;
+  constexpr size_t maxOffset = 16;
+
+  char32_t buffer[maxOffset + maxLength + 1];
+  char32_t other[maxOffset + maxLength + 1];
+
+  for (size_t offset = 0; offset < maxOffset; ++offset) {
+    for (size_t length = 0; length <= maxLength; ++length) {
+      char32_t* string = buffer + offset;
+
+      for (size_t i = 0; i < length; ++i)
+        string[i] = U'a' + (i % 23);
+      string[length] = 0;
+
+      EXPECT_EQ(Utils::length(string), Utils::lengthScalar(string));
+      EXPECT_EQ(Utils::length(string), length);
+
+      for (char32_t character : { U'a', U'w', U'z', char32_t(0) }) {
+        EXPECT_EQ(
+          Utils::find(string, length, character),
+          Utils::findScalar(string, length, character)
+        );
+      }
+
+      if (length > 0) {
+        string[length - 1] = U'#';
+        EXPECT_EQ(Utils::find(string, length, U'#'), length - 1);
+      }
+
+      char32_t* sub = other + (maxOffset - 1 - offset);
+      for (size_t i = 0; i < length; ++i)
+        sub[i] = string[i];
+
+      EXPECT_TRUE(Utils::isSubStringEqual(string, 0, sub, length));
+
+      for (size_t i = 0; i < length; ++i) {
+        sub[i] = U'!';
+        EXPECT_FALSE(Utils::isSubStringEqual(string, 0, sub, length));
+        EXPECT_EQ(
+          Utils::isSubStringEqual(string, 0, sub, i),
+          Utils::isSubStringEqualScalar(string, 0, sub, i)
+        );
+        sub[i] = string[i];
+      }
+    }
+  }
+}
+
+static_assert(StringView{U"Hello, World!"}.find(U"World", 5) == 7);
+static_assert(StringView{U"Hello, World!"}.find(U"World!", 6) == 7);
+static_assert(StringView{U"Hello, World!"}.find(U"Worlds", 6) == -1);
+
+TEST(CoreTests, StringFind) {
+  StringView hello = U"Hello, World!";
+  EXPECT_EQ(hello.find(U"Hello"), 0);
+  EXPECT_EQ(hello.find(U"World!"), 7);
+  EXPECT_EQ(hello.find(U"Hello, World!"), 0);
+  EXPECT_EQ(hello.find(U"Hello, World?"), -1);
+  EXPECT_EQ(hello.find(U""), 0);
+  EXPECT_TRUE(String{hello}.contains(U"o, W"));
+  EXPECT_FALSE(String{hello}.contains(U"o,W"));
+
+  // compare with STL on small alphabets, where partial matches are frequent
+  uint32_t seed = 12345;
+  auto random = [&seed](uint32_t bound) {
+    seed = seed * 1103515245 + 12345;
+    return (seed >> 16) % bound;
+  };
+
+  for (size_t iteration = 0; iteration < 2000; ++iteration) {
+    uint32_t alphabet = 2 + random(3);
+
+    std::u32string haystack(random(400), U'a');
+    for (auto& character : haystack)
+      character = U'a' + random(alphabet);
+
+    std::u32string needle(1 + random(80), U'a');
+    for (auto& character : needle)
+      character = U'a' + random(alphabet);
+
+    // sometimes plant the needle
+    if (random(2) && needle.length() <= haystack.length())
+      haystack.replace(random(haystack.length() - needle.length() + 1), needle.length(), needle);
+
+    ssize_t expected = static_cast<ssize_t>(std::u32string_view{haystack}.find(needle));
+
+    EXPECT_EQ(StringView{haystack}.find(needle), expected);
+    EXPECT_EQ(Searcher{needle}.find(haystack), expected);
+  }
+
+  // periodic long needle
+  std::u32string periodic;
+  for (size_t i = 0; i < 20; ++i)
+    periodic += U"abcab";
+
+  std::u32string text = U"x";
+  for (size_t i = 0; i < 100; ++i)
+    text += U"abcab";
+  text += U"y";
+
+  EXPECT_EQ(StringView{text}.find(periodic), 1);
+  EXPECT_EQ(StringView{text}.find(periodic + U"y"), 1 + 80 * 5);
+  EXPECT_EQ(StringView{text}.find(U"y" + periodic), -1);
+}
+
+TEST(CoreTests, Searcher) {
+  String needle{U"needle that is definitely longer than a short one"};
+  Searcher searcher{needle};
+
+  EXPECT_EQ(searcher.needle(), needle);
+
+  String haystack(1000, U'n');
+  EXPECT_FALSE(searcher.contains(haystack));
+
+  haystack.insert(500, needle);
+  EXPECT_EQ(searcher.find(haystack), 500);
+  EXPECT_EQ(searcher.find(StringView{haystack}.subView(501)), -1);
+
+  Searcher short_searcher{U"ne"};
+  EXPECT_EQ(short_searcher.find(haystack), 500);
+}
+
+static_assert((StringView{U"a"} + U"b" + U"c").length() == 3);
+
+template <typename RangeT>
+static std::vector<std::u32string> collect(RangeT const& range) {
+  std::vector<std::u32string> result;
+
+  for (StringView piece : range)
+    result.emplace_back(piece.data(), piece.length());
+
+  return result;
+}
+
+static_assert(rh::Iterable<decltype(StringView{}.split(U','))>);
+static_assert(rh::Iterable<decltype(StringView{}.lines())>);
+static_assert(StringView{U"a,b,,c"}.split(U',').count() == 4);
+static_assert(StringView{U"  padded\t\n"}.trim() == U"padded");
+
+TEST(CoreTests, StringViewSplit) {
+  using Pieces = std::vector<std::u32string>;
+
+  EXPECT_EQ(collect(StringView{U"a,,b,"}.split(U',')), (Pieces{U"a", U"", U"b", U""}));
+  EXPECT_EQ(collect(StringView{U""}.split(U',')), (Pieces{U""}));
+  EXPECT_EQ(collect(StringView{U"no delimiters"}.split(U',')), (Pieces{U"no delimiters"}));
+
+  EXPECT_EQ(collect(StringView{U"one::two:three::"}.split(U"::")), (Pieces{U"one", U"two:three", U""}));
+  EXPECT_EQ(collect(StringView{U"abc"}.split(U"")), (Pieces{U"abc"}));
+
+  EXPECT_EQ(collect(StringView{U"key=value; other = 2"}.splitAny(U"=; ")), (Pieces{U"key", U"value", U"", U"other", U"", U"", U"2"}));
+
+  EXPECT_EQ(collect(StringView{U"first\r\nsecond\n\nlast"}.lines()), (Pieces{U"first", U"second", U"", U"last"}));
+  EXPECT_EQ(collect(StringView{U"ends with break\n"}.lines()), (Pieces{U"ends with break"}));
+  EXPECT_EQ(collect(StringView{U""}.lines()), Pieces{});
+  EXPECT_EQ(collect(StringView{U"\n"}.lines()), (Pieces{U""}));
+
+  EXPECT_EQ(StringView{U" \t x y \r\n"}.trim(), U"x y");
+  EXPECT_EQ(StringView{U"  x "}.trimStart(), U"x ");
+  EXPECT_EQ(StringView{U"  x "}.trimEnd(), U"  x");
+  EXPECT_EQ(StringView{U"   "}.trim(), U"");
+
+  // pieces point into the original buffer
+  String csv{U"10,20,30"};
+  StringView view = csv;
+  const char32_t* expected = csv.data();
+
+  for (StringView piece : view.split(U',')) {
+    EXPECT_EQ(piece.data(), expected);
+    expected += piece.length() + 1;
+  }
+
+  // CSV-like records: lines, then fields
+  String table{U"name, age\r\nalice, 30\r\nbob, 25\r\n"};
+  Pieces ages;
+
+  for (StringView line : StringView{table}.lines()) {
+    size_t column = 0;
+
+    for (StringView field : line.split(U',')) {
+      if (column++ == 1)
+        ages.emplace_back(field.trim().data(), field.trim().length());
+    }
+  }
+
+  EXPECT_EQ(ages, (Pieces{U"age", U"30", U"25"}));
+}
+
+TEST(CoreTests, StringUtilsFindAnyVectorMatchesScalar) {
+  using Utils = rh::_Hidden::StringUtils;
+
+  char32_t string[100];
+  for (size_t index = 0; index < 100; ++index)
+    string[index] = U'a' + index % 20;
+
+  const char32_t set[] = U"xyz;tq,p";
+
+  for (size_t length = 0; length <= 100; ++length) {
+    for (size_t set_length = 0; set_length <= 8; ++set_length) {
+      EXPECT_EQ(
+        Utils::findAny(string, length, set, set_length),
+        Utils::findAnyScalar(string, length, set, set_length)
+      );
+    }
+  }
+}
+
+TEST(CoreTests, StringConcat) {
+  String first{U"first"};
+  StringView second = U", second";
+  String third{U", third"};
+
+  auto lazy = first + second + third + U"!";
+  EXPECT_EQ(lazy.length(), 21);
+
+  String joined = lazy;
+  EXPECT_TRUE(joined == U"first, second, third!");
+  EXPECT_EQ(joined.capacity(), 22);
+
+  String grouped = (first + second) + (third + U"!");
+  EXPECT_TRUE(grouped == joined);
+  EXPECT_TRUE(U">" + (first + U"<") == U">first<");
+
+  String assigned;
+  assigned = first + U"+" + first;
+  EXPECT_TRUE(assigned == U"first+first");
+
+  assigned += second + third;
+  EXPECT_TRUE(assigned == U"first+first, second, third");
+}
+
+TEST(CoreTests, StringConcatAliasing) {
+  // operands view the destination, which grows under them
+  String string{U"abc"};
+  string += string + U"!";
+  EXPECT_TRUE(string == U"abcabc!");
+
+  string += U"<" + string + U">" + string;
+  EXPECT_TRUE(string == U"abcabc!<abcabc!>abcabc!");
+
+  String heap(100, U'x');
+  heap += heap + heap;
+  EXPECT_EQ(heap.length(), 300);
+  EXPECT_EQ(heap.find(U'y'), -1);
+
+  // part of itself
+  String part{U"0123456789"};
+  part.append(StringView{part}.subView(2, 3));
+  part.append(part);
+  EXPECT_TRUE(part == U"0123456789234" U"0123456789234");
+
+  StringBuilder builder;
+  builder.append(U"ab");
+
+  for (int i = 0; i < 6; ++i)
+    builder.append(builder.view());
+
+  EXPECT_EQ(builder.length(), 128);
+  EXPECT_TRUE(builder.view().startsWith(U"abab"));
+
+  builder.append(builder.view().subView(0, 2) + U"!" + builder.view());
+  EXPECT_EQ(builder.length(), 128 * 2 + 3);
+  EXPECT_TRUE(builder.view().endsWith(U"ab"));
+  EXPECT_EQ(builder.view()[130], U'!');
+
+  constexpr bool is_constant = [] {
+    String string{U"ab"};
+    string += string + string;
+    string.append(string);
+    return string == U"abababababab";
+  }();
+  EXPECT_TRUE(is_constant);
+}
+
+TEST(CoreTests, StringOrder) {
+  StringView apple = U"apple";
+  String apricot{U"apricot"};
+
+  EXPECT_LT(apple.compare(U"apricot"), 0);
+  EXPECT_GT(apricot.compare(apple), 0);
+  EXPECT_EQ(apple.compare(String(U"apple")), 0);
+
+  // prefix goes first, code units are compared as unsigned
+  EXPECT_TRUE(StringView{U"app"} < apple);
+  EXPECT_FALSE(apple < U"app");
+  EXPECT_TRUE(apple < apricot);
+  EXPECT_TRUE(apricot < U"b");
+  EXPECT_TRUE(rh::BasicStringView<char>{"z"} < rh::BasicStringView<char>{"\xC3\xA9"});
+}
+
+TEST(CoreTests, StringBuilder) {
+  StringBuilder builder;
+  EXPECT_TRUE(builder.isEmpty());
+
+  for (size_t i = 0; i < 1000; ++i)
+    builder.append(U"ab").append(U'c');
+
+  builder.append(StringView{U"x"} + U"yz");
+  builder.append(2, U'!');
+
+  EXPECT_EQ(builder.length(), 3005);
+  EXPECT_TRUE(builder.view().endsWith(U"cxyz!!"));
+
+  const char32_t* data = builder.view().data();
+  String built = builder.build();
+
+  EXPECT_EQ(built.data(), data);
+  EXPECT_EQ(built.length(), 3005);
+  EXPECT_TRUE(builder.isEmpty());
+}
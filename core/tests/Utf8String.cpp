@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+
+#include <rh/Utf8String.hpp>
+
+static_assert(utf8::isValid(u8"Привет, мир!"));
+static_assert(!utf8::isValid(Utf8StringView{u8"\xC0\xAF"}));
+static_assert(utf8::countCodePoints(u8"Привет") == 6);
+
+TEST(Utf8Tests, MemberSurface) {
+  Utf8String string{u8"Hello"};
+  string.append(u8", World!");
+
+  EXPECT_EQ(string.length(), 13);
+  EXPECT_TRUE(string.startsWith(u8"Hello"));
+  EXPECT_TRUE(string.endsWith(u8"World!"));
+  EXPECT_EQ(string.find(u8"World"), 7);
+  EXPECT_EQ(string.find(u8'!'), 12);
+  EXPECT_TRUE(Utf8StringView{string}.subView(7, 5) == u8"World");
+}
+
+TEST(Utf8Tests, Validation) {
+  EXPECT_TRUE(utf8::isValid(u8""));
+  EXPECT_TRUE(utf8::isValid(u8"plain ascii text which is longer than a block"));
+  EXPECT_TRUE(utf8::isValid(u8"é€\U0001F600"));
+
+  struct InvalidCase {
+    const char* bytes;
+    ssize_t     invalidIndex;
+  };
+
+  InvalidCase cases[] = {
+    { "\x80",                                0 },     // lone continuation
+    { "abc\xC1\xBF",                         3 },     // overlong 2-byte
+    { "abcd\xE0\x80\x80",                    4 },     // overlong 3-byte
+    { "\xED\xA0\x80",                        0 },     // surrogate
+    { "\xF4\x90\x80\x80",                    0 },     // above U+10FFFF
+    { "\xF5\x80\x80\x80",                    0 },     // invalid lead
+    { "0123456789abcdef0123456789\xE2\x82",  26 },    // truncated after ascii blocks
+  };
+
+  for (auto const& test_case : cases) {
+    Utf8StringView string{reinterpret_cast<const char8_t*>(test_case.bytes)};
+    EXPECT_EQ(utf8::findInvalid(string), test_case.invalidIndex) << test_case.bytes;
+    EXPECT_THROW(utf8::decode(string), rh::EncodingError);
+  }
+}
+
+// Every kind of invalid sequence at every position around SIMD block boundaries,
+//  after ASCII and after multi-byte text
+TEST(Utf8Tests, ValidationAtBlockBoundaries) {
+  struct InvalidCase {
+    const char* bytes;
+    size_t      invalidOffset;
+  };
+
+  InvalidCase invalid[] = {
+    { "\xE2\x82",         0 },  // truncated 3-byte
+    { "\xF0\x9F\x98",     0 },  // truncated 4-byte
+    { "\xC3",             0 },  // truncated 2-byte
+    { "\xC0\x80",         0 },  // overlong 2-byte
+    { "\xE0\x9F\xBF",     0 },  // overlong 3-byte
+    { "\xF0\x8F\xBF\xBF", 0 },  // overlong 4-byte
+    { "\xED\xA0\x80",     0 },  // high surrogate
+    { "\xED\xBF\xBF",     0 },  // low surrogate
+    { "\xF4\x90\x80\x80", 0 },  // above U+10FFFF
+    { "\xF5\x80\x80\x80", 0 },  // invalid lead
+    { "\xFF",             0 },  // invalid lead
+    { "\x80",             0 },  // lone continuation
+    { "\xE2\x82\xAC\xAC", 3 },  // continuation after complete sequence
+  };
+
+  const char8_t* fillers[] = { u8"a", u8"é" };
+
+  for (const char8_t* filler : fillers) {
+    for (auto const& test_case : invalid) {
+      Utf8StringView bad{reinterpret_cast<const char8_t*>(test_case.bytes)};
+
+      for (size_t offset = 0; offset < 40; ++offset) {
+        // valid prefix of about "offset" bytes, so the sequence starts at every byte of a block
+        Utf8String string;
+        while (string.length() + Utf8StringView{filler}.length() <= offset)
+          string.append(filler);
+
+        ssize_t expected = static_cast<ssize_t>(string.length() + test_case.invalidOffset);
+        string.append(bad);
+
+        // at the end, then followed by ASCII and by one more block
+        for (int suffix = 0; suffix < 3; ++suffix) {
+          EXPECT_EQ(utf8::findInvalid(string), expected) << test_case.bytes << " at " << offset;
+
+          string.append(suffix == 0 ? u8"x" : u8"0123456789abcdef");
+        }
+      }
+    }
+  }
+
+  // valid sequences across every boundary
+  const char8_t* valid[] = { u8"é", u8"€", u8"😀", u8"\U0010FFFF", u8"\uD7FF", u8"\uE000" };
+
+  for (const char8_t* sequence : valid) {
+    Utf8String string;
+
+    for (size_t offset = 0; offset < 40; ++offset) {
+      string.append(u8"a");
+
+      Utf8String copy = string;
+      for (int repeat = 0; repeat < 8; ++repeat)
+        copy.append(sequence);
+
+      EXPECT_TRUE(utf8::isValid(copy)) << offset;
+    }
+  }
+}
+
+TEST(Utf8Tests, Transcoding) {
+  StringView text = U"ASCII block of sixteen, then кириллица, € and 😀, then ascii again to the end";
+
+  Utf8String encoded = utf8::encode(text);
+  EXPECT_TRUE(encoded == Utf8StringView{u8"ASCII block of sixteen, then кириллица, € and 😀, then ascii again to the end"});
+  EXPECT_EQ(utf8::countCodePoints(encoded), text.length());
+
+  String decoded = utf8::decode(encoded);
+  EXPECT_TRUE(decoded == text);
+
+  String appended{U">"};
+  utf8::decodeTo(appended, u8"ü");
+  EXPECT_TRUE(appended == U">ü");
+
+  EXPECT_THROW(utf8::encode(StringView{U"\xD800"}), rh::EncodingError);
+
+  // every code point, by chunks
+  String all;
+  for (char32_t code_point = 1; code_point <= 0x10FFFF; ++code_point) {
+    if (code_point < 0xD800 || code_point > 0xDFFF)
+      all.push(code_point);
+  }
+
+  Utf8String allEncoded = utf8::encode(all);
+  EXPECT_TRUE(utf8::isValid(allEncoded));
+  EXPECT_TRUE(utf8::decode(allEncoded) == all);
+}
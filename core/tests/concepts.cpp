@@ -1,8 +1,11 @@
 #include <rh/Array.hpp>
 #include <rh/Container.hpp>
 #include <rh/List.hpp>
+#include <rh/SmallList.hpp>
 
 static_assert(rh::Container<rh::List<int>, int>);
 static_assert(rh::ConstContainer<rh::List<int>, int>);
 static_assert(rh::ConstContainer<rh::List<int> const, int>);
 static_assert(rh::ConstContainer<rh::Array<int, 1>, int>);
+static_assert(rh::Container<rh::SmallList<int, 8>, int>);
+static_assert(rh::ConstContainer<rh::SmallList<int, 8> const, int>);
@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+
+#include <rh/Allocator.hpp>
+#include <rh/format.hpp>
+
+namespace {
+
+struct Point {
+  int x;
+  int y;
+};
+
+}
+
+template <>
+struct rh::Formatter<Point> {
+  static constexpr size_t maxLength(Point const& point) noexcept {
+    return Formatter<int>::maxLength(point.x) + Formatter<int>::maxLength(point.y) + 3;
+  }
+
+  static constexpr char32_t* write(char32_t* destination, Point const& point) noexcept {
+    *destination++ = U'<';
+    destination = Formatter<int>::write(destination, point.x);
+    *destination++ = U';';
+    destination = Formatter<int>::write(destination, point.y);
+    *destination++ = U'>';
+
+    return destination;
+  }
+};
+
+namespace {
+
+using Parser = rh::_Hidden::FormatParser;
+
+constexpr Parser::Error parseError(const char32_t* format) {
+  size_t length = 0;
+  while (format[length])
+    ++length;
+
+  return Parser::parse(format, length, nullptr).error;
+}
+
+}
+
+// braces consumed as "}}" don't close a later '{'
+static_assert(parseError(U"}}{x}") == Parser::Error::UnsupportedSpecification);
+static_assert(parseError(U"}}{") == Parser::Error::UnmatchedOpenBrace);
+static_assert(parseError(U"{}}") == Parser::Error::UnmatchedCloseBrace);
+static_assert(parseError(U"}}{}{{") == Parser::Error::None);
+
+TEST(FormatTests, Basic) {
+  EXPECT_EQ(format<"">(), U"");
+  EXPECT_EQ(format<"plain text">(), U"plain text");
+  EXPECT_EQ(format<"{} of {} done">(3, 10u), U"3 of 10 done");
+  EXPECT_EQ(format<"{}{}">(-5, U'x'), U"-5x");
+  EXPECT_EQ(format<U"привет, {}!">(StringView{U"мир"}), U"привет, мир!");
+  EXPECT_EQ(format<"{{}} {{{}}}">(1), U"{} {1}");
+  EXPECT_EQ(format<"}}{}">(1), U"}1");
+  EXPECT_EQ(format<"{} {}">(true, false), U"true false");
+  EXPECT_EQ(format<"{} {}">(1.5, 0.1f), U"1.5 0.1");
+
+  String name{U"rhlib"};
+  EXPECT_EQ(format<"[{}|{}]">(name, U"literal"), U"[rhlib|literal]");
+  EXPECT_EQ(format<"{}">(FixedString{U"fixed"}), U"fixed");
+
+  constexpr size_t length = format<"{}-{}">(12345, -67).length();
+  EXPECT_EQ(length, 9);
+}
+
+TEST(FormatTests, Containers) {
+  rh::List<int> numbers;
+  numbers.append(1);
+  numbers.append(22);
+  numbers.append(-333);
+
+  EXPECT_EQ(format<"{}">(numbers), U"[1, 22, -333]");
+  EXPECT_EQ(format<"{}">(rh::List<int>{}), U"[]");
+
+  rh::Pair<String, int> pair{String{U"answer"}, 42};
+  EXPECT_EQ(format<"{}">(pair), U"(answer, 42)");
+
+  rh::List<rh::Pair<int, bool>> pairs;
+  pairs.append(rh::Pair<int, bool>{1, true});
+  pairs.append(rh::Pair<int, bool>{2, false});
+
+  EXPECT_EQ(format<"{}">(pairs), U"[(1, true), (2, false)]");
+
+  rh::List<Point> points;
+  points.append(Point{3, 4});
+
+  EXPECT_EQ(format<"{} -> {}">(Point{1, -2}, points), U"<1;-2> -> [<3;4>]");
+
+  rh::Arena arena;
+  rh::List<int, rh::ArenaAllocator> arenaNumbers{rh::ArenaAllocator{arena}};
+  arenaNumbers.append(7);
+  arenaNumbers.append(8);
+
+  EXPECT_EQ(format<"{}">(arenaNumbers), U"[7, 8]");
+}
+
+TEST(FormatTests, FormatTo) {
+  String buffer{U"log: "};
+
+  formatTo<"{}+{}={}">(buffer, 2, 2, 4);
+  EXPECT_EQ(buffer, U"log: 2+2=4");
+
+  // reserved space is reused
+  buffer.clear();
+  formatTo<"{}">(buffer, String(100, U'a'));
+  const char32_t* data = buffer.data();
+
+  buffer.clear();
+  formatTo<"{} {}">(buffer, 1.0 / 3.0, 12345678);
+  EXPECT_EQ(buffer, U"0.3333333333333333 12345678");
+  EXPECT_EQ(buffer.data(), data);
+
+  EXPECT_TRUE((Formattable<rh::List<rh::Pair<int, double>>>));
+  EXPECT_FALSE(Formattable<rh::List<void*>>);
+}
+
+// arguments, which view destination, are read before it changes
+TEST(FormatTests, FormatToItself) {
+  // grows
+  String string{U"abc"};
+  formatTo<"{}!">(string, string);
+  EXPECT_EQ(string, U"abcabc!");
+
+  formatTo<"<{}|{}>">(string, StringView{string}.subView(0, 3), string);
+  EXPECT_EQ(string, U"abcabc!<abc|abcabc!>");
+
+  // fits into capacity
+  String reserved{U"xy"};
+  reserved.reserve(100);
+  const char32_t* data = reserved.data();
+
+  formatTo<"{}{}">(reserved, reserved, StringView{reserved});
+  EXPECT_EQ(reserved, U"xyxyxy");
+  EXPECT_EQ(reserved.data(), data);
+
+  constexpr bool in_constant_evaluation = [] {
+    String string{U"constant"};
+    formatTo<" {}">(string, string);
+    return string == U"constant constant";
+  }();
+
+  EXPECT_TRUE(in_constant_evaluation);
+}
@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+
+#include <rh/String.hpp>
+#include <rh/hash.hpp>
+
+#include <random>
+#include <vector>
+#include <unordered_set>
+
+namespace {
+
+constexpr size_t LONG_LENGTH = 1000;
+
+// long enough for the stripe loop, with several blocks and a partial last stripe
+struct LongString {
+  char32_t characters[LONG_LENGTH + 1] = {};
+
+  constexpr LongString() {
+    for (size_t index = 0; index < LONG_LENGTH; ++index)
+      characters[index] = static_cast<char32_t>(U'a' + index * 7 % 26 + (index % 13 == 0 ? 0x400 : 0));
+  }
+
+  constexpr StringView view() const {
+    return StringView{characters, LONG_LENGTH};
+  }
+};
+
+constexpr LongString LONG_STRING;
+
+}
+
+TEST(HashTests, ConstantEvaluation) {
+  constexpr uint64_t empty = StringView{}.hash();
+  constexpr uint64_t hello = StringView{U"hello"}.hash();
+  constexpr uint64_t medium = StringView{U"a string which is longer than forty eight code units, so it takes the loop"}.hash();
+  constexpr uint64_t seeded = StringView{U"hello"}.hash(42);
+  constexpr uint64_t long_hash = LONG_STRING.view().hash();
+
+  EXPECT_EQ(empty, hash::units(U"", 0));
+  EXPECT_EQ(hello, String{U"hello"}.hash());
+  EXPECT_EQ(medium, String{U"a string which is longer than forty eight code units, so it takes the loop"}.hash());
+  EXPECT_EQ(seeded, String{U"hello"}.hash(42));
+  EXPECT_EQ(long_hash, String{LONG_STRING.view()}.hash());
+
+  EXPECT_NE(hello, seeded);
+  EXPECT_NE(hello, empty);
+
+  constexpr uint64_t bytes_hash = hash::units(u8"bytes", 5);
+  EXPECT_EQ(bytes_hash, hash::bytes(u8"bytes", 5));
+}
+
+TEST(HashTests, UnitsMatchBytes) {
+  std::mt19937_64 random{42};
+
+  for (size_t length = 0; length < 700; length += 1 + length / 8) {
+    String string;
+    for (size_t index = 0; index < length; ++index)
+      string.push(static_cast<char32_t>(random() % 0x10FFFF));
+
+    StringView view = string;
+
+    EXPECT_EQ(view.hash(), hash::bytes(view.data(), length * sizeof(char32_t))) << length;
+    EXPECT_EQ(view.hash(7), hash::bytes(view.data(), length * sizeof(char32_t), 7)) << length;
+  }
+}
+
+TEST(HashTests, Avalanche) {
+  constexpr size_t KEYS_COUNT = 200;
+
+  std::mt19937_64 random{1};
+
+  // sizes cover short inputs, the 48-byte loop and the stripe loop
+  for (size_t size : { 8, 16, 40, 100, 600 }) {
+    std::vector<uint8_t> key(size);
+    size_t flipped = 0;
+    size_t total = 0;
+
+    for (size_t iteration = 0; iteration < KEYS_COUNT; ++iteration) {
+      for (uint8_t& value : key)
+        value = static_cast<uint8_t>(random());
+
+      uint64_t original = hash::bytes(key.data(), size);
+
+      for (size_t bit = 0; bit < size * 8; bit += 1 + size / 16) {
+        key[bit / 8] ^= 1 << (bit % 8);
+        flipped += __builtin_popcountll(original ^ hash::bytes(key.data(), size));
+        total += 64;
+        key[bit / 8] ^= 1 << (bit % 8);
+      }
+    }
+
+    double ratio = static_cast<double>(flipped) / total;
+    EXPECT_GT(ratio, 0.49) << size;
+    EXPECT_LT(ratio, 0.51) << size;
+  }
+
+  EXPECT_NE(hash::integer(1), hash::integer(2));
+  EXPECT_NE(hash::combine(1, 2), hash::combine(2, 1));
+}
+
+TEST(HashTests, Collisions) {
+  std::unordered_set<uint64_t> full_hashes;
+  std::unordered_set<uint64_t> low_bits;
+
+  constexpr size_t KEYS_COUNT = 100000;
+
+  for (size_t index = 0; index < KEYS_COUNT; ++index) {
+    std::u32string key = U"key_" + std::u32string(index % 7, U'x');
+    for (size_t value = index; value; value /= 10)
+      key += static_cast<char32_t>(U'0' + value % 10);
+
+    uint64_t hash = StringView{key}.hash();
+    full_hashes.insert(hash);
+    low_bits.insert(hash & 0xFFFFF);
+  }
+
+  EXPECT_EQ(full_hashes.size(), KEYS_COUNT);
+
+  // ~100000 keys in 2^20 buckets, random function would leave ~95.4% of them unique
+  EXPECT_GT(low_bits.size(), KEYS_COUNT * 94 / 100);
+}
+
+TEST(HashTests, Hasher) {
+  EXPECT_EQ(Hasher<String>{}(String{U"key"}), StringView{U"key"}.hash());
+  EXPECT_EQ(Hasher<StringView>{}(U"key"), StringView{U"key"}.hash());
+  EXPECT_EQ(Hasher<int>{}(5), hash::integer(5));
+  EXPECT_NE(Hasher<int>{}(5), Hasher<int>{}(6));
+
+  int value = 0;
+  EXPECT_EQ(Hasher<int*>{}(&value), Hasher<int*>{}(&value));
+}
+
+// hash follows every change of the string
+TEST(HashTests, StringChanges) {
+  String string{U"value"};
+  uint64_t before = string.hash();
+
+  string[0] = U'V';
+  EXPECT_NE(string.hash(), before);
+  EXPECT_EQ(string.hash(), StringView{U"Value"}.hash());
+
+  string.append(U" and more");
+  EXPECT_EQ(string.hash(), StringView{U"Value and more"}.hash());
+
+  String moved = move(string);
+  EXPECT_EQ(moved.hash(), StringView{U"Value and more"}.hash());
+  EXPECT_EQ(string.hash(), StringView{}.hash());
+}
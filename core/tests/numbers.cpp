@@ -0,0 +1,321 @@
+#include <gtest/gtest.h>
+
+#include <rh/numbers.hpp>
+
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <random>
+#include <string>
+
+namespace {
+
+template <typename T>
+String toString(T value) {
+  String result;
+  toChars(result, value);
+  return result;
+}
+
+std::u32string widen(const char* begin, const char* end) {
+  return std::u32string(begin, end);
+}
+
+// std::to_chars is the reference for the shortest representation
+template <typename T>
+std::u32string referenceChars(T value) {
+  char buffer[64];
+  std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+
+  return widen(buffer, result.ptr);
+}
+
+template <typename T>
+std::u32string ourChars(T value) {
+  char32_t buffer[MAX_NUMBER_LENGTH];
+  char32_t* end = toChars(buffer, value);
+
+  EXPECT_LE(end - buffer, static_cast<ssize_t>(MAX_NUMBER_LENGTH));
+  return std::u32string(buffer, end);
+}
+
+template <typename T>
+uint64_t bitsOf(T value) {
+  if constexpr (sizeof(T) == 8)
+    return __builtin_bit_cast(uint64_t, value);
+  else
+    return __builtin_bit_cast(uint32_t, value);
+}
+
+}
+
+TEST(NumbersTests, IntegerToChars) {
+  constexpr auto digits = [] {
+    char32_t buffer[MAX_NUMBER_LENGTH] = {};
+    return toChars(buffer, -1234567) - buffer;
+  }();
+
+  EXPECT_EQ(digits, 8);
+
+  EXPECT_EQ(toString(0), U"0");
+  EXPECT_EQ(toString(7), U"7");
+  EXPECT_EQ(toString(-42), U"-42");
+  EXPECT_EQ(toString(1000000), U"1000000");
+  EXPECT_EQ(toString(std::numeric_limits<int64_t>::min()), U"-9223372036854775808");
+  EXPECT_EQ(toString(std::numeric_limits<uint64_t>::max()), U"18446744073709551615");
+  EXPECT_EQ(toString(static_cast<int8_t>(-128)), U"-128");
+
+  String appended{U"x = "};
+  toChars(appended, 99u);
+  EXPECT_EQ(appended, U"x = 99");
+
+  uint64_t value = 1;
+  for (int power = 0; power < 20; ++power, value *= 10) {
+    EXPECT_EQ(ourChars(value), referenceChars(value));
+    EXPECT_EQ(ourChars(value - 1), referenceChars(value - 1));
+  }
+}
+
+TEST(NumbersTests, IntegerParsing) {
+  int32_t value = 0;
+
+  EXPECT_EQ(parseNumber(U"123abc", value), 3);
+  EXPECT_EQ(value, 123);
+
+  EXPECT_EQ(parseNumber(U"-2147483648", value), 11);
+  EXPECT_EQ(value, std::numeric_limits<int32_t>::min());
+
+  EXPECT_EQ(parseNumber(U"2147483647", value), 10);
+  EXPECT_EQ(value, std::numeric_limits<int32_t>::max());
+
+  EXPECT_EQ(parseNumber(U"2147483648", value), -1);
+  EXPECT_EQ(parseNumber(U"-2147483649", value), -1);
+  EXPECT_EQ(parseNumber(U"", value), -1);
+  EXPECT_EQ(parseNumber(U"-", value), -1);
+  EXPECT_EQ(parseNumber(U"+1", value), -1);
+
+  uint64_t big = 0;
+  EXPECT_EQ(parseNumber(U"18446744073709551615", big), 20);
+  EXPECT_EQ(big, std::numeric_limits<uint64_t>::max());
+  EXPECT_EQ(parseNumber(U"18446744073709551616", big), -1);
+  EXPECT_EQ(parseNumber(U"-1", big), -1);
+
+  constexpr int16_t parsed = parseNumber<int16_t>(U"-300");
+  EXPECT_EQ(parsed, -300);
+
+  EXPECT_THROW((void)parseNumber<int>(U"12 "), rh::ParseError);
+  EXPECT_THROW((void)parseNumber<uint8_t>(U"256"), rh::ParseError);
+
+  std::mt19937_64 random{42};
+
+  for (int iteration = 0; iteration < 10000; ++iteration) {
+    int64_t number = static_cast<int64_t>(random()) >> (random() % 64);
+    String string = toString(number);
+
+    EXPECT_EQ(parseNumber<int64_t>(string), number);
+  }
+}
+
+TEST(NumbersTests, FloatingPointToChars) {
+  EXPECT_EQ(toString(0.0), U"0");
+  EXPECT_EQ(toString(-0.0), U"-0");
+  EXPECT_EQ(toString(1.5), U"1.5");
+  EXPECT_EQ(toString(0.1), U"0.1");
+  EXPECT_EQ(toString(100.0), U"100");
+  EXPECT_EQ(toString(1e21), U"1e+21");
+  EXPECT_EQ(toString(1e-7), U"1e-07");
+  EXPECT_EQ(toString(0.1f), U"0.1");
+  EXPECT_EQ(toString(190944592.0f), U"190944592");
+  EXPECT_EQ(toString(std::numeric_limits<double>::infinity()), U"inf");
+  EXPECT_EQ(toString(-std::numeric_limits<float>::infinity()), U"-inf");
+  EXPECT_EQ(toString(std::numeric_limits<double>::quiet_NaN()), U"nan");
+
+  const double doubles[] = {
+    std::numeric_limits<double>::min(), std::numeric_limits<double>::max(),
+    std::numeric_limits<double>::denorm_min(), std::numeric_limits<double>::epsilon(),
+    5e-324, 9007199254740993.0, 123456789012345680.0, 0.3, 2.0 / 3.0, 1e23, 1e22
+  };
+
+  for (double value : doubles)
+    EXPECT_EQ(ourChars(value), referenceChars(value)) << value;
+
+  std::mt19937_64 random{42};
+
+  for (int iteration = 0; iteration < 200000; ++iteration) {
+    uint64_t bits = random();
+    double value = __builtin_bit_cast(double, bits);
+
+    if (std::isfinite(value)) {
+      ASSERT_EQ(ourChars(value), referenceChars(value)) << std::hex << bits;
+    }
+
+    float single = __builtin_bit_cast(float, static_cast<uint32_t>(bits));
+
+    if (std::isfinite(single)) {
+      ASSERT_EQ(ourChars(single), referenceChars(single)) << std::hex << static_cast<uint32_t>(bits);
+    }
+  }
+
+  // every power of two, including the ones with closer lower boundary
+  for (int exponent = -1074; exponent <= 1023; ++exponent)
+    ASSERT_EQ(ourChars(std::ldexp(1.0, exponent)), referenceChars(std::ldexp(1.0, exponent)));
+
+  for (int exponent = -149; exponent <= 127; ++exponent)
+    ASSERT_EQ(ourChars(std::ldexp(1.0f, exponent)), referenceChars(std::ldexp(1.0f, exponent)));
+}
+
+TEST(NumbersTests, FloatingPointParsing) {
+  double value = 0;
+
+  EXPECT_EQ(parseNumber(U"1.25e2x", value), 6);
+  EXPECT_EQ(value, 125.0);
+
+  EXPECT_EQ(parseNumber(U"-.5", value), 3);
+  EXPECT_EQ(value, -0.5);
+
+  EXPECT_EQ(parseNumber(U"7.", value), 2);
+  EXPECT_EQ(value, 7.0);
+
+  // exponent without digits isn't consumed
+  EXPECT_EQ(parseNumber(U"3e", value), 1);
+  EXPECT_EQ(parseNumber(U"3e+", value), 1);
+
+  EXPECT_EQ(parseNumber(U"Infinity", value), 8);
+  EXPECT_EQ(value, std::numeric_limits<double>::infinity());
+
+  EXPECT_EQ(parseNumber(U"-inf", value), 4);
+  EXPECT_EQ(value, -std::numeric_limits<double>::infinity());
+
+  EXPECT_EQ(parseNumber(U"NaN", value), 3);
+  EXPECT_TRUE(std::isnan(value));
+
+  EXPECT_EQ(parseNumber(U"1e400", value), 5);
+  EXPECT_EQ(value, std::numeric_limits<double>::infinity());
+
+  EXPECT_EQ(parseNumber(U"-1e-400", value), 7);
+  EXPECT_EQ(bitsOf(value), bitsOf(-0.0));
+
+  EXPECT_EQ(parseNumber(U"", value), -1);
+  EXPECT_EQ(parseNumber(U".", value), -1);
+  EXPECT_EQ(parseNumber(U"-e5", value), -1);
+
+  EXPECT_EQ(parseNumber<double>(U"4.9406564584124654e-324"), std::numeric_limits<double>::denorm_min());
+  EXPECT_EQ(parseNumber<double>(U"1.7976931348623157e308"), std::numeric_limits<double>::max());
+  EXPECT_EQ(parseNumber<float>(U"3.4028235e38"), std::numeric_limits<float>::max());
+
+  // halfway between 2^53 and 2^53 + 2 with and without the digits beyond 19
+  EXPECT_EQ(parseNumber<double>(U"9007199254740993"), 9007199254740992.0);
+  EXPECT_EQ(parseNumber<double>(U"9007199254740993.00000000000000000001"), 9007199254740994.0);
+  EXPECT_EQ(parseNumber<double>(U"0.1000000000000000055511151231257827021181583404541015625"), 0.1);
+
+  EXPECT_THROW((void)parseNumber<double>(U"1.5 "), rh::ParseError);
+}
+
+TEST(NumbersTests, FloatingPointRoundTrip) {
+  std::mt19937_64 random{7};
+
+  for (int iteration = 0; iteration < 100000; ++iteration) {
+    uint64_t bits = random();
+    double value = __builtin_bit_cast(double, bits);
+
+    if (std::isfinite(value)) {
+      ASSERT_EQ(bitsOf(parseNumber<double>(toString(value))), bits);
+    }
+
+    float single = __builtin_bit_cast(float, static_cast<uint32_t>(bits));
+
+    if (std::isfinite(single)) {
+      ASSERT_EQ(bitsOf(parseNumber<float>(toString(single))), static_cast<uint32_t>(bits));
+    }
+  }
+}
+
+TEST(NumbersTests, FloatingPointParsingMatchesFromChars) {
+  std::mt19937_64 random{11};
+
+  for (int iteration = 0; iteration < 100000; ++iteration) {
+    std::string narrow;
+
+    if (random() % 2)
+      narrow += '-';
+
+    // long mantissas exercise the truncated path
+    size_t integer_digits = random() % 30;
+    size_t fraction_digits = random() % 30;
+
+    for (size_t index = 0; index < integer_digits; ++index)
+      narrow += static_cast<char>('0' + random() % 10);
+
+    narrow += '.';
+
+    for (size_t index = 0; index < fraction_digits; ++index)
+      narrow += static_cast<char>('0' + random() % 10);
+
+    if (integer_digits + fraction_digits == 0)
+      narrow += '0';
+
+    narrow += 'e';
+    narrow += std::to_string(static_cast<int>(random() % 700) - 350);
+
+    std::u32string wide = widen(narrow.data(), narrow.data() + narrow.size());
+
+    double expected = std::strtod(narrow.c_str(), nullptr);
+    double actual = 0;
+
+    ASSERT_EQ(parseNumber(StringView{wide.data(), wide.size()}, actual), static_cast<ssize_t>(wide.size()));
+    ASSERT_EQ(bitsOf(actual), bitsOf(expected)) << narrow;
+
+    float expected_single = std::strtof(narrow.c_str(), nullptr);
+    float actual_single = 0;
+
+    ASSERT_EQ(parseNumber(StringView{wide.data(), wide.size()}, actual_single), static_cast<ssize_t>(wide.size()));
+    ASSERT_EQ(bitsOf(actual_single), bitsOf(expected_single)) << narrow;
+  }
+}
+
+TEST(NumbersTests, FloatingPointParsingLongMantissa) {
+  // 2^53 + 1 lies halfway between two doubles, so a nonzero digit far in the tail decides
+  std::string halfway = "9007199254740993." + std::string(1000, '0');
+  std::u32string wide = widen(halfway.data(), halfway.data() + halfway.size());
+  double value = 0;
+
+  EXPECT_EQ(parseNumber(StringView{wide.data(), wide.size()}, value), static_cast<ssize_t>(wide.size()));
+  EXPECT_EQ(value, 9007199254740992.0);
+
+  wide += U'1';
+
+  EXPECT_EQ(parseNumber(StringView{wide.data(), wide.size()}, value), static_cast<ssize_t>(wide.size()));
+  EXPECT_EQ(value, 9007199254740994.0);
+
+  std::mt19937_64 random{13};
+
+  for (int iteration = 0; iteration < 2000; ++iteration) {
+    std::string narrow;
+
+    if (random() % 2)
+      narrow += '-';
+
+    size_t integer_digits = random() % 600;
+    size_t fraction_digits = 257 + random() % 900;
+
+    for (size_t index = 0; index < integer_digits; ++index)
+      narrow += static_cast<char>('0' + random() % 10);
+
+    narrow += '.';
+
+    for (size_t index = 0; index < fraction_digits; ++index)
+      narrow += static_cast<char>('0' + random() % 10);
+
+    narrow += 'e';
+    narrow += std::to_string(static_cast<int>(random() % 1200) - 900);
+
+    std::u32string wide_random = widen(narrow.data(), narrow.data() + narrow.size());
+
+    double expected = std::strtod(narrow.c_str(), nullptr);
+    double actual = 0;
+
+    ASSERT_EQ(parseNumber(StringView{wide_random.data(), wide_random.size()}, actual), static_cast<ssize_t>(wide_random.size()));
+    ASSERT_EQ(bitsOf(actual), bitsOf(expected)) << narrow;
+  }
+}
@@ -0,0 +1,493 @@
+#include <gtest/gtest.h>
+
+#include <rh/Array.hpp>
+#include <rh/List.hpp>
+#include <rh/SmallList.hpp>
+#include <rh/String.hpp>
+#include <rh/sort.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace {
+
+template <typename T>
+rh::List<T> listOf(std::vector<T> const& values) {
+  rh::List<T> list;
+
+  for (T const& value : values)
+    list.append(value);
+
+  return list;
+}
+
+template <typename T>
+std::vector<T> vectorOf(rh::List<T> const& list) {
+  return std::vector<T>(list.begin(), list.end());
+}
+
+// Shapes, which are known to hurt quicksorts
+std::vector<std::vector<int>> patterns(size_t count) {
+  std::mt19937 random(7);
+  std::vector<std::vector<int>> result;
+
+  std::vector<int> ascending(count);
+  for (size_t i = 0; i < count; ++i)
+    ascending[i] = static_cast<int>(i);
+
+  std::vector<int> descending(ascending.rbegin(), ascending.rend());
+
+  std::vector<int> pipe(count);
+  for (size_t i = 0; i < count; ++i)
+    pipe[i] = static_cast<int>(i < count / 2 ? i : count - i);
+
+  std::vector<int> few(count);
+  for (int& value : few)
+    value = static_cast<int>(random() % 4);
+
+  std::vector<int> noisy = ascending;
+  for (size_t i = 0; count > 0 && i < count / 100 + 1; ++i)
+    std::swap(noisy[random() % count], noisy[random() % count]);
+
+  std::vector<int> shuffled = ascending;
+  std::shuffle(shuffled.begin(), shuffled.end(), random);
+
+  std::vector<int> negative(count);
+  for (int& value : negative)
+    value = static_cast<int>(random());
+
+  return { ascending, descending, pipe, few, noisy, shuffled, negative };
+}
+
+struct Record {
+  int key;
+  int order;
+};
+
+}
+
+static_assert(rh::SortableContainer<rh::List<int>>);
+static_assert(rh::SortableContainer<rh::SmallList<int, 8>>);
+static_assert(rh::SortableContainer<rh::Array<int, 4>>);
+static_assert(!rh::SortableContainer<rh::List<int> const>);
+
+TEST(SortTests, Patterns) {
+  for (size_t count : { 0, 1, 2, 23, 24, 100, 129, 1000, 20000 }) {
+    for (std::vector<int> const& values : patterns(count)) {
+      std::vector<int> expected = values;
+      std::sort(expected.begin(), expected.end());
+
+      // comparator keeps it away from radix sort
+      rh::List<int> list = listOf(values);
+      rh::sort(list, [](int left, int right) { return left < right; });
+      EXPECT_EQ(vectorOf(list), expected) << count;
+
+      list = listOf(values);
+      rh::sort(list);
+      EXPECT_EQ(vectorOf(list), expected) << count;
+
+      list = listOf(values);
+      rh::stableSort(list, [](int left, int right) { return left < right; });
+      EXPECT_EQ(vectorOf(list), expected) << count;
+    }
+  }
+}
+
+TEST(SortTests, Comparators) {
+  std::vector<int> values = patterns(5000)[5];
+
+  rh::List<int> list = listOf(values);
+  rh::sort(list, [](int left, int right) { return left > right; });
+  EXPECT_TRUE(std::is_sorted(list.begin(), list.end(), std::greater<int>()));
+
+  rh::Array<int, 5> array;
+  for (size_t i = 0; i < 5; ++i)
+    array[i] = static_cast<int>(i * 3 % 5 + 1);
+
+  rh::sort(array);
+  EXPECT_EQ(array[0], 1);
+  EXPECT_EQ(array[4], 5);
+
+  rh::SmallList<int, 8> small;
+  for (int value : { 3, 1, 2 })
+    small.append(value);
+
+  rh::sort(small);
+  EXPECT_EQ(small[0], 1);
+  EXPECT_EQ(small[2], 3);
+
+  int raw[] = { 2, 1 };
+  rh::sort(raw, raw + 2);
+  EXPECT_EQ(raw[0], 1);
+
+  constexpr int sorted = [] {
+    int items[] = { 4, 2, 3, 1 };
+    rh::sort(items, items + 4);
+    return items[0] * 1000 + items[1] * 100 + items[2] * 10 + items[3];
+  }();
+  EXPECT_EQ(sorted, 1234);
+}
+
+TEST(SortTests, Radix) {
+  std::mt19937_64 random(42);
+
+  std::vector<int64_t> integers(10000);
+  for (int64_t& value : integers)
+    value = static_cast<int64_t>(random());
+
+  integers[0] = std::numeric_limits<int64_t>::min();
+  integers[1] = std::numeric_limits<int64_t>::max();
+  integers[2] = 0;
+  integers[3] = -1;
+
+  rh::List<int64_t> list = listOf(integers);
+  rh::sort(list);
+  std::sort(integers.begin(), integers.end());
+  EXPECT_EQ(vectorOf(list), integers);
+
+  std::vector<uint8_t> bytes(3000);
+  for (uint8_t& value : bytes)
+    value = static_cast<uint8_t>(random());
+
+  rh::List<uint8_t> byte_list = listOf(bytes);
+  rh::stableSort(byte_list);
+  std::sort(bytes.begin(), bytes.end());
+  EXPECT_EQ(vectorOf(byte_list), bytes);
+
+  // only the high byte differs, lower passes are skipped
+  std::vector<uint32_t> high(1000);
+  for (uint32_t& value : high)
+    value = static_cast<uint32_t>(random() % 256) << 24;
+
+  rh::List<uint32_t> high_list = listOf(high);
+  rh::sort(high_list);
+  std::sort(high.begin(), high.end());
+  EXPECT_EQ(vectorOf(high_list), high);
+}
+
+TEST(SortTests, FloatingPoint) {
+  std::mt19937 random(3);
+  std::uniform_real_distribution<double> distribution(-1e6, 1e6);
+
+  std::vector<double> values(5000);
+  for (double& value : values)
+    value = distribution(random);
+
+  values[0] = -0.0;
+  values[1] = 0.0;
+  values[2] = std::numeric_limits<double>::infinity();
+  values[3] = -std::numeric_limits<double>::infinity();
+  values[4] = std::numeric_limits<double>::denorm_min();
+  values[5] = -std::numeric_limits<double>::denorm_min();
+
+  rh::List<double> list = listOf(values);
+  rh::sort(list);
+  EXPECT_TRUE(std::is_sorted(list.begin(), list.end()));
+  EXPECT_EQ(list[0], -std::numeric_limits<double>::infinity());
+  EXPECT_EQ(list[list.length() - 1], std::numeric_limits<double>::infinity());
+
+  // -0 and +0 are equal, so they keep their order
+  rh::List<double> zeros;
+  for (int i = 0; i < 1000; ++i)
+    zeros.append(i % 2 ? 0.0 : -0.0);
+
+  zeros.append(-1.0f);
+  rh::stableSort(zeros);
+  EXPECT_EQ(zeros[0], -1.0);
+
+  for (size_t i = 1; i < zeros.length(); ++i)
+    EXPECT_EQ(std::signbit(zeros[i]), i % 2 == 1) << i;
+
+  // fewer zeros, than radix sort takes, are merged and keep their order too
+  rh::List<double> pair = listOf(std::vector<double>{ 0.0, -0.0 });
+  rh::stableSort(pair);
+  EXPECT_FALSE(std::signbit(pair[0]));
+
+  for (size_t count : { 3, 7, 40, 300 }) {
+    rh::List<double> mixed;
+    std::vector<bool> signs;
+
+    for (size_t i = 0; i < count; ++i) {
+      double value = random() % 3 ? (random() % 2 ? 0.0 : -0.0) : static_cast<double>(random() % 5) - 2.0;
+      mixed.append(value);
+
+      if (value == 0)
+        signs.push_back(std::signbit(value));
+    }
+
+    rh::stableSort(mixed);
+    EXPECT_TRUE(std::is_sorted(mixed.begin(), mixed.end()));
+
+    std::vector<bool> sorted_signs;
+    for (double value : mixed) {
+      if (value == 0)
+        sorted_signs.push_back(std::signbit(value));
+    }
+
+    EXPECT_EQ(sorted_signs, signs) << count;
+  }
+
+  std::vector<float> floats(1000);
+  for (float& value : floats)
+    value = static_cast<float>(distribution(random));
+
+  rh::List<float> float_list = listOf(floats);
+  rh::sort(float_list);
+  std::sort(floats.begin(), floats.end());
+  EXPECT_EQ(vectorOf(float_list), floats);
+}
+
+TEST(SortTests, Strings) {
+  std::mt19937 random(11);
+  rh::List<String> strings;
+  std::vector<std::u32string> expected;
+
+  // short alphabet and shared prefixes, so equal units go deep
+  for (int i = 0; i < 3000; ++i) {
+    std::u32string string = i % 3 ? U"prefix" : U"";
+    size_t length = random() % 8;
+
+    for (size_t j = 0; j < length; ++j)
+      string += static_cast<char32_t>(U'a' + random() % 3);
+
+    if (i % 100 == 0)
+      string += U'\U0001F600';
+
+    expected.push_back(string);
+    strings.append(String(string.data(), string.size()));
+  }
+
+  rh::sort(strings);
+  std::sort(expected.begin(), expected.end());
+
+  ASSERT_EQ(strings.length(), expected.size());
+  for (size_t i = 0; i < expected.size(); ++i)
+    EXPECT_EQ(strings[i], StringView(expected[i].data(), expected[i].size())) << i;
+
+  rh::List<StringView> views;
+  for (std::u32string const& string : expected)
+    views.append(StringView(string.data(), string.size()));
+
+  std::shuffle(views.begin(), views.end(), random);
+  rh::stableSort(views);
+  EXPECT_TRUE(std::is_sorted(views.begin(), views.end()));
+
+  // equal views of different text keep their order, the text goes in the same order
+  for (size_t count : { 10, 3000 }) {
+    std::u32string text;
+
+    for (size_t i = 0; i < count; ++i)
+      text += random() % 2 ? U"ab" : U"b";
+
+    rh::List<StringView> words;
+    for (size_t i = 0; i < text.size(); i += text[i] == U'a' ? 2 : 1)
+      words.append(StringView(text.data() + i, text[i] == U'a' ? 2 : 1));
+
+    rh::stableSort(words);
+
+    for (size_t i = 1; i < words.length(); ++i) {
+      ASSERT_FALSE(words[i] < words[i - 1]) << i;
+
+      if (words[i - 1] == words[i]) {
+        ASSERT_LT(words[i - 1].data(), words[i].data()) << count << " " << i;
+      }
+    }
+  }
+
+  // all equal
+  rh::List<String> same;
+  for (int i = 0; i < 100; ++i)
+    same.append(String(U"same"));
+
+  rh::sort(same);
+  EXPECT_EQ(same[99], U"same");
+}
+
+TEST(SortTests, Stable) {
+  std::mt19937 random(5);
+
+  for (size_t count : { 10, 33, 1000, 10000 }) {
+    rh::List<Record> records;
+
+    for (size_t i = 0; i < count; ++i)
+      records.append(Record{ static_cast<int>(random() % 16), static_cast<int>(i) });
+
+    rh::stableSort(records, [](Record const& left, Record const& right) {
+      return left.key < right.key;
+    });
+
+    for (size_t i = 1; i < count; ++i) {
+      ASSERT_LE(records[i - 1].key, records[i].key);
+
+      if (records[i - 1].key == records[i].key) {
+        ASSERT_LT(records[i - 1].order, records[i].order);
+      }
+    }
+  }
+}
+
+TEST(SortTests, StableOwning) {
+  std::mt19937 random(9);
+  rh::List<String> strings;
+  std::vector<std::u32string> expected;
+
+  for (int i = 0; i < 500; ++i) {
+    std::u32string string(random() % 40, static_cast<char32_t>(U'a' + random() % 5));
+    expected.push_back(string);
+    strings.append(String(string.data(), string.size()));
+  }
+
+  // by length only: equal lengths keep their order
+  auto by_length = [](auto const& left, auto const& right) { return left.length() < right.length(); };
+
+  rh::stableSort(strings, by_length);
+  std::stable_sort(expected.begin(), expected.end(), [](auto const& left, auto const& right) {
+    return left.size() < right.size();
+  });
+
+  for (size_t i = 0; i < expected.size(); ++i)
+    EXPECT_EQ(strings[i], StringView(expected[i].data(), expected[i].size())) << i;
+}
+
+TEST(SortTests, ThrowingComparator) {
+  std::vector<std::u32string> expected;
+
+  for (int i = 0; i < 200; ++i)
+    expected.emplace_back(static_cast<size_t>(i * 37 % 101), U'x');
+
+  std::sort(expected.begin(), expected.end());
+
+  for (int throw_at : { 50, 1000 }) {
+    for (bool is_stable : { false, true }) {
+      rh::List<String> strings;
+
+      for (std::u32string const& string : expected)
+        strings.append(String(string.data(), string.size()));
+
+      std::shuffle(strings.begin(), strings.end(), std::mt19937(throw_at));
+
+      int calls = 0;
+      auto throwing = [&](String const& left, String const& right) {
+        if (++calls == throw_at)
+          throw std::runtime_error("comparison failed");
+
+        return left.length() < right.length();
+      };
+
+      if (is_stable) {
+        EXPECT_THROW(rh::stableSort(strings, throwing), std::runtime_error);
+      }
+      else {
+        EXPECT_THROW(rh::sort(strings, throwing), std::runtime_error);
+      }
+
+      // no item is lost or duplicated
+      std::vector<std::u32string> actual;
+      for (String const& string : strings)
+        actual.emplace_back(string.data(), string.length());
+
+      std::sort(actual.begin(), actual.end());
+      EXPECT_EQ(actual, expected) << throw_at << is_stable;
+    }
+  }
+}
+
+TEST(SortTests, Parallel) {
+  std::mt19937_64 random(1);
+  size_t count = rh::PARALLEL_SORT_THRESHOLD * 8 + 123;
+
+  std::vector<uint64_t> values(count);
+  for (uint64_t& value : values)
+    value = random() % 100000;
+
+  rh::List<uint64_t> list = listOf(values);
+  rh::parallelSort(list);
+  std::sort(values.begin(), values.end());
+  EXPECT_EQ(vectorOf(list), values);
+
+  // 8 parts and three rounds of merges, whatever the hardware is
+  std::shuffle(values.begin(), values.end(), random);
+  list = listOf(values);
+  rh::parallelSort(list, [](uint64_t left, uint64_t right) { return left > right; }, 8);
+  std::sort(values.begin(), values.end(), std::greater<uint64_t>());
+  EXPECT_EQ(vectorOf(list), values);
+
+  // owning items are moved through the buffer
+  rh::List<String> strings;
+  std::vector<std::u32string> expected;
+
+  for (size_t i = 0; i < rh::PARALLEL_SORT_THRESHOLD * 3; ++i) {
+    std::u32string string(1 + random() % 4, static_cast<char32_t>(U'a' + random() % 26));
+    expected.push_back(string);
+    strings.append(String(string.data(), string.size()));
+  }
+
+  rh::parallelSort(strings, rh::Less{}, 3);
+  std::sort(expected.begin(), expected.end());
+
+  for (size_t i = 0; i < expected.size(); ++i)
+    ASSERT_EQ(strings[i], StringView(expected[i].data(), expected[i].size())) << i;
+
+  // short input is sorted on the calling thread
+  rh::List<int> small = listOf(std::vector<int>{ 3, 2, 1 });
+  rh::parallelSort(small, rh::Less{}, 4);
+  EXPECT_EQ(vectorOf(small), (std::vector<int>{ 1, 2, 3 }));
+
+  std::vector<int> shuffled = patterns(count)[5];
+  rh::List<int> ints = listOf(shuffled);
+  EXPECT_THROW(rh::parallelSort(ints, [](int left, int right) {
+    if (left == 12345 || right == 12345)
+      throw std::runtime_error("comparison failed");
+
+    return left < right;
+  }, 4), std::runtime_error);
+
+  std::vector<int> actual = vectorOf(ints);
+  std::sort(actual.begin(), actual.end());
+  std::sort(shuffled.begin(), shuffled.end());
+  EXPECT_EQ(actual, shuffled);
+
+  // the same sort makes the same number of comparisons, so the throw lands in the last merge
+  std::vector<std::u32string> texts;
+  for (size_t i = 0; i < count; ++i)
+    texts.emplace_back(1 + random() % 4, static_cast<char32_t>(U'a' + random() % 26));
+
+  auto stringsOf = [](std::vector<std::u32string> const& values) {
+    rh::List<String> list;
+
+    for (std::u32string const& value : values)
+      list.append(String(value.data(), value.size()));
+
+    return list;
+  };
+
+  std::atomic<size_t> calls = 0;
+  size_t throw_at = 0;
+
+  auto counting = [&](String const& left, String const& right) {
+    if (++calls == throw_at)
+      throw std::runtime_error("comparison failed");
+
+    return left < right;
+  };
+
+  rh::List<String> merged = stringsOf(texts);
+  rh::parallelSort(merged, counting, 4);
+
+  throw_at = calls - 1000;
+  calls = 0;
+  merged = stringsOf(texts);
+  EXPECT_THROW(rh::parallelSort(merged, counting, 4), std::runtime_error);
+
+  std::vector<std::u32string> restored;
+  for (String const& string : merged)
+    restored.emplace_back(string.data(), string.length());
+
+  std::sort(restored.begin(), restored.end());
+  std::sort(texts.begin(), texts.end());
+  EXPECT_EQ(restored, texts);
+}